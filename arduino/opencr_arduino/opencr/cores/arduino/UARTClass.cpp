@@ -46,7 +46,6 @@ void UARTClass::begin(const uint32_t dwBaudRate, const UARTModes config)
   UNUSED(config);
 
   rx_buffer.iHead = rx_buffer.iTail = 0;
-  tx_buffer.iHead = tx_buffer.iTail = 0;
 
   _uart_baudrate = dwBaudRate;
 
@@ -76,10 +75,7 @@ int UARTClass::available( void )
 
 int UARTClass::availableForWrite(void)
 {
-  int head = tx_buffer.iHead;
-  int tail = tx_buffer.iTail;
-  if (head >= tail) return SERIAL_BUFFER_SIZE - 1 - head + tail;
-  return tail - head - 1;
+  return drv_uart_tx_available(_uart_num);
 }
 
 int UARTClass::peek( void )
@@ -110,10 +106,31 @@ int UARTClass::read( void )
   }
 }
 
+bool UARTClass::waitAvailable( uint32_t timeout_us )
+{
+  uint32_t start = micros();
+
+  // sleep until the rx interrupt (IRQ mode) or the idle line interrupt (DMA mode) brings data
+  while (available() == 0)
+  {
+    if ((micros() - start) >= timeout_us)
+      return false;
+
+    __WFI();
+  }
+
+  return true;
+}
+
 void UARTClass::flush( void )
 {
-  while (tx_buffer.iHead != tx_buffer.iTail); //wait for transmit data to be sent
-  // Wait for transmission to complete
+  // wait for the tx ring buffer to be sent up to the last stop bit
+  drv_uart_flush(_uart_num);
+}
+
+bool UARTClass::isTxDone( void )
+{
+  return drv_uart_tx_done(_uart_num) == TRUE;
 }
 
 size_t UARTClass::write( const uint8_t uc_data )
@@ -122,6 +139,13 @@ size_t UARTClass::write( const uint8_t uc_data )
   return drv_uart_write(_uart_num, uc_data);
 }
 
+size_t UARTClass::write( const uint8_t *buffer, size_t size )
+{
+  // queued into the tx ring buffer at once, returns before the data is sent
+  tx_cnt += size;
+  return drv_uart_write_buf(_uart_num, buffer, size);
+}
+
 uint32_t UARTClass::getBaudRate( void )
 {
   return _uart_baudrate;
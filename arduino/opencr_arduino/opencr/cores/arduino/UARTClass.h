@@ -50,8 +50,11 @@ class UARTClass : public HardwareSerial
     int availableForWrite(void);
     int peek(void);
     int read(void);
+    bool waitAvailable(uint32_t timeout_us);
     void flush(void);
+    bool isTxDone(void);
     size_t write(const uint8_t c);
+    size_t write(const uint8_t *buffer, size_t size);
     using Print::write; // pull in write(str) and write(buf, size) from Print
 
 
@@ -79,7 +82,6 @@ class UARTClass : public HardwareSerial
     uint32_t _uart_baudrate;
 
     uint8_t r_byte;
-    ring_buffer tx_buffer;
     ring_buffer rx_buffer;
 
     uint32_t rx_cnt;
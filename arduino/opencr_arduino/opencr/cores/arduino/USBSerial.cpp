@@ -98,6 +98,26 @@ size_t USBSerial::write(uint8_t c) {
 	return write(&c, 1);
 }
 
+int USBSerial::availableForWrite(void)
+{
+  return vcp_tx_available();
+}
+
+// Contiguous space in the tx buffer to build up to length bytes in place.
+// It returns NULL instead of waiting when there is no room, and every
+// reserveWrite() that succeeds must be followed by a commitWrite().
+uint8_t *USBSerial::reserveWrite(uint32_t length)
+{
+  return vcp_tx_reserve(length);
+}
+
+void USBSerial::commitWrite(uint32_t length)
+{
+  vcp_tx_commit(length);
+
+  tx_cnt += length;
+}
+
 uint32_t USBSerial::getBaudRate(void)
 {
   return usb_cdc_bitrate;
@@ -54,6 +54,9 @@ class USBSerial : public Stream {
     virtual size_t write(uint8_t c);
     virtual size_t write(const uint8_t *buffer, size_t size);
     using Print::write; // pull in write(str) from Print
+    int availableForWrite(void);
+    uint8_t *reserveWrite(uint32_t length);
+    void commitWrite(uint32_t length);
     operator bool();
 
     uint32_t getBaudRate(void);
@@ -0,0 +1,209 @@
+/*******************************************************************************
+* Copyright (c) 2016, ROBOTIS CO., LTD.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* * Neither the name of ROBOTIS nor the names of its
+*   contributors may be used to endorse or promote products derived from
+*   this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+// Adaptive status packet timeout of PortHandler (setAdaptiveTimeout) against the fixed timeout of the port handler.
+// Three IDs answer with different return delays and some jitter. The program checks that
+//   steady      : the learned timeouts time out no status packet that arrives (false timeouts)
+//   muted ID    : a device that stopped answering costs the timeout fast_fail learned for it, and less than the fixed timeout
+//   slower ID   : a device whose return delay grew is answered again after the timeouts it takes to relearn
+// for the fixed timeout, the adaptive timeout and the adaptive timeout with fast_fail.
+// The simulator stamps every status packet against its schedule from the moment the read was sent (ServoSimulator::stampInstruction).
+// A timeout whose status packet the simulator thread wrote more than LATE_LIMIT after its schedule was caused by the host scheduler,
+// not by the timeout, so it is counted apart and not checked. Up to 1 % of the other timeouts is tolerated in steady state,
+// for the tail of the jitter beyond the 99th percentile.
+// After a timeout the test waits for the late status packet, so that it is flushed before the next read instead of taken as its answer.
+//
+// usage: adaptive_timeout_test [baudrate [reads]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "dynamixel_sdk.h"
+#include "servo_simulator.h"
+
+#define ADDR_PRESENT_POSITION   132
+#define MODEL_XM430_W210        1030
+
+#define ID_NUM                  3
+
+static const double return_delay_list[ID_NUM] = { 100.0, 250.0, 500.0 };   // usec
+#define JITTER                  100.0                                       // usec
+#define SLOWER_RETURN_DELAY     2500.0                                      // usec, after the change of ID 3
+#define CONTROL_PERIOD          5.0                                         // msec between the reads of the slower ID
+#define LATE_LIMIT              0.25                                        // msec, a status packet later than this was held up by the host
+#define LATE_WAIT               50.0                                        // msec to wait for the status packet after a timeout
+#define STATUS_LENGTH           15                                          // status packet of a 4 byte read
+#define MUTED_READS             20
+#define READ_OVERHEAD           1.0                                         // msec per read the host may add to a timeout
+
+enum { MODE_FIXED, MODE_ADAPTIVE, MODE_FAST_FAIL, MODE_NUM };
+static const char *mode_name[MODE_NUM] = { "fixed", "adaptive", "fast_fail" };
+
+struct ReadCost
+{
+  int    timeout;
+  int    late;      // timeouts of status packets the host held up, see LATE_LIMIT
+  double msec;      // mean time per read
+};
+
+// sim is NULL for an ID that doesn't answer, whose timeouts are not looked into
+static ReadCost readId(dynamixel::PortHandler *port, dynamixel::PacketHandler *ph, ServoSimulator *sim, uint8_t id, int reads, double period = 0.0)
+{
+  ReadCost cost = { 0, 0, 0.0 };
+  double   start_time = port->getCurrentTime();
+
+  for (int i = 0; i < reads; i++)
+  {
+    while (port->getCurrentTime() - start_time < period * i)
+      usleep(50);
+
+    uint32_t position     = 0;
+    uint8_t  error        = 0;
+    uint32_t status_count = 0;
+
+    if (sim != NULL)
+    {
+      status_count = sim->getStatusCount();
+      sim->stampInstruction();
+    }
+
+    double   read_time    = port->getCurrentTime();
+    int      result       = ph->read4ByteTxRx(port, id, ADDR_PRESENT_POSITION, &position, &error);
+    cost.msec += port->getCurrentTime() - read_time;
+
+    if (result == COMM_SUCCESS)
+      continue;
+
+    if (sim == NULL)
+    {
+      cost.timeout++;
+      continue;
+    }
+
+    double wait_time = port->getCurrentTime();
+    while (sim->getStatusCount() == status_count && port->getCurrentTime() - wait_time < LATE_WAIT)
+      usleep(50);
+
+    if (sim->getStatusCount() != status_count && sim->getStatusLateness() > LATE_LIMIT)
+      cost.late++;
+    else
+      cost.timeout++;
+  }
+  cost.msec /= reads;
+
+  return cost;
+}
+
+// muted_timeout is the fast_fail timeout the learned statistics of ID 2 give, see PortHandler::setStatusPacketTimeout()
+static bool runMode(int baudrate, int reads, int mode, double *muted_msec, double *muted_timeout)
+{
+  bool ok = true;
+
+  ServoSimulator sim(2.0, baudrate);
+  if (sim.open() == false)
+    return false;
+  for (int id = 1; id <= ID_NUM; id++)
+    sim.addServo(id, MODEL_XM430_W210, return_delay_list[id - 1]);
+  sim.setJitter(JITTER);
+
+  dynamixel::PortHandler   *port = dynamixel::PortHandler::getPortHandler(sim.getPortName());
+  dynamixel::PacketHandler *ph   = dynamixel::PacketHandler::getPacketHandler(2.0);
+  port->setBaudRate(baudrate);
+  port->setAdaptiveTimeout(mode != MODE_FIXED, mode == MODE_FAST_FAIL);
+
+  printf("%s\n", mode_name[mode]);
+
+  // steady: every ID answers
+  for (int id = 1; id <= ID_NUM; id++)
+  {
+    ReadCost cost = readId(port, ph, &sim, id, reads);
+    printf("  steady    ID %d  return delay %4.0f us : p99 %6.3f ms  %7.3f ms/read  %3d false timeouts  %3d held up by the host\n",
+           id, return_delay_list[id - 1], port->getRoundTripTime(id, 99.0), cost.msec, cost.timeout, cost.late);
+    ok = ok && (cost.timeout * 100 <= reads);
+  }
+
+  // muted: ID 2 stops answering
+  sim.setFault(2, ServoSimulator::FAULT_MUTE);
+  {
+    double p99    = port->getRoundTripTime(2, 99.0);
+    double margin = p99 - port->getRoundTripTime(2, 50.0);
+    if (margin < 0.5)
+      margin = 0.5;
+    *muted_timeout = (10000.0 / (double)port->getBaudRate()) * STATUS_LENGTH + p99 + margin;
+
+    ReadCost cost = readId(port, ph, NULL, 2, MUTED_READS);
+    printf("  muted     ID 2                      : %7.3f ms/read  %3d timeouts\n", cost.msec, cost.timeout);
+    ok = ok && (cost.timeout == MUTED_READS);
+    *muted_msec = cost.msec;
+  }
+  sim.setFault(2, ServoSimulator::FAULT_NONE);
+
+  // slower: the return delay of ID 3 grows beyond the learned timeout
+  sim.setReturnDelay(3, SLOWER_RETURN_DELAY);
+  {
+    ReadCost relearn = readId(port, ph, &sim, 3, reads, CONTROL_PERIOD);
+    ReadCost after   = readId(port, ph, &sim, 3, reads, CONTROL_PERIOD);
+    printf("  slower    ID 3  return delay %4.0f us : %3d timeouts to relearn, then %7.3f ms/read %3d timeouts  %3d held up by the host\n",
+           SLOWER_RETURN_DELAY, relearn.timeout, after.msec, after.timeout, after.late);
+    ok = ok && (after.timeout * 100 <= reads);
+  }
+
+  port->closePort();
+  delete port;
+
+  return ok;
+}
+
+int main(int argc, char *argv[])
+{
+  int  baudrate = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int  reads    = (argc > 2) ? atoi(argv[2]) : 300;
+  bool ok       = true;
+  double muted_msec[MODE_NUM];
+  double muted_timeout[MODE_NUM];
+
+  printf("baudrate %d, %d reads, jitter %.0f us\n\n", baudrate, reads, JITTER);
+
+  for (int mode = 0; mode < MODE_NUM; mode++)
+    ok = runMode(baudrate, reads, mode, &muted_msec[mode], &muted_timeout[mode]) && ok;
+
+  // a missing device must cost what fast_fail learned for it, with the fixed timeout waited every RTT_PROBE_INTERVAL reads,
+  // and less than with the fixed timeout. The learned timeout follows the host, the check doesn't depend on it
+  int    probes   = MUTED_READS / RTT_PROBE_INTERVAL;
+  double expected = (muted_timeout[MODE_FAST_FAIL] * (MUTED_READS - probes) + muted_msec[MODE_FIXED] * probes) / MUTED_READS;
+  bool   cheaper  = (muted_msec[MODE_FAST_FAIL] <= expected + READ_OVERHEAD) && (muted_msec[MODE_FAST_FAIL] < muted_msec[MODE_FIXED]);
+  printf("\nmuted ID, fast_fail against learned / fixed : %.3f ms/read against %.3f / %.3f ms/read %s\n",
+         muted_msec[MODE_FAST_FAIL], expected, muted_msec[MODE_FIXED], cheaper ? "OK" : "NG");
+  ok = ok && cheaper;
+
+  printf("%s\n", ok ? "OK" : "NG");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,364 @@
+/*******************************************************************************
+* Copyright (c) 2016, ROBOTIS CO., LTD.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* * Neither the name of ROBOTIS nor the names of its
+*   contributors may be used to endorse or promote products derived from
+*   this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+// Cost of one control cycle (Sync Write of goal velocity + Sync Read of present position)
+// for 2, 6 and 20 IDs, done three ways:
+//   per cycle : addParam / txRxPacket / clearParam every cycle, as the wheel and arm loops used to do
+//   reused    : the ID list is added once, the groups are not frozen
+//   frozen    : the ID list is added once and the groups are frozen by freezeParam()
+// It reports heap allocations per cycle, CPU time of the calling thread and wall time per cycle.
+// Every cycle must succeed. A failed cycle whose status packets the simulator thread wrote more than LATE_LIMIT after
+// their schedule was held up by the host scheduler (ServoSimulator::stampInstruction), which happens on a loaded host
+// with 20 IDs. It is counted as held up and doesn't fail the benchmark.
+//
+// After the benchmark, one ID answers with a status packet longer than the one asked for.
+// The Sync Read (Protocol 2.0, frozen or not) and the frozen Bulk Read (Protocol 1.0) must report COMM_RX_CORRUPT for it
+// and keep the data of the other IDs. Run it as "make asan" to check that the packet buffers are not overrun.
+//
+// Then every ID sends 0 to 1024 bytes of broken status headers before its status packet (noisy bus).
+// The frozen Sync Read must still get every packet, and the time per cycle must grow only linearly with the noise.
+// This case runs at baudrate 0, so the time is the cost of the header search on the host.
+//
+// usage: group_benchmark [baudrate [cycles]]
+//   baudrate 0 puts no wire time on the packets, so only the host side cost is measured
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dynamixel_sdk.h"
+#include "servo_simulator.h"
+#include "alloc_counter.h"
+
+#define ADDR_GOAL_VELOCITY      104
+#define ADDR_PRESENT_POSITION   132
+#define LEN_4BYTE               4
+
+#define P1_ADDR_PRESENT_POSITION  36
+#define P1_LEN_PRESENT_POSITION   2
+
+#define MODEL_XM430_W210        1030
+#define MODEL_MX_28             29
+
+#define LATE_LIMIT              0.25    // msec, a status packet later than this was held up by the host
+#define LATE_WAIT               50.0    // msec to wait for the status packets after a failed cycle
+
+enum
+{
+  MODE_PER_CYCLE,
+  MODE_REUSED,
+  MODE_FROZEN,
+  MODE_NUM
+};
+
+static const char *mode_name[MODE_NUM] = { "per cycle", "reused", "frozen" };
+
+static double getTime(clockid_t clock)
+{
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+}
+
+static void makeVelocity(uint8_t *data, int32_t velocity)
+{
+  data[0] = DXL_LOBYTE(DXL_LOWORD(velocity));
+  data[1] = DXL_HIBYTE(DXL_LOWORD(velocity));
+  data[2] = DXL_LOBYTE(DXL_HIWORD(velocity));
+  data[3] = DXL_HIBYTE(DXL_HIWORD(velocity));
+}
+
+// after a failed cycle: waits for the status packets still due, then tells whether the host held up the simulator thread
+static bool isHeldUp(ServoSimulator *sim, uint32_t status_count)
+{
+  double wait_start = getTime(CLOCK_MONOTONIC);
+
+  while (sim->getStatusCount() < status_count && getTime(CLOCK_MONOTONIC) - wait_start < LATE_WAIT * 1000.0)
+    usleep(50);
+
+  return (sim->getStatusCount() >= status_count && sim->getStatusLateness() > LATE_LIMIT);
+}
+
+static bool runCycles(dynamixel::PortHandler *port, dynamixel::PacketHandler *ph, ServoSimulator *sim, int id_num, int mode, int cycles)
+{
+  dynamixel::GroupSyncWrite sync_write(port, ph, ADDR_GOAL_VELOCITY, LEN_4BYTE);
+  dynamixel::GroupSyncRead  sync_read (port, ph, ADDR_PRESENT_POSITION, LEN_4BYTE);
+  uint8_t data[LEN_4BYTE];
+  int     fail = 0;
+  int     held_up = 0;
+
+  if (mode != MODE_PER_CYCLE)
+  {
+    for (int id = 1; id <= id_num; id++)
+    {
+      makeVelocity(data, 0);
+      sync_write.addParam(id, data);
+      sync_read.addParam(id);
+    }
+    if (mode == MODE_FROZEN && (sync_write.freezeParam() == false || sync_read.freezeParam() == false))
+    {
+      printf("freezeParam failed\n");
+      return false;
+    }
+  }
+
+  sim->clearStatistics();
+  unsigned long alloc_start = getAllocationCount();
+  double cpu_start          = getTime(CLOCK_THREAD_CPUTIME_ID);
+  double wall_start         = getTime(CLOCK_MONOTONIC);
+
+  for (int cycle = 0; cycle < cycles; cycle++)
+  {
+    bool     cycle_ok     = true;
+    uint32_t status_count = sim->getStatusCount();
+
+    sim->stampInstruction();
+    for (int id = 1; id <= id_num; id++)
+    {
+      makeVelocity(data, cycle + id);
+      if (mode == MODE_PER_CYCLE)
+        sync_write.addParam(id, data);
+      else
+        sync_write.changeParam(id, data);
+    }
+    if (sync_write.txPacket() != COMM_SUCCESS)
+      cycle_ok = false;
+    if (mode == MODE_PER_CYCLE)
+      sync_write.clearParam();
+
+    if (mode == MODE_PER_CYCLE)
+    {
+      for (int id = 1; id <= id_num; id++)
+        sync_read.addParam(id);
+    }
+    if (sync_read.txRxPacket() != COMM_SUCCESS)
+      cycle_ok = false;
+    for (int id = 1; id <= id_num; id++)
+    {
+      if (sync_read.isAvailable(id, ADDR_PRESENT_POSITION, LEN_4BYTE) == false)
+        cycle_ok = false;
+      sync_read.getData(id, ADDR_PRESENT_POSITION, LEN_4BYTE);
+    }
+    if (mode == MODE_PER_CYCLE)
+      sync_read.clearParam();
+
+    if (cycle_ok == false)
+    {
+      if (isHeldUp(sim, status_count + id_num) == true)
+        held_up++;
+      else
+        fail++;
+    }
+  }
+
+  double wall = getTime(CLOCK_MONOTONIC) - wall_start;
+  double cpu  = getTime(CLOCK_THREAD_CPUTIME_ID) - cpu_start;
+  unsigned long alloc = getAllocationCount() - alloc_start;
+
+  printf("%4d  %-10s %10.2f %12.2f %12.2f %13.1f %6d %8d\n",
+         id_num, mode_name[mode], (double)alloc / cycles, cpu / cycles, wall / cycles,
+         sim->getWireTime() * 1000.0 / cycles, fail, held_up);
+
+  return (fail == 0);
+}
+
+// the ID in the middle answers with a longer status packet than the buffer of the frozen group is made for
+static bool checkOversizedStatus(int baudrate)
+{
+  bool      ok = true;
+  const int id_num = 3;
+
+  // Protocol 2.0, frozen and not frozen Sync Read
+  for (int frozen = 1; frozen >= 0; frozen--)
+  {
+    ServoSimulator sim(2.0, baudrate);
+    if (sim.open() == false)
+      return false;
+    for (int id = 1; id <= id_num; id++)
+    {
+      sim.addServo(id, MODEL_XM430_W210, 0.0);
+      sim.setValue(id, ADDR_PRESENT_POSITION, LEN_4BYTE, 1000 * id);
+    }
+    sim.setFault(2, ServoSimulator::FAULT_OVERSIZE);
+
+    dynamixel::PortHandler   *port = dynamixel::PortHandler::getPortHandler(sim.getPortName());
+    dynamixel::PacketHandler *ph   = dynamixel::PacketHandler::getPacketHandler(2.0);
+    port->openPort();
+
+    dynamixel::GroupSyncRead sync_read(port, ph, ADDR_PRESENT_POSITION, LEN_4BYTE);
+    for (int id = 1; id <= id_num; id++)
+      sync_read.addParam(id);
+    if (frozen == 1)
+      sync_read.freezeParam();
+
+    sync_read.txRxPacket();
+    bool result = sync_read.getResult(1) == COMM_SUCCESS && sync_read.getData(1, ADDR_PRESENT_POSITION, LEN_4BYTE) == 1000 &&
+                  sync_read.getResult(2) == COMM_RX_CORRUPT &&
+                  sync_read.getResult(3) == COMM_SUCCESS && sync_read.getData(3, ADDR_PRESENT_POSITION, LEN_4BYTE) == 3000;
+    printf("oversized status, %-10s Sync Read (2.0) : %s (ID 1 %d, ID 2 %d, ID 3 %d)\n",
+           (frozen == 1) ? "frozen" : "not frozen", result ? "OK" : "NG", sync_read.getResult(1), sync_read.getResult(2), sync_read.getResult(3));
+    ok = ok && result;
+
+    port->closePort();
+    delete port;
+  }
+
+  // Protocol 1.0, frozen Bulk Read. The group stops at the first failure, so the oversized ID comes last
+  {
+    ServoSimulator sim(1.0, baudrate);
+    if (sim.open() == false)
+      return false;
+    for (int id = 1; id <= id_num; id++)
+    {
+      sim.addServo(id, MODEL_MX_28, 0.0);
+      sim.setValue(id, P1_ADDR_PRESENT_POSITION, P1_LEN_PRESENT_POSITION, 100 * id);
+    }
+    sim.setFault(id_num, ServoSimulator::FAULT_OVERSIZE);
+
+    dynamixel::PortHandler   *port = dynamixel::PortHandler::getPortHandler(sim.getPortName());
+    dynamixel::PacketHandler *ph   = dynamixel::PacketHandler::getPacketHandler(1.0);
+    port->openPort();
+
+    dynamixel::GroupBulkRead bulk_read(port, ph);
+    for (int id = 1; id <= id_num; id++)
+      bulk_read.addParam(id, P1_ADDR_PRESENT_POSITION, P1_LEN_PRESENT_POSITION);
+    bulk_read.freezeParam();
+
+    int comm_result = bulk_read.txRxPacket();
+    bool result = (comm_result == COMM_RX_CORRUPT);
+    printf("oversized status, frozen     Bulk Read (1.0) : %s (%d)\n", result ? "OK" : "NG", comm_result);
+    ok = ok && result;
+
+    port->closePort();
+    delete port;
+  }
+
+  return ok;
+}
+
+// the status packets of all IDs come after noise_length bytes of broken headers
+static bool checkNoisyBus(int cycles)
+{
+  bool      ok = true;
+  const int id_num = 3;
+  uint16_t  noise_lengths[] = { 0, 64, 256, 1024 };
+
+  printf("noise byte/status  cpu us/cycle  wall us/cycle  fail\n");
+
+  for (unsigned int n = 0; n < sizeof(noise_lengths) / sizeof(noise_lengths[0]); n++)
+  {
+    ServoSimulator sim(2.0, 0);
+    if (sim.open() == false)
+      return false;
+    sim.setNoiseLength(noise_lengths[n]);
+    for (int id = 1; id <= id_num; id++)
+    {
+      sim.addServo(id, MODEL_XM430_W210, 0.0);
+      sim.setValue(id, ADDR_PRESENT_POSITION, LEN_4BYTE, 1000 * id);
+      sim.setFault(id, ServoSimulator::FAULT_NOISE);
+    }
+
+    dynamixel::PortHandler   *port = dynamixel::PortHandler::getPortHandler(sim.getPortName());
+    dynamixel::PacketHandler *ph   = dynamixel::PacketHandler::getPacketHandler(2.0);
+    port->openPort();
+
+    dynamixel::GroupSyncRead sync_read(port, ph, ADDR_PRESENT_POSITION, LEN_4BYTE);
+    for (int id = 1; id <= id_num; id++)
+      sync_read.addParam(id);
+    sync_read.freezeParam();
+
+    int    fail       = 0;
+    double cpu_start  = getTime(CLOCK_THREAD_CPUTIME_ID);
+    double wall_start = getTime(CLOCK_MONOTONIC);
+
+    for (int cycle = 0; cycle < cycles; cycle++)
+    {
+      if (sync_read.txRxPacket() != COMM_SUCCESS)
+        fail++;
+      for (int id = 1; id <= id_num; id++)
+      {
+        if (sync_read.isAvailable(id, ADDR_PRESENT_POSITION, LEN_4BYTE) == false ||
+            sync_read.getData(id, ADDR_PRESENT_POSITION, LEN_4BYTE) != (uint32_t)(1000 * id))
+          fail++;
+      }
+    }
+
+    double wall = getTime(CLOCK_MONOTONIC) - wall_start;
+    double cpu  = getTime(CLOCK_THREAD_CPUTIME_ID) - cpu_start;
+
+    printf("%17d %13.2f %14.2f %5d\n", noise_lengths[n], cpu / cycles, wall / cycles, fail);
+    ok = ok && (fail == 0);
+
+    port->closePort();
+    delete port;
+  }
+
+  return ok;
+}
+
+int main(int argc, char *argv[])
+{
+  int baudrate  = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int cycles    = (argc > 2) ? atoi(argv[2]) : 2000;
+  int id_nums[] = { 2, 6, 20 };
+  bool ok       = true;
+
+  printf("baudrate %d, %d cycles of Sync Write (4 byte) + Sync Read (4 byte)\n\n", baudrate, cycles);
+  printf(" IDs  mode       alloc/cycle  cpu us/cycle wall us/cycle  wire us/cycle  fail  held up\n");
+
+  for (unsigned int n = 0; n < sizeof(id_nums) / sizeof(id_nums[0]); n++)
+  {
+    ServoSimulator sim(2.0, baudrate);
+    if (sim.open() == false)
+      return 1;
+    for (int id = 1; id <= id_nums[n]; id++)
+      sim.addServo(id, MODEL_XM430_W210, 0.0);
+
+    dynamixel::PortHandler   *port = dynamixel::PortHandler::getPortHandler(sim.getPortName());
+    dynamixel::PacketHandler *ph   = dynamixel::PacketHandler::getPacketHandler(2.0);
+    if (port->openPort() == false)
+      return 1;
+
+    for (int mode = 0; mode < MODE_NUM; mode++)
+      ok = runCycles(port, ph, &sim, id_nums[n], mode, cycles) && ok;
+
+    port->closePort();
+    delete port;
+  }
+
+  printf("\n");
+  ok = checkOversizedStatus(baudrate) && ok;
+
+  printf("\n");
+  ok = checkNoisyBus(cycles / 4) && ok;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,620 @@
+/*******************************************************************************
+* Copyright (c) 2016, ROBOTIS CO., LTD.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* * Neither the name of ROBOTIS nor the names of its
+*   contributors may be used to endorse or promote products derived from
+*   this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "servo_simulator.h"
+
+#include <pty.h>
+#include <poll.h>
+#include <time.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <termios.h>
+
+#define BROADCAST_ID        0xFE
+
+#define INST_PING           1
+#define INST_READ           2
+#define INST_WRITE          3
+#define INST_SYNC_READ      0x82
+#define INST_SYNC_WRITE     0x83
+#define INST_BULK_READ      0x92
+#define INST_BULK_WRITE     0x93
+#define INST_STATUS         0x55
+
+#define ERRBIT_ACCESS       7     // Protocol 2.0 data range error, Protocol 1.0 uses its range error bit 0x08
+
+#define OVERSIZE_PARAM_LENGTH_P1  240
+#define OVERSIZE_PARAM_LENGTH_P2  300
+
+// Protocol 2.0 status headers, each broken at another byte, and bytes that can't start one.
+// The pattern may be cut anywhere: the 0xFF that starts the real status packet breaks whatever header is left open.
+static const uint8_t noise_pattern[] =
+{
+  0xFF, 0x00,
+  0xFF, 0xFF, 0x00,
+  0xFF, 0xFF, 0xFD, 0xFD,
+  0xFF, 0xFF, 0xFD, 0x00, 0xFD,
+  0xFF, 0xFF, 0xFD, 0x00, 0x01, 0x00, 0x00,
+  0xFF, 0xFF, 0xFD, 0x00, 0x01, 0x07, 0x00, 0x03,
+  0x55, 0xA5
+};
+
+static double nowUsec()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+}
+
+// sleep for the most of the wait and spin the rest, the wire time of a few bytes is below the timer slack
+static void waitUntil(double usec)
+{
+  double remaining = usec - nowUsec();
+
+  if (remaining > 200.0)
+  {
+    struct timespec ts;
+    double sleep_usec = remaining - 100.0;
+    ts.tv_sec  = (time_t)(sleep_usec / 1000000.0);
+    ts.tv_nsec = (long)((sleep_usec - (double)ts.tv_sec * 1000000.0) * 1000.0);
+    nanosleep(&ts, NULL);
+  }
+  while (nowUsec() < usec)
+    ;
+}
+
+// bitwise CRC-16 (0x8005) of Protocol 2.0, kept apart from the SDK so that the SDK is checked against it
+static uint16_t calcCRC(const uint8_t *data, uint16_t length)
+{
+  uint16_t crc = 0;
+
+  for (uint16_t i = 0; i < length; i++)
+  {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int b = 0; b < 8; b++)
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x8005) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+ServoSimulator::ServoSimulator(float protocol_version, int baudrate)
+  : protocol_version_(protocol_version),
+    baudrate_(baudrate),
+    master_fd_(-1),
+    slave_fd_(-1),
+    is_running_(false),
+    jitter_(0.0),
+    noise_length_(64),
+    stamp_time_(0.0),
+    schedule_time_(0.0),
+    status_lateness_(0.0),
+    bus_free_time_(0.0),
+    instruction_count_(0),
+    status_count_(0),
+    wire_time_(0.0)
+{
+  port_name_[0] = 0;
+  pthread_mutex_init(&mutex_, NULL);
+}
+
+ServoSimulator::~ServoSimulator()
+{
+  close();
+  pthread_mutex_destroy(&mutex_);
+}
+
+bool ServoSimulator::open()
+{
+  struct termios tio;
+
+  if (openpty(&master_fd_, &slave_fd_, port_name_, NULL, NULL) != 0)
+  {
+    perror("[ServoSimulator] openpty");
+    return false;
+  }
+
+  tcgetattr(slave_fd_, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave_fd_, TCSANOW, &tio);
+
+  is_running_ = true;
+  if (pthread_create(&thread_, NULL, threadMain, this) != 0)
+  {
+    is_running_ = false;
+    close();
+    return false;
+  }
+  return true;
+}
+
+void ServoSimulator::close()
+{
+  if (is_running_ == true)
+  {
+    is_running_ = false;
+    pthread_join(thread_, NULL);
+  }
+  if (master_fd_ >= 0)
+    ::close(master_fd_);
+  if (slave_fd_ >= 0)
+    ::close(slave_fd_);
+  master_fd_ = -1;
+  slave_fd_  = -1;
+}
+
+void ServoSimulator::addServo(uint8_t id, uint16_t model_number, double return_delay)
+{
+  Servo servo;
+
+  memset(&servo, 0, sizeof(servo));
+  servo.id            = id;
+  servo.fault         = FAULT_NONE;
+  servo.return_delay  = return_delay;
+  servo.table[0]      = (uint8_t)(model_number & 0xFF);
+  servo.table[1]      = (uint8_t)(model_number >> 8);
+  servo.table[protocol_version_ == 1.0 ? 3 : 7] = id;
+
+  pthread_mutex_lock(&mutex_);
+  servo_list_.push_back(servo);
+  pthread_mutex_unlock(&mutex_);
+}
+
+void ServoSimulator::setReturnDelay(uint8_t id, double return_delay)
+{
+  pthread_mutex_lock(&mutex_);
+  Servo *servo = findServo(id);
+  if (servo != NULL)
+    servo->return_delay = return_delay;
+  pthread_mutex_unlock(&mutex_);
+}
+
+void ServoSimulator::setJitter(double jitter)
+{
+  pthread_mutex_lock(&mutex_);
+  jitter_ = jitter;
+  pthread_mutex_unlock(&mutex_);
+}
+
+void ServoSimulator::setFault(uint8_t id, uint8_t fault)
+{
+  pthread_mutex_lock(&mutex_);
+  Servo *servo = findServo(id);
+  if (servo != NULL)
+    servo->fault = fault;
+  pthread_mutex_unlock(&mutex_);
+}
+
+void ServoSimulator::setNoiseLength(uint16_t length)
+{
+  pthread_mutex_lock(&mutex_);
+  noise_length_ = length;
+  pthread_mutex_unlock(&mutex_);
+}
+
+void ServoSimulator::stampInstruction()
+{
+  pthread_mutex_lock(&mutex_);
+  stamp_time_ = nowUsec();
+  pthread_mutex_unlock(&mutex_);
+}
+
+double ServoSimulator::getStatusLateness()
+{
+  pthread_mutex_lock(&mutex_);
+  double lateness = status_lateness_;
+  pthread_mutex_unlock(&mutex_);
+  return lateness / 1000.0;
+}
+
+uint32_t ServoSimulator::getValue(uint8_t id, uint16_t address, uint16_t length)
+{
+  uint32_t value = 0;
+
+  pthread_mutex_lock(&mutex_);
+  Servo *servo = findServo(id);
+  if (servo != NULL && length <= 4 && address + length <= SIM_CONTROL_TABLE_SIZE)
+  {
+    for (int i = length - 1; i >= 0; i--)
+      value = (value << 8) | servo->table[address + i];
+  }
+  pthread_mutex_unlock(&mutex_);
+
+  return value;
+}
+
+void ServoSimulator::setValue(uint8_t id, uint16_t address, uint16_t length, uint32_t value)
+{
+  pthread_mutex_lock(&mutex_);
+  Servo *servo = findServo(id);
+  if (servo != NULL && length <= 4 && address + length <= SIM_CONTROL_TABLE_SIZE)
+  {
+    for (int i = 0; i < length; i++)
+      servo->table[address + i] = (uint8_t)(value >> (8 * i));
+  }
+  pthread_mutex_unlock(&mutex_);
+}
+
+void ServoSimulator::clearStatistics()
+{
+  pthread_mutex_lock(&mutex_);
+  instruction_count_  = 0;
+  status_count_       = 0;
+  wire_time_          = 0.0;
+  pthread_mutex_unlock(&mutex_);
+}
+
+ServoSimulator::Servo *ServoSimulator::findServo(uint8_t id)
+{
+  for (unsigned int i = 0; i < servo_list_.size(); i++)
+  {
+    if (servo_list_[i].id == id)
+      return &servo_list_[i];
+  }
+  return NULL;
+}
+
+double ServoSimulator::wireTime(uint16_t bytes)
+{
+  if (baudrate_ <= 0)
+    return 0.0;
+  return (double)bytes * 10.0 * 1000000.0 / (double)baudrate_;
+}
+
+void *ServoSimulator::threadMain(void *arg)
+{
+  ((ServoSimulator *)arg)->run();
+  return NULL;
+}
+
+void ServoSimulator::run()
+{
+  std::vector<uint8_t> rx;
+  uint8_t buffer[1024];
+
+  while (is_running_ == true)
+  {
+    struct pollfd pfd;
+    pfd.fd      = master_fd_;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    if (poll(&pfd, 1, 10) <= 0)
+      continue;
+
+    int length = read(master_fd_, buffer, sizeof(buffer));
+    if (length <= 0)
+      continue;
+
+    double arrival_time = nowUsec();
+    rx.insert(rx.end(), buffer, buffer + length);
+
+    while (parsePacket(rx, arrival_time) > 0)
+      ;
+  }
+}
+
+// returns 1 when bytes were taken from rx, 0 when the next packet is not complete yet
+int ServoSimulator::parsePacket(std::vector<uint8_t> &rx, double arrival_time)
+{
+  if (protocol_version_ == 1.0)
+  {
+    if (rx.size() < 6)
+      return 0;
+    if (rx[0] != 0xFF || rx[1] != 0xFF || rx[2] == 0xFF)
+    {
+      rx.erase(rx.begin());
+      return 1;
+    }
+
+    uint16_t total = rx[3] + 4;
+    if (rx[3] < 2)
+    {
+      rx.erase(rx.begin());
+      return 1;
+    }
+    if (rx.size() < total)
+      return 0;
+
+    uint8_t checksum = 0;
+    for (uint16_t i = 2; i < total - 1; i++)
+      checksum += rx[i];
+    checksum = ~checksum;
+
+    if (checksum == rx[total - 1])
+    {
+      pthread_mutex_lock(&mutex_);
+      handleInstruction(rx[2], rx[4], &rx[5], total - 6, arrival_time, total);
+      pthread_mutex_unlock(&mutex_);
+    }
+    rx.erase(rx.begin(), rx.begin() + total);
+    return 1;
+  }
+
+  if (rx.size() < 10)
+    return 0;
+  if (rx[0] != 0xFF || rx[1] != 0xFF || rx[2] != 0xFD || rx[3] != 0x00)
+  {
+    rx.erase(rx.begin());
+    return 1;
+  }
+
+  uint16_t length = rx[5] | (rx[6] << 8);
+  uint32_t total  = length + 7;
+  if (length < 3 || total > 4096)
+  {
+    rx.erase(rx.begin());
+    return 1;
+  }
+  if (rx.size() < total)
+    return 0;
+
+  if (calcCRC(&rx[0], total - 2) == (uint16_t)(rx[total - 2] | (rx[total - 1] << 8)))
+  {
+    // remove the byte stuffing, FF FF FD FD -> FF FF FD
+    std::vector<uint8_t> param;
+    for (uint32_t i = 8; i < total - 2; i++)
+    {
+      if (i >= 10 && rx[i] == 0xFD && rx[i - 1] == 0xFD && rx[i - 2] == 0xFF && rx[i - 3] == 0xFF)
+        continue;
+      param.push_back(rx[i]);
+    }
+
+    pthread_mutex_lock(&mutex_);
+    handleInstruction(rx[4], rx[7], param.data(), param.size(), arrival_time, total);
+    pthread_mutex_unlock(&mutex_);
+  }
+  rx.erase(rx.begin(), rx.begin() + total);
+  return 1;
+}
+
+void ServoSimulator::handleInstruction(uint8_t id, uint8_t instruction, uint8_t *param, uint16_t param_length, double start_time, uint16_t wire_length)
+{
+  bool      p1    = (protocol_version_ == 1.0);
+  double    ready = (start_time > bus_free_time_ ? start_time : bus_free_time_) + wireTime(wire_length);
+  Servo    *servo = findServo(id);
+
+  instruction_count_++;
+  wire_time_     += wireTime(wire_length);
+  bus_free_time_  = ready;
+
+  // the schedule runs from the last stamp, packet after packet, as the bus would with a host that is never held up
+  if (stamp_time_ > 0.0)
+    schedule_time_ = stamp_time_;
+  stamp_time_     = 0.0;
+  schedule_time_ += wireTime(wire_length);
+
+  switch (instruction)
+  {
+    case INST_PING:
+    {
+      uint8_t info[3];
+      for (unsigned int i = 0; i < servo_list_.size(); i++)
+      {
+        Servo *s = &servo_list_[i];
+        if (id != BROADCAST_ID && s->id != id)
+          continue;
+        info[0] = s->table[0];
+        info[1] = s->table[1];
+        info[2] = s->table[6];
+        sendStatus(s, 0, info, p1 ? 0 : 3, ready);
+      }
+      break;
+    }
+
+    case INST_READ:
+    {
+      if (servo == NULL || param_length < (p1 ? 2 : 4))
+        break;
+      uint16_t address = p1 ? param[0] : (uint16_t)(param[0] | (param[1] << 8));
+      uint16_t length  = p1 ? param[1] : (uint16_t)(param[2] | (param[3] << 8));
+      if (address + length > SIM_CONTROL_TABLE_SIZE)
+        sendStatus(servo, p1 ? 0x08 : ERRBIT_ACCESS, NULL, 0, ready);
+      else
+        sendStatus(servo, 0, &servo->table[address], length, ready);
+      break;
+    }
+
+    case INST_WRITE:
+    {
+      if (param_length < (p1 ? 1 : 2))
+        break;
+      uint16_t address = p1 ? param[0] : (uint16_t)(param[0] | (param[1] << 8));
+      uint8_t *data    = param + (p1 ? 1 : 2);
+      uint16_t length  = param_length - (p1 ? 1 : 2);
+      for (unsigned int i = 0; i < servo_list_.size(); i++)
+      {
+        Servo *s = &servo_list_[i];
+        if (id != BROADCAST_ID && s->id != id)
+          continue;
+        if (address + length <= SIM_CONTROL_TABLE_SIZE)
+          memcpy(&s->table[address], data, length);
+      }
+      if (servo != NULL)
+        sendStatus(servo, 0, NULL, 0, ready);
+      break;
+    }
+
+    case INST_SYNC_WRITE:
+    {
+      uint16_t head    = p1 ? 2 : 4;
+      if (param_length < head)
+        break;
+      uint16_t address = p1 ? param[0] : (uint16_t)(param[0] | (param[1] << 8));
+      uint16_t length  = p1 ? param[1] : (uint16_t)(param[2] | (param[3] << 8));
+      for (uint16_t i = head; i + 1 + length <= param_length; i += 1 + length)
+      {
+        Servo *s = findServo(param[i]);
+        if (s != NULL && address + length <= SIM_CONTROL_TABLE_SIZE)
+          memcpy(&s->table[address], &param[i + 1], length);
+      }
+      break;
+    }
+
+    case INST_SYNC_READ:
+    {
+      if (p1 || param_length < 4)
+        break;
+      uint16_t address = param[0] | (param[1] << 8);
+      uint16_t length  = param[2] | (param[3] << 8);
+      for (uint16_t i = 4; i < param_length; i++)
+      {
+        Servo *s = findServo(param[i]);
+        if (s != NULL && address + length <= SIM_CONTROL_TABLE_SIZE)
+          sendStatus(s, 0, &s->table[address], length, ready);
+      }
+      break;
+    }
+
+    case INST_BULK_READ:
+    {
+      // Protocol 1.0: 0x00 [LEN ID ADDR]..., Protocol 2.0: [ID ADDR_L ADDR_H LEN_L LEN_H]...
+      uint16_t i = p1 ? 1 : 0;
+      for (; i + (p1 ? 3 : 5) <= param_length; i += (p1 ? 3 : 5))
+      {
+        uint8_t  read_id = p1 ? param[i + 1] : param[i];
+        uint16_t address = p1 ? param[i + 2] : (uint16_t)(param[i + 1] | (param[i + 2] << 8));
+        uint16_t length  = p1 ? param[i]     : (uint16_t)(param[i + 3] | (param[i + 4] << 8));
+        Servo *s = findServo(read_id);
+        if (s != NULL && address + length <= SIM_CONTROL_TABLE_SIZE)
+          sendStatus(s, 0, &s->table[address], length, ready);
+      }
+      break;
+    }
+
+    case INST_BULK_WRITE:
+    {
+      for (uint16_t i = 0; !p1 && i + 5 <= param_length; )
+      {
+        uint16_t address = param[i + 1] | (param[i + 2] << 8);
+        uint16_t length  = param[i + 3] | (param[i + 4] << 8);
+        Servo *s = findServo(param[i]);
+        if (i + 5 + length > param_length)
+          break;
+        if (s != NULL && address + length <= SIM_CONTROL_TABLE_SIZE)
+          memcpy(&s->table[address], &param[i + 5], length);
+        i += 5 + length;
+      }
+      break;
+    }
+
+    default:
+      if (servo != NULL)
+        sendStatus(servo, 0, NULL, 0, ready);
+      break;
+  }
+}
+
+void ServoSimulator::sendStatus(Servo *servo, uint8_t error, uint8_t *param, uint16_t param_length, double &ready_time)
+{
+  std::vector<uint8_t> packet;
+  std::vector<uint8_t> oversize;
+
+  if (servo->fault == FAULT_MUTE)
+    return;
+
+  if (servo->fault == FAULT_OVERSIZE)
+  {
+    oversize.assign(protocol_version_ == 1.0 ? OVERSIZE_PARAM_LENGTH_P1 : OVERSIZE_PARAM_LENGTH_P2, 0xA5);
+    param         = oversize.data();
+    param_length  = oversize.size();
+  }
+
+  if (protocol_version_ == 1.0)
+  {
+    uint8_t checksum = 0;
+    packet.push_back(0xFF);
+    packet.push_back(0xFF);
+    packet.push_back(servo->id);
+    packet.push_back((uint8_t)(param_length + 2));
+    packet.push_back(error);
+    for (uint16_t i = 0; i < param_length; i++)
+      packet.push_back(param[i]);
+    for (unsigned int i = 2; i < packet.size(); i++)
+      checksum += packet[i];
+    packet.push_back((uint8_t)~checksum);
+    if (servo->fault == FAULT_CORRUPT)
+      packet.back() ^= 0x5A;
+  }
+  else
+  {
+    uint8_t head[9] = { 0xFF, 0xFF, 0xFD, 0x00, servo->id, 0, 0, INST_STATUS, error };
+    packet.assign(head, head + 9);
+    for (uint16_t i = 0; i < param_length; i++)
+    {
+      packet.push_back(param[i]);
+      if (param[i] == 0xFD && packet.size() >= 3 &&
+          packet[packet.size() - 2] == 0xFF && packet[packet.size() - 3] == 0xFF)
+        packet.push_back(0xFD);   // FF FF FD -> FF FF FD FD
+    }
+    uint16_t length = packet.size() - 7 + 2;
+    packet[5] = (uint8_t)(length & 0xFF);
+    packet[6] = (uint8_t)(length >> 8);
+    uint16_t crc = calcCRC(packet.data(), packet.size());
+    if (servo->fault == FAULT_CORRUPT)
+      crc ^= 0x5A5A;
+    packet.push_back((uint8_t)(crc & 0xFF));
+    packet.push_back((uint8_t)(crc >> 8));
+
+    if (servo->fault == FAULT_NOISE)
+    {
+      std::vector<uint8_t> noise(noise_length_);
+      for (uint16_t i = 0; i < noise_length_; i++)
+        noise[i] = noise_pattern[i % sizeof(noise_pattern)];
+      packet.insert(packet.begin(), noise.begin(), noise.end());
+    }
+  }
+
+  double delay = servo->return_delay;
+  if (jitter_ > 0.0)
+    delay += jitter_ * (double)rand() / (double)RAND_MAX;
+
+  double end_time = ready_time + delay + wireTime(packet.size());
+  waitUntil(end_time);
+  schedule_time_ += delay + wireTime(packet.size());
+
+  size_t sent = 0;
+  while (sent < packet.size())
+  {
+    ssize_t result = write(master_fd_, packet.data() + sent, packet.size() - sent);
+    if (result < 0 && errno != EINTR && errno != EAGAIN)
+      break;
+    if (result > 0)
+      sent += result;
+  }
+
+  status_lateness_ = nowUsec() - schedule_time_;
+  status_count_++;
+  wire_time_     += wireTime(packet.size());
+  ready_time      = end_time;
+  bus_free_time_  = end_time;
+}
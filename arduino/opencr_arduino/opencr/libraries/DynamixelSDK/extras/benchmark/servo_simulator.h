@@ -0,0 +1,183 @@
+/*******************************************************************************
+* Copyright (c) 2016, ROBOTIS CO., LTD.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* * Neither the name of ROBOTIS nor the names of its
+*   contributors may be used to endorse or promote products derived from
+*   this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for the Dynamixel servo simulator used by the host benchmarks
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_EXTRAS_BENCHMARK_SERVO_SIMULATOR_H_
+#define DYNAMIXEL_SDK_EXTRAS_BENCHMARK_SERVO_SIMULATOR_H_
+
+
+#include <stdint.h>
+#include <pthread.h>
+#include <vector>
+
+#define SIM_CONTROL_TABLE_SIZE  1024
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class for N Dynamixels on a simulated half-duplex bus behind a pty
+/// @description The simulator answers Protocol 1.0 or 2.0 instruction packets written to the pty given by getPortName().
+/// @description Every packet takes its wire time at the simulated baudrate (10 bits per byte), and each status packet starts
+/// @description after the return delay of its ID, so the loop rates measured against it are the ones of the real bus.
+/// @description A baudrate of 0 answers at once, which leaves only the host side cost in the measurement.
+////////////////////////////////////////////////////////////////////////////////
+class ServoSimulator
+{
+ public:
+  enum
+  {
+    FAULT_NONE,
+    FAULT_MUTE,         ///< the ID doesn't answer
+    FAULT_CORRUPT,      ///< the status packet of the ID has a wrong checksum
+    FAULT_OVERSIZE,     ///< the ID answers with a valid status packet longer than the one asked for
+    FAULT_NOISE         ///< broken Protocol 2.0 status headers of setNoiseLength() bytes come before the status packet of the ID
+  };
+
+ private:
+  struct Servo
+  {
+    uint8_t   id;
+    uint8_t   fault;
+    double    return_delay;               // usec
+    uint8_t   table[SIM_CONTROL_TABLE_SIZE];
+  };
+
+  float     protocol_version_;
+  int       baudrate_;
+  int       master_fd_;
+  int       slave_fd_;
+  char      port_name_[64];
+  pthread_t thread_;
+  bool      is_running_;
+
+  pthread_mutex_t     mutex_;
+  std::vector<Servo>  servo_list_;
+  double    jitter_;                      // usec, added to the return delay at random
+  uint16_t  noise_length_;                // bytes before the status packet of a FAULT_NOISE ID
+  double    stamp_time_;                  // usec, stampInstruction() of the next instruction, 0 when taken
+  double    schedule_time_;               // usec, where the last packet should have ended from the stamp
+  double    status_lateness_;             // usec
+  double    bus_free_time_;               // usec, end of the last packet on the bus
+
+  uint32_t  instruction_count_;
+  uint32_t  status_count_;
+  double    wire_time_;                   // usec
+
+  static void  *threadMain(void *arg);
+  void    run();
+  int     parsePacket(std::vector<uint8_t> &rx, double arrival_time);
+  void    handleInstruction(uint8_t id, uint8_t instruction, uint8_t *param, uint16_t param_length, double start_time, uint16_t wire_length);
+  void    sendStatus(Servo *servo, uint8_t error, uint8_t *param, uint16_t param_length, double &ready_time);
+  Servo  *findServo(uint8_t id);
+  double  wireTime(uint16_t bytes);
+
+ public:
+  ServoSimulator(float protocol_version, int baudrate);
+  ~ServoSimulator();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that opens the pty and starts the simulator thread
+  /// @return false when the pty can't be opened
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    open();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that stops the simulator thread and closes the pty
+  ////////////////////////////////////////////////////////////////////////////////
+  void    close();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the name of the pty for PortHandler::getPortHandler()
+  ////////////////////////////////////////////////////////////////////////////////
+  const char *getPortName() { return port_name_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a Dynamixel on the bus
+  /// @param id Dynamixel ID
+  /// @param model_number Model number placed at address 0 of the control table
+  /// @param return_delay Time from the end of the instruction packet to the start of the status packet in usec
+  ////////////////////////////////////////////////////////////////////////////////
+  void    addServo(uint8_t id, uint16_t model_number, double return_delay);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that changes the return delay of an ID in usec
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setReturnDelay(uint8_t id, double return_delay);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets a random delay up to jitter usec added to every return delay
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setJitter(double jitter);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that makes an ID misbehave, see ServoSimulator::FAULT_NONE
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setFault(uint8_t id, uint8_t fault);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the number of noise bytes sent before the status packet of a FAULT_NOISE ID
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setNoiseLength(uint16_t length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that stamps the time at which the host sends its next instruction packet
+  /// @description The packets from that instruction on are scheduled from the stamp, one after the other: wire time of the instructions,
+  /// @description return delay with its jitter and wire time of the status packets. ServoSimulator::getStatusLateness() tells
+  /// @description how much later than that the simulator thread wrote the last status packet, which is the delay the host scheduler added.
+  /// @description Stamp before every read or control cycle, a schedule left running falls behind the host.
+  ////////////////////////////////////////////////////////////////////////////////
+  void    stampInstruction();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets how late the last status packet of a stamped instruction was written to the pty in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getStatusLateness();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that reads a value of the control table of an ID
+  ////////////////////////////////////////////////////////////////////////////////
+  uint32_t getValue(uint8_t id, uint16_t address, uint16_t length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that writes a value in the control table of an ID
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setValue(uint8_t id, uint16_t address, uint16_t length, uint32_t value);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that get and clear the statistics of the bus
+  ////////////////////////////////////////////////////////////////////////////////
+  uint32_t getInstructionCount()  { return instruction_count_; }
+  uint32_t getStatusCount()       { return status_count_; }
+  double   getWireTime()          { return wire_time_ / 1000.0; }   // msec
+  void     clearStatistics();
+};
+
+#endif /* DYNAMIXEL_SDK_EXTRAS_BENCHMARK_SERVO_SIMULATOR_H_ */
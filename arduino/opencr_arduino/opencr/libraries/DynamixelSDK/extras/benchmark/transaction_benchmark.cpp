@@ -0,0 +1,184 @@
+/*******************************************************************************
+* Copyright (c) 2016, ROBOTIS CO., LTD.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* * Neither the name of ROBOTIS nor the names of its
+*   contributors may be used to endorse or promote products derived from
+*   this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+// Achievable loop rate of one control tick at 1, 2, 3 and 4.5 Mbps:
+// Sync Write of goal position (4 byte), Sync Read of present position (4 byte) and Sync Read of present current (2 byte).
+//   serial      : each group runs its own txPacket() / txRxPacket(), as DynamixelDriver::syncWrite/syncRead do
+//   transaction : the frozen groups run back-to-back from GroupTransaction::txRxPacket()
+// The wire bound is the rate at which the bus carries nothing but the packets of the tick.
+// A tick that loses the host scheduler for longer than the packet timeout fails, up to 1 % of the ticks are tolerated.
+//
+// usage: transaction_benchmark [servo_num [ticks [return_delay_usec [period_msec]]]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include "dynamixel_sdk.h"
+#include "servo_simulator.h"
+
+#define ADDR_GOAL_POSITION      116
+#define ADDR_PRESENT_CURRENT    126
+#define ADDR_PRESENT_POSITION   132
+#define LEN_2BYTE               2
+#define LEN_4BYTE               4
+
+#define MODEL_XM430_W210        1030
+
+static const int baudrate_list[] = { 1000000, 2000000, 3000000, 4500000 };
+
+struct Result
+{
+  double  tick_median;  // msec
+  double  tick_p99;     // msec
+  double  rate;         // Hz
+  double  wire;         // msec per tick
+  double  utilization;  // percent, from GroupTransaction
+  double  slack;        // msec, from GroupTransaction
+  int     fail;
+};
+
+static Result runTicks(dynamixel::PortHandler *port, dynamixel::PacketHandler *ph, ServoSimulator *sim,
+                       int servo_num, int ticks, double period, bool use_transaction)
+{
+  dynamixel::GroupSyncWrite goal_position   (port, ph, ADDR_GOAL_POSITION, LEN_4BYTE);
+  dynamixel::GroupSyncRead  present_position(port, ph, ADDR_PRESENT_POSITION, LEN_4BYTE);
+  dynamixel::GroupSyncRead  present_current (port, ph, ADDR_PRESENT_CURRENT, LEN_2BYTE);
+  dynamixel::GroupTransaction transaction   (port, ph, period);
+  uint8_t data[LEN_4BYTE] = { 0, 8, 0, 0 };
+  Result  result = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0 };
+  std::vector<double> tick_time(ticks);
+
+  for (int id = 1; id <= servo_num; id++)
+  {
+    goal_position.addParam(id, data);
+    present_position.addParam(id);
+    present_current.addParam(id);
+  }
+  goal_position.freezeParam();
+  present_position.freezeParam();
+  present_current.freezeParam();
+
+  transaction.addSyncWrite(&goal_position);
+  transaction.addSyncRead(&present_position);
+  transaction.addSyncRead(&present_current);
+
+  sim->clearStatistics();
+  double start_time = port->getCurrentTime();
+
+  for (int tick = 0; tick < ticks; tick++)
+  {
+    double tick_start = port->getCurrentTime();
+
+    data[0] = (uint8_t)tick;
+    for (int id = 1; id <= servo_num; id++)
+      goal_position.changeParam(id, data);
+
+    if (use_transaction == true)
+    {
+      if (transaction.txRxPacket() != COMM_SUCCESS)
+        result.fail++;
+      result.utilization += transaction.getBusUtilization();
+      result.slack       += transaction.getSlack();
+    }
+    else
+    {
+      if (goal_position.txPacket() != COMM_SUCCESS)
+        result.fail++;
+      if (present_position.txRxPacket() != COMM_SUCCESS)
+        result.fail++;
+      if (present_current.txRxPacket() != COMM_SUCCESS)
+        result.fail++;
+    }
+
+    tick_time[tick] = port->getCurrentTime() - tick_start;
+  }
+
+  double total_time   = port->getCurrentTime() - start_time;
+  std::sort(tick_time.begin(), tick_time.end());
+  result.tick_median  = tick_time[ticks / 2];
+  result.tick_p99     = tick_time[ticks * 99 / 100];
+  result.rate         = ticks * 1000.0 / total_time;
+  result.wire         = sim->getWireTime() / ticks;
+  result.utilization /= ticks;
+  result.slack       /= ticks;
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  int     servo_num     = (argc > 1) ? atoi(argv[1]) : 6;
+  int     ticks         = (argc > 2) ? atoi(argv[2]) : 2000;
+  double  return_delay  = (argc > 3) ? atof(argv[3]) : 0.0;
+  double  period        = (argc > 4) ? atof(argv[4]) : 1.0;
+  bool    ok            = true;
+
+  printf("%d servos, %d ticks, return delay %.0f usec, period %.2f msec\n\n", servo_num, ticks, return_delay, period);
+  printf("  baudrate  mode       median ms  p99 ms    loop Hz  wire bound Hz  util %%  slack ms  fail\n");
+
+  for (unsigned int b = 0; b < sizeof(baudrate_list) / sizeof(baudrate_list[0]); b++)
+  {
+    ServoSimulator sim(2.0, baudrate_list[b]);
+    if (sim.open() == false)
+      return 1;
+    for (int id = 1; id <= servo_num; id++)
+      sim.addServo(id, MODEL_XM430_W210, return_delay);
+
+    dynamixel::PortHandler   *port = dynamixel::PortHandler::getPortHandler(sim.getPortName());
+    dynamixel::PacketHandler *ph   = dynamixel::PacketHandler::getPacketHandler(2.0);
+
+    // a pty takes no custom divisor, the port only uses the baudrate for its timeouts and the wire time report
+    port->setBaudRate(baudrate_list[b]);
+
+    for (int mode = 0; mode < 2; mode++)
+    {
+      bool   use_transaction = (mode == 1);
+      Result r = runTicks(port, ph, &sim, servo_num, ticks, period, use_transaction);
+
+      printf("%10d  %-11s %8.3f %7.3f %10.1f %14.1f",
+             baudrate_list[b], use_transaction ? "transaction" : "serial",
+             r.tick_median, r.tick_p99, r.rate, 1000.0 / r.wire);
+      if (use_transaction == true)
+        printf(" %7.1f %9.3f", r.utilization, r.slack);
+      else
+        printf(" %7s %9s", "-", "-");
+      printf(" %5d\n", r.fail);
+
+      ok = ok && (r.fail * 100 <= ticks);
+    }
+
+    port->closePort();
+    delete port;
+  }
+
+  return ok ? 0 : 1;
+}
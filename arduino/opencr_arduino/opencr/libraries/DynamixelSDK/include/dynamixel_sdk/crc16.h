@@ -0,0 +1,68 @@
+/*******************************************************************************
+* Copyright (c) 2016, ROBOTIS CO., LTD.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* * Neither the name of ROBOTIS nor the names of its
+*   contributors may be used to endorse or promote products derived from
+*   this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for CRC-16 of Dynamixel Protocol 2.0
+/// @author Zerom, Leon (RyuWoon Jung)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CRC16_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CRC16_H_
+
+
+#include "port_handler.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The function that calculates CRC-16 (polynomial 0x8005) of a data block
+/// @description The function processes four bytes per step with constant tables placed in read-only memory (flash on OpenCR),
+/// @description and the rest bytes one by one. Nothing is built on the stack.
+/// @param crc_accum CRC accumulated so far, 0 for a new packet
+/// @param data_blk_ptr Data block
+/// @param data_blk_size Length of the data block
+/// @return CRC accumulated with the data block
+////////////////////////////////////////////////////////////////////////////////
+WINDECLSPEC uint16_t updateCRC16(uint16_t crc_accum, const uint8_t *data_blk_ptr, uint16_t data_blk_size);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The function that accumulates one byte into CRC-16 (polynomial 0x8005)
+/// @description The function is for parsers that receive a packet byte by byte.
+/// @param crc_accum CRC accumulated so far, 0 for a new packet
+/// @param data Data byte
+/// @return CRC accumulated with the byte
+////////////////////////////////////////////////////////////////////////////////
+WINDECLSPEC uint16_t updateCRC16(uint16_t crc_accum, uint8_t data);
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CRC16_H_ */
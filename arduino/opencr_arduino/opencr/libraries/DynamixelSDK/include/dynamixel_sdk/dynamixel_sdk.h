@@ -37,10 +37,12 @@
 #define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_DYNAMIXELSDK_H_
 
 
+#include "crc16.h"
 #include "group_bulk_read.h"
 #include "group_bulk_write.h"
 #include "group_sync_read.h"
 #include "group_sync_write.h"
+#include "group_transaction.h"
 #include "packet_handler.h"
 #include "port_handler.h"
 
@@ -64,6 +64,13 @@ class WINDECLSPEC GroupBulkRead
 
   uint8_t        *param_;
 
+  bool            is_frozen_;
+  uint8_t        *frozen_txpacket_;         // instruction packet made by freezeParam()
+  uint16_t        frozen_txpacket_length_;
+  uint16_t        frozen_wait_length_;      // length of the status packets expected
+  uint8_t        *frozen_rxpacket_;         // status packet buffer reused by rxPacket()
+  uint16_t        frozen_rxpacket_length_;
+
   void    makeParam();
 
  public:
@@ -113,6 +120,47 @@ class WINDECLSPEC GroupBulkRead
   ////////////////////////////////////////////////////////////////////////////////
   void    clearParam  ();
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that freezes the Bulk Read list and makes the instruction packet in advance
+  /// @description The function makes the Bulk Read instruction packet once into a buffer owned by the instance,
+  /// @description so GroupBulkRead::txPacket() and GroupBulkRead::rxPacket() transmit and receive without rebuilding the parameter or allocating memory.
+  /// @description Adding, removing or clearing the list unfreezes it.
+  /// @return false
+  /// @return   when the list for Bulk Read is empty
+  /// @return   when the instruction packet couldn't be made
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    freezeParam ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that releases the instruction packet made by GroupBulkRead::freezeParam()
+  ////////////////////////////////////////////////////////////////////////////////
+  void    unfreezeParam();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns whether the Bulk Read list is frozen
+  /// @return true when the list is frozen by GroupBulkRead::freezeParam()
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isFrozen    () { return is_frozen_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the instruction packet made by GroupBulkRead::freezeParam()
+  /// @description The packet can be transmitted by the caller together with other packets, as GroupTransaction does.
+  /// @param txpacket Pointer that receives the instruction packet
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list is not frozen
+  /// @return or length of the instruction packet
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getFrozenTxPacket(uint8_t **txpacket);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the total length of the status packets expected for the frozen list
+  /// @return 0
+  /// @return   when the list is not frozen
+  /// @return or length of the status packets
+  ////////////////////////////////////////////////////////////////////////////////
+  uint16_t getFrozenRxLength();
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits the Bulk Read instruction packet which might be constructed by GroupBulkRead::addParam function
   /// @return COMM_NOT_AVAILABLE
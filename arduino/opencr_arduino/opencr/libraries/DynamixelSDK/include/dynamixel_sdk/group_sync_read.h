@@ -56,6 +56,7 @@ class WINDECLSPEC GroupSyncRead
 
   std::vector<uint8_t>            id_list_;
   std::map<uint8_t, uint8_t* >    data_list_; // <id, data>
+  std::map<uint8_t, int>          result_list_; // <id, communication result of the last rxPacket()>
 
   bool            last_result_;
   bool            is_param_changed_;
@@ -64,6 +65,13 @@ class WINDECLSPEC GroupSyncRead
   uint16_t        start_address_;
   uint16_t        data_length_;
 
+  bool            is_frozen_;
+  uint8_t        *frozen_txpacket_;         // instruction packet made by freezeParam()
+  uint16_t        frozen_txpacket_length_;
+
+  uint8_t        *rxpacket_;                // status packet buffer of rxPacket(), allocated once with the group
+  uint16_t        rxpacket_length_;
+
   void    makeParam();
 
  public:
@@ -79,7 +87,7 @@ class WINDECLSPEC GroupSyncRead
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that calls clearParam function to clear the parameter list for Sync Read
   ////////////////////////////////////////////////////////////////////////////////
-  ~GroupSyncRead() { clearParam(); }
+  ~GroupSyncRead() { clearParam(); delete[] rxpacket_; }
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that returns PortHandler instance
@@ -114,6 +122,48 @@ class WINDECLSPEC GroupSyncRead
   ////////////////////////////////////////////////////////////////////////////////
   void    clearParam  ();
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that freezes the Sync Read list and makes the instruction packet in advance
+  /// @description The function makes the Sync Read instruction packet once into a buffer owned by the instance,
+  /// @description so GroupSyncRead::txPacket() and GroupSyncRead::rxPacket() transmits it as-is without rebuilding the parameter or allocating memory.
+  /// @description Adding, removing or clearing the list unfreezes it.
+  /// @return false
+  /// @return   when the list for Sync Read is empty
+  /// @return   when the protocol1.0 has been used
+  /// @return   when the instruction packet couldn't be made
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    freezeParam ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that releases the instruction packet made by GroupSyncRead::freezeParam()
+  ////////////////////////////////////////////////////////////////////////////////
+  void    unfreezeParam();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns whether the Sync Read list is frozen
+  /// @return true when the list is frozen by GroupSyncRead::freezeParam()
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isFrozen    () { return is_frozen_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the instruction packet made by GroupSyncRead::freezeParam()
+  /// @description The packet can be transmitted by the caller together with other packets, as GroupTransaction does.
+  /// @param txpacket Pointer that receives the instruction packet
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list is not frozen
+  /// @return or length of the instruction packet
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getFrozenTxPacket(uint8_t **txpacket);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the total length of the status packets expected for the frozen list
+  /// @return 0
+  /// @return   when the list is not frozen
+  /// @return or length of the status packets
+  ////////////////////////////////////////////////////////////////////////////////
+  uint16_t getFrozenRxLength();
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits the Sync Read instruction packet which might be constructed by GroupSyncRead::addParam function
   /// @return COMM_NOT_AVAILABLE
@@ -125,12 +175,14 @@ class WINDECLSPEC GroupSyncRead
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that receives the packet which might be come from the Dynamixel
+  /// @description The function keeps receiving after a Dynamixel fails to answer,
+  /// @description so the data of the others stay available and GroupSyncRead::getResult() tells which one failed.
   /// @return COMM_NOT_AVAILABLE
   /// @return   when the list for Sync Read is empty
   /// @return   when the protocol1.0 has been used
   /// @return COMM_SUCCESS
-  /// @return   when there is packet recieved
-  /// @return or the other communication results
+  /// @return   when the packets of all Dynamixels are recieved
+  /// @return or the communication result of the first Dynamixel which failed
   ////////////////////////////////////////////////////////////////////////////////
   int     rxPacket();
 
@@ -153,6 +205,7 @@ class WINDECLSPEC GroupSyncRead
   /// @param data_length Length of the data for read
   /// @return false
   /// @return   when there are no data available
+  /// @return   when the Dynamixel failed to answer in the last GroupSyncRead::rxPacket
   /// @return   when the protocol1.0 has been used
   /// @return or true
   ////////////////////////////////////////////////////////////////////////////////
@@ -166,6 +219,15 @@ class WINDECLSPEC GroupSyncRead
   /// @return data value
   ////////////////////////////////////////////////////////////////////////////////
   uint32_t    getData     (uint8_t id, uint16_t address, uint16_t data_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the communication result of a Dynamixel in the last GroupSyncRead::rxPacket
+  /// @param id Dynamixel ID
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the ID is not in the list
+  /// @return or the communication result of the Dynamixel
+  ////////////////////////////////////////////////////////////////////////////////
+  int         getResult   (uint8_t id);
 };
 
 }
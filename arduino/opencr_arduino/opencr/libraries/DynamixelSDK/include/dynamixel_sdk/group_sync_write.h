@@ -63,6 +63,10 @@ class WINDECLSPEC GroupSyncWrite
   uint16_t        start_address_;
   uint16_t        data_length_;
 
+  bool            is_frozen_;
+  uint8_t        *frozen_txpacket_;         // instruction packet made by freezeParam()
+  uint16_t        frozen_txpacket_length_;
+
   void    makeParam();
 
  public:
@@ -123,6 +127,42 @@ class WINDECLSPEC GroupSyncWrite
   ////////////////////////////////////////////////////////////////////////////////
   void    clearParam  ();
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that freezes the Sync Write list and makes the instruction packet in advance
+  /// @description The function makes the Sync Write instruction packet once into a buffer owned by the instance,
+  /// @description so GroupSyncWrite::txPacket() transmits it as-is without rebuilding the parameter or allocating memory.
+  /// @description The data of the frozen list can be changed by GroupSyncWrite::changeParam().
+  /// @description Adding, removing or clearing the list unfreezes it.
+  /// @return false
+  /// @return   when the list for Sync Write is empty
+  /// @return   when the instruction packet couldn't be made
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    freezeParam ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that releases the instruction packet made by GroupSyncWrite::freezeParam()
+  ////////////////////////////////////////////////////////////////////////////////
+  void    unfreezeParam();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns whether the Sync Write list is frozen
+  /// @return true when the list is frozen by GroupSyncWrite::freezeParam()
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isFrozen    () { return is_frozen_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the instruction packet made by GroupSyncWrite::freezeParam()
+  /// @description The function re-makes the packet when the data was changed by GroupSyncWrite::changeParam().
+  /// @description The packet can be transmitted by the caller together with other packets, as GroupTransaction does.
+  /// @param txpacket Pointer that receives the instruction packet
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list is not frozen
+  /// @return or length of the instruction packet
+  /// @return or the other results which come from PacketHandler::makeSyncWriteTx
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getFrozenTxPacket(uint8_t **txpacket);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits the Sync Write instruction packet which might be constructed by GroupSyncWrite::addParam function
   /// @return COMM_NOT_AVAILABLE
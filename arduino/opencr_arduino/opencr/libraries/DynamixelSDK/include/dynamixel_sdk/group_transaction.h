@@ -0,0 +1,188 @@
+/*******************************************************************************
+* Copyright (c) 2016, ROBOTIS CO., LTD.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* * Neither the name of ROBOTIS nor the names of its
+*   contributors may be used to endorse or promote products derived from
+*   this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for Dynamixel Group Transaction
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_GROUPTRANSACTION_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_GROUPTRANSACTION_H_
+
+
+#include <vector>
+#include "port_handler.h"
+#include "packet_handler.h"
+#include "group_sync_read.h"
+#include "group_sync_write.h"
+#include "group_bulk_read.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class for running a list of frozen Sync Write / Sync Read / Bulk Read groups back-to-back on one port
+/// @description Instruction packets of write-only groups are sent in one burst together with the instruction packet of the next read group,
+/// @description so the bus doesn't idle between the groups and a USB serial adapter needs one transfer per read group instead of one per group.
+/// @description The bus is half duplex, so nothing is sent while the status packets of a read group are expected:
+/// @description the next burst goes out after the read group is received, and the transmission of a group never overlaps the reception of another.
+/// @description Groups run in the order they were added, and the bus time of each tick is reported.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC GroupTransaction
+{
+ private:
+  enum
+  {
+    TRANSACTION_SYNC_WRITE,
+    TRANSACTION_SYNC_READ,
+    TRANSACTION_BULK_READ
+  };
+
+  struct Operation
+  {
+    uint8_t   type;
+    void     *group;
+  };
+
+  PortHandler    *port_;
+  PacketHandler  *ph_;
+
+  std::vector<Operation>  operation_list_;
+  std::vector<uint8_t>    burst_;           // instruction packets sent in one writePort()
+
+  double          period_;
+  double          tick_time_;
+  double          wire_time_;
+
+  bool    addOperation(uint8_t type, void *group);
+  int     txBurst(uint16_t rx_length);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that Initializes instance for Group Transaction
+  /// @param port PortHandler instance
+  /// @param ph PacketHandler instance
+  /// @param period Period of the control loop in millisecond, used for reporting bus utilization and slack
+  ////////////////////////////////////////////////////////////////////////////////
+  GroupTransaction(PortHandler *port, PacketHandler *ph, double period);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PortHandler instance
+  /// @return PortHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PortHandler     *getPortHandler()   { return port_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PacketHandler instance
+  /// @return PacketHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PacketHandler   *getPacketHandler() { return ph_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a Sync Write group to the transaction list
+  /// @description The group should be frozen by GroupSyncWrite::freezeParam() before GroupTransaction::txRxPacket() is called.
+  /// @param group GroupSyncWrite instance
+  /// @return false
+  /// @return   when the group uses the other port or exists already in the list
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    addSyncWrite(GroupSyncWrite *group);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a Sync Read group to the transaction list
+  /// @description The group should be frozen by GroupSyncRead::freezeParam() before GroupTransaction::txRxPacket() is called.
+  /// @param group GroupSyncRead instance
+  /// @return false
+  /// @return   when the group uses the other port or exists already in the list
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    addSyncRead (GroupSyncRead *group);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a Bulk Read group to the transaction list
+  /// @description The group should be frozen by GroupBulkRead::freezeParam() before GroupTransaction::txRxPacket() is called.
+  /// @param group GroupBulkRead instance
+  /// @return false
+  /// @return   when the group uses the other port or exists already in the list
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    addBulkRead (GroupBulkRead *group);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the transaction list
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearParam  ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that runs all groups in the transaction list once
+  /// @description The function sends the instruction packets of the write groups with the instruction packet of the next read group,
+  /// @description then receives the status packets of the read group by its rxPacket().
+  /// @description The write groups after the last read group are sent in a last burst.
+  /// @description A failed group doesn't stop the following groups, and its data is not available by getData().
+  /// @return COMM_PORT_BUSY
+  /// @return   when the port is in use
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list is empty
+  /// @return   when a group in the list is not frozen
+  /// @return or the first result that is not COMM_SUCCESS from the groups
+  /// @return or COMM_SUCCESS
+  ////////////////////////////////////////////////////////////////////////////////
+  int     txRxPacket();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the time that the last GroupTransaction::txRxPacket() took
+  /// @return time in millisecond
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getTickTime()       { return tick_time_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the time that the packets of the last tick occupied the bus
+  /// @description The time is calculated from the number of instruction and status bytes at the baudrate of the port (10 bits per byte),
+  /// @description so it doesn't include return delay time of Dynamixels and latency of the port.
+  /// @return time in millisecond
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getWireTime()       { return wire_time_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the bus utilization of the last tick
+  /// @return ratio of the wire time to the period in percent
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getBusUtilization() { return (period_ > 0.0) ? (wire_time_ / period_ * 100.0) : 0.0; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the slack of the last tick
+  /// @return time left in the period after the last tick in millisecond, negative when the tick overran the period
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getSlack()          { return period_ - tick_time_; }
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_GROUPTRANSACTION_H_ */
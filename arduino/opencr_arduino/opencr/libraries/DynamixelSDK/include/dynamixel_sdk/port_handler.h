@@ -52,9 +52,32 @@
 
 #include <stdint.h>
 
+#define RTT_HISTOGRAM_BIN_NUM     16      // number of round trip time histogram bins
+#define RTT_HISTOGRAM_WINDOW      1024    // samples kept before the histogram is halved
+#define RTT_MIN_SAMPLE_NUM        8       // samples needed before the adaptive timeout is used
+#define RTT_PROBE_INTERVAL        8       // consecutive timeouts after which fast_fail waits the fixed timeout once
+#define RTT_ID_NUM                253     // IDs 0 ~ 252 are measured, broadcast is not
+
 namespace dynamixel
 {
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The struct that keeps the status packet latency measured for an ID
+/// @description The latency is the time from the end of the instruction packet to the start of the status packet,
+/// @description including the return delay time of the device and the latency of the USB converter.
+/// @description Each bin of the histogram counts the samples below PortHandler::getRoundTripBinLimit() of the bin.
+////////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+  uint32_t  count;                              ///< number of status packets received
+  uint32_t  timeout_count;                      ///< number of status packets timed out
+  uint16_t  consecutive_timeout_count;          ///< number of status packets timed out since the last one received
+  uint16_t  sample_num;                         ///< number of samples in the histogram
+  double    min;                                ///< minimum latency in millisecond
+  double    max;                                ///< maximum latency in millisecond
+  uint16_t  histogram[RTT_HISTOGRAM_BIN_NUM];   ///< latency histogram
+} RoundTripStats;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief The class for port control that inherits PortHandlerLinux, PortHandlerWindows, PortHandlerMac, or PortHandlerArduino
 ////////////////////////////////////////////////////////////////////////////////
@@ -71,7 +94,15 @@ class WINDECLSPEC PortHandler
 
   bool   is_using_; ///< shows whether the port is in use
 
-  virtual ~PortHandler() { }
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes the round trip time measurement
+  ////////////////////////////////////////////////////////////////////////////////
+  PortHandler();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that releases the round trip time statistics
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual ~PortHandler();
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that opens the port
@@ -174,6 +205,102 @@ class WINDECLSPEC PortHandler
   /// @description The function checks whether current time is passed by the time of packet timeout from the time set by PortHandlerLinux::setPacketTimeout().
   ////////////////////////////////////////////////////////////////////////////////
   virtual bool    isPacketTimeout() = 0;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the current time
+  /// @description The function gets the current time from the clock which the port handler uses for the packet timeout.
+  /// @return current time in millisecond
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual double  getCurrentTime() = 0;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that waits until bytes are available on the port or the packet timeout is passed
+  /// @description The function lets the packet handler sleep during bus turnaround instead of polling PortHandler::readPort().
+  /// @description The default implementation returns immediately, so the caller keeps polling the port.
+  /// @return false
+  /// @return   when the packet timeout has been passed
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual bool    waitForBytesAvailable();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that enables the packet timeout derived from the measured latency
+  /// @description The function makes PortHandler::setStatusPacketTimeout() use the status packet latency measured for each ID
+  /// @description instead of the fixed USB latency timer of the port handler.
+  /// @description The timeout is the wire time of the status packet + 2 x the 99th percentile latency + 1 msec.
+  /// @description With fast_fail, the timeout is the wire time of the status packet + the 99th percentile latency
+  /// @description + the spread of the latency (99th - 50th percentile, at least 0.5 msec),
+  /// @description so that a missing device costs little more than a device which answers.
+  /// @description After every RTT_PROBE_INTERVAL consecutive timeouts, fast_fail waits the fixed timeout once,
+  /// @description so that a device which became slower is measured again.
+  /// @param enable Enables the adaptive packet timeout
+  /// @param fast_fail Keeps the adaptive packet timeout even after a timeout
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setAdaptiveTimeout(bool enable, bool fast_fail = false);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets and starts stopwatch for watching the status packet of an ID
+  /// @description The function calls PortHandler::setPacketTimeout() with packet_length,
+  /// @description and shortens the packet timeout when the adaptive packet timeout is enabled
+  /// @description and the ID has enough latency samples.
+  /// @description The stopwatch is also used by PortHandler::updateRoundTripTime() to measure the latency.
+  /// @param id Dynamixel ID which is expected to send the status packet
+  /// @param packet_length Length of the packet expected to be received
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setStatusPacketTimeout(uint8_t id, uint16_t packet_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that records the result of the status packet watched by PortHandler::setStatusPacketTimeout()
+  /// @description The function adds the latency of the status packet into the statistics of the ID,
+  /// @description or counts the timeout when the status packet was not received.
+  /// @description The function does nothing when id is not the one set by PortHandler::setStatusPacketTimeout().
+  /// @param id Dynamixel ID of the status packet
+  /// @param is_received Whether the status packet was received
+  ////////////////////////////////////////////////////////////////////////////////
+  void    updateRoundTripTime(uint8_t id, bool is_received);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the round trip time statistics of an ID
+  /// @param id Dynamixel ID
+  /// @return NULL
+  /// @return   when no status packet of the ID was watched
+  /// @return or statistics of the ID
+  ////////////////////////////////////////////////////////////////////////////////
+  const RoundTripStats *getRoundTripStats(uint8_t id);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the latency percentile of an ID from the histogram
+  /// @description The function returns the upper limit of the histogram bin which holds the percentile,
+  /// @description or the maximum latency for the last bin.
+  /// @param id Dynamixel ID
+  /// @param percentile Percentile (0.0 ~ 100.0)
+  /// @return -1.0
+  /// @return   when the ID has no latency sample
+  /// @return or latency in millisecond
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getRoundTripTime(uint8_t id, double percentile);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the round trip time statistics of all IDs
+  /// @description The function should be called when the baudrate or the return delay time of the devices are changed.
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearRoundTripStats();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the upper limit of a round trip time histogram bin
+  /// @param bin Histogram bin (0 ~ RTT_HISTOGRAM_BIN_NUM - 1)
+  /// @return upper limit of the bin in millisecond
+  ////////////////////////////////////////////////////////////////////////////////
+  static double getRoundTripBinLimit(int bin);
+
+ private:
+  RoundTripStats *rtt_stats_[RTT_ID_NUM];
+  bool    is_adaptive_timeout_;
+  bool    is_fast_fail_;
+
+  uint8_t  rtt_id_;
+  uint16_t rtt_packet_length_;
+  double   rtt_start_time_;
 };
 
 }
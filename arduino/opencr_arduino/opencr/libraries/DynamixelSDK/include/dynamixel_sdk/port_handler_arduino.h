@@ -65,7 +65,6 @@ class PortHandlerArduino : public PortHandler
 
   bool    setupPort(const int cflag_baud);
 
-  double  getCurrentTime();
   double  getTimeSinceStart();
 
   int     checkBaudrateAvailable(int baudrate);
@@ -74,6 +73,7 @@ class PortHandlerArduino : public PortHandler
   void    setPowerOff();
   void    setTxEnable();
   void    setTxDisable();
+  void    waitTxDone();
 
  public:
   ////////////////////////////////////////////////////////////////////////////////
@@ -162,6 +162,7 @@ class PortHandlerArduino : public PortHandler
   /// @brief The function that writes bytes on the port buffer
   /// @description The function writes bytes on the port buffer,
   /// @description and returns a number of bytes which are successfully written.
+  /// @description On OpenCR the function returns while the bytes are still being sent.
   /// @param packet Buffer which would be written on the port buffer
   /// @param length Length of the buffer for write
   /// @return -1
@@ -173,6 +174,7 @@ class PortHandlerArduino : public PortHandler
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that sets and starts stopwatch for watching packet timeout
   /// @description The function sets the stopwatch by getting current time and the time of packet timeout with packet_length.
+  /// @description The stopwatch starts after the last byte written by PortHandlerArduino::writePort() has been sent.
   /// @param packet_length Length of the packet expected to be received
   ////////////////////////////////////////////////////////////////////////////////
   void    setPacketTimeout(uint16_t packet_length);
@@ -180,6 +182,7 @@ class PortHandlerArduino : public PortHandler
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that sets and starts stopwatch for watching packet timeout
   /// @description The function sets the stopwatch by getting current time and the time of packet timeout with msec.
+  /// @description The stopwatch starts after the last byte written by PortHandlerArduino::writePort() has been sent.
   /// @param packet_length Length of the packet expected to be received
   ////////////////////////////////////////////////////////////////////////////////
   void    setPacketTimeout(double msec);
@@ -189,6 +192,21 @@ class PortHandlerArduino : public PortHandler
   /// @description The function checks whether current time is passed by the time of packet timeout from the time set by PortHandlerArduino::setPacketTimeout().
   ////////////////////////////////////////////////////////////////////////////////
   bool    isPacketTimeout();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the current time
+  /// @return current time in millisecond
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getCurrentTime();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that waits until bytes are available on the port or the packet timeout is passed
+  /// @description The function puts the CPU to sleep until the UART receives bytes for the rest of the time set by PortHandlerArduino::setPacketTimeout().
+  /// @return false
+  /// @return   when the packet timeout has been passed
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    waitForBytesAvailable();
 };
 
 }
@@ -60,7 +60,6 @@ class PortHandlerMac : public PortHandler
   bool    setCustomBaudrate(int speed);
   int     getCFlagBaud(const int baudrate);
 
-  double  getCurrentTime();
   double  getTimeSinceStart();
 
  public:
@@ -178,6 +177,21 @@ class PortHandlerMac : public PortHandler
   /// @description The function checks whether current time is passed by the time of packet timeout from the time set by PortHandlerMac::setPacketTimeout().
   ////////////////////////////////////////////////////////////////////////////////
   bool    isPacketTimeout();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the current time
+  /// @return current time in millisecond
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getCurrentTime();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that waits until bytes are available on the port or the packet timeout is passed
+  /// @description The function blocks in select() on the port for the rest of the time set by PortHandlerMac::setPacketTimeout().
+  /// @return false
+  /// @return   when the packet timeout has been passed
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    waitForBytesAvailable();
 };
 
 }
@@ -61,7 +61,6 @@ class WINDECLSPEC PortHandlerWindows : public PortHandler
 
   bool    setupPort(const int baudrate);
 
-  double  getCurrentTime();
   double  getTimeSinceStart();
 
  public:
@@ -178,6 +177,12 @@ class WINDECLSPEC PortHandlerWindows : public PortHandler
   /// @description The function checks whether current time is passed by the time of packet timeout from the time set by PortHandlerWindows::setPacketTimeout().
   ////////////////////////////////////////////////////////////////////////////////
   bool    isPacketTimeout();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the current time
+  /// @return current time in millisecond
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getCurrentTime();
 };
 
 }
@@ -53,8 +53,12 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   Protocol2PacketHandler();
 
   uint16_t    updateCRC(uint16_t crc_accum, uint8_t *data_blk_ptr, uint16_t data_blk_size);
-  void        addStuffing(uint8_t *packet);
-  void        removeStuffing(uint8_t *packet);
+  bool        addStuffing(uint8_t *packet, uint16_t buffer_length);
+  int         makeTxPacket(uint8_t *txpacket, uint16_t buffer_length);
+  int         makePacket(uint8_t *txpacket, uint16_t buffer_length, uint8_t id, uint8_t instruction,
+                         uint8_t *prefix, uint16_t prefix_length, uint8_t *param, uint16_t param_length);
+  int         txRxMadePacket(PortHandler *port, uint8_t *txpacket, uint16_t packet_length, uint8_t *rxpacket, uint8_t *error);
+  int         rxStatusPacket(PortHandler *port, uint8_t *txpacket, uint8_t *rxpacket, uint8_t *error);
 
  public:
   ////////////////////////////////////////////////////////////////////////////////
@@ -104,6 +108,7 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   /// @description The function clears the port buffer by PortHandler::clearPort() function,
   /// @description   then transmits txpacket by PortHandler::writePort() function.
   /// @description The function activates only when the port is not busy and when the packet is already written on the port buffer
+  /// @description Byte stuffing is added to txpacket in place, so txpacket should have room for the stuffed bytes.
   /// @param port PortHandler instance
   /// @param txpacket packet for transmission
   /// @return COMM_PORT_BUSY
@@ -137,6 +142,17 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int rxPacket        (PortHandler *port, uint8_t *rxpacket);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives packet (rxpacket) into a buffer of rxpacket_length bytes
+  /// @description The function works as Protocol2PacketHandler::rxPacket(), but stops with COMM_RX_CORRUPT
+  /// @description as soon as the length field of the packet shows that it does not fit in rxpacket.
+  /// @param port PortHandler instance
+  /// @param rxpacket received packet
+  /// @param rxpacket_length Size of rxpacket
+  /// @return communication results as Protocol2PacketHandler::rxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int rxPacket        (PortHandler *port, uint8_t *rxpacket, uint16_t rxpacket_length);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits packet (txpacket) and receives packet (rxpacket) during designated time via PortHandler port
   /// @description The function calls Protocol2PacketHandler::txPacket(),
@@ -153,6 +169,23 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int txRxPacket      (PortHandler *port, uint8_t *txpacket, uint8_t *rxpacket, uint8_t *error = 0);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits the instruction packet which was completed in advance
+  /// @description The function clears the port buffer by PortHandler::clearPort() function,
+  /// @description   then transmits txpacket as-is by PortHandler::writePort() function.
+  /// @description txpacket should be made by Protocol2PacketHandler::makeSyncReadTx() / Protocol2PacketHandler::makeSyncWriteTx() / Protocol2PacketHandler::makeBulkReadTx(),
+  /// @description so the same packet can be transmitted repeatedly without being rebuilt.
+  /// @param port PortHandler instance
+  /// @param txpacket packet for transmission
+  /// @param packet_length Length of the packet for transmission
+  /// @return COMM_PORT_BUSY
+  /// @return   when the port is already in use
+  /// @return COMM_TX_FAIL
+  /// @return   when written packet is shorter than expected
+  /// @return or COMM_SUCCESS
+  ////////////////////////////////////////////////////////////////////////////////
+  int txPreparedPacket(PortHandler *port, uint8_t *txpacket, uint16_t packet_length);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that pings Dynamixel but doesn't take its model number
   /// @description The function calls Protocol2PacketHandler::ping() which gets Dynamixel model number,
@@ -190,6 +223,24 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int broadcastPing   (PortHandler *port, std::vector<uint8_t> &id_list);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief (Available only in Protocol 2.0) The function that pings Dynamixels of ID up to max_id and gets their model numbers and firmware versions
+  /// @description The Dynamixels answer the broadcast ping in the order of ID,
+  /// @description so the function waits only for the time that Dynamixels of ID up to max_id need,
+  /// @description and stops as soon as the Dynamixel of max_id answers.
+  /// @param port PortHandler instance
+  /// @param max_id Highest ID to wait for (1 ~ MAX_ID)
+  /// @param id_list ID list of Dynamixels which are found by broadcast ping
+  /// @param model_list Model numbers of the Dynamixels in id_list
+  /// @param firmware_list Firmware versions of the Dynamixels in id_list
+  /// @return COMM_RX_TIMEOUT
+  /// @return   when no Dynamixel answers
+  /// @return COMM_SUCCESS
+  /// @return   when any Dynamixel answers
+  /// @return or COMM_RX_CORRUPT
+  ////////////////////////////////////////////////////////////////////////////////
+  int broadcastPing   (PortHandler *port, uint8_t max_id, std::vector<uint8_t> &id_list, std::vector<uint16_t> &model_list, std::vector<uint8_t> &firmware_list);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that makes Dynamixels run as written in the Dynamixel register
   /// @description The function makes an instruction packet with INST_ACTION,
@@ -255,6 +306,20 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int readRx          (PortHandler *port, uint16_t length, uint8_t *data, uint8_t *error = 0);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives the packet into rxpacket and reads the data in the packet
+  /// @description The function works as Protocol2PacketHandler::readRx(), but receives the packet into the buffer given by the caller
+  /// @description instead of allocating a packet buffer for every call.
+  /// @param port PortHandler instance
+  /// @param length Length of the data for read
+  /// @param data Data extracted from the packet
+  /// @param error Dynamixel hardware error
+  /// @param rxpacket Buffer for the packet
+  /// @param rxpacket_length Size of rxpacket, a longer status packet ends in COMM_RX_CORRUPT
+  /// @return communication results which come from Protocol2PacketHandler::rxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int readRx          (PortHandler *port, uint16_t length, uint8_t *data, uint8_t *error, uint8_t *rxpacket, uint16_t rxpacket_length);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_READ instruction packet, and read data from received packet
   /// @description The function makes an instruction packet with INST_READ,
@@ -561,6 +626,54 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   /// @return communication results which come from Protocol2PacketHandler::txRxPacket()
   ////////////////////////////////////////////////////////////////////////////////
   int bulkWriteTxOnly (PortHandler *port, uint8_t *param, uint16_t param_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that makes INST_SYNC_READ instruction packet without transmitting it
+  /// @description The function makes an instruction packet with INST_SYNC_READ into txpacket,
+  /// @description and completes it with the header, byte stuffing and CRC16 for Protocol2PacketHandler::txPreparedPacket().
+  /// @param txpacket Buffer for the packet
+  /// @param buffer_length Size of the buffer for the packet
+  /// @param start_address Address of the data for Sync Read
+  /// @param data_length Length of the data for Sync Read
+  /// @param param Parameter for Sync Read
+  /// @param param_length Length of the data for Sync Read
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the protocol1.0 has been used
+  /// @return COMM_TX_ERROR
+  /// @return   when the packet doesn't fit into buffer_length
+  /// @return or Length of the packet made
+  ////////////////////////////////////////////////////////////////////////////////
+  int makeSyncReadTx  (uint8_t *txpacket, uint16_t buffer_length, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that makes INST_SYNC_WRITE instruction packet without transmitting it
+  /// @description The function makes an instruction packet with INST_SYNC_WRITE into txpacket,
+  /// @description and completes it with the header, byte stuffing and CRC16 (or checksum) for Protocol2PacketHandler::txPreparedPacket().
+  /// @param txpacket Buffer for the packet
+  /// @param buffer_length Size of the buffer for the packet
+  /// @param start_address Address of the data for Sync Write
+  /// @param data_length Length of the data for Sync Write
+  /// @param param Parameter for Sync Write
+  /// @param param_length Length of the data for Sync Write
+  /// @return COMM_TX_ERROR
+  /// @return   when the packet doesn't fit into buffer_length
+  /// @return or Length of the packet made
+  ////////////////////////////////////////////////////////////////////////////////
+  int makeSyncWriteTx (uint8_t *txpacket, uint16_t buffer_length, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that makes INST_BULK_READ instruction packet without transmitting it
+  /// @description The function makes an instruction packet with INST_BULK_READ into txpacket,
+  /// @description and completes it with the header, byte stuffing and CRC16 (or checksum) for Protocol2PacketHandler::txPreparedPacket().
+  /// @param txpacket Buffer for the packet
+  /// @param buffer_length Size of the buffer for the packet
+  /// @param param Parameter for Bulk Read
+  /// @param param_length Length of the data for Bulk Read
+  /// @return COMM_TX_ERROR
+  /// @return   when the packet doesn't fit into buffer_length
+  /// @return or Length of the packet made
+  ////////////////////////////////////////////////////////////////////////////////
+  int makeBulkReadTx  (uint8_t *txpacket, uint16_t buffer_length, uint8_t *param, uint16_t param_length);
 };
 
 }
@@ -51,7 +51,13 @@ GroupBulkRead::GroupBulkRead(PortHandler *port, PacketHandler *ph)
     ph_(ph),
     last_result_(false),
     is_param_changed_(false),
-    param_(0)
+    param_(0),
+    is_frozen_(false),
+    frozen_txpacket_(0),
+    frozen_txpacket_length_(0),
+    frozen_wait_length_(0),
+    frozen_rxpacket_(0),
+    frozen_rxpacket_length_(0)
 {
   clearParam();
 }
@@ -100,6 +106,7 @@ bool GroupBulkRead::addParam(uint8_t id, uint16_t start_address, uint16_t data_l
   if (std::find(id_list_.begin(), id_list_.end(), id) != id_list_.end())   // id already exist
     return false;
 
+  unfreezeParam();
   id_list_.push_back(id);
   length_list_[id]    = data_length;
   address_list_[id]   = start_address;
@@ -115,6 +122,7 @@ void GroupBulkRead::removeParam(uint8_t id)
   if (it == id_list_.end())    // NOT exist
     return;
 
+  unfreezeParam();
   id_list_.erase(it);
   address_list_.erase(id);
   length_list_.erase(id);
@@ -126,6 +134,8 @@ void GroupBulkRead::removeParam(uint8_t id)
 
 void GroupBulkRead::clearParam()
 {
+  unfreezeParam();
+
   if (id_list_.size() == 0)
     return;
 
@@ -141,11 +151,99 @@ void GroupBulkRead::clearParam()
   param_ = 0;
 }
 
+bool GroupBulkRead::freezeParam()
+{
+  if (id_list_.size() == 0)
+    return false;
+
+  unfreezeParam();
+  makeParam();
+
+  uint16_t param_length   = 0;
+  uint16_t max_length     = 0;
+
+  frozen_wait_length_ = 0;
+  for (unsigned int i = 0; i < id_list_.size(); i++)
+  {
+    uint16_t data_length = length_list_[id_list_[i]];
+    if (data_length > max_length)
+      max_length = data_length;
+
+    if (ph_->getProtocolVersion() == 1.0)
+      frozen_wait_length_ += data_length + 7;
+    else    // 2.0
+      frozen_wait_length_ += data_length + 10;
+  }
+
+  if (ph_->getProtocolVersion() == 1.0)
+    param_length = id_list_.size() * 3;   // ID(1) + ADDR(1) + LENGTH(1)
+  else    // 2.0
+    param_length = id_list_.size() * 5;   // ID(1) + ADDR(2) + LENGTH(2)
+
+  uint16_t tx_length      = param_length + 10 + (param_length + 10) / 3;  // (length/3): consider stuffing
+  uint16_t rx_length      = max_length + 11 + (max_length + 11) / 3;      // (length/3): consider stuffing
+
+  frozen_txpacket_ = new uint8_t[tx_length];
+  frozen_rxpacket_ = new uint8_t[rx_length];
+  frozen_rxpacket_length_ = rx_length;
+
+  int result = ph_->makeBulkReadTx(frozen_txpacket_, tx_length, param_, param_length);
+  if (result < 0)
+  {
+    unfreezeParam();
+    return false;
+  }
+
+  frozen_txpacket_length_ = (uint16_t)result;
+  is_frozen_              = true;
+  return true;
+}
+
+void GroupBulkRead::unfreezeParam()
+{
+  if (frozen_txpacket_ != 0)
+    delete[] frozen_txpacket_;
+  frozen_txpacket_ = 0;
+  if (frozen_rxpacket_ != 0)
+    delete[] frozen_rxpacket_;
+  frozen_rxpacket_ = 0;
+  frozen_rxpacket_length_ = 0;
+
+  frozen_txpacket_length_ = 0;
+  frozen_wait_length_     = 0;
+  is_frozen_              = false;
+}
+
+int GroupBulkRead::getFrozenTxPacket(uint8_t **txpacket)
+{
+  if (is_frozen_ == false)
+    return COMM_NOT_AVAILABLE;
+
+  *txpacket = frozen_txpacket_;
+  return frozen_txpacket_length_;
+}
+
+uint16_t GroupBulkRead::getFrozenRxLength()
+{
+  if (is_frozen_ == false)
+    return 0;
+
+  return frozen_wait_length_;
+}
+
 int GroupBulkRead::txPacket()
 {
   if (id_list_.size() == 0)
     return COMM_NOT_AVAILABLE;
 
+  if (is_frozen_ == true)
+  {
+    int result = ph_->txPreparedPacket(port_, frozen_txpacket_, frozen_txpacket_length_);
+    if (result == COMM_SUCCESS)
+      port_->setPacketTimeout(getFrozenRxLength());
+    return result;
+  }
+
   if (is_param_changed_ == true || param_ == 0)
     makeParam();
 
@@ -173,7 +271,10 @@ int GroupBulkRead::rxPacket()
   {
     uint8_t id = id_list_[i];
 
-    result = ph_->readRx(port_, length_list_[id], data_list_[id]);
+    if (is_frozen_ == true)
+      result = ph_->readRx(port_, length_list_[id], data_list_[id], 0, frozen_rxpacket_, frozen_rxpacket_length_);
+    else
+      result = ph_->readRx(port_, length_list_[id], data_list_[id]);
     if (result != COMM_SUCCESS)
       return result;
   }
@@ -43,6 +43,8 @@
 #include "../../include/dynamixel_sdk/group_sync_read.h"
 #endif
 
+#define PKT_ID  4   // ID position in the protocol 2.0 status packet
+
 using namespace dynamixel;
 
 GroupSyncRead::GroupSyncRead(PortHandler *port, PacketHandler *ph, uint16_t start_address, uint16_t data_length)
@@ -52,8 +54,14 @@ GroupSyncRead::GroupSyncRead(PortHandler *port, PacketHandler *ph, uint16_t star
     is_param_changed_(false),
     param_(0),
     start_address_(start_address),
-    data_length_(data_length)
+    data_length_(data_length),
+    is_frozen_(false),
+    frozen_txpacket_(0),
+    frozen_txpacket_length_(0),
+    rxpacket_(0),
+    rxpacket_length_(data_length + 11 + (data_length + 11) / 3)  // (length/3): consider stuffing
 {
+  rxpacket_ = new uint8_t[rxpacket_length_];
   clearParam();
 }
 
@@ -81,8 +89,10 @@ bool GroupSyncRead::addParam(uint8_t id)
   if (std::find(id_list_.begin(), id_list_.end(), id) != id_list_.end())   // id already exist
     return false;
 
+  unfreezeParam();
   id_list_.push_back(id);
   data_list_[id] = new uint8_t[data_length_];
+  result_list_[id] = COMM_NOT_AVAILABLE;
 
   is_param_changed_   = true;
   return true;
@@ -96,14 +106,18 @@ void GroupSyncRead::removeParam(uint8_t id)
   if (it == id_list_.end())    // NOT exist
     return;
 
+  unfreezeParam();
   id_list_.erase(it);
   delete[] data_list_[id];
   data_list_.erase(id);
+  result_list_.erase(id);
 
   is_param_changed_   = true;
 }
 void GroupSyncRead::clearParam()
 {
+  unfreezeParam();
+
   if (ph_->getProtocolVersion() == 1.0 || id_list_.size() == 0)
     return;
 
@@ -112,16 +126,77 @@ void GroupSyncRead::clearParam()
 
   id_list_.clear();
   data_list_.clear();
+  result_list_.clear();
   if (param_ != 0)
     delete[] param_;
   param_ = 0;
 }
 
+bool GroupSyncRead::freezeParam()
+{
+  if (ph_->getProtocolVersion() == 1.0 || id_list_.size() == 0)
+    return false;
+
+  unfreezeParam();
+  makeParam();
+
+  uint16_t param_length   = id_list_.size() * 1;                 // ID(1)
+  uint16_t tx_length      = param_length + 14 + (param_length + 14) / 3;  // (length/3): consider stuffing
+
+  frozen_txpacket_ = new uint8_t[tx_length];
+
+  int result = ph_->makeSyncReadTx(frozen_txpacket_, tx_length, start_address_, data_length_, param_, param_length);
+  if (result < 0)
+  {
+    unfreezeParam();
+    return false;
+  }
+
+  frozen_txpacket_length_ = (uint16_t)result;
+  is_frozen_              = true;
+  return true;
+}
+
+void GroupSyncRead::unfreezeParam()
+{
+  if (frozen_txpacket_ != 0)
+    delete[] frozen_txpacket_;
+  frozen_txpacket_ = 0;
+
+  frozen_txpacket_length_ = 0;
+  is_frozen_              = false;
+}
+
+int GroupSyncRead::getFrozenTxPacket(uint8_t **txpacket)
+{
+  if (is_frozen_ == false)
+    return COMM_NOT_AVAILABLE;
+
+  *txpacket = frozen_txpacket_;
+  return frozen_txpacket_length_;
+}
+
+uint16_t GroupSyncRead::getFrozenRxLength()
+{
+  if (is_frozen_ == false)
+    return 0;
+
+  return (uint16_t)((11 + data_length_) * id_list_.size());
+}
+
 int GroupSyncRead::txPacket()
 {
   if (ph_->getProtocolVersion() == 1.0 || id_list_.size() == 0)
     return COMM_NOT_AVAILABLE;
 
+  if (is_frozen_ == true)
+  {
+    int result = ph_->txPreparedPacket(port_, frozen_txpacket_, frozen_txpacket_length_);
+    if (result == COMM_SUCCESS)
+      port_->setPacketTimeout(getFrozenRxLength());
+    return result;
+  }
+
   if (is_param_changed_ == true || param_ == 0)
     makeParam();
 
@@ -136,18 +211,45 @@ int GroupSyncRead::rxPacket()
     return COMM_NOT_AVAILABLE;
 
   int cnt            = id_list_.size();
-  int result         = COMM_RX_FAIL;
+  int result         = COMM_SUCCESS;
 
   if (cnt == 0)
     return COMM_NOT_AVAILABLE;
 
   for (int i = 0; i < cnt; i++)
-  {
-    uint8_t id = id_list_[i];
+    result_list_[id_list_[i]] = COMM_RX_TIMEOUT;
 
-    result = ph_->readRx(port_, data_length_, data_list_[id]);
-    if (result != COMM_SUCCESS)
-      return result;
+  // The status packets come in the order of the list. A packet from a later ID
+  // means the ones between did not answer, so it is stored for its own ID.
+  int i = 0;
+  while (i < cnt)
+  {
+    uint8_t id      = id_list_[i];
+    int rx_result   = ph_->readRx(port_, data_length_, data_list_[id], 0, rxpacket_, rxpacket_length_);
+
+    if (rx_result == COMM_SUCCESS && rxpacket_[PKT_ID] != id)
+    {
+      int j = i + 1;
+      while (j < cnt && id_list_[j] != rxpacket_[PKT_ID])
+        j++;
+
+      if (j < cnt)
+      {
+        for (int s = 0; s < data_length_; s++)
+          data_list_[id_list_[j]][s] = data_list_[id][s];
+        result_list_[id_list_[j]] = COMM_SUCCESS;
+        if (result == COMM_SUCCESS)
+          result = COMM_RX_TIMEOUT;
+        i = j + 1;
+      }
+      // a packet of the ID out of the list is dropped
+      continue;
+    }
+
+    result_list_[id] = rx_result;
+    if (rx_result != COMM_SUCCESS && result == COMM_SUCCESS)
+      result = rx_result;
+    i++;
   }
 
   if (result == COMM_SUCCESS)
@@ -172,7 +274,7 @@ int GroupSyncRead::txRxPacket()
 
 bool GroupSyncRead::isAvailable(uint8_t id, uint16_t address, uint16_t data_length)
 {
-  if (ph_->getProtocolVersion() == 1.0 || last_result_ == false || data_list_.find(id) == data_list_.end())
+  if (ph_->getProtocolVersion() == 1.0 || data_list_.find(id) == data_list_.end() || result_list_[id] != COMM_SUCCESS)
     return false;
 
   if (address < start_address_ || start_address_ + data_length_ - data_length < address)
@@ -202,3 +304,12 @@ uint32_t GroupSyncRead::getData(uint8_t id, uint16_t address, uint16_t data_leng
       return 0;
   }
 }
+
+int GroupSyncRead::getResult(uint8_t id)
+{
+  std::map<uint8_t, int>::iterator it = result_list_.find(id);
+  if (it == result_list_.end())
+    return COMM_NOT_AVAILABLE;
+
+  return it->second;
+}
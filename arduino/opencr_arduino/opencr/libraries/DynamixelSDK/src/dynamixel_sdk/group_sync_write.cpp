@@ -51,7 +51,10 @@ GroupSyncWrite::GroupSyncWrite(PortHandler *port, PacketHandler *ph, uint16_t st
     is_param_changed_(false),
     param_(0),
     start_address_(start_address),
-    data_length_(data_length)
+    data_length_(data_length),
+    is_frozen_(false),
+    frozen_txpacket_(0),
+    frozen_txpacket_length_(0)
 {
   clearParam();
 }
@@ -84,6 +87,7 @@ bool GroupSyncWrite::addParam(uint8_t id, uint8_t *data)
   if (std::find(id_list_.begin(), id_list_.end(), id) != id_list_.end())   // id already exist
     return false;
 
+  unfreezeParam();
   id_list_.push_back(id);
   data_list_[id]    = new uint8_t[data_length_];
   for (int c = 0; c < data_length_; c++)
@@ -99,6 +103,7 @@ void GroupSyncWrite::removeParam(uint8_t id)
   if (it == id_list_.end())    // NOT exist
     return;
 
+  unfreezeParam();
   id_list_.erase(it);
   delete[] data_list_[id];
   data_list_.erase(id);
@@ -112,17 +117,25 @@ bool GroupSyncWrite::changeParam(uint8_t id, uint8_t *data)
   if (it == id_list_.end())    // NOT exist
     return false;
 
-  delete[] data_list_[id];
-  data_list_[id]    = new uint8_t[data_length_];
   for (int c = 0; c < data_length_; c++)
     data_list_[id][c] = data[c];
 
+  if (is_frozen_ == true)
+  {
+    // patch the data in the frozen parameter
+    int idx = (it - id_list_.begin()) * (1 + data_length_) + 1;   // ID(1) + DATA(data_length)
+    for (int c = 0; c < data_length_; c++)
+      param_[idx + c] = data[c];
+  }
+
   is_param_changed_   = true;
   return true;
 }
 
 void GroupSyncWrite::clearParam()
 {
+  unfreezeParam();
+
   if (id_list_.size() == 0)
     return;
 
@@ -136,11 +149,82 @@ void GroupSyncWrite::clearParam()
   param_ = 0;
 }
 
+bool GroupSyncWrite::freezeParam()
+{
+  if (id_list_.size() == 0)
+    return false;
+
+  unfreezeParam();
+  makeParam();
+
+  uint16_t param_length   = id_list_.size() * (1 + data_length_);         // ID(1) + DATA(data_length)
+  uint16_t tx_length      = param_length + 14 + (param_length + 14) / 3;  // (length/3): consider stuffing
+
+  frozen_txpacket_ = new uint8_t[tx_length];
+
+  int result = ph_->makeSyncWriteTx(frozen_txpacket_, tx_length, start_address_, data_length_, param_, param_length);
+  if (result < 0)
+  {
+    unfreezeParam();
+    return false;
+  }
+
+  frozen_txpacket_length_ = (uint16_t)result;
+  is_frozen_              = true;
+  is_param_changed_       = false;
+  return true;
+}
+
+void GroupSyncWrite::unfreezeParam()
+{
+  if (frozen_txpacket_ != 0)
+    delete[] frozen_txpacket_;
+  frozen_txpacket_ = 0;
+
+  frozen_txpacket_length_ = 0;
+  is_frozen_              = false;
+}
+
+int GroupSyncWrite::getFrozenTxPacket(uint8_t **txpacket)
+{
+  if (is_frozen_ == false)
+    return COMM_NOT_AVAILABLE;
+
+  // re-make the packet only when the data was changed, in the buffer made by freezeParam()
+  if (is_param_changed_ == true)
+  {
+    uint16_t param_length = id_list_.size() * (1 + data_length_);
+    uint16_t tx_length    = param_length + 14 + (param_length + 14) / 3;
+
+    int result = ph_->makeSyncWriteTx(frozen_txpacket_, tx_length, start_address_, data_length_, param_, param_length);
+    if (result < 0)
+      return result;
+
+    frozen_txpacket_length_ = (uint16_t)result;
+    is_param_changed_       = false;
+  }
+
+  *txpacket = frozen_txpacket_;
+  return frozen_txpacket_length_;
+}
+
 int GroupSyncWrite::txPacket()
 {
   if (id_list_.size() == 0)
     return COMM_NOT_AVAILABLE;
 
+  if (is_frozen_ == true)
+  {
+    uint8_t *txpacket = 0;
+    int      result   = getFrozenTxPacket(&txpacket);
+    if (result < 0)
+      return result;
+
+    result = ph_->txPreparedPacket(port_, txpacket, (uint16_t)result);
+    port_->is_using_ = false;   // no status packet for Sync Write
+    return result;
+  }
+
   if (is_param_changed_ == true || param_ == 0)
     makeParam();
 
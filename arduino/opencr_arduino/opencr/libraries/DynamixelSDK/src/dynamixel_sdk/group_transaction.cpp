@@ -0,0 +1,206 @@
+/*******************************************************************************
+* Copyright (c) 2016, ROBOTIS CO., LTD.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* * Redistributions of source code must retain the above copyright notice, this
+*   list of conditions and the following disclaimer.
+*
+* * Redistributions in binary form must reproduce the above copyright notice,
+*   this list of conditions and the following disclaimer in the documentation
+*   and/or other materials provided with the distribution.
+*
+* * Neither the name of ROBOTIS nor the names of its
+*   contributors may be used to endorse or promote products derived from
+*   this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+#if defined(__linux__)
+#include "group_transaction.h"
+#elif defined(__APPLE__)
+#include "group_transaction.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include "group_transaction.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/group_transaction.h"
+#endif
+
+using namespace dynamixel;
+
+GroupTransaction::GroupTransaction(PortHandler *port, PacketHandler *ph, double period)
+  : port_(port),
+    ph_(ph),
+    period_(period),
+    tick_time_(0.0),
+    wire_time_(0.0)
+{
+  clearParam();
+}
+
+bool GroupTransaction::addOperation(uint8_t type, void *group)
+{
+  for (unsigned int i = 0; i < operation_list_.size(); i++)
+  {
+    if (operation_list_[i].group == group)   // group already exist
+      return false;
+  }
+
+  Operation operation;
+  operation.type  = type;
+  operation.group = group;
+  operation_list_.push_back(operation);
+
+  return true;
+}
+
+bool GroupTransaction::addSyncWrite(GroupSyncWrite *group)
+{
+  if (group->getPortHandler() != port_)
+    return false;
+
+  return addOperation(TRANSACTION_SYNC_WRITE, group);
+}
+
+bool GroupTransaction::addSyncRead(GroupSyncRead *group)
+{
+  if (group->getPortHandler() != port_)
+    return false;
+
+  return addOperation(TRANSACTION_SYNC_READ, group);
+}
+
+bool GroupTransaction::addBulkRead(GroupBulkRead *group)
+{
+  if (group->getPortHandler() != port_)
+    return false;
+
+  return addOperation(TRANSACTION_BULK_READ, group);
+}
+
+void GroupTransaction::clearParam()
+{
+  operation_list_.clear();
+  burst_.clear();
+}
+
+int GroupTransaction::txBurst(uint16_t rx_length)
+{
+  int burst_length = burst_.size();
+
+  port_->is_using_ = true;
+
+  // tx packets
+  port_->clearPort();
+  int written_length = port_->writePort(&burst_[0], burst_length);
+  burst_.clear();
+
+  if (burst_length != written_length)
+  {
+    port_->is_using_ = false;
+    return COMM_TX_FAIL;
+  }
+
+  // the status packets come after the whole burst is on the wire
+  if (rx_length > 0)
+    port_->setPacketTimeout((uint16_t)(burst_length + rx_length));
+  else
+    port_->is_using_ = false;
+
+  return COMM_SUCCESS;
+}
+
+int GroupTransaction::txRxPacket()
+{
+  if (operation_list_.size() == 0)
+    return COMM_NOT_AVAILABLE;
+
+  if (port_->is_using_)
+    return COMM_PORT_BUSY;
+
+  double    start_time  = port_->getCurrentTime();
+  uint32_t  wire_length = 0;
+  int       result      = COMM_SUCCESS;
+
+  burst_.clear();
+
+  for (unsigned int i = 0; i < operation_list_.size(); i++)
+  {
+    Operation &operation  = operation_list_[i];
+    uint8_t   *txpacket   = 0;
+    int        tx_length  = COMM_NOT_AVAILABLE;
+    uint16_t   rx_length  = 0;
+
+    switch (operation.type)
+    {
+      case TRANSACTION_SYNC_WRITE:
+        tx_length = ((GroupSyncWrite *)operation.group)->getFrozenTxPacket(&txpacket);
+        break;
+
+      case TRANSACTION_SYNC_READ:
+        tx_length = ((GroupSyncRead *)operation.group)->getFrozenTxPacket(&txpacket);
+        rx_length = ((GroupSyncRead *)operation.group)->getFrozenRxLength();
+        break;
+
+      case TRANSACTION_BULK_READ:
+        tx_length = ((GroupBulkRead *)operation.group)->getFrozenTxPacket(&txpacket);
+        rx_length = ((GroupBulkRead *)operation.group)->getFrozenRxLength();
+        break;
+    }
+
+    if (tx_length < 0)
+    {
+      if (result == COMM_SUCCESS)
+        result = tx_length;
+      continue;
+    }
+
+    // write-only packets wait in the burst for the instruction packet of the next read group
+    burst_.insert(burst_.end(), txpacket, txpacket + tx_length);
+    wire_length += tx_length;
+
+    if (operation.type == TRANSACTION_SYNC_WRITE)
+      continue;
+
+    int group_result = txBurst(rx_length);
+    if (group_result == COMM_SUCCESS)
+    {
+      wire_length += rx_length;
+
+      if (operation.type == TRANSACTION_SYNC_READ)
+        group_result = ((GroupSyncRead *)operation.group)->rxPacket();
+      else
+        group_result = ((GroupBulkRead *)operation.group)->rxPacket();
+    }
+
+    if (group_result != COMM_SUCCESS && result == COMM_SUCCESS)
+      result = group_result;
+  }
+
+  // write-only packets after the last read group
+  if (burst_.size() > 0)
+  {
+    int group_result = txBurst(0);
+    if (group_result != COMM_SUCCESS && result == COMM_SUCCESS)
+      result = group_result;
+  }
+
+  tick_time_ = port_->getCurrentTime() - start_time;
+  wire_time_ = (port_->getBaudRate() > 0) ? ((double)wire_length * 10.0 * 1000.0 / port_->getBaudRate()) : 0.0;
+
+  return result;
+}
@@ -45,8 +45,34 @@
 #include "../../include/dynamixel_sdk/port_handler_arduino.h"
 #endif
 
+#include <stdlib.h>
+#include <string.h>
+
 using namespace dynamixel;
 
+static const double rtt_bin_limit[RTT_HISTOGRAM_BIN_NUM] =
+{
+  0.1, 0.2, 0.3, 0.4, 0.5, 0.75, 1.0, 1.5, 2.0, 3.0, 4.0, 6.0, 8.0, 12.0, 16.0, 1000000.0
+};
+
+PortHandler::PortHandler()
+  : is_using_(false),
+    is_adaptive_timeout_(false),
+    is_fast_fail_(false),
+    rtt_id_(0xFF),
+    rtt_packet_length_(0),
+    rtt_start_time_(0.0)
+{
+  for (int id = 0; id < RTT_ID_NUM; id++)
+    rtt_stats_[id] = NULL;
+}
+
+PortHandler::~PortHandler()
+{
+  for (int id = 0; id < RTT_ID_NUM; id++)
+    delete rtt_stats_[id];
+}
+
 PortHandler *PortHandler::getPortHandler(const char *port_name)
 {
 #if defined(__linux__)
@@ -59,3 +85,147 @@ PortHandler *PortHandler::getPortHandler(const char *port_name)
   return (PortHandler *)(new PortHandlerArduino(port_name));
 #endif
 }
+
+bool PortHandler::waitForBytesAvailable()
+{
+  return true;
+}
+
+void PortHandler::setAdaptiveTimeout(bool enable, bool fast_fail)
+{
+  is_adaptive_timeout_ = enable;
+  is_fast_fail_        = fast_fail;
+}
+
+void PortHandler::setStatusPacketTimeout(uint8_t id, uint16_t packet_length)
+{
+  setPacketTimeout(packet_length);
+
+  rtt_id_             = id;
+  rtt_packet_length_  = packet_length;
+  rtt_start_time_     = getCurrentTime();
+
+  if (is_adaptive_timeout_ == false || id >= RTT_ID_NUM)
+    return;
+
+  RoundTripStats *stats = rtt_stats_[id];
+  if (stats == NULL || stats->sample_num < RTT_MIN_SAMPLE_NUM)
+    return;
+
+  // the device may have become slower (e.g. return delay time was changed): wait as long as the port handler does until it answers again.
+  // fast_fail does it once every RTT_PROBE_INTERVAL timeouts, so a missing device stays cheap and a slower one is measured again
+  if (is_fast_fail_ == false && stats->consecutive_timeout_count > 0)
+    return;
+  if (is_fast_fail_ == true && stats->consecutive_timeout_count > 0 && (stats->consecutive_timeout_count % RTT_PROBE_INTERVAL) == 0)
+    return;
+
+  double wire_time  = (10000.0 / (double)getBaudRate()) * (double)packet_length;
+  double latency    = getRoundTripTime(id, 99.0);
+
+  if (is_fast_fail_ == true)
+  {
+    // the margin follows the spread of the latency, so a port whose latency has a long tail is not cut at its 99th percentile
+    double margin = latency - getRoundTripTime(id, 50.0);
+    if (margin < 0.5)
+      margin = 0.5;
+    setPacketTimeout(wire_time + latency + margin);
+  }
+  else
+    setPacketTimeout(wire_time + (latency * 2.0) + 1.0);
+}
+
+void PortHandler::updateRoundTripTime(uint8_t id, bool is_received)
+{
+  if (id != rtt_id_ || id >= RTT_ID_NUM)
+    return;
+  rtt_id_ = 0xFF;
+
+  RoundTripStats *stats = rtt_stats_[id];
+  if (stats == NULL)
+  {
+    stats = new RoundTripStats;
+    memset(stats, 0, sizeof(RoundTripStats));
+    rtt_stats_[id] = stats;
+  }
+
+  if (is_received == false)
+  {
+    stats->timeout_count++;
+    if (stats->consecutive_timeout_count < 0xFFFF)
+      stats->consecutive_timeout_count++;
+    return;
+  }
+
+  double latency = getCurrentTime() - rtt_start_time_ - ((10000.0 / (double)getBaudRate()) * (double)rtt_packet_length_);
+  if (latency < 0.0)
+    latency = 0.0;
+
+  if (stats->count == 0 || latency < stats->min)
+    stats->min = latency;
+  if (stats->count == 0 || latency > stats->max)
+    stats->max = latency;
+  stats->count++;
+  stats->consecutive_timeout_count = 0;
+
+  // halve the histogram so that it follows the recent latency
+  if (stats->sample_num >= RTT_HISTOGRAM_WINDOW)
+  {
+    stats->sample_num = 0;
+    for (int bin = 0; bin < RTT_HISTOGRAM_BIN_NUM; bin++)
+    {
+      stats->histogram[bin] /= 2;
+      stats->sample_num += stats->histogram[bin];
+    }
+  }
+
+  int bin = 0;
+  while (bin < RTT_HISTOGRAM_BIN_NUM - 1 && latency >= rtt_bin_limit[bin])
+    bin++;
+  stats->histogram[bin]++;
+  stats->sample_num++;
+}
+
+const RoundTripStats *PortHandler::getRoundTripStats(uint8_t id)
+{
+  if (id >= RTT_ID_NUM)
+    return NULL;
+
+  return rtt_stats_[id];
+}
+
+double PortHandler::getRoundTripTime(uint8_t id, double percentile)
+{
+  if (id >= RTT_ID_NUM || rtt_stats_[id] == NULL || rtt_stats_[id]->sample_num == 0)
+    return -1.0;
+
+  RoundTripStats *stats = rtt_stats_[id];
+  double target = (double)stats->sample_num * percentile / 100.0;
+  uint32_t sum  = 0;
+
+  for (int bin = 0; bin < RTT_HISTOGRAM_BIN_NUM - 1; bin++)
+  {
+    sum += stats->histogram[bin];
+    if ((double)sum >= target)
+      return rtt_bin_limit[bin];
+  }
+
+  return stats->max;
+}
+
+void PortHandler::clearRoundTripStats()
+{
+  for (int id = 0; id < RTT_ID_NUM; id++)
+  {
+    delete rtt_stats_[id];
+    rtt_stats_[id] = NULL;
+  }
+  rtt_id_ = 0xFF;
+}
+
+double PortHandler::getRoundTripBinLimit(int bin)
+{
+  if (bin < 0 || bin >= RTT_HISTOGRAM_BIN_NUM)
+    return -1.0;
+
+  return rtt_bin_limit[bin];
+}
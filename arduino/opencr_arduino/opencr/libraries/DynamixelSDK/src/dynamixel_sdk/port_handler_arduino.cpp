@@ -196,12 +196,16 @@ int PortHandlerArduino::writePort(uint8_t *packet, int length)
 
 void PortHandlerArduino::setPacketTimeout(uint16_t packet_length)
 {
+  waitTxDone();
+
   packet_start_time_  = getCurrentTime();
   packet_timeout_     = (tx_time_per_byte * (double)packet_length) + (LATENCY_TIMER * 2.0) + 2.0;
 }
 
 void PortHandlerArduino::setPacketTimeout(double msec)
 {
+  waitTxDone();
+
   packet_start_time_  = getCurrentTime();
   packet_timeout_     = msec;
 }
@@ -217,9 +221,22 @@ bool PortHandlerArduino::isPacketTimeout()
   return false;
 }
 
+bool PortHandlerArduino::waitForBytesAvailable()
+{
+  double remaining_time = packet_timeout_ - getTimeSinceStart();
+  if (remaining_time <= 0.0)
+    return false;
+
+#if defined(__OPENCR__)
+  return DYNAMIXEL_SERIAL.waitAvailable((uint32_t)(remaining_time * 1000.0));
+#else
+  return true;
+#endif
+}
+
 double PortHandlerArduino::getCurrentTime()
 {
-	return (double)millis();
+	return (double)micros() / 1000.0;
 }
 
 double PortHandlerArduino::getTimeSinceStart()
@@ -305,4 +322,13 @@ void PortHandlerArduino::setTxDisable()
 #endif
 }
 
+void PortHandlerArduino::waitTxDone()
+{
+  // the status packet can't start before the instruction packet has left, so its timeout counts from the last stop bit
+#if defined(__OPENCR__)
+  if (drv_dxl_tx_done() != TRUE)
+    DYNAMIXEL_SERIAL.flush();
+#endif
+}
+
 #endif
@@ -39,6 +39,7 @@
 #include <termios.h>
 #include <time.h>
 #include <sys/time.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <linux/serial.h>
 
@@ -150,6 +151,24 @@ bool PortHandlerLinux::isPacketTimeout()
   return false;
 }
 
+bool PortHandlerLinux::waitForBytesAvailable()
+{
+  double remaining_time = packet_timeout_ - getTimeSinceStart();
+  if(remaining_time <= 0.0)
+    return false;
+
+  struct pollfd   pfd;
+  struct timespec ts;
+
+  pfd.fd      = socket_fd_;
+  pfd.events  = POLLIN;
+  pfd.revents = 0;
+  ts.tv_sec   = (time_t)(remaining_time / 1000.0);
+  ts.tv_nsec  = (long)((remaining_time - (double)ts.tv_sec * 1000.0) * 1000000.0);
+
+  return (ppoll(&pfd, 1, &ts, NULL) > 0);
+}
+
 double PortHandlerLinux::getCurrentTime()
 {
 	struct timespec tv;
@@ -39,6 +39,7 @@
 #include <termios.h>
 #include <time.h>
 #include <sys/time.h>
+#include <sys/select.h>
 #include <sys/ioctl.h>
 
 #include "port_handler_mac.h"
@@ -149,6 +150,23 @@ bool PortHandlerMac::isPacketTimeout()
   return false;
 }
 
+bool PortHandlerMac::waitForBytesAvailable()
+{
+  double remaining_time = packet_timeout_ - getTimeSinceStart();
+  if(remaining_time <= 0.0)
+    return false;
+
+  fd_set          rfds;
+  struct timeval  tv;
+
+  FD_ZERO(&rfds);
+  FD_SET(socket_fd_, &rfds);
+  tv.tv_sec   = (time_t)(remaining_time / 1000.0);
+  tv.tv_usec  = (suseconds_t)((remaining_time - (double)tv.tv_sec * 1000.0) * 1000.0);
+
+  return (select(socket_fd_ + 1, &rfds, NULL, NULL, &tv) > 0);
+}
+
 double PortHandlerMac::getCurrentTime()
 {
 	struct timespec tv;
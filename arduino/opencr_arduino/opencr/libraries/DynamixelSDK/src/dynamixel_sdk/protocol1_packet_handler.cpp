@@ -155,6 +155,27 @@ void Protocol1PacketHandler::printRxPacketError(uint8_t error)
 #endif
 }
 
+int Protocol1PacketHandler::makeTxPacket(uint8_t *txpacket, uint16_t buffer_length)
+{
+  uint8_t checksum               = 0;
+  uint16_t total_packet_length   = txpacket[PKT_LENGTH] + 4; // 4: HEADER0 HEADER1 ID LENGTH
+
+  // check max packet length
+  if (total_packet_length > TXPACKET_MAX_LEN || total_packet_length > buffer_length)
+    return COMM_TX_ERROR;
+
+  // make packet header
+  txpacket[PKT_HEADER0]   = 0xFF;
+  txpacket[PKT_HEADER1]   = 0xFF;
+
+  // add a checksum to the packet
+  for (int idx = 2; idx < total_packet_length - 1; idx++)   // except header, checksum
+    checksum += txpacket[idx];
+  txpacket[total_packet_length - 1] = ~checksum;
+
+  return total_packet_length;
+}
+
 int Protocol1PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
 {
   uint8_t checksum               = 0;
@@ -193,111 +214,136 @@ int Protocol1PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
   return COMM_SUCCESS;
 }
 
+// check if the byte can be placed at position pos of a status packet header
+static bool isValidStatusByte(uint16_t pos, uint8_t data)
+{
+  switch (pos)
+  {
+    case PKT_HEADER0:
+    case PKT_HEADER1:
+      return (data == 0xFF);
+
+    case PKT_ID:
+      return (data <= 0xFD);                        // unavailable ID
+
+    case PKT_LENGTH:
+      return (data >= 2 && data + PKT_LENGTH + 1 <= RXPACKET_MAX_LEN);  // unavailable Length (ERROR CHKSUM)
+
+    case PKT_ERROR:
+      return (data < 0x64);                         // unavailable Error
+
+    default:
+      return true;
+  }
+}
+
+// append a received byte to the status packet
+// if the byte breaks the header, the header bytes already accepted are re-parsed from the next byte,
+// so a corrupted byte costs at most one header length of work.
+static void feedStatusByte(uint8_t *rxpacket, uint16_t &rx_length, uint8_t data)
+{
+  if (isValidStatusByte(rx_length, data) == true)
+  {
+    rxpacket[rx_length++] = data;
+    return;
+  }
+
+  if (rx_length == 0)
+    return;
+
+  uint8_t   replay[PKT_ERROR];
+  uint16_t  replay_length = rx_length - 1;
+
+  for (uint16_t s = 0; s < replay_length; s++)
+    replay[s] = rxpacket[1 + s];
+
+  rx_length = 0;
+  for (uint16_t s = 0; s < replay_length; s++)
+    feedStatusByte(rxpacket, rx_length, replay[s]);
+  feedStatusByte(rxpacket, rx_length, data);
+}
+
 int Protocol1PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
+{
+  return rxPacket(port, rxpacket, RXPACKET_MAX_LEN);
+}
+
+int Protocol1PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket, uint16_t rxpacket_length)
 {
   int     result         = COMM_TX_FAIL;
 
   uint8_t checksum       = 0;
-  uint8_t rx_length      = 0;
-  uint8_t wait_length    = 6;    // minimum length (HEADER0 HEADER1 ID LENGTH ERROR CHKSUM)
+  uint16_t rx_length     = 0;
+  uint16_t wait_length   = 6;    // minimum length (HEADER0 HEADER1 ID LENGTH ERROR CHKSUM)
 
   while(true)
   {
-    rx_length += port->readPort(&rxpacket[rx_length], wait_length - rx_length);
-    if (rx_length >= wait_length)
+    int read_length = port->readPort(&rxpacket[rx_length], wait_length - rx_length);
+
+    if (read_length > 0)
     {
-      uint8_t idx = 0;
+      uint16_t read_end = rx_length + read_length;
 
-      // find packet header
-      for (idx = 0; idx < (rx_length - 1); idx++)
+      if (rx_length > PKT_ERROR)
       {
-        if (rxpacket[idx] == 0xFF && rxpacket[idx+1] == 0xFF)
-          break;
+        // header is already verified, parameter bytes are taken as they are
+        rx_length = read_end;
       }
-
-      if (idx == 0)   // found at the beginning of the packet
+      else
       {
-        if (rxpacket[PKT_ID] > 0xFD ||                  // unavailable ID
-           rxpacket[PKT_LENGTH] > RXPACKET_MAX_LEN ||   // unavailable Length
-           rxpacket[PKT_ERROR] >= 0x64)                 // unavailable Error
-        {
-            // remove the first byte in the packet
-            for (uint8_t s = 0; s < rx_length - 1; s++)
-              rxpacket[s] = rxpacket[1 + s];
-            //memcpy(&rxpacket[0], &rxpacket[idx], rx_length - idx);
-            rx_length -= 1;
-            continue;
-        }
+        // parse only the newly arrived bytes. accepted bytes are compacted in place
+        for (uint16_t idx = rx_length; idx < read_end; idx++)
+          feedStatusByte(rxpacket, rx_length, rxpacket[idx]);
 
         // re-calculate the exact length of the rx packet
-        if (wait_length != rxpacket[PKT_LENGTH] + PKT_LENGTH + 1)
-        {
+        if (rx_length > PKT_ERROR)
           wait_length = rxpacket[PKT_LENGTH] + PKT_LENGTH + 1;
-          continue;
-        }
 
-        if (rx_length < wait_length)
+        // a status packet longer than the buffer of the caller is not received
+        if (wait_length > rxpacket_length)
         {
-          // check timeout
-          if (port->isPacketTimeout() == true)
-          {
-            if (rx_length == 0)
-            {
-              result = COMM_RX_TIMEOUT;
-            }
-            else
-            {
-              result = COMM_RX_CORRUPT;
-            }
-            break;
-          }
-          else
-          {
-            continue;
-          }
+          result = COMM_RX_CORRUPT;
+          break;
         }
+      }
+    }
 
-        // calculate checksum
-        for (int i = 2; i < wait_length - 1; i++)   // except header, checksum
-          checksum += rxpacket[i];
-        checksum = ~checksum;
+    if (rx_length >= wait_length)
+    {
+      // calculate checksum
+      for (int i = 2; i < wait_length - 1; i++)   // except header, checksum
+        checksum += rxpacket[i];
+      checksum = ~checksum;
 
-        // verify checksum
-        if (rxpacket[wait_length - 1] == checksum)
-        {
-          result = COMM_SUCCESS;
-        }
-        else
-        {
-          result = COMM_RX_CORRUPT;
-        }
-        break;
+      // verify checksum
+      if (rxpacket[wait_length - 1] == checksum)
+      {
+        result = COMM_SUCCESS;
       }
       else
       {
-        // remove unnecessary packets
-        for (uint8_t s = 0; s < rx_length - idx; s++)
-          rxpacket[s] = rxpacket[idx + s];
-        //memcpy(&rxpacket[0], &rxpacket[idx], rx_length - idx);
-        rx_length -= idx;
+        result = COMM_RX_CORRUPT;
       }
+      break;
     }
-    else
+
+    // check timeout
+    if (port->isPacketTimeout() == true)
     {
-      // check timeout
-      if (port->isPacketTimeout() == true)
+      if (rx_length == 0)
       {
-        if (rx_length == 0)
-        {
-          result = COMM_RX_TIMEOUT;
-        }
-        else
-        {
-          result = COMM_RX_CORRUPT;
-        }
-        break;
+        result = COMM_RX_TIMEOUT;
       }
+      else
+      {
+        result = COMM_RX_CORRUPT;
+      }
+      break;
     }
+
+    // sleep until the port has new data instead of spinning on readPort
+    if (read_length <= 0)
+      port->waitForBytesAvailable();
   }
   port->is_using_ = false;
 
@@ -326,11 +372,11 @@ int Protocol1PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
     // set packet timeout
     if (txpacket[PKT_INSTRUCTION] == INST_READ)
     {
-      port->setPacketTimeout((uint16_t)(txpacket[PKT_PARAMETER0+1] + 6));
+      port->setStatusPacketTimeout(txpacket[PKT_ID], (uint16_t)(txpacket[PKT_PARAMETER0+1] + 6));
     }
     else
     {
-      port->setPacketTimeout((uint16_t)6);
+      port->setStatusPacketTimeout(txpacket[PKT_ID], (uint16_t)6);
     }
 
     // rx packet
@@ -339,6 +385,9 @@ int Protocol1PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
     if (txpacket[PKT_ID] != rxpacket[PKT_ID])
       result = rxPacket(port, rxpacket);
 
+    if (result == COMM_RX_TIMEOUT || (result == COMM_SUCCESS && txpacket[PKT_ID] == rxpacket[PKT_ID]))
+      port->updateRoundTripTime(txpacket[PKT_ID], result == COMM_SUCCESS);
+
     if (result == COMM_SUCCESS && txpacket[PKT_ID] != BROADCAST_ID)
     {
       if (error != 0)
@@ -347,6 +396,26 @@ int Protocol1PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
     return result;
 }
 
+int Protocol1PacketHandler::txPreparedPacket(PortHandler *port, uint8_t *txpacket, uint16_t packet_length)
+{
+  uint16_t written_packet_length = 0;
+
+  if (port->is_using_)
+    return COMM_PORT_BUSY;
+  port->is_using_ = true;
+
+  // tx packet
+  port->clearPort();
+  written_packet_length = port->writePort(txpacket, packet_length);
+  if (packet_length != written_packet_length)
+  {
+    port->is_using_ = false;
+    return COMM_TX_FAIL;
+  }
+
+  return COMM_SUCCESS;
+}
+
 int Protocol1PacketHandler::ping(PortHandler *port, uint8_t id, uint8_t *error)
 {
   UNUSED(port);
@@ -389,6 +458,98 @@ int Protocol1PacketHandler::broadcastPing(PortHandler *port, std::vector<uint8_t
   return COMM_NOT_AVAILABLE;
 }
 
+int Protocol1PacketHandler::broadcastPing(PortHandler *port, uint8_t max_id, std::vector<uint8_t> &id_list, std::vector<uint16_t> &model_list, std::vector<uint8_t> &firmware_list)
+{
+  int result                  = COMM_TX_FAIL;
+
+  uint8_t txpacket[6]         = {0};
+  uint8_t rxpacket[6]         = {0};
+
+  // instruction(6) + status(6) on the wire, the longest return delay time (508us) and 1ms of margin
+  double  wire_timeout        = (1000.0 / (double)port->getBaudRate()) * 10.0 * 12 + 0.508 + 1.0;
+  bool    is_wire_timeout     = true;
+
+  id_list.clear();
+  model_list.clear();
+  firmware_list.clear();
+
+  if (max_id > MAX_ID)
+    max_id = MAX_ID;
+
+  // Protocol 1.0 has no broadcast ping, so each ID is pinged waiting only for the time on the wire.
+  // A status arriving later means the port adds latency (e.g. USB latency timer):
+  // the ID is pinged again and the rest wait for the normal packet timeout.
+  for (int id = 0; id <= max_id + 1; id++)
+  {
+    if (is_wire_timeout == true && id > 0)
+    {
+      if (id == max_id + 1)
+      {
+        port->setPacketTimeout((uint16_t)6);
+        while (port->getBytesAvailable() == 0 && port->isPacketTimeout() == false)
+          port->waitForBytesAvailable();
+      }
+
+      if (port->getBytesAvailable() > 0)
+      {
+        is_wire_timeout = false;
+        id -= 2;
+        continue;
+      }
+    }
+
+    if (id == max_id + 1)
+      break;
+
+    txpacket[PKT_ID]            = (uint8_t)id;
+    txpacket[PKT_LENGTH]        = 2;
+    txpacket[PKT_INSTRUCTION]   = INST_PING;
+
+    result = txPacket(port, txpacket);
+    if (result != COMM_SUCCESS)
+    {
+      port->is_using_ = false;
+      return result;
+    }
+
+    if (is_wire_timeout == true)
+      port->setPacketTimeout(wire_timeout);
+    else
+      port->setPacketTimeout((uint16_t)6);
+
+    result = rxPacket(port, rxpacket);
+    while (result == COMM_SUCCESS && rxpacket[PKT_ID] != id)
+    {
+      if (is_wire_timeout == true)
+        break;
+      result = rxPacket(port, rxpacket);    // skip late status packets of the pings before
+    }
+
+    if (result == COMM_SUCCESS && rxpacket[PKT_ID] < id && is_wire_timeout == true)
+    {
+      is_wire_timeout = false;
+      id = rxpacket[PKT_ID] - 1;
+      continue;
+    }
+    if (result != COMM_SUCCESS || rxpacket[PKT_ID] != id)
+      continue;
+
+    // Address 0 : Model Number, Address 2 : Firmware Version
+    uint8_t data_read[3] = {0};
+    if (readTxRx(port, (uint8_t)id, 0, 3, data_read) == COMM_SUCCESS)
+    {
+      id_list.push_back((uint8_t)id);
+      model_list.push_back(DXL_MAKEWORD(data_read[0], data_read[1]));
+      firmware_list.push_back(data_read[2]);
+    }
+  }
+
+  if (id_list.size() == 0)
+    return COMM_RX_TIMEOUT;
+
+  return COMM_SUCCESS;
+}
+
 int Protocol1PacketHandler::action(PortHandler *port, uint8_t id)
 {
   uint8_t txpacket[6]         = {0};
@@ -472,6 +633,26 @@ int Protocol1PacketHandler::readRx(PortHandler *port, uint16_t length, uint8_t *
   return result;
 }
 
+int Protocol1PacketHandler::readRx(PortHandler *port, uint16_t length, uint8_t *data, uint8_t *error, uint8_t *rxpacket, uint16_t rxpacket_length)
+{
+  int result                 = COMM_TX_FAIL;
+
+  result = rxPacket(port, rxpacket, rxpacket_length);
+  if (result == COMM_SUCCESS)
+  {
+    if (error != 0)
+    {
+      *error = (uint8_t)rxpacket[PKT_ERROR];
+    }
+    for (uint16_t s = 0; s < length; s++)
+    {
+      data[s] = rxpacket[PKT_PARAMETER0 + s];
+    }
+  }
+
+  return result;
+}
+
 int Protocol1PacketHandler::readTxRx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error)
 {
   int result = COMM_TX_FAIL;
@@ -774,3 +955,50 @@ int Protocol1PacketHandler::bulkWriteTxOnly(PortHandler *port, uint8_t *param, u
 
   return COMM_NOT_AVAILABLE;
 }
+
+int Protocol1PacketHandler::makeSyncReadTx(uint8_t *txpacket, uint16_t buffer_length, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
+{
+  UNUSED(txpacket);
+  UNUSED(buffer_length);
+  UNUSED(start_address);
+  UNUSED(data_length);
+  UNUSED(param);
+  UNUSED(param_length);
+
+  return COMM_NOT_AVAILABLE;
+}
+
+int Protocol1PacketHandler::makeSyncWriteTx(uint8_t *txpacket, uint16_t buffer_length, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
+{
+  if (param_length + 8 > buffer_length)
+    return COMM_TX_ERROR;
+  // 8: HEADER0 HEADER1 ID LEN INST START_ADDR DATA_LEN ... CHKSUM
+
+  txpacket[PKT_ID]            = BROADCAST_ID;
+  txpacket[PKT_LENGTH]        = param_length + 4; // 4: INST START_ADDR DATA_LEN ... CHKSUM
+  txpacket[PKT_INSTRUCTION]   = INST_SYNC_WRITE;
+  txpacket[PKT_PARAMETER0+0]  = start_address;
+  txpacket[PKT_PARAMETER0+1]  = data_length;
+
+  for (uint16_t s = 0; s < param_length; s++)
+    txpacket[PKT_PARAMETER0+2+s] = param[s];
+
+  return makeTxPacket(txpacket, buffer_length);
+}
+
+int Protocol1PacketHandler::makeBulkReadTx(uint8_t *txpacket, uint16_t buffer_length, uint8_t *param, uint16_t param_length)
+{
+  if (param_length + 7 > buffer_length)
+    return COMM_TX_ERROR;
+  // 7: HEADER0 HEADER1 ID LEN INST 0x00 ... CHKSUM
+
+  txpacket[PKT_ID]            = BROADCAST_ID;
+  txpacket[PKT_LENGTH]        = param_length + 3; // 3: INST 0x00 ... CHKSUM
+  txpacket[PKT_INSTRUCTION]   = INST_BULK_READ;
+  txpacket[PKT_PARAMETER0+0]  = 0x00;
+
+  for (uint16_t s = 0; s < param_length; s++)
+    txpacket[PKT_PARAMETER0+1+s] = param[s];
+
+  return makeTxPacket(txpacket, buffer_length);
+}
@@ -32,13 +32,17 @@
 
 #if defined(__linux__)
 #include "protocol2_packet_handler.h"
+#include "crc16.h"
 #elif defined(__APPLE__)
 #include "protocol2_packet_handler.h"
+#include "crc16.h"
 #elif defined(_WIN32) || defined(_WIN64)
 #define WINDLLEXPORT
 #include "protocol2_packet_handler.h"
+#include "crc16.h"
 #elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
 #include "../../include/dynamixel_sdk/protocol2_packet_handler.h"
+#include "../../include/dynamixel_sdk/crc16.h"
 #endif
 
 #include <stdio.h>
@@ -181,135 +185,50 @@ void Protocol2PacketHandler::printRxPacketError(uint8_t error)
 
 unsigned short Protocol2PacketHandler::updateCRC(uint16_t crc_accum, uint8_t *data_blk_ptr, uint16_t data_blk_size)
 {
-  uint16_t i;
-  uint16_t crc_table[256] = {0x0000,
-  0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011,
-  0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027,
-  0x0022, 0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D,
-  0x8077, 0x0072, 0x0050, 0x8055, 0x805F, 0x005A, 0x804B,
-  0x004E, 0x0044, 0x8041, 0x80C3, 0x00C6, 0x00CC, 0x80C9,
-  0x00D8, 0x80DD, 0x80D7, 0x00D2, 0x00F0, 0x80F5, 0x80FF,
-  0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1, 0x00A0, 0x80A5,
-  0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1, 0x8093,
-  0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082,
-  0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197,
-  0x0192, 0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE,
-  0x01A4, 0x81A1, 0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB,
-  0x01FE, 0x01F4, 0x81F1, 0x81D3, 0x01D6, 0x01DC, 0x81D9,
-  0x01C8, 0x81CD, 0x81C7, 0x01C2, 0x0140, 0x8145, 0x814F,
-  0x014A, 0x815B, 0x015E, 0x0154, 0x8151, 0x8173, 0x0176,
-  0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162, 0x8123,
-  0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132,
-  0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104,
-  0x8101, 0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D,
-  0x8317, 0x0312, 0x0330, 0x8335, 0x833F, 0x033A, 0x832B,
-  0x032E, 0x0324, 0x8321, 0x0360, 0x8365, 0x836F, 0x036A,
-  0x837B, 0x037E, 0x0374, 0x8371, 0x8353, 0x0356, 0x035C,
-  0x8359, 0x0348, 0x834D, 0x8347, 0x0342, 0x03C0, 0x83C5,
-  0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1, 0x83F3,
-  0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2,
-  0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7,
-  0x03B2, 0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E,
-  0x0384, 0x8381, 0x0280, 0x8285, 0x828F, 0x028A, 0x829B,
-  0x029E, 0x0294, 0x8291, 0x82B3, 0x02B6, 0x02BC, 0x82B9,
-  0x02A8, 0x82AD, 0x82A7, 0x02A2, 0x82E3, 0x02E6, 0x02EC,
-  0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2, 0x02D0, 0x82D5,
-  0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1, 0x8243,
-  0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252,
-  0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264,
-  0x8261, 0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E,
-  0x0234, 0x8231, 0x8213, 0x0216, 0x021C, 0x8219, 0x0208,
-  0x820D, 0x8207, 0x0202 };
-
-  for (uint16_t j = 0; j < data_blk_size; j++)
-  {
-    i = ((uint16_t)(crc_accum >> 8) ^ *data_blk_ptr++) & 0xFF;
-    crc_accum = (crc_accum << 8) ^ crc_table[i];
-  }
-
-  return crc_accum;
+  return updateCRC16(crc_accum, data_blk_ptr, data_blk_size);
 }
 
-void Protocol2PacketHandler::addStuffing(uint8_t *packet)
+bool Protocol2PacketHandler::addStuffing(uint8_t *packet, uint16_t buffer_length)
 {
-  int i = 0, index = 0;
   int packet_length_in = DXL_MAKEWORD(packet[PKT_LENGTH_L], packet[PKT_LENGTH_H]);
-  int packet_length_out = packet_length_in;
-  uint8_t temp[TXPACKET_MAX_LEN] = {0};
-
-  for (uint8_t s = PKT_HEADER0; s <= PKT_LENGTH_H; s++)
-    temp[s] = packet[s]; // FF FF FD XX ID LEN_L LEN_H
-  //memcpy(temp, packet, PKT_LENGTH_H+1);
-  index = PKT_INSTRUCTION;
-  for (i = 0; i < packet_length_in - 2; i++)  // except CRC
+  int stuffing_count = 0;
+
+  for (int i = PKT_INSTRUCTION; i < PKT_INSTRUCTION + packet_length_in - 2; i++)  // except CRC
   {
-    temp[index++] = packet[i+PKT_INSTRUCTION];
-    if (packet[i+PKT_INSTRUCTION] == 0xFD && packet[i+PKT_INSTRUCTION-1] == 0xFF && packet[i+PKT_INSTRUCTION-2] == 0xFF)
-    {   // FF FF FD
-      temp[index++] = 0xFD;
-      packet_length_out++;
-    }
+    if (packet[i] == 0xFD && packet[i-1] == 0xFF && packet[i-2] == 0xFF)
+      stuffing_count++;   // FF FF FD
   }
-  temp[index++] = packet[PKT_INSTRUCTION+packet_length_in-2];
-  temp[index++] = packet[PKT_INSTRUCTION+packet_length_in-1];
-
-
-  //////////////////////////
-  if (packet_length_in != packet_length_out)
-    packet = (uint8_t *)realloc(packet, index * sizeof(uint8_t));
-
-  ///////////////////////////
-
-  for (uint8_t s = 0; s < index; s++)
-    packet[s] = temp[s];
-  //memcpy(packet, temp, index);
-  packet[PKT_LENGTH_L] = DXL_LOBYTE(packet_length_out);
-  packet[PKT_LENGTH_H] = DXL_HIBYTE(packet_length_out);
-}
 
-void Protocol2PacketHandler::removeStuffing(uint8_t *packet)
-{
-  int i = 0, index = 0;
-  int packet_length_in = DXL_MAKEWORD(packet[PKT_LENGTH_L], packet[PKT_LENGTH_H]);
-  int packet_length_out = packet_length_in;
+  if (packet_length_in + stuffing_count + 7 > buffer_length)
+    return false;
 
-  index = PKT_INSTRUCTION;
-  for (i = 0; i < packet_length_in - 2; i++)  // except CRC
+  // expand from the tail, so the packet is stuffed in place without a temporary buffer
+  int n = stuffing_count;
+  for (int i = PKT_INSTRUCTION + packet_length_in - 3; i >= PKT_INSTRUCTION && n > 0; i--)
   {
-    if (packet[i+PKT_INSTRUCTION] == 0xFD && packet[i+PKT_INSTRUCTION+1] == 0xFD && packet[i+PKT_INSTRUCTION-1] == 0xFF && packet[i+PKT_INSTRUCTION-2] == 0xFF)
-    {   // FF FF FD FD
-      packet_length_out--;
-      i++;
-    }
-    packet[index++] = packet[i+PKT_INSTRUCTION];
+    if (packet[i] == 0xFD && packet[i-1] == 0xFF && packet[i-2] == 0xFF)
+      packet[i + n--] = 0xFD;
+    packet[i + n] = packet[i];
   }
-  packet[index++] = packet[PKT_INSTRUCTION+packet_length_in-2];
-  packet[index++] = packet[PKT_INSTRUCTION+packet_length_in-1];
 
-  packet[PKT_LENGTH_L] = DXL_LOBYTE(packet_length_out);
-  packet[PKT_LENGTH_H] = DXL_HIBYTE(packet_length_out);
+  packet[PKT_LENGTH_L] = DXL_LOBYTE(packet_length_in + stuffing_count);
+  packet[PKT_LENGTH_H] = DXL_HIBYTE(packet_length_in + stuffing_count);
+  return true;
 }
 
-int Protocol2PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
+int Protocol2PacketHandler::makeTxPacket(uint8_t *txpacket, uint16_t buffer_length)
 {
-  uint16_t total_packet_length   = 0;
-  uint16_t written_packet_length = 0;
-
-  if (port->is_using_)
-    return COMM_PORT_BUSY;
-  port->is_using_ = true;
+  uint16_t total_packet_length = 0;
 
   // byte stuffing for header
-  addStuffing(txpacket);
+  if (addStuffing(txpacket, buffer_length) == false)
+    return COMM_TX_ERROR;
 
   // check max packet length
   total_packet_length = DXL_MAKEWORD(txpacket[PKT_LENGTH_L], txpacket[PKT_LENGTH_H]) + 7;
   // 7: HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H
   if (total_packet_length > TXPACKET_MAX_LEN)
-  {
-    port->is_using_ = false;
     return COMM_TX_ERROR;
-  }
 
   // make packet header
   txpacket[PKT_HEADER0]   = 0xFF;
@@ -322,126 +241,289 @@ int Protocol2PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
   txpacket[total_packet_length - 2] = DXL_LOBYTE(crc);
   txpacket[total_packet_length - 1] = DXL_HIBYTE(crc);
 
-  // tx packet
-  port->clearPort();
-  written_packet_length = port->writePort(txpacket, total_packet_length);
+  return total_packet_length;
+}
 
-  if (total_packet_length != written_packet_length)
+// state of the byte stuffing pattern after data
+// 0: none, 1: FF, 2: FF FF, 3: FF FF FD (0xFD should be stuffed after this)
+static uint8_t getStuffingState(uint8_t state, uint8_t data)
+{
+  if (data == 0xFF)
+    return (state == 1 || state == 2) ? 2 : 1;
+  if (data == 0xFD && state == 2)
+    return 3;
+  return 0;
+}
+
+static uint16_t countStuffing(uint8_t &state, uint8_t *data, uint16_t length)
+{
+  uint16_t stuffing_count = 0;
+
+  for (uint16_t s = 0; s < length; s++)
   {
-    port->is_using_ = false;
-    return COMM_TX_FAIL;
+    state = getStuffingState(state, data[s]);
+    if (state == 3)
+    {
+      stuffing_count++;
+      state = 0;    // the stuffed 0xFD breaks the pattern
+    }
   }
 
-  return COMM_SUCCESS;
+  return stuffing_count;
+}
+
+static uint16_t writeStuffing(uint8_t *packet, uint16_t index, uint8_t &state, uint16_t &crc, uint8_t *data, uint16_t length)
+{
+  for (uint16_t s = 0; s < length; s++)
+  {
+    packet[index++] = data[s];
+    crc = updateCRC16(crc, data[s]);
+
+    state = getStuffingState(state, data[s]);
+    if (state == 3)
+    {
+      packet[index++] = 0xFD;
+      crc = updateCRC16(crc, (uint8_t)0xFD);
+      state = 0;
+    }
+  }
+
+  return index;
+}
+
+int Protocol2PacketHandler::makePacket(uint8_t *txpacket, uint16_t buffer_length, uint8_t id, uint8_t instruction,
+                                       uint8_t *prefix, uint16_t prefix_length, uint8_t *param, uint16_t param_length)
+{
+  uint8_t  state          = 0;
+  uint16_t stuffing_count = 0;
+  uint16_t index          = 0;
+  uint16_t crc            = 0;
+
+  // count the stuffing first, so the length is known before the header goes into CRC16
+  stuffing_count += countStuffing(state, prefix, prefix_length);
+  stuffing_count += countStuffing(state, param, param_length);
+
+  uint16_t packet_length       = 1 + prefix_length + param_length + stuffing_count + 2;   // INST PARAM CRC16_L CRC16_H
+  uint16_t total_packet_length = packet_length + 7;
+  // 7: HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H
+  if (total_packet_length > TXPACKET_MAX_LEN || total_packet_length > buffer_length)
+    return COMM_TX_ERROR;
+
+  // make packet header
+  txpacket[PKT_HEADER0]     = 0xFF;
+  txpacket[PKT_HEADER1]     = 0xFF;
+  txpacket[PKT_HEADER2]     = 0xFD;
+  txpacket[PKT_RESERVED]    = 0x00;
+  txpacket[PKT_ID]          = id;
+  txpacket[PKT_LENGTH_L]    = DXL_LOBYTE(packet_length);
+  txpacket[PKT_LENGTH_H]    = DXL_HIBYTE(packet_length);
+  txpacket[PKT_INSTRUCTION] = instruction;
+  crc = updateCRC(0, txpacket, PKT_INSTRUCTION + 1);
+
+  // copy parameters with byte stuffing and CRC16 in one pass
+  state = 0;
+  index = writeStuffing(txpacket, PKT_PARAMETER0, state, crc, prefix, prefix_length);
+  index = writeStuffing(txpacket, index, state, crc, param, param_length);
+
+  // add CRC16
+  txpacket[index++] = DXL_LOBYTE(crc);
+  txpacket[index++] = DXL_HIBYTE(crc);
+
+  return total_packet_length;
+}
+
+int Protocol2PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
+{
+  int total_packet_length = 0;
+
+  if (port->is_using_)
+    return COMM_PORT_BUSY;
+
+  // byte stuffing in place, header and CRC16
+  total_packet_length = makeTxPacket(txpacket, TXPACKET_MAX_LEN);
+  if (total_packet_length < 0)
+    return total_packet_length;
+
+  return txPreparedPacket(port, txpacket, (uint16_t)total_packet_length);
+}
+
+// check if the byte can be placed at position pos of a status packet header
+static bool isValidStatusByte(uint8_t *rxpacket, uint16_t pos, uint8_t data)
+{
+  switch (pos)
+  {
+    case PKT_HEADER0:
+    case PKT_HEADER1:
+      return (data == 0xFF);
+
+    case PKT_HEADER2:
+      return (data == 0xFD);
+
+    case PKT_RESERVED:
+      return (data == 0x00);
+
+    case PKT_ID:
+      return (data <= 0xFC);
+
+    case PKT_LENGTH_H:
+    {
+      uint16_t length = DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], data);
+      return (length >= 4 && length + PKT_LENGTH_H + 1 <= RXPACKET_MAX_LEN);  // INST ERROR CRC16_L CRC16_H
+    }
+
+    case PKT_INSTRUCTION:
+      return (data == INST_STATUS);
+
+    default:
+      return true;
+  }
 }
 
 int Protocol2PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
+{
+  return rxPacket(port, rxpacket, RXPACKET_MAX_LEN);
+}
+
+int Protocol2PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket, uint16_t rxpacket_length)
 {
   int     result         = COMM_TX_FAIL;
 
-  uint16_t rx_length     = 0;
+  uint16_t rx_length     = 0;  // length of the packet in rxpacket, without stuffing. 0 until the header is complete
+  uint16_t wire_length   = 0;  // length of the packet received from the port, with stuffing
   uint16_t wait_length   = 11; // minimum length (HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H INST ERROR CRC16_L CRC16_H)
+  uint16_t head          = 0;  // start of the header candidate in rxpacket
+  uint16_t header_end    = 0;  // end of the bytes read for the header candidate
+  uint16_t checked       = 0;  // header bytes of the candidate found valid
+  uint16_t crc           = 0;
+  uint8_t  state         = 0;  // byte stuffing pattern in the parameter
 
   while(true)
   {
-    rx_length += port->readPort(&rxpacket[rx_length], wait_length - rx_length);
-    if (rx_length >= wait_length)
-    {
-      uint16_t idx = 0;
+    int      read_length;
+    uint16_t idx         = rx_length;
+    uint16_t read_end    = rx_length;
 
-      // find packet header
-      for (idx = 0; idx < (rx_length - 3); idx++)
+    if (rx_length == 0)
+    {
+      // the candidate is shorter than the header, so moving it to the front costs at most a header length per read
+      if (head > 0)
       {
-        if ((rxpacket[idx] == 0xFF) && (rxpacket[idx+1] == 0xFF) && (rxpacket[idx+2] == 0xFD) && (rxpacket[idx+3] != 0xFD))
-          break;
+        for (uint16_t s = head; s < header_end; s++)
+          rxpacket[s - head] = rxpacket[s];
+        header_end -= head;
+        head        = 0;
       }
 
-      if (idx == 0)   // found at the beginning of the packet
+      read_length = port->readPort(&rxpacket[header_end], wait_length - header_end);
+      if (read_length > 0)
       {
-        if (rxpacket[PKT_RESERVED] != 0x00 ||
-           rxpacket[PKT_ID] > 0xFC ||
-           DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) > RXPACKET_MAX_LEN ||
-           rxpacket[PKT_INSTRUCTION] != 0x55)
-        {
-          // remove the first byte in the packet
-          for (uint8_t s = 0; s < rx_length - 1; s++)
-            rxpacket[s] = rxpacket[1 + s];
-          //memcpy(&rxpacket[0], &rxpacket[idx], rx_length - idx);
-          rx_length -= 1;
-          continue;
-        }
-
-        // re-calculate the exact length of the rx packet
-        if (wait_length != DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) + PKT_LENGTH_H + 1)
-        {
-          wait_length = DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) + PKT_LENGTH_H + 1;
-          continue;
-        }
+        header_end += read_length;
 
-        if (rx_length < wait_length)
+        // a byte that breaks the header drops the first byte of the candidate, and the search goes on from the next one.
+        // no byte is checked more than a header length of times, whatever the amount of garbage.
+        while (checked <= PKT_INSTRUCTION && head + checked < header_end)
         {
-          // check timeout
-          if (port->isPacketTimeout() == true)
+          if (isValidStatusByte(&rxpacket[head], checked, rxpacket[head + checked]) == true)
           {
-            if (rx_length == 0)
-            {
-              result = COMM_RX_TIMEOUT;
-            }
-            else
-            {
-              result = COMM_RX_CORRUPT;
-            }
-            break;
+            checked++;
           }
           else
           {
-            continue;
+            head++;
+            checked = 0;
           }
         }
 
-        // verify CRC16
-        uint16_t crc = DXL_MAKEWORD(rxpacket[wait_length-2], rxpacket[wait_length-1]);
-        if (updateCRC(0, rxpacket, wait_length - 2) == crc)
-        {
-          result = COMM_SUCCESS;
-        }
-        else
+        if (checked > PKT_INSTRUCTION)
         {
-          result = COMM_RX_CORRUPT;
+          for (uint16_t s = head; s < header_end; s++)
+            rxpacket[s - head] = rxpacket[s];
+
+          rx_length   = PKT_INSTRUCTION + 1;
+          wire_length = rx_length;
+          idx         = rx_length;
+          read_end    = header_end - head;
+
+          // re-calculate the exact length of the rx packet
+          wait_length = DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) + PKT_LENGTH_H + 1;
+          crc         = updateCRC(0, rxpacket, rx_length);
         }
-        break;
-      }
-      else
-      {
-        // remove unnecessary packets
-        for (uint8_t s = 0; s < rx_length - idx; s++)
-          rxpacket[s] = rxpacket[idx + s];
-        //memcpy(&rxpacket[0], &rxpacket[idx], rx_length - idx);
-        rx_length -= idx;
       }
     }
     else
     {
-      // check timeout
-      if (port->isPacketTimeout() == true)
+      read_length = port->readPort(&rxpacket[rx_length], wait_length - wire_length);
+      if (read_length > 0)
+        read_end = rx_length + read_length;
+    }
+
+    if (read_length > 0)
+    {
+      // a status packet longer than the buffer of the caller is not received
+      if (wait_length > rxpacket_length)
       {
-        if (rx_length == 0)
+        result = COMM_RX_CORRUPT;
+        break;
+      }
+
+      // the rest bytes go into CRC16 as they arrive, and the stuffed 0xFD is removed on the way
+      for (; idx < read_end; idx++)
+      {
+        uint8_t data = rxpacket[idx];
+
+        if (wire_length++ >= wait_length - 2)   // CRC16_L CRC16_H
         {
-          result = COMM_RX_TIMEOUT;
+          rxpacket[rx_length++] = data;
+          continue;
         }
-        else
+
+        crc = updateCRC16(crc, data);
+        if (state == 3 && data == 0xFD)   // FF FF FD FD
         {
-          result = COMM_RX_CORRUPT;
+          state = 0;
+          continue;
         }
-        break;
+        state = getStuffingState(state, data);
+        rxpacket[rx_length++] = data;
+      }
+    }
+
+    if (rx_length > PKT_INSTRUCTION && wire_length >= wait_length)
+    {
+      // verify CRC16
+      if (DXL_MAKEWORD(rxpacket[rx_length-2], rxpacket[rx_length-1]) == crc)
+      {
+        rxpacket[PKT_LENGTH_L] = DXL_LOBYTE(rx_length - 7);
+        rxpacket[PKT_LENGTH_H] = DXL_HIBYTE(rx_length - 7);
+        result = COMM_SUCCESS;
+      }
+      else
+      {
+        result = COMM_RX_CORRUPT;
       }
+      break;
     }
+
+    // check timeout
+    if (port->isPacketTimeout() == true)
+    {
+      if (rx_length == 0 && checked == 0)
+      {
+        result = COMM_RX_TIMEOUT;
+      }
+      else
+      {
+        result = COMM_RX_CORRUPT;
+      }
+      break;
+    }
+
+    // sleep until the port has new data instead of spinning on readPort
+    if (read_length <= 0)
+      port->waitForBytesAvailable();
   }
   port->is_using_ = false;
 
-  if (result == COMM_SUCCESS)
-    removeStuffing(rxpacket);
-
   return result;
 }
 
@@ -456,6 +538,13 @@ int Protocol2PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
   if (result != COMM_SUCCESS)
     return result;
 
+  return rxStatusPacket(port, txpacket, rxpacket, error);
+}
+
+int Protocol2PacketHandler::rxStatusPacket(PortHandler *port, uint8_t *txpacket, uint8_t *rxpacket, uint8_t *error)
+{
+  int result = COMM_SUCCESS;
+
   // (ID == Broadcast ID && NOT BulkRead) == no need to wait for status packet
   // (Instruction == action) == no need to wait for status packet
   if ((txpacket[PKT_ID] == BROADCAST_ID && txpacket[PKT_INSTRUCTION] != INST_BULK_READ) ||
@@ -469,11 +558,11 @@ int Protocol2PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
   // set packet timeout
   if (txpacket[PKT_INSTRUCTION] == INST_READ)
   {
-    port->setPacketTimeout((uint16_t)(DXL_MAKEWORD(txpacket[PKT_PARAMETER0+2], txpacket[PKT_PARAMETER0+3]) + 11));
+    port->setStatusPacketTimeout(txpacket[PKT_ID], (uint16_t)(DXL_MAKEWORD(txpacket[PKT_PARAMETER0+2], txpacket[PKT_PARAMETER0+3]) + 11));
   }
   else
   {
-    port->setPacketTimeout((uint16_t)11);
+    port->setStatusPacketTimeout(txpacket[PKT_ID], (uint16_t)11);
     // HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H INST ERROR CRC16_L CRC16_H
   }
 
@@ -483,6 +572,9 @@ int Protocol2PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
   if (txpacket[PKT_ID] != rxpacket[PKT_ID])
     result = rxPacket(port, rxpacket);
 
+  if (result == COMM_RX_TIMEOUT || (result == COMM_SUCCESS && txpacket[PKT_ID] == rxpacket[PKT_ID]))
+    port->updateRoundTripTime(txpacket[PKT_ID], result == COMM_SUCCESS);
+
   if (result == COMM_SUCCESS && txpacket[PKT_ID] != BROADCAST_ID)
   {
     if (error != 0)
@@ -492,6 +584,40 @@ int Protocol2PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
   return result;
 }
 
+int Protocol2PacketHandler::txPreparedPacket(PortHandler *port, uint8_t *txpacket, uint16_t packet_length)
+{
+  uint16_t written_packet_length = 0;
+
+  if (port->is_using_)
+    return COMM_PORT_BUSY;
+  port->is_using_ = true;
+
+  // tx packet
+  port->clearPort();
+  written_packet_length = port->writePort(txpacket, packet_length);
+
+  if (packet_length != written_packet_length)
+  {
+    port->is_using_ = false;
+    return COMM_TX_FAIL;
+  }
+
+  return COMM_SUCCESS;
+}
+
+int Protocol2PacketHandler::txRxMadePacket(PortHandler *port, uint8_t *txpacket, uint16_t packet_length, uint8_t *rxpacket, uint8_t *error)
+{
+  int result = COMM_TX_FAIL;
+
+  // tx packet
+  result = txPreparedPacket(port, txpacket, packet_length);
+
+  if (result != COMM_SUCCESS)
+    return result;
+
+  return rxStatusPacket(port, txpacket, rxpacket, error);
+}
+
 int Protocol2PacketHandler::ping(PortHandler *port, uint8_t id, uint8_t *error)
 {
   return ping(port, id, 0, error);
@@ -613,6 +739,93 @@ int Protocol2PacketHandler::broadcastPing(PortHandler *port, std::vector<uint8_t
   return result;
 }
 
+int Protocol2PacketHandler::broadcastPing(PortHandler *port, uint8_t max_id, std::vector<uint8_t> &id_list, std::vector<uint16_t> &model_list, std::vector<uint8_t> &firmware_list)
+{
+  const int STATUS_LENGTH     = 14;
+  int result                  = COMM_TX_FAIL;
+
+  id_list.clear();
+  model_list.clear();
+  firmware_list.clear();
+
+  if (max_id == 0 || max_id > MAX_ID)
+    max_id = MAX_ID;
+
+  uint16_t rx_length          = 0;
+  uint16_t parsed_length      = 0;
+  uint16_t wait_length        = STATUS_LENGTH * max_id;
+  uint32_t wait_time          = (uint32_t)wait_length * 30;
+  bool     is_last_id         = false;
+
+  uint8_t txpacket[10]        = {0};
+  uint8_t rxpacket[STATUS_LENGTH * MAX_ID] = {0};
+
+  txpacket[PKT_ID]            = BROADCAST_ID;
+  txpacket[PKT_LENGTH_L]      = 3;
+  txpacket[PKT_LENGTH_H]      = 0;
+  txpacket[PKT_INSTRUCTION]   = INST_PING;
+
+  result = txPacket(port, txpacket);
+  if (result != COMM_SUCCESS)
+  {
+    port->is_using_ = false;
+    return result;
+  }
+
+  // set rx timeout (same 30 byte times per status byte as broadcastPing(port, id_list), for IDs up to max_id)
+  if (wait_time > 0xFFFF)
+    wait_time = 0xFFFF;
+  port->setPacketTimeout((uint16_t)wait_time);
+
+  result = COMM_RX_TIMEOUT;
+  while (is_last_id == false && rx_length < wait_length)
+  {
+    rx_length += port->readPort(&rxpacket[rx_length], wait_length - rx_length);
+
+    // parse every complete status packet as it arrives
+    while (rx_length - parsed_length >= STATUS_LENGTH)
+    {
+      uint8_t *status = &rxpacket[parsed_length];
+
+      if (status[PKT_HEADER0] != 0xFF || status[PKT_HEADER1] != 0xFF || status[PKT_HEADER2] != 0xFD)
+      {
+        parsed_length++;
+        continue;
+      }
+
+      if (updateCRC(0, status, STATUS_LENGTH - 2) != DXL_MAKEWORD(status[STATUS_LENGTH-2], status[STATUS_LENGTH-1]))
+      {
+        if (result != COMM_SUCCESS)
+          result = COMM_RX_CORRUPT;
+        parsed_length += 3;   // skip the header
+        continue;
+      }
+
+      result = COMM_SUCCESS;
+      id_list.push_back(status[PKT_ID]);
+      model_list.push_back(DXL_MAKEWORD(status[PKT_PARAMETER0+1], status[PKT_PARAMETER0+2]));
+      firmware_list.push_back(status[PKT_PARAMETER0+3]);
+
+      if (status[PKT_ID] >= max_id)
+        is_last_id = true;
+
+      parsed_length += STATUS_LENGTH;
+    }
+
+    if (port->isPacketTimeout() == true)
+      break;
+
+    port->waitForBytesAvailable();
+  }
+
+  port->is_using_ = false;
+
+  if (result == COMM_RX_TIMEOUT && rx_length != 0)
+    result = COMM_RX_CORRUPT;
+
+  return result;
+}
+
 int Protocol2PacketHandler::action(PortHandler *port, uint8_t id)
 {
   uint8_t txpacket[10]        = {0};
@@ -656,21 +869,18 @@ int Protocol2PacketHandler::readTx(PortHandler *port, uint8_t id, uint16_t addre
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t txpacket[14]        = {0};
+  uint8_t txpacket[15]        = {0};
+  // 15: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST ADDR_L ADDR_H DATA_LEN_L DATA_LEN_H (STUFFING) CRC16_L CRC16_H
+  uint8_t prefix[4]           = { DXL_LOBYTE(address), DXL_HIBYTE(address), DXL_LOBYTE(length), DXL_HIBYTE(length) };
 
   if (id >= BROADCAST_ID)
     return COMM_NOT_AVAILABLE;
 
-  txpacket[PKT_ID]            = id;
-  txpacket[PKT_LENGTH_L]      = 7;
-  txpacket[PKT_LENGTH_H]      = 0;
-  txpacket[PKT_INSTRUCTION]   = INST_READ;
-  txpacket[PKT_PARAMETER0+0]  = (uint8_t)DXL_LOBYTE(address);
-  txpacket[PKT_PARAMETER0+1]  = (uint8_t)DXL_HIBYTE(address);
-  txpacket[PKT_PARAMETER0+2]  = (uint8_t)DXL_LOBYTE(length);
-  txpacket[PKT_PARAMETER0+3]  = (uint8_t)DXL_HIBYTE(length);
+  result = makePacket(txpacket, sizeof(txpacket), id, INST_READ, prefix, 4, 0, 0);
+  if (result < 0)
+    return result;
 
-  result = txPacket(port, txpacket);
+  result = txPreparedPacket(port, txpacket, (uint16_t)result);
 
   // set packet timeout
   if (result == COMM_SUCCESS)
@@ -701,32 +911,47 @@ int Protocol2PacketHandler::readRx(PortHandler *port, uint16_t length, uint8_t *
   return result;
 }
 
+int Protocol2PacketHandler::readRx(PortHandler *port, uint16_t length, uint8_t *data, uint8_t *error, uint8_t *rxpacket, uint16_t rxpacket_length)
+{
+  int result                 = COMM_TX_FAIL;
+
+  result = rxPacket(port, rxpacket, rxpacket_length);
+  if (result == COMM_SUCCESS)
+  {
+    if (error != 0)
+      *error = (uint8_t)rxpacket[PKT_ERROR];
+    for (uint16_t s = 0; s < length; s++)
+      data[s] = rxpacket[PKT_PARAMETER0 + 1 + s];
+  }
+
+  return result;
+}
+
 int Protocol2PacketHandler::readTxRx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error)
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t txpacket[14]        = {0};
-  uint8_t *rxpacket           = (uint8_t *)malloc(RXPACKET_MAX_LEN);
-  //(length + 11 + (length/3));  // (length/3): consider stuffing
+  uint8_t txpacket[15]        = {0};
+  // 15: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST ADDR_L ADDR_H DATA_LEN_L DATA_LEN_H (STUFFING) CRC16_L CRC16_H
+  uint8_t prefix[4]           = { DXL_LOBYTE(address), DXL_HIBYTE(address), DXL_LOBYTE(length), DXL_HIBYTE(length) };
+  uint8_t *rxpacket           = 0;
 
   if (id >= BROADCAST_ID)
     return COMM_NOT_AVAILABLE;
 
-  txpacket[PKT_ID]            = id;
-  txpacket[PKT_LENGTH_L]      = 7;
-  txpacket[PKT_LENGTH_H]      = 0;
-  txpacket[PKT_INSTRUCTION]   = INST_READ;
-  txpacket[PKT_PARAMETER0+0]  = (uint8_t)DXL_LOBYTE(address);
-  txpacket[PKT_PARAMETER0+1]  = (uint8_t)DXL_HIBYTE(address);
-  txpacket[PKT_PARAMETER0+2]  = (uint8_t)DXL_LOBYTE(length);
-  txpacket[PKT_PARAMETER0+3]  = (uint8_t)DXL_HIBYTE(length);
+  result = makePacket(txpacket, sizeof(txpacket), id, INST_READ, prefix, 4, 0, 0);
+  if (result < 0)
+    return result;
 
-  result = txRxPacket(port, txpacket, rxpacket, error);
+  rxpacket                    = (uint8_t *)malloc(RXPACKET_MAX_LEN);
+  //(length + 11 + (length/3));  // (length/3): consider stuffing
+
+  result = txRxMadePacket(port, txpacket, (uint16_t)result, rxpacket, error);
   if (result == COMM_SUCCESS)
   {
     if (error != 0)
       *error = (uint8_t)rxpacket[PKT_ERROR];
-    for (uint8_t s = 0; s < length; s++)
+    for (uint16_t s = 0; s < length; s++)
       data[s] = rxpacket[PKT_PARAMETER0 + 1 + s];
     //memcpy(data, &rxpacket[PKT_PARAMETER0+1], length);
   }
@@ -804,22 +1029,17 @@ int Protocol2PacketHandler::writeTxOnly(PortHandler *port, uint8_t id, uint16_t
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length+12);
-  //uint8_t *txpacket           = new uint8_t[length+12];
+  uint16_t buffer_length      = length + 12 + (length + 2) / 3;   // ((length+2)/3): consider stuffing
+  uint8_t *txpacket           = (uint8_t *)malloc(buffer_length);
+  //uint8_t *txpacket           = new uint8_t[buffer_length];
+  uint8_t prefix[2]           = { DXL_LOBYTE(address), DXL_HIBYTE(address) };
 
-  txpacket[PKT_ID]            = id;
-  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
-  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(length+5);
-  txpacket[PKT_INSTRUCTION]   = INST_WRITE;
-  txpacket[PKT_PARAMETER0+0]  = (uint8_t)DXL_LOBYTE(address);
-  txpacket[PKT_PARAMETER0+1]  = (uint8_t)DXL_HIBYTE(address);
-
-  for (uint8_t s = 0; s < length; s++)
-    txpacket[PKT_PARAMETER0+2+s] = data[s];
-  //memcpy(&txpacket[PKT_PARAMETER0+2], data, length);
-
-  result = txPacket(port, txpacket);
-  port->is_using_ = false;
+  result = makePacket(txpacket, buffer_length, id, INST_WRITE, prefix, 2, data, length);
+  if (result >= 0)
+  {
+    result = txPreparedPacket(port, txpacket, (uint16_t)result);
+    port->is_using_ = false;
+  }
 
   free(txpacket);
   //delete[] txpacket;
@@ -830,22 +1050,15 @@ int Protocol2PacketHandler::writeTxRx(PortHandler *port, uint8_t id, uint16_t ad
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length + 12);
-  //uint8_t *txpacket           = new uint8_t[length+12];
+  uint16_t buffer_length      = length + 12 + (length + 2) / 3;   // ((length+2)/3): consider stuffing
+  uint8_t *txpacket           = (uint8_t *)malloc(buffer_length);
+  //uint8_t *txpacket           = new uint8_t[buffer_length];
+  uint8_t prefix[2]           = { DXL_LOBYTE(address), DXL_HIBYTE(address) };
   uint8_t rxpacket[11]        = {0};
 
-  txpacket[PKT_ID]            = id;
-  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
-  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(length+5);
-  txpacket[PKT_INSTRUCTION]   = INST_WRITE;
-  txpacket[PKT_PARAMETER0+0]  = (uint8_t)DXL_LOBYTE(address);
-  txpacket[PKT_PARAMETER0+1]  = (uint8_t)DXL_HIBYTE(address);
-
-  for (uint8_t s = 0; s < length; s++)
-    txpacket[PKT_PARAMETER0+2+s] = data[s];
-  //memcpy(&txpacket[PKT_PARAMETER0+2], data, length);
-
-  result = txRxPacket(port, txpacket, rxpacket, error);
+  result = makePacket(txpacket, buffer_length, id, INST_WRITE, prefix, 2, data, length);
+  if (result >= 0)
+    result = txRxMadePacket(port, txpacket, (uint16_t)result, rxpacket, error);
 
   free(txpacket);
   //delete[] txpacket;
@@ -887,24 +1100,19 @@ int Protocol2PacketHandler::write4ByteTxRx(PortHandler *port, uint8_t id, uint16
 
 int Protocol2PacketHandler::regWriteTxOnly(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data)
 {
-  int result                 = COMM_TX_FAIL;
-
-  uint8_t *txpacket           = (uint8_t *)malloc(length + 12);
-  //uint8_t *txpacket           = new uint8_t[length+12];
-
-  txpacket[PKT_ID]            = id;
-  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
-  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(length+5);
-  txpacket[PKT_INSTRUCTION]   = INST_REG_WRITE;
-  txpacket[PKT_PARAMETER0+0]  = (uint8_t)DXL_LOBYTE(address);
-  txpacket[PKT_PARAMETER0+1]  = (uint8_t)DXL_HIBYTE(address);
+  int result                  = COMM_TX_FAIL;
 
-  for (uint8_t s = 0; s < length; s++)
-    txpacket[PKT_PARAMETER0+2+s] = data[s];
-  //memcpy(&txpacket[PKT_PARAMETER0+2], data, length);
+  uint16_t buffer_length      = length + 12 + (length + 2) / 3;   // ((length+2)/3): consider stuffing
+  uint8_t *txpacket           = (uint8_t *)malloc(buffer_length);
+  //uint8_t *txpacket           = new uint8_t[buffer_length];
+  uint8_t prefix[2]           = { DXL_LOBYTE(address), DXL_HIBYTE(address) };
 
-  result = txPacket(port, txpacket);
-  port->is_using_ = false;
+  result = makePacket(txpacket, buffer_length, id, INST_REG_WRITE, prefix, 2, data, length);
+  if (result >= 0)
+  {
+    result = txPreparedPacket(port, txpacket, (uint16_t)result);
+    port->is_using_ = false;
+  }
 
   free(txpacket);
   //delete[] txpacket;
@@ -913,24 +1121,17 @@ int Protocol2PacketHandler::regWriteTxOnly(PortHandler *port, uint8_t id, uint16
 
 int Protocol2PacketHandler::regWriteTxRx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error)
 {
-  int result                 = COMM_TX_FAIL;
+  int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length + 12);
-  //uint8_t *txpacket           = new uint8_t[length+12];
+  uint16_t buffer_length      = length + 12 + (length + 2) / 3;   // ((length+2)/3): consider stuffing
+  uint8_t *txpacket           = (uint8_t *)malloc(buffer_length);
+  //uint8_t *txpacket           = new uint8_t[buffer_length];
+  uint8_t prefix[2]           = { DXL_LOBYTE(address), DXL_HIBYTE(address) };
   uint8_t rxpacket[11]        = {0};
 
-  txpacket[PKT_ID]            = id;
-  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
-  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(length+5);
-  txpacket[PKT_INSTRUCTION]   = INST_REG_WRITE;
-  txpacket[PKT_PARAMETER0+0]  = (uint8_t)DXL_LOBYTE(address);
-  txpacket[PKT_PARAMETER0+1]  = (uint8_t)DXL_HIBYTE(address);
-
-  for (uint8_t s = 0; s < length; s++)
-    txpacket[PKT_PARAMETER0+2+s] = data[s];
-  //memcpy(&txpacket[PKT_PARAMETER0+2], data, length);
-
-  result = txRxPacket(port, txpacket, rxpacket, error);
+  result = makePacket(txpacket, buffer_length, id, INST_REG_WRITE, prefix, 2, data, length);
+  if (result >= 0)
+    result = txRxMadePacket(port, txpacket, (uint16_t)result, rxpacket, error);
 
   free(txpacket);
   //delete[] txpacket;
@@ -941,23 +1142,13 @@ int Protocol2PacketHandler::syncReadTx(PortHandler *port, uint16_t start_address
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length + 14);
+  uint16_t buffer_length      = param_length + 14 + (param_length + 4) / 3;  // ((param_length+4)/3): consider stuffing
+  uint8_t *txpacket           = (uint8_t *)malloc(buffer_length);
   // 14: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
 
-  txpacket[PKT_ID]            = BROADCAST_ID;
-  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
-  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
-  txpacket[PKT_INSTRUCTION]   = INST_SYNC_READ;
-  txpacket[PKT_PARAMETER0+0]  = DXL_LOBYTE(start_address);
-  txpacket[PKT_PARAMETER0+1]  = DXL_HIBYTE(start_address);
-  txpacket[PKT_PARAMETER0+2]  = DXL_LOBYTE(data_length);
-  txpacket[PKT_PARAMETER0+3]  = DXL_HIBYTE(data_length);
-
-  for (uint8_t s = 0; s < param_length; s++)
-    txpacket[PKT_PARAMETER0+4+s] = param[s];
-  //memcpy(&txpacket[PKT_PARAMETER0+4], param, param_length);
-
-  result = txPacket(port, txpacket);
+  result = makeSyncReadTx(txpacket, buffer_length, start_address, data_length, param, param_length);
+  if (result >= 0)
+    result = txPreparedPacket(port, txpacket, (uint16_t)result);
   if (result == COMM_SUCCESS)
     port->setPacketTimeout((uint16_t)((11 + data_length) * param_length));
 
@@ -969,24 +1160,17 @@ int Protocol2PacketHandler::syncWriteTxOnly(PortHandler *port, uint16_t start_ad
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length + 14);
-  //uint8_t *txpacket           = new uint8_t[param_length + 14];
+  uint16_t buffer_length      = param_length + 14 + (param_length + 4) / 3;  // ((param_length+4)/3): consider stuffing
+  uint8_t *txpacket           = (uint8_t *)malloc(buffer_length);
+  //uint8_t *txpacket           = new uint8_t[buffer_length];
   // 14: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
 
-  txpacket[PKT_ID]            = BROADCAST_ID;
-  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
-  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
-  txpacket[PKT_INSTRUCTION]   = INST_SYNC_WRITE;
-  txpacket[PKT_PARAMETER0+0]  = DXL_LOBYTE(start_address);
-  txpacket[PKT_PARAMETER0+1]  = DXL_HIBYTE(start_address);
-  txpacket[PKT_PARAMETER0+2]  = DXL_LOBYTE(data_length);
-  txpacket[PKT_PARAMETER0+3]  = DXL_HIBYTE(data_length);
-
-  for (uint8_t s = 0; s < param_length; s++)
-    txpacket[PKT_PARAMETER0+4+s] = param[s];
-  //memcpy(&txpacket[PKT_PARAMETER0+4], param, param_length);
-
-  result = txRxPacket(port, txpacket, 0, 0);
+  result = makeSyncWriteTx(txpacket, buffer_length, start_address, data_length, param, param_length);
+  if (result >= 0)
+  {
+    result = txPreparedPacket(port, txpacket, (uint16_t)result);
+    port->is_using_ = false;
+  }
 
   free(txpacket);
   //delete[] txpacket;
@@ -997,20 +1181,14 @@ int Protocol2PacketHandler::bulkReadTx(PortHandler *port, uint8_t *param, uint16
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length + 10);
-  //uint8_t *txpacket           = new uint8_t[param_length + 10];
+  uint16_t buffer_length      = param_length + 10 + param_length / 3;  // (param_length/3): consider stuffing
+  uint8_t *txpacket           = (uint8_t *)malloc(buffer_length);
+  //uint8_t *txpacket           = new uint8_t[buffer_length];
   // 10: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST CRC16_L CRC16_H
 
-  txpacket[PKT_ID]            = BROADCAST_ID;
-  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 3); // 3: INST CRC16_L CRC16_H
-  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(param_length + 3); // 3: INST CRC16_L CRC16_H
-  txpacket[PKT_INSTRUCTION]   = INST_BULK_READ;
-
-  for (uint8_t s = 0; s < param_length; s++)
-    txpacket[PKT_PARAMETER0+s] = param[s];
-  //memcpy(&txpacket[PKT_PARAMETER0], param, param_length);
-
-  result = txPacket(port, txpacket);
+  result = makeBulkReadTx(txpacket, buffer_length, param, param_length);
+  if (result >= 0)
+    result = txPreparedPacket(port, txpacket, (uint16_t)result);
   if (result == COMM_SUCCESS)
   {
     int wait_length = 0;
@@ -1028,22 +1206,38 @@ int Protocol2PacketHandler::bulkWriteTxOnly(PortHandler *port, uint8_t *param, u
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length + 10);
-  //uint8_t *txpacket           = new uint8_t[param_length + 10];
+  uint16_t buffer_length      = param_length + 10 + param_length / 3;  // (param_length/3): consider stuffing
+  uint8_t *txpacket           = (uint8_t *)malloc(buffer_length);
+  //uint8_t *txpacket           = new uint8_t[buffer_length];
   // 10: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST CRC16_L CRC16_H
 
-  txpacket[PKT_ID]            = BROADCAST_ID;
-  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 3); // 3: INST CRC16_L CRC16_H
-  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(param_length + 3); // 3: INST CRC16_L CRC16_H
-  txpacket[PKT_INSTRUCTION]   = INST_BULK_WRITE;
-
-  for (uint8_t s = 0; s < param_length; s++)
-    txpacket[PKT_PARAMETER0+s] = param[s];
-  //memcpy(&txpacket[PKT_PARAMETER0], param, param_length);
-
-  result = txRxPacket(port, txpacket, 0, 0);
+  result = makePacket(txpacket, buffer_length, BROADCAST_ID, INST_BULK_WRITE, 0, 0, param, param_length);
+  if (result >= 0)
+  {
+    result = txPreparedPacket(port, txpacket, (uint16_t)result);
+    port->is_using_ = false;
+  }
 
   free(txpacket);
   //delete[] txpacket;
   return result;
 }
+
+int Protocol2PacketHandler::makeSyncReadTx(uint8_t *txpacket, uint16_t buffer_length, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
+{
+  uint8_t prefix[4] = { DXL_LOBYTE(start_address), DXL_HIBYTE(start_address), DXL_LOBYTE(data_length), DXL_HIBYTE(data_length) };
+
+  return makePacket(txpacket, buffer_length, BROADCAST_ID, INST_SYNC_READ, prefix, 4, param, param_length);
+}
+
+int Protocol2PacketHandler::makeSyncWriteTx(uint8_t *txpacket, uint16_t buffer_length, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
+{
+  uint8_t prefix[4] = { DXL_LOBYTE(start_address), DXL_HIBYTE(start_address), DXL_LOBYTE(data_length), DXL_HIBYTE(data_length) };
+
+  return makePacket(txpacket, buffer_length, BROADCAST_ID, INST_SYNC_WRITE, prefix, 4, param, param_length);
+}
+
+int Protocol2PacketHandler::makeBulkReadTx(uint8_t *txpacket, uint16_t buffer_length, uint8_t *param, uint16_t param_length)
+{
+  return makePacket(txpacket, buffer_length, BROADCAST_ID, INST_BULK_READ, 0, 0, param, param_length);
+}
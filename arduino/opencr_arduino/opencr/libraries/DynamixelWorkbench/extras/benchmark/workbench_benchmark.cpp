@@ -0,0 +1,213 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Taehun Lim (Darby) */
+
+// Host side cost of the name based calls of DynamixelWorkbench against the ItemHandle calls:
+//   lookup          : DynamixelTool::getControlItem("Present_Position") only
+//   itemRead        : itemRead(id, "Present_Position") and itemRead(id, handle) of one ID
+//   syncWrite       : syncWrite("Goal_Position", data) and syncWrite(handle, data) of all IDs
+// The same source is built against the current tree (workbench_benchmark) and against the tree before ItemHandle
+// (workbench_benchmark_baseline, WORKBENCH_BASELINE defined), where only the name based calls exist.
+// The servos are ServoSimulator on a pty. A simulator baudrate of 0 puts no wire time on the packets,
+// so the wall time is the host side cost plus the pty round trip.
+//
+// usage: workbench_benchmark [servo_num [calls [baudrate]]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dynamixel_workbench.h"
+#include "servo_simulator.h"
+
+#define BAUDRATE        1000000
+
+static double getUsec(clockid_t clock)
+{
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec * 1e-3;
+}
+
+struct Cost
+{
+  double wall;  // usec per call
+  double cpu;   // usec per call, calling thread only
+  int    fail;
+};
+
+static void printCost(const char *name, Cost cost)
+{
+  printf("  %-34s %10.3f %10.3f %6d\n", name, cost.wall, cost.cpu, cost.fail);
+}
+
+static volatile int32_t value_sink;
+
+int main(int argc, char *argv[])
+{
+  int     servo_num = (argc > 1) ? atoi(argv[1]) : 6;
+  int     calls     = (argc > 2) ? atoi(argv[2]) : 2000;
+  int     baudrate  = (argc > 3) ? atoi(argv[3]) : 0;
+  int32_t goal[16];
+
+  if (servo_num > 16)
+    servo_num = 16;
+
+  ServoSimulator sim(2.0, baudrate);
+  if (sim.open() == false)
+    return 1;
+  for (int id = 1; id <= servo_num; id++)
+    sim.addServo(id, XM430_W210, 0);
+
+  DynamixelWorkbench wb;
+  if (wb.begin(sim.getPortName(), BAUDRATE) == false)
+    return 1;
+
+  for (int id = 1; id <= servo_num; id++)
+  {
+    uint16_t model_number = 0;
+    if (wb.ping(id, &model_number) == false)
+    {
+      printf("ID %d does not answer\n", id);
+      return 1;
+    }
+    goal[id - 1] = 2048;
+  }
+  wb.addSyncWrite("Goal_Position");
+
+  printf("%d servos, %d calls, simulator baudrate %d\n\n", servo_num, calls, baudrate);
+#if defined(WORKBENCH_BASELINE)
+  printf("tree before ItemHandle\n");
+#else
+  printf("current tree\n");
+#endif
+  printf("  %-34s %10s %10s %6s\n", "call", "wall us", "cpu us", "fail");
+
+  // name lookup alone, as every name based call does it
+  {
+    DynamixelTool tool;
+    tool.addTool(XM430_W210, 1);
+
+    int    lookup_num = calls * 100;
+    Cost   cost       = { 0.0, 0.0, 0 };
+    double wall       = getUsec(CLOCK_MONOTONIC);
+    double cpu        = getUsec(CLOCK_THREAD_CPUTIME_ID);
+
+    for (int i = 0; i < lookup_num; i++)
+    {
+      ControlTableItem *cti = tool.getControlItem("Present_Position");
+      if (cti == NULL)
+        cost.fail++;
+      else
+        value_sink = cti->address;
+    }
+    cost.wall = (getUsec(CLOCK_MONOTONIC) - wall) / lookup_num;
+    cost.cpu  = (getUsec(CLOCK_THREAD_CPUTIME_ID) - cpu) / lookup_num;
+    printCost("getControlItem(name)", cost);
+  }
+
+  {
+    Cost   cost = { 0.0, 0.0, 0 };
+    double wall = getUsec(CLOCK_MONOTONIC);
+    double cpu  = getUsec(CLOCK_THREAD_CPUTIME_ID);
+
+    for (int i = 0; i < calls; i++)
+      value_sink = wb.itemRead(1 + i % servo_num, "Present_Position");
+
+    cost.wall = (getUsec(CLOCK_MONOTONIC) - wall) / calls;
+    cost.cpu  = (getUsec(CLOCK_THREAD_CPUTIME_ID) - cpu) / calls;
+    printCost("itemRead(id, name)", cost);
+  }
+
+#if !defined(WORKBENCH_BASELINE)
+  {
+    ItemHandle handle;
+    Cost   cost = { 0.0, 0.0, 0 };
+
+    if (wb.getItemHandle(1, "Present_Position", &handle) == false)
+      return 1;
+
+    double wall = getUsec(CLOCK_MONOTONIC);
+    double cpu  = getUsec(CLOCK_THREAD_CPUTIME_ID);
+
+    for (int i = 0; i < calls; i++)
+    {
+      int32_t value = 0;
+
+      if (wb.itemRead(1 + i % servo_num, handle, &value) == false)
+        cost.fail++;
+      value_sink = value;
+    }
+
+    cost.wall = (getUsec(CLOCK_MONOTONIC) - wall) / calls;
+    cost.cpu  = (getUsec(CLOCK_THREAD_CPUTIME_ID) - cpu) / calls;
+    printCost("itemRead(id, handle)", cost);
+  }
+#endif
+
+  {
+    Cost   cost = { 0.0, 0.0, 0 };
+    double wall = getUsec(CLOCK_MONOTONIC);
+    double cpu  = getUsec(CLOCK_THREAD_CPUTIME_ID);
+
+    for (int i = 0; i < calls; i++)
+    {
+      goal[0] = 2048 + i % 100;
+      if (wb.syncWrite("Goal_Position", goal) == false)
+        cost.fail++;
+    }
+
+    cost.wall = (getUsec(CLOCK_MONOTONIC) - wall) / calls;
+    cost.cpu  = (getUsec(CLOCK_THREAD_CPUTIME_ID) - cpu) / calls;
+    printCost("syncWrite(name, data)", cost);
+  }
+
+#if !defined(WORKBENCH_BASELINE)
+  {
+    ItemHandle handle;
+    Cost   cost = { 0.0, 0.0, 0 };
+
+    if (wb.getItemHandle(1, "Goal_Position", &handle) == false)
+      return 1;
+
+    double wall = getUsec(CLOCK_MONOTONIC);
+    double cpu  = getUsec(CLOCK_THREAD_CPUTIME_ID);
+
+    for (int i = 0; i < calls; i++)
+    {
+      goal[0] = 2048 + i % 100;
+      if (wb.syncWrite(handle, goal) == false)
+        cost.fail++;
+    }
+
+    cost.wall = (getUsec(CLOCK_MONOTONIC) - wall) / calls;
+    cost.cpu  = (getUsec(CLOCK_THREAD_CPUTIME_ID) - cpu) / calls;
+    printCost("syncWrite(handle, data)", cost);
+  }
+#endif
+
+  // clearPort() of the next packet drops what the simulator has not taken from the pty yet
+  usleep(20000);
+  if (sim.getValue(1, 116, 4) != (uint32_t)goal[0])
+  {
+    printf("the last Sync Write did not reach ID 1\n");
+    return 1;
+  }
+
+  return 0;
+}
@@ -28,4 +28,12 @@ typedef struct
   uint8_t     data_length;
 } ControlTableItem;
 
+// Address and length of a control table item, resolved once by name so that
+// periodic reads and writes skip the item name lookup
+typedef struct
+{
+  uint16_t address;
+  uint8_t  data_length;
+} ItemHandle;
+
 #endif //CONTROL_TABLE_ITEM_H
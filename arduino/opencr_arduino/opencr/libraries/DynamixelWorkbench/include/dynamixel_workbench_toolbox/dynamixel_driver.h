@@ -32,6 +32,9 @@
 
 #define MAX_DXL_SERIES_NUM 5
 #define MAX_HANDLER_NUM 5
+#define MAX_SESSION_NUM 5
+#define MAX_SESSION_ID_NUM 16
+#define MAX_SCAN_NUM 32
 
 #define BYTE  1
 #define WORD  2
@@ -49,6 +52,37 @@ typedef struct
   dynamixel::GroupSyncRead  *groupSyncRead;     
 } SyncReadHandler;
 
+typedef struct
+{
+  uint8_t  id;
+  uint16_t model_number;
+  uint8_t  firmware_version;
+  float    protocol_version;
+  uint32_t baud_rate;
+} DXLScanInfo;
+
+// Sync Write bound to a list of IDs once; each call only changes the data
+typedef struct
+{
+  ItemHandle item;
+  uint8_t id[MAX_SESSION_ID_NUM];
+  uint8_t id_num;
+  dynamixel::GroupSyncWrite *groupSyncWrite;
+} SyncWriteSession;
+
+// Sync Read of a contiguous address range bound to a list of IDs once.
+// Protocol 1.0 has no Sync Read, so the range is read from each ID into data.
+typedef struct
+{
+  uint16_t address;
+  uint16_t data_length;
+  uint8_t id[MAX_SESSION_ID_NUM];
+  uint8_t id_num;
+  bool available[MAX_SESSION_ID_NUM];
+  uint8_t *data;
+  dynamixel::GroupSyncRead *groupSyncRead;
+} SyncReadSession;
+
 class DynamixelDriver
 {
  private:
@@ -69,6 +103,12 @@ class DynamixelDriver
   uint8_t sync_write_handler_cnt_;
   uint8_t sync_read_handler_cnt_;
 
+  SyncWriteSession syncWriteSession_[MAX_SESSION_NUM];
+  SyncReadSession  syncReadSession_[MAX_SESSION_NUM];
+
+  uint8_t sync_write_session_cnt_;
+  uint8_t sync_read_session_cnt_;
+
  public:
   DynamixelDriver();
   ~DynamixelDriver();
@@ -88,23 +128,38 @@ class DynamixelDriver
   uint8_t getTheNumberOfItem(uint8_t id);
 
   bool scan(uint8_t *get_id, uint8_t *get_id_num, uint8_t range = 200);
+  bool scan(DXLScanInfo *info, uint8_t max_info_num, uint8_t *info_num, uint8_t range = 200, bool sweep_baud = false);
   bool ping(uint8_t id, uint16_t *get_model_number);
 
   bool reboot(uint8_t id);
   bool reset(uint8_t id);
 
+  bool getItemHandle(uint8_t id, const char *item_name, ItemHandle *handle);
+
   bool writeRegister(uint8_t id, const char *item_name, int32_t data);
+  bool writeRegister(uint8_t id, ItemHandle handle, int32_t data);
   bool writeRegister(uint8_t id, uint16_t addr, uint8_t length, int32_t data);
   bool readRegister(uint8_t id, const char *item_name, int32_t *data);
+  bool readRegister(uint8_t id, ItemHandle handle, int32_t *data);
   bool readRegister(uint8_t id, uint16_t addr, uint8_t length, int32_t *data);
   bool readRegister(uint8_t id, uint16_t length, uint8_t *data);
 
   void addSyncWrite(const char *item_name);
   bool syncWrite(const char *item_name, int32_t *data);
+  bool syncWrite(ItemHandle handle, int32_t *data);
   bool syncWrite(uint8_t *id, uint8_t id_num, const char *item_name, int32_t *data);
+  bool syncWrite(uint8_t *id, uint8_t id_num, ItemHandle handle, int32_t *data);
 
   void addSyncRead(const char *item_name);
   bool syncRead(const char *item_name, int32_t *data);
+  bool syncRead(ItemHandle handle, int32_t *data);
+
+  int8_t addSyncWriteSession(uint8_t *id, uint8_t id_num, const char *item_name);
+  bool syncWriteSession(uint8_t session, int32_t *data);
+
+  int8_t addSyncReadSession(uint8_t *id, uint8_t id_num, const char *first_item_name, const char *last_item_name = NULL);
+  uint8_t syncReadSession(uint8_t session);
+  uint8_t getSyncReadSessionData(uint8_t session, ItemHandle handle, int32_t *data, bool *available = NULL);
 
   void initBulkWrite();
   bool addBulkWriteParam(uint8_t id, const char *item_name, int32_t data);
@@ -130,8 +185,17 @@ class DynamixelDriver
  private:
   void initDXLinfo(void);
   void setTools(uint16_t model_number, uint8_t id);
-  const char *findModelName(uint16_t model_num);
   uint8_t getToolsFactor(uint8_t id);
+  uint8_t scanBus(dynamixel::PacketHandler *packetHandler, uint8_t range, DXLScanInfo *info, uint8_t max_info_num);
+
+  SyncWriteHandler *findSyncWriteHandler(const char *item_name);
+  SyncWriteHandler *findSyncWriteHandler(ItemHandle handle);
+  SyncReadHandler  *findSyncReadHandler(const char *item_name);
+  SyncReadHandler  *findSyncReadHandler(ItemHandle handle);
+
+  bool syncWrite(SyncWriteHandler *swh, int32_t *data);
+  bool syncWrite(SyncWriteHandler *swh, uint8_t *id, uint8_t id_num, int32_t *data);
+  bool syncRead(SyncReadHandler *srh, int32_t *data);
 
   void millis(uint16_t msec);
 };
@@ -80,8 +80,17 @@ typedef struct
   float  max_radian;
 } ModelInfo;
 
+typedef struct
+{
+  uint16_t    number;
+  const char* name;
+} ModelName;
+
 uint8_t getTheNumberOfControlItem();
 ControlTableItem* getConrolTableItem(uint16_t model_number);
 ModelInfo* getModelInfo(uint16_t model_number);
 
+const char* findModelName(uint16_t model_number);
+uint16_t findModelNumber(const char* model_name);
+
 #endif //DYNAMIXEL_H
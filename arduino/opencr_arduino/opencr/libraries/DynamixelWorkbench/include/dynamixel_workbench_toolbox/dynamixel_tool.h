@@ -77,6 +77,7 @@ class DynamixelTool
 
   uint8_t getTheNumberOfItem(void);
   ControlTableItem* getControlItem(const char *item_name);
+  bool getItemHandle(const char *item_name, ItemHandle *handle);
   ControlTableItem* getControlItemPtr(void);
   ModelInfo* getModelInfoPtr(void);
 
@@ -86,5 +87,7 @@ class DynamixelTool
 
   void setModelName(uint16_t model_number);
   void setModelNum(const char* model_name);
+
+  ControlTableItem* findControlItem(const char *item_name);
 };
 #endif //DYNAMIXEL_TOOL_H
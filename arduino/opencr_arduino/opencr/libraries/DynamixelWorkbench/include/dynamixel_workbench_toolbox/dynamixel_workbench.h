@@ -46,6 +46,7 @@ class DynamixelWorkbench
   bool begin(const char* device_name = "/dev/ttyUSB0", uint32_t baud_rate = 57600);
  
   bool scan(uint8_t *get_id, uint8_t *get_id_num = 0, uint8_t range = 200);
+  bool scan(DXLScanInfo *info, uint8_t max_info_num, uint8_t *info_num, uint8_t range = 200, bool sweep_baud = false);
   bool ping(uint8_t id, uint16_t *get_model_number = 0);
 
   bool reboot(uint8_t id);
@@ -68,20 +69,33 @@ class DynamixelWorkbench
   bool goalPosition(uint8_t id, int32_t goal);
   bool goalSpeed(uint8_t id, int32_t goal);
 
+  bool getItemHandle(uint8_t id, const char* item_name, ItemHandle* handle);  // resolve item once for itemWrite/itemRead/sync
+
   bool itemWrite(uint8_t id, const char* item_name, int32_t value);  // write value to item
+  bool itemWrite(uint8_t id, ItemHandle handle, int32_t value);
   bool itemWrite(uint8_t id, uint16_t addr, uint8_t length, int32_t data);
   bool syncWrite(const char *item_name, int32_t* value);             // sync write
+  bool syncWrite(ItemHandle handle, int32_t* value);
   bool syncWrite(uint8_t *id, uint8_t id_num, const char *item_name, int32_t *data);
+  bool syncWrite(uint8_t *id, uint8_t id_num, ItemHandle handle, int32_t *data);
   bool bulkWrite(void);                                              // bulk write
 
   int32_t  itemRead(uint8_t id, const char* item_name);  // read value from item
+  bool     itemRead(uint8_t id, ItemHandle handle, int32_t *value);   // false when the read failed, *value is then left as it was
   int32_t  itemRead(uint8_t id, uint16_t addr, uint8_t length);
   int32_t* syncRead(const char* item_name);              // sync read
+  bool     syncRead(ItemHandle handle, int32_t *data);              // data[i] is the i-th Dynamixel of the driver, false when one did not answer
   int32_t  bulkRead(uint8_t id, const char* item_name);  // bulk read
 
   void addSyncWrite(const char* item_name);
   void addSyncRead(const char* item_name);
 
+  int8_t  addSyncWriteSession(uint8_t *id, uint8_t id_num, const char *item_name);                                              // returns session or -1
+  int8_t  addSyncReadSession(uint8_t *id, uint8_t id_num, const char *first_item_name, const char *last_item_name = NULL);     // returns session or -1
+  bool    syncWriteSession(uint8_t session, int32_t *data);                                                                     // data[i] goes to id[i]
+  uint8_t syncReadSession(uint8_t session);                                                                                     // returns the number of IDs answered
+  uint8_t getSyncReadSessionData(uint8_t session, ItemHandle handle, int32_t *data, bool *available = NULL);
+
   void initBulkWrite();
   void initBulkRead();
 
@@ -18,7 +18,11 @@
 
 #include "../../include/dynamixel_workbench_toolbox/dynamixel_driver.h"
 
-DynamixelDriver::DynamixelDriver() : tools_cnt_(0), sync_write_handler_cnt_(0), sync_read_handler_cnt_(0) {}
+DynamixelDriver::DynamixelDriver() : tools_cnt_(0),
+                                     sync_write_handler_cnt_(0),
+                                     sync_read_handler_cnt_(0),
+                                     sync_write_session_cnt_(0),
+                                     sync_read_session_cnt_(0) {}
 
 DynamixelDriver::~DynamixelDriver()
 {
@@ -50,7 +54,7 @@ void DynamixelDriver::setTools(uint16_t model_number, uint8_t id)
   }
   else
   {
-    if (!strncmp(tools_[tools_cnt_-1].dxl_info_[0].model_name, findModelName(model_number), strlen(findModelName(model_number))))
+    if (tools_[tools_cnt_-1].dxl_info_[0].model_num == model_number)
     {
       tools_[--tools_cnt_].addDXL(model_number, id);
     }
@@ -180,47 +184,69 @@ uint8_t DynamixelDriver::getTheNumberOfItem(uint8_t id)
 
 bool DynamixelDriver::scan(uint8_t *get_id, uint8_t *get_id_num, uint8_t range)
 {
-  uint8_t id = 0;
+  DXLScanInfo info[MAX_SCAN_NUM];
+  uint8_t info_num = 0;
+
+  if (scan(info, MAX_SCAN_NUM, &info_num, range) == false)
+    return false;
+
+  for (int i = 0; i < info_num; i++)
+    get_id[i] = info[i].id;
+
+  if (get_id_num != NULL)
+    *get_id_num = info_num;
+
+  return true;
+}
+
+bool DynamixelDriver::scan(DXLScanInfo *info, uint8_t max_info_num, uint8_t *info_num, uint8_t range, bool sweep_baud)
+{
+  // The most common baud rates come first
+  static const uint32_t baud_list[] = {57600, 1000000, 115200, 2000000, 3000000, 4000000, 9600};
+  const uint8_t baud_num = sizeof(baud_list) / sizeof(baud_list[0]);
+
+  uint32_t current_baud_rate = portHandler_->getBaudRate();
   uint8_t id_cnt = 0;
-  uint16_t model_number = 0;
-  float protocol_version = 2.0;
 
   tools_cnt_ = 0;
 
-  for (id = 1; id <= range; id++)
+  // The current baud rate is scanned first, then the others if sweep_baud is set
+  for (int i = -1; i < (sweep_baud ? baud_num : 0); i++)
   {
-    if (packetHandler_1->ping(portHandler_, id, &model_number) == COMM_SUCCESS)
-    {
-      get_id[id_cnt] = id;
-      setTools(model_number, id);
-      id_cnt++;
-      protocol_version = 1.0;
-    }
-  }
+    uint32_t baud_rate = current_baud_rate;
 
-  for (id = 1; id <= range; id++)
-  {
-    if (packetHandler_2->ping(portHandler_, id, &model_number) == COMM_SUCCESS)
+    if (i >= 0)
     {
-      get_id[id_cnt] = id;
-      setTools(model_number, id);
-      id_cnt++;
-      protocol_version = 2.0;
+      if (baud_list[i] == current_baud_rate || setBaudrate(baud_list[i]) == false)
+        continue;
+      baud_rate = baud_list[i];
     }
+
+    uint8_t cnt = id_cnt;
+
+    id_cnt += scanBus(packetHandler_2, range, &info[id_cnt], max_info_num - id_cnt);
+    id_cnt += scanBus(packetHandler_1, range, &info[id_cnt], max_info_num - id_cnt);
+
+    for (int j = cnt; j < id_cnt; j++)
+      info[j].baud_rate = baud_rate;
   }
 
   if (id_cnt == 0)
   {
+    setBaudrate(current_baud_rate);
     return false;
   }
-  else
-  {
-    *get_id_num = id_cnt;
-    if (setPacketHandler(protocol_version) == false)
-      return false;
 
-    return true;
-  }
+  *info_num = id_cnt;
+
+  // Talk to the Dynamixels found first, preferring protocol 2.0 at the same baud rate
+  if (setBaudrate(info[0].baud_rate) == false)
+    return false;
+
+  if (setPacketHandler(info[0].protocol_version) == false)
+    return false;
+
+  return true;
 }
 
 bool DynamixelDriver::ping(uint8_t id, uint16_t *get_model_number)
@@ -400,40 +426,24 @@ bool DynamixelDriver::reset(uint8_t id)
   }
 }
 
-bool DynamixelDriver::writeRegister(uint8_t id, const char *item_name, int32_t data)
+bool DynamixelDriver::getItemHandle(uint8_t id, const char *item_name, ItemHandle *handle)
 {
-  uint8_t error = 0;
-  int dxl_comm_result = COMM_TX_FAIL;
-
-  ControlTableItem *cti;
-  cti = tools_[getToolsFactor(id)].getControlItem(item_name);
+  return tools_[getToolsFactor(id)].getItemHandle(item_name, handle);
+}
 
-  if (cti->data_length == BYTE)
-  {
-    dxl_comm_result = packetHandler_->write1ByteTxRx(portHandler_, id, cti->address, (uint8_t)data, &error);
-  }
-  else if (cti->data_length == WORD)
-  {
-    dxl_comm_result = packetHandler_->write2ByteTxRx(portHandler_, id, cti->address, (uint16_t)data, &error);
-  }
-  else if (cti->data_length == DWORD)
-  {
-    dxl_comm_result = packetHandler_->write4ByteTxRx(portHandler_, id, cti->address, (uint32_t)data, &error);
-  }
+bool DynamixelDriver::writeRegister(uint8_t id, const char *item_name, int32_t data)
+{
+  ItemHandle handle;
 
-  if (dxl_comm_result == COMM_SUCCESS)
-  {
-    if (error != 0)
-    {
-      return false;
-    }
-  }
-  else
-  {
+  if (getItemHandle(id, item_name, &handle) == false)
     return false;
-  }
 
-  return true;
+  return writeRegister(id, handle.address, handle.data_length, data);
+}
+
+bool DynamixelDriver::writeRegister(uint8_t id, ItemHandle handle, int32_t data)
+{
+  return writeRegister(id, handle.address, handle.data_length, data);
 }
 
 bool DynamixelDriver::writeRegister(uint8_t id, uint16_t addr, uint8_t length, int32_t data)
@@ -471,55 +481,17 @@ bool DynamixelDriver::writeRegister(uint8_t id, uint16_t addr, uint8_t length, i
 
 bool DynamixelDriver::readRegister(uint8_t id, const char *item_name, int32_t *data)
 {
-  uint8_t error = 0;
-  int dxl_comm_result = COMM_RX_FAIL;
+  ItemHandle handle;
 
-  int8_t value_8_bit = 0;
-  int16_t value_16_bit = 0;
-  int32_t value_32_bit = 0;
-
-  ControlTableItem *cti;
-  cti = tools_[getToolsFactor(id)].getControlItem(item_name);
-
-  if (cti->data_length == BYTE)
-  {
-    dxl_comm_result = packetHandler_->read1ByteTxRx(portHandler_, id, cti->address, (uint8_t *)&value_8_bit, &error);
-  }
-  else if (cti->data_length == WORD)
-  {
-    dxl_comm_result = packetHandler_->read2ByteTxRx(portHandler_, id, cti->address, (uint16_t *)&value_16_bit, &error);
-  }
-  else if (cti->data_length == DWORD)
-  {
-    dxl_comm_result = packetHandler_->read4ByteTxRx(portHandler_, id, cti->address, (uint32_t *)&value_32_bit, &error);
-  }
-
-  if (dxl_comm_result == COMM_SUCCESS)
-  {
-    if (error != 0)
-    {
-      return false;
-    }
+  if (getItemHandle(id, item_name, &handle) == false)
+    return false;
 
-    if (cti->data_length == BYTE)
-    {
-      *data = value_8_bit;
-    }
-    else if (cti->data_length == WORD)
-    {
-      *data = value_16_bit;
-    }
-    else if (cti->data_length == DWORD)
-    {
-      *data = value_32_bit;
-    }
+  return readRegister(id, handle.address, handle.data_length, data);
+}
 
-    return true;
-  }
-  else
-  {
-    return false;
-  }
+bool DynamixelDriver::readRegister(uint8_t id, ItemHandle handle, int32_t *data)
+{
+  return readRegister(id, handle.address, handle.data_length, data);
 }
 
 bool DynamixelDriver::readRegister(uint8_t id, uint16_t addr, uint8_t length, int32_t *data)
@@ -594,6 +566,33 @@ bool DynamixelDriver::readRegister(uint8_t id, uint16_t length, uint8_t *data)
   }
 }
 
+uint8_t DynamixelDriver::scanBus(dynamixel::PacketHandler *packetHandler, uint8_t range, DXLScanInfo *info, uint8_t max_info_num)
+{
+  std::vector<uint8_t>  id_list;
+  std::vector<uint16_t> model_list;
+  std::vector<uint8_t>  firmware_list;
+  uint8_t id_cnt = 0;
+
+  if (packetHandler->broadcastPing(portHandler_, range, id_list, model_list, firmware_list) != COMM_SUCCESS)
+    return 0;
+
+  for (unsigned int i = 0; i < id_list.size() && id_cnt < max_info_num; i++)
+  {
+    if (id_list[i] > range)
+      continue;
+
+    info[id_cnt].id               = id_list[i];
+    info[id_cnt].model_number     = model_list[i];
+    info[id_cnt].firmware_version = firmware_list[i];
+    info[id_cnt].protocol_version = packetHandler->getProtocolVersion();
+
+    setTools(model_list[i], id_list[i]);
+    id_cnt++;
+  }
+
+  return id_cnt;
+}
+
 uint8_t DynamixelDriver::getToolsFactor(uint8_t id)
 {
   for (int i = 0; i < tools_cnt_; i++)
@@ -606,101 +605,19 @@ uint8_t DynamixelDriver::getToolsFactor(uint8_t id)
       }
     }
   }
-}
 
-const char *DynamixelDriver::findModelName(uint16_t model_num)
-{
-  uint16_t num = model_num;
-  static const char* model_name = NULL;
-
-  if (num == AX_12A)
-    model_name = "AX-12A";
-  else if (num == AX_12W)
-    model_name = "AX-12W";
-  else if (num == AX_18A)
-    model_name = "AX-18A";
-
-  else if (num == RX_24F)
-    model_name = "RX-24F";
-  else if (num == RX_28)
-    model_name = "RX-28";
-  else if (num == RX_64)
-    model_name = "RX-64";
-
-  else if (num == EX_106)
-    model_name = "EX-106";
-
-  else if (num == MX_12W)
-    model_name = "MX-12W";
-  else if (num == MX_28)
-    model_name = "MX-28";
-  else if (num == MX_28_2)
-    model_name = "MX-28-2";
-  else if (num == MX_64)
-    model_name = "MX-64";
-  else if (num == MX_64_2)
-    model_name = "MX-64-2";
-  else if (num == MX_106)
-    model_name = "MX-106";
-  else if (num == MX_106_2)
-    model_name = "MX-106-2";
-
-  else if (num == XL_320)
-    model_name = "XL-320";
-  else if (num == XL430_W250)
-    model_name = "XL430-W250";
-
-  else if (num == XM430_W210)
-    model_name = "XM430-W210";
-  else if (num == XM430_W350)
-    model_name = "XM430-W350";
-  else if (num == XM540_W150)
-    model_name = "XM540-W150";
-  else if (num == XM540_W270)
-    model_name = "XM540-W270";
-
-  else if (num == XH430_V210)
-    model_name = "XH430-V210";
-  else if (num == XH430_V350)
-    model_name = "XH430-V350";
-  else if (num == XH430_W210)
-    model_name = "XH430-W210";
-  else if (num == XH430_W350)
-    model_name = "XH430-W350";
-
-  else if (num == PRO_L42_10_S300_R)
-    model_name = "PRO-L42-10-S300-R";
-  else if (num == PRO_L54_30_S400_R)
-    model_name = "PRO-L54-30-S400-R";
-  else if (num == PRO_L54_30_S500_R)
-    model_name = "PRO-L54-30-S500-R";
-  else if (num == PRO_L54_50_S290_R)
-    model_name = "PRO-L54-50-S290-R";
-  else if (num == PRO_L54_50_S500_R)
-    model_name = "PRO-L54-50-S500-R";
-
-  else if (num == PRO_M42_10_S260_R)
-    model_name = "PRO-M42-10-S260-R";
-  else if (num == PRO_M54_40_S250_R)
-    model_name = "PRO-M54-40-S250-R";
-  else if (num == PRO_M54_60_S250_R)
-    model_name = "PRO-M54-60-S250-R";
-
-  else if (num == PRO_H42_20_S300_R)
-    model_name = "PRO-H42-20-S300-R";
-  else if (num == PRO_H54_100_S500_R)
-    model_name = "PRO-H54-100-S500-R";
-  else if (num == PRO_H54_200_S500_R)
-    model_name = "PRO-H54-200-S500-R";
-
-  return model_name;
+  return 0;
 }
 
+
 void DynamixelDriver::addSyncWrite(const char *item_name)
 {
   ControlTableItem *cti;
   cti = tools_[0].getControlItem(item_name);
 
+  if (cti == NULL || sync_write_handler_cnt_ >= MAX_HANDLER_NUM)
+    return;
+
   syncWriteHandler_[sync_write_handler_cnt_].cti = cti;
 
   syncWriteHandler_[sync_write_handler_cnt_++].groupSyncWrite = new dynamixel::GroupSyncWrite(portHandler_,
@@ -711,160 +628,251 @@ void DynamixelDriver::addSyncWrite(const char *item_name)
 
 bool DynamixelDriver::syncWrite(const char *item_name, int32_t *data)
 {
-  bool dxl_addparam_result = false;
-  int dxl_comm_result = COMM_TX_FAIL;
+  return syncWrite(findSyncWriteHandler(item_name), data);
+}
+
+bool DynamixelDriver::syncWrite(ItemHandle handle, int32_t *data)
+{
+  return syncWrite(findSyncWriteHandler(handle), data);
+}
+
+bool DynamixelDriver::syncWrite(uint8_t *id, uint8_t id_num, const char *item_name, int32_t *data)
+{
+  return syncWrite(findSyncWriteHandler(item_name), id, id_num, data);
+}
+
+bool DynamixelDriver::syncWrite(uint8_t *id, uint8_t id_num, ItemHandle handle, int32_t *data)
+{
+  return syncWrite(findSyncWriteHandler(handle), id, id_num, data);
+}
+
+void DynamixelDriver::addSyncRead(const char *item_name)
+{
+  ControlTableItem *cti;
+  cti = tools_[0].getControlItem(item_name);
+
+  if (cti == NULL || sync_read_handler_cnt_ >= MAX_HANDLER_NUM)
+    return;
+
+  syncReadHandler_[sync_read_handler_cnt_].cti = cti;
+  
+  syncReadHandler_[sync_read_handler_cnt_++].groupSyncRead = new dynamixel::GroupSyncRead(portHandler_,
+                                                                                          packetHandler_,
+                                                                                          cti->address,
+                                                                                          cti->data_length);
+}
+
+bool DynamixelDriver::syncRead(const char *item_name, int32_t *data)
+{
+  return syncRead(findSyncReadHandler(item_name), data);
+}
+
+bool DynamixelDriver::syncRead(ItemHandle handle, int32_t *data)
+{
+  return syncRead(findSyncReadHandler(handle), data);
+}
 
+int8_t DynamixelDriver::addSyncWriteSession(uint8_t *id, uint8_t id_num, const char *item_name)
+{
+  ItemHandle handle;
   uint8_t data_byte[4] = {0, };
-  uint8_t cnt = 0;
 
-  SyncWriteHandler swh;
+  if (sync_write_session_cnt_ >= MAX_SESSION_NUM || id_num == 0 || id_num > MAX_SESSION_ID_NUM)
+    return -1;
 
-  for (int index = 0; index < sync_write_handler_cnt_; index++)
+  if (getItemHandle(id[0], item_name, &handle) == false)
+    return -1;
+
+  SyncWriteSession *sws = &syncWriteSession_[sync_write_session_cnt_];
+
+  sws->item           = handle;
+  sws->id_num         = id_num;
+  sws->groupSyncWrite = new dynamixel::GroupSyncWrite(portHandler_, packetHandler_, handle.address, handle.data_length);
+
+  for (int i = 0; i < id_num; i++)
   {
-    if (!strncmp(syncWriteHandler_[index].cti->item_name, item_name, strlen(item_name)))
+    sws->id[i] = id[i];
+    if (sws->groupSyncWrite->addParam(id[i], data_byte) != true)
     {
-      swh = syncWriteHandler_[index];
+      delete sws->groupSyncWrite;
+      return -1;
     }
   }
 
-  for (int i = 0; i < tools_cnt_; i++)
-  {
-    for (int j = 0; j < tools_[i].dxl_info_cnt_; j++)
-    {
-      data_byte[0] = DXL_LOBYTE(DXL_LOWORD(data[cnt]));
-      data_byte[1] = DXL_HIBYTE(DXL_LOWORD(data[cnt]));
-      data_byte[2] = DXL_LOBYTE(DXL_HIWORD(data[cnt]));
-      data_byte[3] = DXL_HIBYTE(DXL_HIWORD(data[cnt]));
+  sws->groupSyncWrite->freezeParam();
 
-      dxl_addparam_result = swh.groupSyncWrite->addParam(tools_[i].dxl_info_[j].id, (uint8_t *)&data_byte);
-      if (dxl_addparam_result != true)
-      {
-        return false;
-      }
+  return sync_write_session_cnt_++;
+}
 
-      cnt++;
-    }
-  }
+bool DynamixelDriver::syncWriteSession(uint8_t session, int32_t *data)
+{
+  uint8_t data_byte[4] = {0, };
 
-  dxl_comm_result = swh.groupSyncWrite->txPacket();
-  if (dxl_comm_result != COMM_SUCCESS)
-  {
+  if (session >= sync_write_session_cnt_)
     return false;
+
+  SyncWriteSession *sws = &syncWriteSession_[session];
+
+  for (int i = 0; i < sws->id_num; i++)
+  {
+    data_byte[0] = DXL_LOBYTE(DXL_LOWORD(data[i]));
+    data_byte[1] = DXL_HIBYTE(DXL_LOWORD(data[i]));
+    data_byte[2] = DXL_LOBYTE(DXL_HIWORD(data[i]));
+    data_byte[3] = DXL_HIBYTE(DXL_HIWORD(data[i]));
+
+    sws->groupSyncWrite->changeParam(sws->id[i], data_byte);
   }
-  swh.groupSyncWrite->clearParam();
+
+  if (sws->groupSyncWrite->txPacket() != COMM_SUCCESS)
+    return false;
+
   return true;
 }
 
-bool DynamixelDriver::syncWrite(uint8_t *id, uint8_t id_num, const char *item_name, int32_t *data)
+int8_t DynamixelDriver::addSyncReadSession(uint8_t *id, uint8_t id_num, const char *first_item_name, const char *last_item_name)
 {
-  bool dxl_addparam_result = false;
-  int dxl_comm_result = COMM_TX_FAIL;
+  ItemHandle first, last;
 
-  uint8_t data_byte[4] = {0, };
-  uint8_t cnt = 0;
+  if (sync_read_session_cnt_ >= MAX_SESSION_NUM || id_num == 0 || id_num > MAX_SESSION_ID_NUM)
+    return -1;
 
-  SyncWriteHandler swh;
+  if (getItemHandle(id[0], first_item_name, &first) == false)
+    return -1;
 
-  for (int index = 0; index < sync_write_handler_cnt_; index++)
+  if (last_item_name == NULL)
+    last = first;
+  else if (getItemHandle(id[0], last_item_name, &last) == false)
+    return -1;
+
+  if (last.address < first.address)
   {
-    if (!strncmp(syncWriteHandler_[index].cti->item_name, item_name, strlen(item_name)))
-    {
-      swh = syncWriteHandler_[index];
-    }
+    ItemHandle temp = first;
+    first = last;
+    last  = temp;
   }
 
+  SyncReadSession *srs = &syncReadSession_[sync_read_session_cnt_];
+
+  srs->address       = first.address;
+  srs->data_length   = (last.address + last.data_length) - first.address;
+  srs->id_num        = id_num;
+  srs->data          = NULL;
+  srs->groupSyncRead = NULL;
+
   for (int i = 0; i < id_num; i++)
   {
-    data_byte[0] = DXL_LOBYTE(DXL_LOWORD(data[cnt]));
-    data_byte[1] = DXL_HIBYTE(DXL_LOWORD(data[cnt]));
-    data_byte[2] = DXL_LOBYTE(DXL_HIWORD(data[cnt]));
-    data_byte[3] = DXL_HIBYTE(DXL_HIWORD(data[cnt]));
+    srs->id[i]        = id[i];
+    srs->available[i] = false;
+  }
+
+  if (packetHandler_->getProtocolVersion() == 2.0)
+  {
+    srs->groupSyncRead = new dynamixel::GroupSyncRead(portHandler_, packetHandler_, srs->address, srs->data_length);
 
-    dxl_addparam_result = swh.groupSyncWrite->addParam(id[i], (uint8_t *)&data_byte);
-    if (dxl_addparam_result != true)
+    for (int i = 0; i < id_num; i++)
     {
-      return false;
+      if (srs->groupSyncRead->addParam(id[i]) != true)
+      {
+        delete srs->groupSyncRead;
+        return -1;
+      }
     }
-    cnt++;
-  }
 
-  dxl_comm_result = swh.groupSyncWrite->txPacket();
-  if (dxl_comm_result != COMM_SUCCESS)
+    srs->groupSyncRead->freezeParam();
+  }
+  else
   {
-    return false;
+    srs->data = new uint8_t[id_num * srs->data_length];
   }
-  swh.groupSyncWrite->clearParam();
-  return true;
-}
 
-void DynamixelDriver::addSyncRead(const char *item_name)
-{
-  ControlTableItem *cti;
-  cti = tools_[0].getControlItem(item_name);
-
-  syncReadHandler_[sync_read_handler_cnt_].cti = cti;
-  
-  syncReadHandler_[sync_read_handler_cnt_++].groupSyncRead = new dynamixel::GroupSyncRead(portHandler_,
-                                                                                          packetHandler_,
-                                                                                          cti->address,
-                                                                                          cti->data_length);
+  return sync_read_session_cnt_++;
 }
 
-bool DynamixelDriver::syncRead(const char *item_name, int32_t *data)
+uint8_t DynamixelDriver::syncReadSession(uint8_t session)
 {
-  int dxl_comm_result = COMM_RX_FAIL;
-  bool dxl_addparam_result = false;
-  bool dxl_getdata_result = false;
+  uint8_t available_cnt = 0;
 
-  int index = 0;
+  if (session >= sync_read_session_cnt_)
+    return 0;
 
-  SyncReadHandler srh;
-  
-  for (int index = 0; index < sync_read_handler_cnt_; index++)
+  SyncReadSession *srs = &syncReadSession_[session];
+
+  if (srs->groupSyncRead != NULL)
   {
-    if (!strncmp(syncReadHandler_[index].cti->item_name, item_name, strlen(item_name)))
+    srs->groupSyncRead->txRxPacket();
+
+    for (int i = 0; i < srs->id_num; i++)
     {
-      srh = syncReadHandler_[index];
+      srs->available[i] = (srs->groupSyncRead->getResult(srs->id[i]) == COMM_SUCCESS);
+      if (srs->available[i])
+        available_cnt++;
     }
   }
-
-  for (int i = 0; i < tools_cnt_; i++)
+  else
   {
-    for (int j = 0; j < tools_[i].dxl_info_cnt_; j++)
+    for (int i = 0; i < srs->id_num; i++)
     {
-      dxl_addparam_result = srh.groupSyncRead->addParam(tools_[i].dxl_info_[j].id);
-      if (dxl_addparam_result != true)
-        return false;
+      uint8_t error = 0;
+      int dxl_comm_result = packetHandler_->readTxRx(portHandler_, srs->id[i], srs->address, srs->data_length, &srs->data[i * srs->data_length], &error);
+
+      srs->available[i] = (dxl_comm_result == COMM_SUCCESS && error == 0);
+      if (srs->available[i])
+        available_cnt++;
     }
   }
 
-  dxl_comm_result = srh.groupSyncRead->txRxPacket();
-  if (dxl_comm_result != COMM_SUCCESS)
-  {
-    return false;
-  }
+  return available_cnt;
+}
 
-  for (int i = 0; i < tools_cnt_; i++)
+uint8_t DynamixelDriver::getSyncReadSessionData(uint8_t session, ItemHandle handle, int32_t *data, bool *available)
+{
+  uint8_t available_cnt = 0;
+
+  if (session >= sync_read_session_cnt_)
+    return 0;
+
+  SyncReadSession *srs = &syncReadSession_[session];
+
+  if (handle.address < srs->address || handle.address + handle.data_length > srs->address + srs->data_length)
+    return 0;
+
+  for (int i = 0; i < srs->id_num; i++)
   {
-    for (int j = 0; j < tools_[i].dxl_info_cnt_; j++)
-    {
-      uint8_t id = tools_[i].dxl_info_[j].id;
+    uint32_t value = 0;
 
-      dxl_getdata_result = srh.groupSyncRead->isAvailable(id, srh.cti->address, srh.cti->data_length);
-      if (dxl_getdata_result)
+    if (srs->available[i])
+    {
+      if (srs->groupSyncRead != NULL)
       {
-        data[index++] = srh.groupSyncRead->getData(id, srh.cti->address, srh.cti->data_length);
+        value = srs->groupSyncRead->getData(srs->id[i], handle.address, handle.data_length);
       }
       else
       {
-        return false;
+        uint8_t *ptr = &srs->data[i * srs->data_length + (handle.address - srs->address)];
+
+        if (handle.data_length == BYTE)
+          value = ptr[0];
+        else if (handle.data_length == WORD)
+          value = DXL_MAKEWORD(ptr[0], ptr[1]);
+        else if (handle.data_length == DWORD)
+          value = DXL_MAKEDWORD(DXL_MAKEWORD(ptr[0], ptr[1]), DXL_MAKEWORD(ptr[2], ptr[3]));
       }
+
+      if (handle.data_length == BYTE)
+        data[i] = (int8_t)value;
+      else if (handle.data_length == WORD)
+        data[i] = (int16_t)value;
+      else
+        data[i] = (int32_t)value;
+
+      available_cnt++;
     }
-  }
 
-  srh.groupSyncRead->clearParam();
+    if (available != NULL)
+      available[i] = srs->available[i];
+  }
 
-  return true;
+  return available_cnt;
 }
 
 void DynamixelDriver::initBulkWrite()
@@ -879,6 +887,8 @@ bool DynamixelDriver::addBulkWriteParam(uint8_t id, const char *item_name, int32
 
   ControlTableItem *cti;
   cti = tools_[getToolsFactor(id)].getControlItem(item_name);
+  if (cti == NULL)
+    return false;
 
   data_byte[0] = DXL_LOBYTE(DXL_LOWORD(data));
   data_byte[1] = DXL_HIBYTE(DXL_LOWORD(data));
@@ -920,6 +930,8 @@ bool DynamixelDriver::addBulkReadParam(uint8_t id, const char *item_name)
 
   ControlTableItem *cti;
   cti = tools_[getToolsFactor(id)].getControlItem(item_name);
+  if (cti == NULL)
+    return false;
 
   dxl_addparam_result = groupBulkRead_->addParam(id, cti->address, cti->data_length);
   if (dxl_addparam_result != true)
@@ -948,6 +960,8 @@ bool DynamixelDriver::bulkRead(uint8_t id, const char *item_name, int32_t *data)
   bool dxl_getdata_result = false;
   ControlTableItem *cti;
   cti = tools_[getToolsFactor(id)].getControlItem(item_name);
+  if (cti == NULL)
+    return false;
 
   dxl_getdata_result = groupBulkRead_->isAvailable(id, cti->address, cti->data_length);
   if (dxl_getdata_result != true)
@@ -1076,6 +1090,183 @@ float DynamixelDriver::convertValue2Torque(uint8_t id, int16_t value)
   return torque;
 }
 
+SyncWriteHandler *DynamixelDriver::findSyncWriteHandler(const char *item_name)
+{
+  for (int index = 0; index < sync_write_handler_cnt_; index++)
+  {
+    if (!strcmp(syncWriteHandler_[index].cti->item_name, item_name))
+      return &syncWriteHandler_[index];
+  }
+
+  return NULL;
+}
+
+SyncWriteHandler *DynamixelDriver::findSyncWriteHandler(ItemHandle handle)
+{
+  for (int index = 0; index < sync_write_handler_cnt_; index++)
+  {
+    if (syncWriteHandler_[index].cti->address == handle.address &&
+        syncWriteHandler_[index].cti->data_length == handle.data_length)
+      return &syncWriteHandler_[index];
+  }
+
+  return NULL;
+}
+
+SyncReadHandler *DynamixelDriver::findSyncReadHandler(const char *item_name)
+{
+  for (int index = 0; index < sync_read_handler_cnt_; index++)
+  {
+    if (!strcmp(syncReadHandler_[index].cti->item_name, item_name))
+      return &syncReadHandler_[index];
+  }
+
+  return NULL;
+}
+
+SyncReadHandler *DynamixelDriver::findSyncReadHandler(ItemHandle handle)
+{
+  for (int index = 0; index < sync_read_handler_cnt_; index++)
+  {
+    if (syncReadHandler_[index].cti->address == handle.address &&
+        syncReadHandler_[index].cti->data_length == handle.data_length)
+      return &syncReadHandler_[index];
+  }
+
+  return NULL;
+}
+
+bool DynamixelDriver::syncWrite(SyncWriteHandler *swh, int32_t *data)
+{
+  bool dxl_addparam_result = false;
+  int dxl_comm_result = COMM_TX_FAIL;
+
+  uint8_t data_byte[4] = {0, };
+  uint8_t cnt = 0;
+
+  if (swh == NULL)
+    return false;
+
+  for (int i = 0; i < tools_cnt_; i++)
+  {
+    for (int j = 0; j < tools_[i].dxl_info_cnt_; j++)
+    {
+      data_byte[0] = DXL_LOBYTE(DXL_LOWORD(data[cnt]));
+      data_byte[1] = DXL_HIBYTE(DXL_LOWORD(data[cnt]));
+      data_byte[2] = DXL_LOBYTE(DXL_HIWORD(data[cnt]));
+      data_byte[3] = DXL_HIBYTE(DXL_HIWORD(data[cnt]));
+
+      dxl_addparam_result = swh->groupSyncWrite->addParam(tools_[i].dxl_info_[j].id, (uint8_t *)&data_byte);
+      if (dxl_addparam_result != true)
+      {
+        swh->groupSyncWrite->clearParam();
+        return false;
+      }
+
+      cnt++;
+    }
+  }
+
+  dxl_comm_result = swh->groupSyncWrite->txPacket();
+  swh->groupSyncWrite->clearParam();
+  if (dxl_comm_result != COMM_SUCCESS)
+  {
+    return false;
+  }
+
+  return true;
+}
+
+bool DynamixelDriver::syncWrite(SyncWriteHandler *swh, uint8_t *id, uint8_t id_num, int32_t *data)
+{
+  bool dxl_addparam_result = false;
+  int dxl_comm_result = COMM_TX_FAIL;
+
+  uint8_t data_byte[4] = {0, };
+
+  if (swh == NULL)
+    return false;
+
+  for (int i = 0; i < id_num; i++)
+  {
+    data_byte[0] = DXL_LOBYTE(DXL_LOWORD(data[i]));
+    data_byte[1] = DXL_HIBYTE(DXL_LOWORD(data[i]));
+    data_byte[2] = DXL_LOBYTE(DXL_HIWORD(data[i]));
+    data_byte[3] = DXL_HIBYTE(DXL_HIWORD(data[i]));
+
+    dxl_addparam_result = swh->groupSyncWrite->addParam(id[i], (uint8_t *)&data_byte);
+    if (dxl_addparam_result != true)
+    {
+      swh->groupSyncWrite->clearParam();
+      return false;
+    }
+  }
+
+  dxl_comm_result = swh->groupSyncWrite->txPacket();
+  swh->groupSyncWrite->clearParam();
+  if (dxl_comm_result != COMM_SUCCESS)
+  {
+    return false;
+  }
+
+  return true;
+}
+
+bool DynamixelDriver::syncRead(SyncReadHandler *srh, int32_t *data)
+{
+  int dxl_comm_result = COMM_RX_FAIL;
+  bool dxl_addparam_result = false;
+  bool dxl_getdata_result = false;
+
+  int index = 0;
+
+  if (srh == NULL)
+    return false;
+
+  for (int i = 0; i < tools_cnt_; i++)
+  {
+    for (int j = 0; j < tools_[i].dxl_info_cnt_; j++)
+    {
+      dxl_addparam_result = srh->groupSyncRead->addParam(tools_[i].dxl_info_[j].id);
+      if (dxl_addparam_result != true)
+      {
+        srh->groupSyncRead->clearParam();
+        return false;
+      }
+    }
+  }
+
+  dxl_comm_result = srh->groupSyncRead->txRxPacket();
+  if (dxl_comm_result != COMM_SUCCESS)
+  {
+    srh->groupSyncRead->clearParam();
+    return false;
+  }
+
+  for (int i = 0; i < tools_cnt_; i++)
+  {
+    for (int j = 0; j < tools_[i].dxl_info_cnt_; j++)
+    {
+      uint8_t id = tools_[i].dxl_info_[j].id;
+
+      dxl_getdata_result = srh->groupSyncRead->isAvailable(id, srh->cti->address, srh->cti->data_length);
+      if (dxl_getdata_result)
+      {
+        data[index++] = srh->groupSyncRead->getData(id, srh->cti->address, srh->cti->data_length);
+      }
+      else
+      {
+        srh->groupSyncRead->clearParam();
+        return false;
+      }
+    }
+  }
+
+  srh->groupSyncRead->clearParam();
+
+  return true;
+}
+
 void DynamixelDriver::millis(uint16_t msec)
 {
 #if defined(__OPENCR__) || defined(__OPENCM904__)
@@ -16,6 +16,8 @@
 
 /* Authors: Taehun Lim (Darby) */
 
+#include <string.h>
+
 #include "../../include/dynamixel_workbench_toolbox/dynamixel_item.h"
 
 static uint8_t the_number_of_item = 0;
@@ -28,6 +30,57 @@ static ControlTableItem item[60]  = {0, };
 
 static ModelInfo model_info = {0.0, };
 
+static const ModelName model_name_table[] =
+{
+  {AX_12A,             "AX-12A"},
+  {AX_12W,             "AX-12W"},
+  {AX_18A,             "AX-18A"},
+
+  {RX_10,              "RX-10"},
+  {RX_24F,             "RX-24F"},
+  {RX_28,              "RX-28"},
+  {RX_64,              "RX-64"},
+
+  {EX_106,             "EX-106"},
+
+  {MX_12W,             "MX-12W"},
+  {MX_28,              "MX-28"},
+  {MX_28_2,            "MX-28-2"},
+  {MX_64,              "MX-64"},
+  {MX_64_2,            "MX-64-2"},
+  {MX_106,             "MX-106"},
+  {MX_106_2,           "MX-106-2"},
+
+  {XL_320,             "XL-320"},
+  {XL430_W250,         "XL430-W250"},
+
+  {XM430_W210,         "XM430-W210"},
+  {XM430_W350,         "XM430-W350"},
+  {XM540_W150,         "XM540-W150"},
+  {XM540_W270,         "XM540-W270"},
+
+  {XH430_V210,         "XH430-V210"},
+  {XH430_V350,         "XH430-V350"},
+  {XH430_W210,         "XH430-W210"},
+  {XH430_W350,         "XH430-W350"},
+
+  {PRO_L42_10_S300_R,  "PRO-L42-10-S300-R"},
+  {PRO_L54_30_S400_R,  "PRO-L54-30-S400-R"},
+  {PRO_L54_30_S500_R,  "PRO-L54-30-S500-R"},
+  {PRO_L54_50_S290_R,  "PRO-L54-50-S290-R"},
+  {PRO_L54_50_S500_R,  "PRO-L54-50-S500-R"},
+
+  {PRO_M42_10_S260_R,  "PRO-M42-10-S260-R"},
+  {PRO_M54_40_S250_R,  "PRO-M54-40-S250-R"},
+  {PRO_M54_60_S250_R,  "PRO-M54-60-S250-R"},
+
+  {PRO_H42_20_S300_R,  "PRO-H42-20-S300-R"},
+  {PRO_H54_100_S500_R, "PRO-H54-100-S500-R"},
+  {PRO_H54_200_S500_R, "PRO-H54-200-S500-R"},
+};
+
+static const uint8_t the_number_of_model = sizeof(model_name_table) / sizeof(model_name_table[0]);
+
 static void setAXItem(void)
 {
 #if defined(__OPENCR__) || defined(__OPENCM904__)
@@ -1347,3 +1400,25 @@ uint8_t getTheNumberOfControlItem()
 {
   return the_number_of_item;
 }
+
+const char* findModelName(uint16_t model_number)
+{
+  for (int num = 0; num < the_number_of_model; num++)
+  {
+    if (model_name_table[num].number == model_number)
+      return model_name_table[num].name;
+  }
+
+  return NULL;
+}
+
+uint16_t findModelNumber(const char* model_name)
+{
+  for (int num = 0; num < the_number_of_model; num++)
+  {
+    if (!strcmp(model_name_table[num].name, model_name))
+      return model_name_table[num].number;
+  }
+
+  return 0;
+}
@@ -61,88 +61,8 @@ void DynamixelTool::addDXL(uint16_t model_number, uint8_t id)
 }
 
 void DynamixelTool::setControlTable(const char *model_name)
-{  
-  const char* name = model_name;
-
-  if (!strncmp(name, "AX-12A", strlen(name))) 
-    setControlTable(AX_12A);
-  else if (!strncmp(name, "AX-12W", strlen(name)))
-    setControlTable(AX_12W);
-  else if (!strncmp(name, "AX-18A", strlen(name)))
-    setControlTable(AX_18A);
-
-  else if (!strncmp(name, "RX-24F", strlen(name)))
-    setControlTable(RX_24F);
-  else if (!strncmp(name, "RX-28", strlen(name)))
-    setControlTable(RX_28);
-  else if (!strncmp(name, "RX-64", strlen(name)))
-    setControlTable(RX_64);
-
-  else if (!strncmp(name, "EX-106", strlen(name)))
-    setControlTable(EX_106);
-
-  else if (!strncmp(name, "MX-12W", strlen(name)))
-    setControlTable(MX_12W);
-  else if (!strncmp(name, "MX-28", strlen(name)))
-    setControlTable(MX_28);
-  else if (!strncmp(name, "MX-28-2", strlen(name)))
-    setControlTable(MX_28_2);
-  else if (!strncmp(name, "MX-64", strlen(name)))
-    setControlTable(MX_64);
-  else if (!strncmp(name, "MX-64-2", strlen(name)))
-    setControlTable(MX_64_2);
-  else if (!strncmp(name, "MX-106", strlen(name)))
-    setControlTable(MX_106);
-  else if (!strncmp(name, "MX-106-2", strlen(name)))
-    setControlTable(MX_106_2);
-
-  else if (!strncmp(name, "XL-320", strlen(name)))
-    setControlTable(XL_320);
-  else if (!strncmp(name, "XL430-W250", strlen(name)))
-    setControlTable(XL430_W250);
-
-  else if (!strncmp(name, "XM430-W210", strlen(name)))
-    setControlTable(XM430_W210);
-  else if (!strncmp(name, "XM430-W350", strlen(name)))
-    setControlTable(XM430_W350);
-  else if (!strncmp(name, "XM540-W150", strlen(name)))
-    setControlTable(XM540_W150);
-  else if (!strncmp(name, "XM540-W270", strlen(name)))
-    setControlTable(XM540_W270);
-
-  else if (!strncmp(name, "XH430-V210", strlen(name)))
-    setControlTable(XH430_V210);
-  else if (!strncmp(name, "XH430-V350", strlen(name)))
-    setControlTable(XH430_V350);
-  else if (!strncmp(name, "XH430-W210", strlen(name)))
-    setControlTable(XH430_W210);
-  else if (!strncmp(name, "XH430-W350", strlen(name)))
-    setControlTable(XH430_W350);
-
-  else if (!strncmp(name, "PRO-L42-10-S300-R", strlen(name)))
-    setControlTable(PRO_L42_10_S300_R);
-  else if (!strncmp(name, "PRO-L54-30-S400-R", strlen(name)))
-    setControlTable(PRO_L54_30_S400_R);
-  else if (!strncmp(name, "PRO-L54-30-S500-R", strlen(name)))
-    setControlTable(PRO_L54_30_S500_R);
-  else if (!strncmp(name, "PRO-L54-50-S290-R", strlen(name)))
-    setControlTable(PRO_L54_50_S290_R);
-  else if (!strncmp(name, "PRO-L54-50-S500-R", strlen(name)))
-    setControlTable(PRO_L54_50_S500_R);
-
-  else if (!strncmp(name, "PRO-M42-10-S260-R", strlen(name)))
-    setControlTable(PRO_M42_10_S260_R);
-  else if (!strncmp(name, "PRO-M54-40-S250-R", strlen(name)))
-    setControlTable(PRO_M54_40_S250_R);
-  else if (!strncmp(name, "PRO-M54-60-S250-R", strlen(name)))
-    setControlTable(PRO_M54_60_S250_R);
-
-  else if (!strncmp(name, "PRO-H42-20-S300-R", strlen(name)))
-    setControlTable(PRO_H42_20_S300_R);
-  else if (!strncmp(name, "PRO-H54-100-S500-R", strlen(name)))
-    setControlTable(PRO_H54_100_S500_R);
-  else if (!strncmp(name, "PRO-H54-200-S500-R", strlen(name)))
-    setControlTable(PRO_H54_200_S500_R);
+{
+  setControlTable(findModelNumber(model_name));
 }
 
 void DynamixelTool::setControlTable(uint16_t model_number)
@@ -168,176 +88,18 @@ void DynamixelTool::setControlTable(uint16_t model_number)
 
 void DynamixelTool::setModelName(uint16_t model_number)
 {
-  uint16_t num = model_number;
-
-  if (num == AX_12A)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "AX-12A");
-  else if (num == AX_12W)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "AX-12W");
-  else if (num == AX_18A)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "AX-18A");
-
-  else if (num == RX_10)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "RX-10");
-  else if (num == RX_24F)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "RX-24F");
-  else if (num == RX_28)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "RX-28");
-  else if (num == RX_64)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "RX-64");
-
-  else if (num == EX_106)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "EX-106");
-
-  else if (num == MX_12W)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "MX-12W");
-  else if (num == MX_28)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "MX-28");
-  else if (num == MX_28_2)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "MX-28-2");
-  else if (num == MX_64)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "MX-64");
-  else if (num == MX_64_2)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "MX-64-2");
-  else if (num == MX_106)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "MX-106");
-  else if (num == MX_106_2)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "MX-106-2");
-
-  else if (num == XL_320)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XL-320");
-  else if (num == XL430_W250)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XL430-W250");
-
-  else if (num == XM430_W210)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XM430-W210");
-  else if (num == XM430_W350)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XM430-W350");
-  else if (num == XM540_W150)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XM540-W150");
-  else if (num == XM540_W270)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XM540-W270");
-
-  else if (num == XH430_V210)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XH430-V210");
-  else if (num == XH430_V350)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XH430-V350");
-  else if (num == XH430_W210)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XH430-W210");
-  else if (num == XH430_W350)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "XH430-W350");
-
-  else if (num == PRO_L42_10_S300_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-L42-10-S300-R");
-  else if (num == PRO_L54_30_S400_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-L54-30-S400-R");
-  else if (num == PRO_L54_30_S500_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-L54-30-S500-R");
-  else if (num == PRO_L54_50_S290_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-L54-50-S290-R");
-  else if (num == PRO_L54_50_S500_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-L54-50-S500-R");
-
-  else if (num == PRO_M42_10_S260_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-M42-10-S260-R");
-  else if (num == PRO_M54_40_S250_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-M54-40-S250-R");
-  else if (num == PRO_M54_60_S250_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-M54-60-S250-R");
-
-  else if (num == PRO_H42_20_S300_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-H42-20-S300-R");
-  else if (num == PRO_H54_100_S500_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-H54-100-S500-R");
-  else if (num == PRO_H54_200_S500_R)
-    strcpy(dxl_info_[dxl_info_cnt_].model_name, "PRO-H54-200-S500-R");
+  const char* name = findModelName(model_number);
+
+  if (name != NULL)
+    strcpy(dxl_info_[dxl_info_cnt_].model_name, name);
 }
 
 void DynamixelTool::setModelNum(const char* model_name)
 {
-  const char* name = model_name;
-
-  if (!strncmp(name, "AX-12A", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = AX_12A;
-  else if (!strncmp(name, "AX-12W", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = AX_12W;
-  else if (!strncmp(name, "AX-18A", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = AX_18A;
-
-  else if (!strncmp(name, "RX-10", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = RX_10;
-  else if (!strncmp(name, "RX-24F", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = RX_24F;
-  else if (!strncmp(name, "RX-28", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = RX_28;
-  else if (!strncmp(name, "RX-64", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = RX_64;
-
-  else if (!strncmp(name, "EX-106", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = EX_106;
-
-  else if (!strncmp(name, "MX-12W", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = MX_12W;
-  else if (!strncmp(name, "MX-28", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = MX_28;
-  else if (!strncmp(name, "MX-28-2", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = MX_28_2;
-  else if (!strncmp(name, "MX-64", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = MX_64;
-  else if (!strncmp(name, "MX-64-2", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = MX_64_2;
-  else if (!strncmp(name, "MX-106", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = MX_106;
-  else if (!strncmp(name, "MX-106-2", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = MX_106_2;
-
-  else if (!strncmp(name, "XL-320", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XL_320;
-  else if (!strncmp(name, "XL430-W250", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XL430_W250;
-
-  else if (!strncmp(name, "XM430-W210", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XM430_W210;
-  else if (!strncmp(name, "XM430-W350", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XM430_W350;
-  else if (!strncmp(name, "XM540-W150", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XM540_W150;
-  else if (!strncmp(name, "XM540-W270", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XM540_W270;
-
-  else if (!strncmp(name, "XH430-V210", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XH430_V210;
-  else if (!strncmp(name, "XH430-V350", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XH430_V350;
-  else if (!strncmp(name, "XH430-W210", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XH430_W210;
-  else if (!strncmp(name, "XH430-W350", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = XH430_W350;
-
-  else if (!strncmp(name, "PRO-L42-10-S300-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_L42_10_S300_R;
-  else if (!strncmp(name, "PRO-L54-30-S400-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_L54_30_S400_R;
-  else if (!strncmp(name, "PRO-L54-30-S500-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_L54_30_S500_R;
-  else if (!strncmp(name, "PRO-L54-50-S290-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_L54_50_S290_R;
-  else if (!strncmp(name, "PRO-L54-50-S500-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_L54_50_S500_R;
-
-  else if (!strncmp(name, "PRO-M42-10-S260-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_M42_10_S260_R;
-  else if (!strncmp(name, "PRO-M54-40-S250-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_M54_40_S250_R;
-  else if (!strncmp(name, "PRO-M54-60-S250-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_M54_60_S250_R;
-
-  else if (!strncmp(name, "PRO-H42-20-S300-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_H42_20_S300_R;
-  else if (!strncmp(name, "PRO-H54-100-S500-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_H54_100_S500_R;
-  else if (!strncmp(name, "PRO-H54-200-S500-R", strlen(name)))
-    dxl_info_[dxl_info_cnt_].model_num = PRO_H54_200_S500_R;
+  uint16_t num = findModelNumber(model_name);
+
+  if (num != 0)
+    dxl_info_[dxl_info_cnt_].model_num = num;
 }
 
 float DynamixelTool::getVelocityToValueRatio(void)
@@ -382,25 +144,35 @@ uint8_t DynamixelTool::getTheNumberOfItem(void)
 
 ControlTableItem* DynamixelTool::getControlItem(const char* item_name)
 {
-  static ControlTableItem* cti;    
+  ControlTableItem* cti = findControlItem(item_name);
 
-  for (int num = 0; num < the_number_of_item_; num++)
-  {
-    if (!strncmp(item_name, item_[num].item_name, strlen(item_[num].item_name)))
-    {
-      cti = &item_[num];
-      return cti;
-    }
-  }
+  if (cti != NULL)
+    return cti;
+
+  // Protocol 1.0 and 2.0 tables name the velocity items differently
+  if (!strcmp(item_name, "Moving_Speed"))
+    return findControlItem("Goal_Velocity");
+  else if (!strcmp(item_name, "Goal_Velocity"))
+    return findControlItem("Moving_Speed");
+  else if (!strcmp(item_name, "Present_Velocity"))
+    return findControlItem("Present_Speed");
+  else if (!strcmp(item_name, "Present_Speed"))
+    return findControlItem("Present_Velocity");
+
+  return NULL;
+}
+
+bool DynamixelTool::getItemHandle(const char* item_name, ItemHandle* handle)
+{
+  ControlTableItem* cti = getControlItem(item_name);
+
+  if (cti == NULL)
+    return false;
+
+  handle->address     = cti->address;
+  handle->data_length = cti->data_length;
 
-  if (!strncmp(item_name, "Moving_Speed", strlen("Moving_Speed")))
-    getControlItem("Goal_Velocity");
-  else if (!strncmp(item_name, "Goal_Velocity", strlen("Goal_Velocity")))
-    getControlItem("Moving_Speed");
-  else if (!strncmp(item_name, "Present_Velocity", strlen("Present_Velocity")))
-    getControlItem("Present_Speed");
-  else if (!strncmp(item_name, "Present_Speed", strlen("Present_Speed")))
-    getControlItem("Present_Velocity");
+  return true;
 }
 
 ControlTableItem* DynamixelTool::getControlItemPtr(void)
@@ -412,3 +184,14 @@ ModelInfo* DynamixelTool::getModelInfoPtr(void)
 {
   return info_ptr_;
 }
+
+ControlTableItem* DynamixelTool::findControlItem(const char* item_name)
+{
+  for (int num = 0; num < the_number_of_item_; num++)
+  {
+    if (!strcmp(item_name, item_[num].item_name))
+      return &item_[num];
+  }
+
+  return NULL;
+}
@@ -46,6 +46,15 @@ bool DynamixelWorkbench::scan(uint8_t *get_id, uint8_t *get_id_num, uint8_t rang
   return isOK;
 }
 
+bool DynamixelWorkbench::scan(DXLScanInfo *info, uint8_t max_info_num, uint8_t *info_num, uint8_t range, bool sweep_baud)
+{
+  bool isOK = false;
+
+  isOK = driver_.scan(info, max_info_num, info_num, range, sweep_baud);
+
+  return isOK;
+}
+
 bool DynamixelWorkbench::ping(uint8_t id, uint16_t *get_model_number)
 {
   bool isOK = false;
@@ -337,6 +346,11 @@ bool DynamixelWorkbench::goalSpeed(uint8_t id, int32_t goal)
   return comm_result;
 }
 
+bool DynamixelWorkbench::getItemHandle(uint8_t id, const char* item_name, ItemHandle* handle)
+{
+  return driver_.getItemHandle(id, item_name, handle);
+}
+
 bool DynamixelWorkbench::itemWrite(uint8_t id, const char* item_name, int32_t value)
 {
   bool comm_result = false;
@@ -346,6 +360,15 @@ bool DynamixelWorkbench::itemWrite(uint8_t id, const char* item_name, int32_t va
   return comm_result;
 }
 
+bool DynamixelWorkbench::itemWrite(uint8_t id, ItemHandle handle, int32_t value)
+{
+  bool comm_result = false;
+
+  comm_result = driver_.writeRegister(id, handle, value);
+
+  return comm_result;
+}
+
 bool DynamixelWorkbench::itemWrite(uint8_t id, uint16_t addr, uint8_t length, int32_t data)
 {
   bool comm_result = false;
@@ -364,6 +387,15 @@ bool DynamixelWorkbench::syncWrite(const char *item_name, int32_t* value)
   return isOK;
 }
 
+bool DynamixelWorkbench::syncWrite(ItemHandle handle, int32_t* value)
+{
+  bool isOK = false;
+
+  isOK =  driver_.syncWrite(handle, value);
+
+  return isOK;
+}
+
 bool DynamixelWorkbench::syncWrite(uint8_t *id, uint8_t id_num, const char *item_name, int32_t *data)
 {
   bool isOK = false;
@@ -373,6 +405,15 @@ bool DynamixelWorkbench::syncWrite(uint8_t *id, uint8_t id_num, const char *item
   return isOK;
 }
 
+bool DynamixelWorkbench::syncWrite(uint8_t *id, uint8_t id_num, ItemHandle handle, int32_t *data)
+{
+  bool isOK = false;
+
+  isOK =  driver_.syncWrite(id, id_num, handle, data);
+
+  return isOK;
+}
+
 bool DynamixelWorkbench::bulkWrite()
 {
   bool isOK = false;
@@ -390,6 +431,17 @@ int32_t DynamixelWorkbench::itemRead(uint8_t id, const char* item_name)
     return data;
 }
 
+bool DynamixelWorkbench::itemRead(uint8_t id, ItemHandle handle, int32_t *value)
+{
+  int32_t data = 0;
+
+  if (driver_.readRegister(id, handle, &data) == false)
+    return false;
+
+  *value = data;
+  return true;
+}
+
 int32_t  DynamixelWorkbench::itemRead(uint8_t id, uint16_t addr, uint8_t length)
 {
   static int32_t data = 0;
@@ -405,6 +457,11 @@ int32_t* DynamixelWorkbench::syncRead(const char *item_name)
     return data;
 }
 
+bool DynamixelWorkbench::syncRead(ItemHandle handle, int32_t *data)
+{
+  return driver_.syncRead(handle, data);
+}
+
 int32_t DynamixelWorkbench::bulkRead(uint8_t id, const char* item_name)
 {
   static int32_t data;
@@ -422,6 +479,31 @@ void DynamixelWorkbench::addSyncRead(const char* item_name)
   driver_.addSyncRead(item_name);
 }
 
+int8_t DynamixelWorkbench::addSyncWriteSession(uint8_t *id, uint8_t id_num, const char *item_name)
+{
+  return driver_.addSyncWriteSession(id, id_num, item_name);
+}
+
+int8_t DynamixelWorkbench::addSyncReadSession(uint8_t *id, uint8_t id_num, const char *first_item_name, const char *last_item_name)
+{
+  return driver_.addSyncReadSession(id, id_num, first_item_name, last_item_name);
+}
+
+bool DynamixelWorkbench::syncWriteSession(uint8_t session, int32_t *data)
+{
+  return driver_.syncWriteSession(session, data);
+}
+
+uint8_t DynamixelWorkbench::syncReadSession(uint8_t session)
+{
+  return driver_.syncReadSession(session);
+}
+
+uint8_t DynamixelWorkbench::getSyncReadSessionData(uint8_t session, ItemHandle handle, int32_t *data, bool *available)
+{
+  return driver_.getSyncReadSessionData(session, handle, data, available);
+}
+
 void DynamixelWorkbench::initBulkWrite()
 {
   driver_.initBulkWrite();
@@ -125,6 +125,10 @@ struct EEPROMClass{
     EEPtr end()                          { return length(); } //Standards requires this to be the item after the last valid entry. The returned pointer is invalid.
     uint16_t length()                    { return drv_eeprom_get_length(); }
 
+    //Group writes, they are programmed to flash together at endBatch().
+    void beginBatch()                    { drv_eeprom_begin_batch(); }
+    void endBatch()                      { drv_eeprom_end_batch(); }
+
     //Functionality to 'get' and 'put' objects to and from EEPROM.
     template< typename T > T &get( int idx, T &t ){
         EEPtr e = idx;
@@ -136,7 +140,9 @@ struct EEPROMClass{
     template< typename T > const T &put( int idx, const T &t ){
         EEPtr e = idx;
         const uint8_t *ptr = (const uint8_t*) &t;
+        drv_eeprom_begin_batch(); //The bytes are programmed together at the end
         for( int count = sizeof(T) ; count ; --count, ++e )  (*e).update( *ptr++ );
+        drv_eeprom_end_batch();
         return t;
     }
 };
@@ -0,0 +1,53 @@
+//=============================================================================================
+// AHRS.cpp
+//=============================================================================================
+//
+// Common part of the attitude filters, see AHRS.h
+//
+//=============================================================================================
+
+//-------------------------------------------------------------------------------------------
+// Header files
+
+#include "AHRS.h"
+#include <math.h>
+
+//-------------------------------------------------------------------------------------------
+// Definitions
+
+#define sampleFreqDef   512.0f          // sample frequency in Hz
+
+
+
+//============================================================================================
+// Functions
+
+AHRS::AHRS() {
+	q0 = 1.0f;
+	q1 = 0.0f;
+	q2 = 0.0f;
+	q3 = 0.0f;
+	invSampleFreq = 1.0f / sampleFreqDef;
+	anglesComputed = 0;
+}
+
+//-------------------------------------------------------------------------------------------
+// Start from a known attitude, used to hand the estimate over when the filter is switched
+
+void AHRS::reset(float w, float x, float y, float z) {
+	q0 = w;
+	q1 = x;
+	q2 = y;
+	q3 = z;
+	anglesComputed = 0;
+}
+
+//-------------------------------------------------------------------------------------------
+
+void AHRS::computeAngles()
+{
+	roll = atan2f(q0*q1 + q2*q3, 0.5f - q1*q1 - q2*q2);
+	pitch = asinf(-2.0f * (q1*q3 - q0*q2));
+	yaw = atan2f(q1*q2 + q0*q3, 0.5f - q2*q2 - q3*q3);
+	anglesComputed = 1;
+}
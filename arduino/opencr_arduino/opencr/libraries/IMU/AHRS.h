@@ -0,0 +1,71 @@
+//=============================================================================================
+// AHRS.h
+//=============================================================================================
+//
+// Common interface of the attitude filters cIMU can run (Madgwick, Mahony, EKF).
+// A filter keeps the quaternion of the sensor frame relative to the earth frame and is
+// stepped once per sample with invSampleFreq set to the time since the previous sample.
+//
+// Gyroscope in degrees/sec, accelerometer and magnetometer in any unit, they are normalised.
+//
+//=============================================================================================
+#ifndef AHRS_h
+#define AHRS_h
+#include <math.h>
+
+//--------------------------------------------------------------------------------------------
+// Variable declaration
+class AHRS{
+protected:
+    float roll;
+    float pitch;
+    float yaw;
+    char anglesComputed;
+    void computeAngles();
+
+    // VSQRT and VDIV on the M7 FPU are exact and as fast as the bit hack with two Newton steps
+    static inline float invSqrt(float x) { return 1.0f / sqrtf(x); }
+
+//-------------------------------------------------------------------------------------------
+// Function declarations
+public:
+    float invSampleFreq;
+
+    float q0;
+    float q1;
+    float q2;
+    float q3;	// quaternion of sensor frame relative to auxiliary frame
+
+    AHRS(void);
+    virtual ~AHRS() {}
+    virtual void begin(float sampleFrequency) { invSampleFreq = 1.0f / sampleFrequency; }
+    virtual void reset(float w, float x, float y, float z);
+    virtual void update(float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz) = 0;
+    virtual void updateIMU(float gx, float gy, float gz, float ax, float ay, float az) = 0;
+
+    float getRoll() {
+        if (!anglesComputed) computeAngles();
+        return roll * 57.29578f;
+    }
+    float getPitch() {
+        if (!anglesComputed) computeAngles();
+        return pitch * 57.29578f;
+    }
+    float getYaw() {
+        if (!anglesComputed) computeAngles();
+        return yaw * 57.29578f + 180.0f;
+    }
+    float getRollRadians() {
+        if (!anglesComputed) computeAngles();
+        return roll;
+    }
+    float getPitchRadians() {
+        if (!anglesComputed) computeAngles();
+        return pitch;
+    }
+    float getYawRadians() {
+        if (!anglesComputed) computeAngles();
+        return yaw;
+    }
+};
+#endif
@@ -0,0 +1,263 @@
+//=============================================================================================
+// EkfAHRS.c
+//=============================================================================================
+//
+// Quaternion extended Kalman filter, see EkfAHRS.h
+//
+// Matrices are small fixed size float arrays and the loops have constant bounds, so the
+// compiler unrolls them into single precision FPU code.
+//
+//=============================================================================================
+
+//-------------------------------------------------------------------------------------------
+// Header files
+
+#include "EkfAHRS.h"
+#include <math.h>
+
+//-------------------------------------------------------------------------------------------
+// Definitions
+
+#define gyroNoiseDef    0.035f          // rad/s, 2 degrees/sec, the sensor noise plus integration error
+#define accNoiseDef     0.1f            // fraction of 1g
+#define initVarDef      0.01f           // initial quaternion variance
+
+
+
+//============================================================================================
+// Functions
+
+Ekf::Ekf() {
+	setNoise(gyroNoiseDef, accNoiseDef);
+	reset(1.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void Ekf::reset(float w, float x, float y, float z) {
+	int i, j;
+
+	AHRS::reset(w, x, y, z);
+
+	for(i = 0; i < 4; i++) {
+		for(j = 0; j < 4; j++) {
+			P[i][j] = (i == j) ? initVarDef : 0.0f;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------
+// AHRS algorithm update
+
+void Ekf::update(float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz) {
+	(void)mx;
+	(void)my;
+	(void)mz;
+
+	updateIMU(gx, gy, gz, ax, ay, az);
+}
+
+//-------------------------------------------------------------------------------------------
+// IMU algorithm update
+
+void Ekf::updateIMU(float gx, float gy, float gz, float ax, float ay, float az) {
+	float recipNorm;
+
+	// Convert gyroscope degrees/sec to radians/sec
+	gx *= 0.0174533f;
+	gy *= 0.0174533f;
+	gz *= 0.0174533f;
+
+	predict(gx, gy, gz);
+
+	// Correct only if accelerometer measurement valid (avoids NaN in accelerometer normalisation)
+	if(!((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))) {
+
+		// Normalise accelerometer measurement
+		recipNorm = invSqrt(ax * ax + ay * ay + az * az);
+		correct(ax * recipNorm, ay * recipNorm, az * recipNorm);
+	}
+
+	// Normalise quaternion
+	recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+	q0 *= recipNorm;
+	q1 *= recipNorm;
+	q2 *= recipNorm;
+	q3 *= recipNorm;
+	anglesComputed = 0;
+
+	float q[4] = {q0, q1, q2, q3};
+	project(q);
+}
+
+//-------------------------------------------------------------------------------------------
+// Remove the variance along the unit vector v, P = (I - v v') P (I - v v')
+// Along q, the normalisation fixes that direction. Left in, it dwarfs the observed
+// variances and float round-off makes P indefinite.
+// Along the heading, see correct().
+
+void Ekf::project(const float* v) {
+	float pv[4];
+	float s;
+	int i, j;
+
+	for(i = 0; i < 4; i++) {
+		pv[i] = P[i][0] * v[0] + P[i][1] * v[1] + P[i][2] * v[2] + P[i][3] * v[3];
+	}
+	s = v[0] * pv[0] + v[1] * pv[1] + v[2] * pv[2] + v[3] * pv[3];
+
+	for(i = 0; i < 4; i++) {
+		for(j = i; j < 4; j++) {
+			float p = P[i][j] - pv[i] * v[j] - v[i] * pv[j] + s * v[i] * v[j];
+			P[i][j] = p;
+			P[j][i] = p;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------
+// Prediction, q = F q and P = F P F' + Q
+
+void Ekf::predict(float gx, float gy, float gz) {
+	float F[4][4];
+	float X[4][3];
+	float FP[4][4];
+	float q[4];
+	float hdt = 0.5f * invSampleFreq;
+	float qVar;
+	int i, j, k;
+
+	// F = I + dt/2 * Omega(w), the same rate of change as Madgwick's qDot
+	gx *= hdt;
+	gy *= hdt;
+	gz *= hdt;
+	F[0][0] = 1.0f; F[0][1] = -gx;  F[0][2] = -gy;  F[0][3] = -gz;
+	F[1][0] = gx;   F[1][1] = 1.0f; F[1][2] = gz;   F[1][3] = -gy;
+	F[2][0] = gy;   F[2][1] = -gz;  F[2][2] = 1.0f; F[2][3] = gx;
+	F[3][0] = gz;   F[3][1] = gy;   F[3][2] = -gx;  F[3][3] = 1.0f;
+
+	// Gyroscope noise enters through qDot = 1/2 X(q) w
+	X[0][0] = -q1; X[0][1] = -q2; X[0][2] = -q3;
+	X[1][0] = q0;  X[1][1] = -q3; X[1][2] = q2;
+	X[2][0] = q3;  X[2][1] = q0;  X[2][2] = -q1;
+	X[3][0] = -q2; X[3][1] = q1;  X[3][2] = q0;
+	qVar = gyroVar * hdt * hdt;
+
+	q[0] = q0; q[1] = q1; q[2] = q2; q[3] = q3;
+	q0 = F[0][0] * q[0] + F[0][1] * q[1] + F[0][2] * q[2] + F[0][3] * q[3];
+	q1 = F[1][0] * q[0] + F[1][1] * q[1] + F[1][2] * q[2] + F[1][3] * q[3];
+	q2 = F[2][0] * q[0] + F[2][1] * q[1] + F[2][2] * q[2] + F[2][3] * q[3];
+	q3 = F[3][0] * q[0] + F[3][1] * q[1] + F[3][2] * q[2] + F[3][3] * q[3];
+
+	for(i = 0; i < 4; i++) {
+		for(j = 0; j < 4; j++) {
+			FP[i][j] = F[i][0] * P[0][j] + F[i][1] * P[1][j] + F[i][2] * P[2][j] + F[i][3] * P[3][j];
+		}
+	}
+
+	// P is symmetric, compute the upper triangle and mirror it
+	for(i = 0; i < 4; i++) {
+		for(j = i; j < 4; j++) {
+			float sum = 0.0f;
+			for(k = 0; k < 4; k++) {
+				sum += FP[i][k] * F[j][k];
+			}
+			sum += qVar * (X[i][0] * X[j][0] + X[i][1] * X[j][1] + X[i][2] * X[j][2]);
+			P[i][j] = sum;
+			P[j][i] = sum;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------
+// Correction with the measured direction of gravity
+
+void Ekf::correct(float ax, float ay, float az) {
+	float H[3][4];
+	float PH[4][3];		// P H'
+	float S[3][3];		// H P H' + R
+	float Si[3][3];
+	float K[4][3];
+	float e[3];
+	static const int column[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+	float u[4];			// heading direction
+	float det, recipDet, uu, recipNorm;
+	int i, j, k;
+
+	// Expected gravity in the sensor frame and its Jacobian, as in Madgwick's objective function
+	e[0] = ax - 2.0f * (q1 * q3 - q0 * q2);
+	e[1] = ay - 2.0f * (q0 * q1 + q2 * q3);
+	e[2] = az - (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3);
+
+	H[0][0] = -2.0f * q2; H[0][1] =  2.0f * q3; H[0][2] = -2.0f * q0; H[0][3] = 2.0f * q1;
+	H[1][0] =  2.0f * q1; H[1][1] =  2.0f * q0; H[1][2] =  2.0f * q3; H[1][3] = 2.0f * q2;
+	H[2][0] =  2.0f * q0; H[2][1] = -2.0f * q1; H[2][2] = -2.0f * q2; H[2][3] = 2.0f * q3;
+
+	// Gravity does not see the heading: H u = 0 along a turn about the vertical, u being the
+	// 4D cross product of the rows of H. The heading variance grows without bound and, through its
+	// covariance with the tilt, would turn every tilt correction partly into a heading change.
+	for(i = 0; i < 4; i++) {
+		const int* c = column[i];
+		u[i] = H[0][c[0]] * (H[1][c[1]] * H[2][c[2]] - H[1][c[2]] * H[2][c[1]])
+		     - H[0][c[1]] * (H[1][c[0]] * H[2][c[2]] - H[1][c[2]] * H[2][c[0]])
+		     + H[0][c[2]] * (H[1][c[0]] * H[2][c[1]] - H[1][c[1]] * H[2][c[0]]);
+	}
+	uu = u[0] * u[0] + u[1] * u[1] + u[2] * u[2] + u[3] * u[3];
+	if(uu > 0.0f) {
+		recipNorm = invSqrt(uu);
+		for(i = 0; i < 4; i++) {
+			u[i] *= recipNorm;
+		}
+		project(u);
+	}
+
+	for(i = 0; i < 4; i++) {
+		for(j = 0; j < 3; j++) {
+			PH[i][j] = P[i][0] * H[j][0] + P[i][1] * H[j][1] + P[i][2] * H[j][2] + P[i][3] * H[j][3];
+		}
+	}
+
+	for(i = 0; i < 3; i++) {
+		for(j = i; j < 3; j++) {
+			float sum = H[i][0] * PH[0][j] + H[i][1] * PH[1][j] + H[i][2] * PH[2][j] + H[i][3] * PH[3][j];
+			S[i][j] = sum;
+			S[j][i] = sum;
+		}
+		S[i][i] += accVar;
+	}
+
+	// 3x3 inverse by cofactors
+	Si[0][0] = S[1][1] * S[2][2] - S[1][2] * S[2][1];
+	Si[0][1] = S[0][2] * S[2][1] - S[0][1] * S[2][2];
+	Si[0][2] = S[0][1] * S[1][2] - S[0][2] * S[1][1];
+	Si[1][0] = S[1][2] * S[2][0] - S[1][0] * S[2][2];
+	Si[1][1] = S[0][0] * S[2][2] - S[0][2] * S[2][0];
+	Si[1][2] = S[0][2] * S[1][0] - S[0][0] * S[1][2];
+	Si[2][0] = S[1][0] * S[2][1] - S[1][1] * S[2][0];
+	Si[2][1] = S[0][1] * S[2][0] - S[0][0] * S[2][1];
+	Si[2][2] = S[0][0] * S[1][1] - S[0][1] * S[1][0];
+	det = S[0][0] * Si[0][0] + S[0][1] * Si[1][0] + S[0][2] * Si[2][0];
+	if(det <= 0.0f) return;
+	recipDet = 1.0f / det;
+
+	for(i = 0; i < 4; i++) {
+		for(j = 0; j < 3; j++) {
+			K[i][j] = (PH[i][0] * Si[0][j] + PH[i][1] * Si[1][j] + PH[i][2] * Si[2][j]) * recipDet;
+		}
+	}
+
+	q0 += K[0][0] * e[0] + K[0][1] * e[1] + K[0][2] * e[2];
+	q1 += K[1][0] * e[0] + K[1][1] * e[1] + K[1][2] * e[2];
+	q2 += K[2][0] * e[0] + K[2][1] * e[1] + K[2][2] * e[2];
+	q3 += K[3][0] * e[0] + K[3][1] * e[1] + K[3][2] * e[2];
+
+	// P = (I - K H) P = P - K (P H')'
+	for(i = 0; i < 4; i++) {
+		for(j = i; j < 4; j++) {
+			float sum = P[i][j];
+			for(k = 0; k < 3; k++) {
+				sum -= K[i][k] * PH[j][k];
+			}
+			P[i][j] = sum;
+			P[j][i] = sum;
+		}
+	}
+}
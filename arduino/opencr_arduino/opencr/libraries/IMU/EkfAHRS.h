@@ -0,0 +1,37 @@
+//=============================================================================================
+// EkfAHRS.h
+//=============================================================================================
+//
+// Quaternion extended Kalman filter.
+// The gyroscope drives the prediction, the direction of gravity measured by the accelerometer
+// corrects it. The state is the quaternion alone, the gyroscope bias is left to the sensor
+// calibration and the magnetometer is not fused, update() runs updateIMU().
+//
+//=============================================================================================
+#ifndef EkfAHRS_h
+#define EkfAHRS_h
+#include <math.h>
+#include "AHRS.h"
+
+//--------------------------------------------------------------------------------------------
+// Variable declaration
+class Ekf : public AHRS{
+private:
+    float gyroVar;			// gyroscope noise variance, (rad/s)^2
+    float accVar;			// accelerometer noise variance, normalised
+    float P[4][4];			// quaternion covariance
+
+    void predict(float gx, float gy, float gz);
+    void correct(float ax, float ay, float az);
+    void project(const float* v);
+
+//-------------------------------------------------------------------------------------------
+// Function declarations
+public:
+    Ekf(void);
+    void setNoise(float gyroNoise, float accNoise) { gyroVar = gyroNoise * gyroNoise; accVar = accNoise * accNoise; }
+    void reset(float w, float x, float y, float z);
+    void update(float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz);
+    void updateIMU(float gx, float gy, float gz, float ax, float ay, float az);
+};
+#endif
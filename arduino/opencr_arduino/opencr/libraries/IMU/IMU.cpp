@@ -37,19 +37,89 @@ cIMU::cIMU()
 
   }
 
-	bConnected = false;
+	bConnected  = false;
+  update_hz   = 200;
+  update_us   = 1000000/update_hz;
+  update_mode = IMU_MODE_POLLING;
+
+  for( i=0; i<IMU_GYRO_FILTER_NUM; i++ )
+  {
+    gyro_buf[i][0] = 0;
+    gyro_buf[i][1] = 0;
+    gyro_buf[i][2] = 0;
+  }
+  gyro_sum[0] = 0;
+  gyro_sum[1] = 0;
+  gyro_sum[2] = 0;
+  gyro_index  = 0;
+
+  filter      = &madgwick;
+  filter_type = IMU_FILTER_MADGWICK;
 }
 
 
 
 
 /*---------------------------------------------------------------------------
-     TITLE   : begin
+     TITLE   : setFilter
+     WORK    : select the attitude filter, it starts from the current attitude
+     ARG     : type IMU_FILTER_MADGWICK, IMU_FILTER_MAHONY or IMU_FILTER_EKF
+     RET     : void
+---------------------------------------------------------------------------*/
+void cIMU::setFilter( uint8_t type )
+{
+  AHRS *next;
+
+
+  switch( type )
+  {
+    case IMU_FILTER_MAHONY:
+      next = &mahony;
+      break;
+
+    case IMU_FILTER_EKF:
+      next = &ekf;
+      break;
+
+    default:
+      type = IMU_FILTER_MADGWICK;
+      next = &madgwick;
+      break;
+  }
+
+  if( next != filter )
+  {
+    next->begin(update_hz);
+    next->reset(filter->q0, filter->q1, filter->q2, filter->q3);
+    filter      = next;
+    filter_type = type;
+  }
+}
+
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : getFilter
      WORK    :
      ARG     : void
+     RET     : IMU_FILTER_xxx
+---------------------------------------------------------------------------*/
+uint8_t cIMU::getFilter( void )
+{
+  return filter_type;
+}
+
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : begin
+     WORK    : IMU_MODE_FIFO falls back to polling without SPI DMA
+     ARG     : hz, mode
      RET     : void
 ---------------------------------------------------------------------------*/
-uint8_t cIMU::begin( uint32_t hz )
+uint8_t cIMU::begin( uint32_t hz, uint8_t mode )
 {
 	uint8_t err_code = IMU_OK;
   uint32_t i;
@@ -63,11 +133,24 @@ uint8_t cIMU::begin( uint32_t hz )
   //mRes = 10.*4912./8190.;  // 14BIT
   mRes = 10.*4912./32760.; // 16BIT
 
-  bConnected = SEN.begin();
+  if( SEN.bFifo == true )
+  {
+    SEN.fifo_end();
+  }
+
+  bConnected  = SEN.begin();
+  update_mode = IMU_MODE_POLLING;
 
   if( bConnected == true )
   {
-    filter.begin(update_hz);
+    if( mode == IMU_MODE_FIFO && SEN.fifo_begin(hz) == true )
+    {
+      update_mode = IMU_MODE_FIFO;
+      update_hz   = 1000000/SEN.fifo_period;
+      update_us   = SEN.fifo_period;
+    }
+
+    filter->begin(update_hz);
 
     for (i=0; i<32; i++)
     {
@@ -107,14 +190,44 @@ uint16_t cIMU::update( uint32_t option )
 	uint16_t ret_time = 0;
 
 	static uint32_t tTime;
+	static uint32_t tProcess;
+  mpu9250_sample_t sample;
+  uint32_t count = 0;
+
+
+  if( update_mode == IMU_MODE_FIFO )
+  {
+    if( (micros()-tTime) >= update_us*IMU_FIFO_POLL_SAMPLES )
+    {
+      tTime = micros();
+      SEN.fifo_start_read();
+    }
 
+    while( SEN.fifo_read(&sample) == true )
+    {
+      SEN.fifo_apply(&sample);
+      processIMU(sample.time);
+      count++;
+    }
+
+    if( count == 0 )
+    {
+      return 0;
+    }
 
-	if( (micros()-tTime) >= update_us )
+    ret_time = micros()-tProcess;
+    tProcess = micros();
+  }
+	else if( (micros()-tTime) >= update_us )
 	{
 		ret_time = micros()-tTime;
     tTime = micros();
 
 		computeIMU();
+  }
+
+  if( ret_time > 0 )
+  {
 
 		gyroData[0] = SEN.gyroADC[0];
 		gyroData[1] = SEN.gyroADC[1];
@@ -139,58 +252,59 @@ uint16_t cIMU::update( uint32_t option )
     magRaw[0]   = SEN.magRAW[0];
     magRaw[1]   = SEN.magRAW[1];
     magRaw[2]   = SEN.magRAW[2];
-	}
+  }
 
 	return ret_time;
 }
 
 
-#define FILTER_NUM    3
-
 /*---------------------------------------------------------------------------
      TITLE   : compute
-     WORK    :
+     WORK    : read the sensor registers and process them as sampled now
      ARG     : void
      RET     : void
 ---------------------------------------------------------------------------*/
 void cIMU::computeIMU( void )
 {
-  static uint32_t prev_process_time = micros();
-  static uint32_t cur_process_time = 0;
-  static uint32_t process_time = 0;
-  uint32_t i;
-  static int32_t gyroADC[3][FILTER_NUM] = {0,};
-  int32_t gyroAdcSum;
-
-  uint32_t axis;
-
 	SEN.acc_get_adc();
 	SEN.gyro_get_adc();
   SEN.mag_get_adc();
 
+  processIMU(micros());
+}
+
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : process
+     WORK    : filter the last sample, the filter step is the time between samples
+     ARG     : sample_time, us
+     RET     : void
+---------------------------------------------------------------------------*/
+void cIMU::processIMU( uint32_t sample_time )
+{
+  static uint32_t prev_process_time = micros();
+  static uint32_t process_time = 0;
+  uint32_t i;
+  uint32_t axis;
 
 
+  // Moving average, the sum drops the oldest sample and adds the newest
   for (axis = 0; axis < 3; axis++)
   {
-    gyroADC[axis][0] = SEN.gyroADC[axis];
-
+    gyro_sum[axis] -= gyro_buf[gyro_index][axis];
+    gyro_buf[gyro_index][axis] = SEN.gyroADC[axis];
+    gyro_sum[axis] += gyro_buf[gyro_index][axis];
 
-    gyroAdcSum = 0;
-    for (i=0; i<FILTER_NUM; i++)
-    {
-      gyroAdcSum += gyroADC[axis][i];
-    }
-    SEN.gyroADC[axis] = gyroAdcSum/FILTER_NUM;
-    for (i=FILTER_NUM-1; i>0; i--)
-    {
-      gyroADC[axis][i] = gyroADC[axis][i-1];
-    }
+    SEN.gyroADC[axis] = gyro_sum[axis]/IMU_GYRO_FILTER_NUM;
 
     if (abs(SEN.gyroADC[axis]) <= 3)
     {
       SEN.gyroADC[axis] = 0;
     }
   }
+  gyro_index = (gyro_index + 1) % IMU_GYRO_FILTER_NUM;
 
 
   for( i=0; i<3; i++ )
@@ -216,29 +330,34 @@ void cIMU::computeIMU( void )
   mz = (float)SEN.magADC[2]*mRes;
 
 
-  cur_process_time  = micros();
-  process_time      = cur_process_time-prev_process_time;
-  prev_process_time = cur_process_time;
+  process_time      = sample_time-prev_process_time;
+  prev_process_time = sample_time;
+
+  if( (int32_t)process_time <= 0 || process_time > 100000 )
+  {
+    process_time = update_us;
+  }
 
   if (SEN.calibratingG == 0 && SEN.calibratingA == 0)
   {
-    filter.invSampleFreq = (float)process_time/1000000.0f;
-    filter.updateIMU(gx, gy, gz, ax, ay, az);
-    //filter.update(gx, gy, gz, ax, ay, az, mx, my, mz);
+    filter->invSampleFreq = (float)process_time/1000000.0f;
+    filter->updateIMU(gx, gy, gz, ax, ay, az);
+    //filter->update(gx, gy, gz, ax, ay, az, mx, my, mz);
   }
 
 
-  rpy[0] = filter.getRoll();
-  rpy[1] = filter.getPitch();
-  rpy[2] = filter.getYaw()-180.;
+  // float literals, the M7 FPU is single precision and double falls back to software
+  rpy[0] = filter->getRoll();
+  rpy[1] = filter->getPitch();
+  rpy[2] = filter->getYaw()-180.0f;
 
-  quat[0] = filter.q0;
-  quat[1] = filter.q1;
-  quat[2] = filter.q2;
-  quat[3] = filter.q3;
+  quat[0] = filter->q0;
+  quat[1] = filter->q1;
+  quat[2] = filter->q2;
+  quat[3] = filter->q3;
 
-  angle[0] = (int16_t)(rpy[0] * 10.);
-  angle[1] = (int16_t)(rpy[1] * 10.);
-  angle[2] = (int16_t)(rpy[1] * 1.);
+  angle[0] = (int16_t)(rpy[0] * 10.0f);
+  angle[1] = (int16_t)(rpy[1] * 10.0f);
+  angle[2] = (int16_t)(rpy[1] * 1.0f);
 
 }
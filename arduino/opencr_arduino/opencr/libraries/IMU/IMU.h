@@ -20,11 +20,24 @@
 #include <SPI.h>
 #include "MPU9250.h"
 #include "MadgwickAHRS.h"
+#include "MahonyAHRS.h"
+#include "EkfAHRS.h"
 
 
 #define IMU_OK			  0x00
 #define IMU_ERR_I2C		0x01
 
+#define IMU_MODE_POLLING  0   // read the sensor registers every 1/hz
+#define IMU_MODE_FIFO     1   // let the sensor sample at hz into its FIFO and read it with DMA bursts
+
+#define IMU_FIFO_POLL_SAMPLES   4
+
+#define IMU_FILTER_MADGWICK     0
+#define IMU_FILTER_MAHONY       1
+#define IMU_FILTER_EKF          2
+
+#define IMU_GYRO_FILTER_NUM     3   // moving average of the gyro samples
+
 
 
 
@@ -64,15 +77,28 @@ public:
 public:
 	cIMU();
 
-	uint8_t  begin( uint32_t hz = 200 );
+	uint8_t  begin( uint32_t hz = 200, uint8_t mode = IMU_MODE_POLLING );
 	uint16_t update( uint32_t option = 0 );
 
+	void     setFilter( uint8_t type );
+	uint8_t  getFilter( void );
+
 private:
-  Madgwick filter;
+  Madgwick madgwick;
+  Mahony   mahony;
+  Ekf      ekf;
+  AHRS    *filter;
+  uint8_t  filter_type;
+
+  int32_t  gyro_buf[IMU_GYRO_FILTER_NUM][3];
+  int32_t  gyro_sum[3];
+  uint8_t  gyro_index;
   uint32_t update_hz;
   uint32_t update_us;
+  uint8_t  update_mode;
 
 	void computeIMU( void );
+	void processIMU( uint32_t sample_time );
 
 };
 
@@ -25,6 +25,20 @@
 #define MPU_CALI_COUNT      512
 
 
+static cMPU9250 *p_fifo_mpu = NULL;
+
+static uint8_t fifo_tx_buf[384] __attribute__((aligned(32)));   // whole cache lines, invalidated after each burst
+static uint8_t fifo_rx_buf[384] __attribute__((aligned(32)));
+
+static void fifo_dma_done_isr(void)
+{
+  if( p_fifo_mpu != NULL )
+  {
+    p_fifo_mpu->fifo_dma_done();
+  }
+}
+
+
 //#define ACC_ORIENTATION(X, Y, Z)  {accADC[PITCH]  = -X; accADC[ROLL]  =  Y; accADC[YAW]  =   Z;}
 //#define GYRO_ORIENTATION(X, Y, Z) {gyroADC[PITCH] =  Y; gyroADC[ROLL] =  X; gyroADC[YAW] =   Z;}
 
@@ -49,6 +63,20 @@ cMPU9250::cMPU9250()
 	calibratingA = 0;
   calibratingM = 0;
   bConnected   = false;
+
+  bFifo              = false;
+  fifo_period        = 1000;
+  fifo_sample_cnt    = 0;
+  fifo_drop_cnt      = 0;
+  fifo_error_cnt     = 0;
+  fifo_busy          = false;
+  fifo_reset_request = false;
+  fifo_burst_time    = 0;
+  fifo_next_time     = 0;
+  fifo_time_valid    = false;
+  fifo_burst_num     = 0;
+  sample_head        = 0;
+  sample_tail        = 0;
 }
 
 
@@ -220,28 +248,40 @@ void cMPU9250::gyro_init( void )
 ---------------------------------------------------------------------------*/
 void cMPU9250::gyro_get_adc( void )
 {
-	int16_t x = 0;
-	int16_t y = 0;
-	int16_t z = 0;
-
   uint8_t rawADC[6];
 
   if( bConnected == true )
   {
     imu_spi_reads( MPU9250_ADDRESS, MPU9250_GYRO_XOUT_H, 6, rawADC );
+    gyro_decode( rawADC );
+  }
 
- 		x = (((int16_t)rawADC[0]) << 8) | rawADC[1];
-  	y = (((int16_t)rawADC[2]) << 8) | rawADC[3];
-  	z = (((int16_t)rawADC[4]) << 8) | rawADC[5];
+  gyro_common();
+}
 
-  	gyroRAW[0] = x;
-  	gyroRAW[1] = y;
-  	gyroRAW[2] = z;
 
-  	GYRO_ORIENTATION( x, y,z );
-  }
 
-  gyro_common();
+/*---------------------------------------------------------------------------
+     TITLE   : gyro_decode
+     WORK    : GYRO_XOUT_H .. GYRO_ZOUT_L into gyroRAW and gyroADC
+     ARG     : void
+     RET     : void
+---------------------------------------------------------------------------*/
+void cMPU9250::gyro_decode( uint8_t *rawADC )
+{
+	int16_t x = 0;
+	int16_t y = 0;
+	int16_t z = 0;
+
+	x = (((int16_t)rawADC[0]) << 8) | rawADC[1];
+	y = (((int16_t)rawADC[2]) << 8) | rawADC[3];
+	z = (((int16_t)rawADC[4]) << 8) | rawADC[5];
+
+	gyroRAW[0] = x;
+	gyroRAW[1] = y;
+	gyroRAW[2] = z;
+
+	GYRO_ORIENTATION( x, y,z );
 }
 
 
@@ -292,10 +332,6 @@ void cMPU9250::acc_init( void )
 ---------------------------------------------------------------------------*/
 void cMPU9250::acc_get_adc( void )
 {
-	int16_t x = 0;
-	int16_t y = 0;
-	int16_t z = 0;
-
   uint8_t rawADC[6];
 
 
@@ -303,19 +339,35 @@ void cMPU9250::acc_get_adc( void )
   if( bConnected == true )
   {
     imu_spi_reads( MPU9250_ADDRESS, MPU9250_ACCEL_XOUT_H, 6, rawADC );
+    acc_decode( rawADC );
+	}
 
-    x = (((int16_t)rawADC[0]) << 8) | rawADC[1];
-    y = (((int16_t)rawADC[2]) << 8) | rawADC[3];
-    z = (((int16_t)rawADC[4]) << 8) | rawADC[5];
+	acc_common();
+}
 
-    accRAW[0] = x;
-    accRAW[1] = y;
-    accRAW[2] = z;
 
-		ACC_ORIENTATION( x,	y, z );
-	}
 
-	acc_common();
+/*---------------------------------------------------------------------------
+     TITLE   : acc_decode
+     WORK    : ACCEL_XOUT_H .. ACCEL_ZOUT_L into accRAW and accADC
+     ARG     : void
+     RET     : void
+---------------------------------------------------------------------------*/
+void cMPU9250::acc_decode( uint8_t *rawADC )
+{
+	int16_t x = 0;
+	int16_t y = 0;
+	int16_t z = 0;
+
+  x = (((int16_t)rawADC[0]) << 8) | rawADC[1];
+  y = (((int16_t)rawADC[2]) << 8) | rawADC[3];
+  z = (((int16_t)rawADC[4]) << 8) | rawADC[5];
+
+  accRAW[0] = x;
+  accRAW[1] = y;
+  accRAW[2] = z;
+
+	ACC_ORIENTATION( x,	y, z );
 }
 
 
@@ -462,21 +514,10 @@ void cMPU9250::mag_get_adc( void )
   {
   	imu_spi_reads(MPU9250_ADDRESS, MPU9250_EXT_SENS_DATA_00, 8, data);
 
-  	if (!(data[0] & MPU9250_AK8963_DATA_READY) || (data[0] & MPU9250_AK8963_DATA_OVERRUN))
+  	if (mag_decode(data) == false)
     {
   		return;
   	}
-  	if (data[7] & MPU9250_AK8963_OVERFLOW)
-    {
-  		return;
-  	}
-  	magRAW[0] = (data[2] << 8) | data[1];
-  	magRAW[1] = (data[4] << 8) | data[3];
-  	magRAW[2] = (data[6] << 8) | data[5];
-
-  	magRAW[0] = ((long)magRAW[0] * AK8963_ASA[0]) >> 8;
-  	magRAW[1] = ((long)magRAW[1] * AK8963_ASA[1]) >> 8;
-  	magRAW[2] = ((long)magRAW[2] * AK8963_ASA[2]) >> 8;
 	}
 
 	mag_common();
@@ -484,6 +525,35 @@ void cMPU9250::mag_get_adc( void )
 
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : mag_decode
+     WORK    : AK8963 ST1 .. ST2 into magRAW
+     ARG     : void
+     RET     : false when the sample is not ready or overflowed
+---------------------------------------------------------------------------*/
+bool cMPU9250::mag_decode( uint8_t *data )
+{
+	if (!(data[0] & MPU9250_AK8963_DATA_READY) || (data[0] & MPU9250_AK8963_DATA_OVERRUN))
+  {
+		return false;
+	}
+	if (data[7] & MPU9250_AK8963_OVERFLOW)
+  {
+		return false;
+	}
+	magRAW[0] = (data[2] << 8) | data[1];
+	magRAW[1] = (data[4] << 8) | data[3];
+	magRAW[2] = (data[6] << 8) | data[5];
+
+	magRAW[0] = ((long)magRAW[0] * AK8963_ASA[0]) >> 8;
+	magRAW[1] = ((long)magRAW[1] * AK8963_ASA[1]) >> 8;
+	magRAW[2] = ((long)magRAW[2] * AK8963_ASA[2]) >> 8;
+
+	return true;
+}
+
+
+
 
 
 /*---------------------------------------------------------------------------
@@ -544,3 +614,320 @@ bool cMPU9250::gyro_cali_get_done()
 	if( calibratingG == 0 ) return true;
 	else                    return false;
 }
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fifo_begin
+     WORK    : the FIFO collects accel, temp, gyro and the AK8963 slave 0 read
+               at sample_rate, fifo_start_read() empties it with DMA bursts
+     ARG     : sample_rate 4 .. 1000 Hz
+     RET     : false when the sensor or the SPI DMA is not available
+---------------------------------------------------------------------------*/
+bool cMPU9250::fifo_begin( uint32_t sample_rate )
+{
+  uint8_t  state;
+  uint32_t div;
+  uint32_t rate;
+
+
+  if( bConnected == false )
+  {
+    return false;
+  }
+
+  if( imu_spi_dma_begin() == false )
+  {
+    return false;
+  }
+  MPU_SPI.setDataMode( SPI_MODE3 );
+  MPU_SPI.setBitOrder( MSBFIRST );
+  MPU_SPI.setClockDivider( SPI_CLOCK_DIV128 ); // register writes are specified up to 1MHz
+
+  //SAMPLE_RATE = Internal_Sample_Rate / (1 + SMPLRT_DIV)
+  sample_rate = constrain(sample_rate, 4, 1000);
+  div         = 1000/sample_rate - 1;
+  rate        = 1000/(1 + div);
+  fifo_period = 1000000/rate;
+
+	imu_spi_write(MPU9250_SPIx_ADDR, MPU9250_SMPLRT_DIV, div);
+	delay(1);
+  //Keep the AK8963 slave 0 read near 100Hz
+	imu_spi_write(MPU9250_SPIx_ADDR, MPU9250_I2C_SLV4_CTRL, (rate >= 200) ? rate/100 - 1 : 0);
+	delay(1);
+
+	imu_spi_write(MPU9250_SPIx_ADDR, MPU9250_FIFO_EN, 0);
+	delay(1);
+	state = imu_spi_read(MPU9250_ADDRESS, MPU9250_USER_CTRL);
+	delay(1);
+	imu_spi_write(MPU9250_ADDRESS, MPU9250_USER_CTRL, state | MPU9250_FIFO_RST);
+	delay(1);
+  //Records are written in register order, ACCEL_XOUT_H .. EXT_SENS_DATA_07
+	imu_spi_write(MPU9250_SPIx_ADDR, MPU9250_FIFO_EN, MPU9250_TEMP_OUT | MPU9250_GYRO_XOUT | MPU9250_GYRO_YOUT | MPU9250_GYRO_ZOUT | MPU9250_ACCEL | MPU9250_SLV0);
+	delay(1);
+	imu_spi_write(MPU9250_ADDRESS, MPU9250_USER_CTRL, state | MPU9250_FIFO_ENABLE);
+	delay(1);
+
+  memset(fifo_tx_buf, 0xFF, sizeof(fifo_tx_buf));
+  fifo_tx_buf[0] = MPU9250_FIFO_R_W | 0x80;
+
+  // The prescaler is a power of 2, 108MHz/4 would exceed the 20MHz read limit
+  MPU_SPI.setClockDivider( SPI_CLOCK_DIV8 ); // 13.5MHz
+
+  sample_head     = 0;
+  sample_tail     = 0;
+  fifo_busy       = false;
+  fifo_time_valid = false;
+  p_fifo_mpu      = this;
+  bFifo           = true;
+
+  return true;
+}
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fifo_end
+     WORK    : stop the bursts, the registers are left to the next begin()
+     ARG     : void
+     RET     : void
+---------------------------------------------------------------------------*/
+void cMPU9250::fifo_end( void )
+{
+  noInterrupts();
+  if( fifo_busy == true )
+  {
+    imu_spi_dma_stop();
+    fifo_busy = false;
+  }
+  bFifo = false;
+  interrupts();
+}
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fifo_reset
+     WORK    : drop everything in the FIFO, it starts again on a record boundary
+     ARG     : void
+     RET     : void
+---------------------------------------------------------------------------*/
+void cMPU9250::fifo_reset( void )
+{
+  uint8_t state;
+
+  MPU_SPI.setClockDivider( SPI_CLOCK_DIV128 );
+	state = imu_spi_read(MPU9250_ADDRESS, MPU9250_USER_CTRL);
+	imu_spi_write(MPU9250_ADDRESS, MPU9250_USER_CTRL, state | MPU9250_FIFO_RST);
+  MPU_SPI.setClockDivider( SPI_CLOCK_DIV8 );
+
+  fifo_time_valid = false;
+}
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fifo_lost_since
+     WORK    : the number of records the sensor took from first_time on,
+               all of them go with a reset of the FIFO
+     ARG     : first_time, sample time of the first record lost
+     RET     : records
+---------------------------------------------------------------------------*/
+uint32_t cMPU9250::fifo_lost_since( uint32_t first_time )
+{
+  int32_t elapsed = (int32_t)(micros() - first_time);
+
+  if( elapsed < 0 )
+  {
+    return 0;
+  }
+
+  return elapsed/fifo_period + 1;
+}
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fifo_start_read
+     WORK    : start a DMA burst of the records waiting in the FIFO,
+               fifo_dma_done() hands them to fifo_read()
+     ARG     : void
+     RET     : void
+---------------------------------------------------------------------------*/
+void cMPU9250::fifo_start_read( void )
+{
+  uint8_t  data[2];
+  uint32_t count;
+  uint32_t total;
+  uint32_t num;
+  uint32_t now;
+  uint32_t anchor;
+  int32_t  error;
+
+
+  if( bFifo == false )
+  {
+    return;
+  }
+
+  if( fifo_busy == true )
+  {
+    if( (micros()-fifo_burst_time) < MPU9250_FIFO_TIMEOUT + MPU9250_FIFO_BURST_MAX*fifo_period )
+    {
+      return;
+    }
+
+    noInterrupts();
+    if( fifo_busy == true )
+    {
+      imu_spi_dma_stop();
+      fifo_busy          = false;
+      fifo_reset_request = true;
+      fifo_error_cnt++;
+    }
+    interrupts();
+  }
+
+  // The records of the aborted burst and all the FIFO took since are lost
+  if( fifo_reset_request == true )
+  {
+    fifo_reset_request = false;
+    fifo_drop_cnt += fifo_lost_since( fifo_burst_time );
+    fifo_reset();
+    return;
+  }
+
+  imu_spi_reads( MPU9250_ADDRESS, MPU9250_FIFO_COUNTH, 2, data );
+  now   = micros();
+  count = ((uint32_t)(data[0] & 0x1F) << 8) | data[1];
+  total = count / MPU9250_FIFO_RECORD_SIZE;
+
+  // Once the FIFO is full it drops its oldest bytes and the record boundaries are lost.
+  // It has overwritten records since the last burst, so the sample clock counts them.
+  if( count > MPU9250_FIFO_LENGTH - MPU9250_FIFO_RECORD_SIZE )
+  {
+    fifo_drop_cnt += (fifo_time_valid == true) ? fifo_lost_since( fifo_next_time ) : total;
+    fifo_reset();
+    return;
+  }
+
+  if( total == 0 )
+  {
+    return;
+  }
+
+  // The newest record was sampled within the last period, the older ones one period apart.
+  // The sample clock runs on from the previous burst and only drifts slowly towards this anchor.
+  anchor = now - fifo_period/2 - (total - 1)*fifo_period;
+  error  = (int32_t)(anchor - fifo_next_time);
+
+  if( fifo_time_valid == false || error > (int32_t)fifo_period || error < -(int32_t)fifo_period )
+  {
+    fifo_burst_time = anchor;
+  }
+  else
+  {
+    fifo_burst_time = fifo_next_time + error/8;
+  }
+
+  num = (total > MPU9250_FIFO_BURST_MAX) ? MPU9250_FIFO_BURST_MAX : total;
+
+  fifo_next_time  = fifo_burst_time + num*fifo_period;
+  fifo_time_valid = true;
+  fifo_burst_num  = num;
+  fifo_busy       = true;
+
+  if( imu_spi_dma_start( fifo_tx_buf, fifo_rx_buf, 1 + num*MPU9250_FIFO_RECORD_SIZE, fifo_dma_done_isr ) == false )
+  {
+    fifo_busy       = false;
+    fifo_time_valid = false;
+  }
+}
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fifo_dma_done
+     WORK    : DMA interrupt, timestamp the records of the burst and queue them
+     ARG     : void
+     RET     : void
+---------------------------------------------------------------------------*/
+void cMPU9250::fifo_dma_done( void )
+{
+  uint32_t i;
+  uint32_t head;
+  uint32_t next;
+
+
+  SCB_InvalidateDCache_by_Addr( (uint32_t *)fifo_rx_buf, sizeof(fifo_rx_buf) );
+
+  head = sample_head;
+  for( i=0; i<fifo_burst_num; i++ )
+  {
+    next = (head + 1) & (MPU9250_SAMPLE_BUF_SIZE - 1);
+    if( next == sample_tail )
+    {
+      fifo_drop_cnt++;
+      continue;
+    }
+
+    sample_buf[head].time = fifo_burst_time + i*fifo_period;
+    memcpy( sample_buf[head].data, &fifo_rx_buf[1 + i*MPU9250_FIFO_RECORD_SIZE], MPU9250_FIFO_RECORD_SIZE );
+    head = next;
+  }
+
+  __DMB();
+  sample_head = head;
+
+  fifo_sample_cnt += fifo_burst_num;
+  fifo_busy        = false;
+}
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fifo_read
+     WORK    : take the oldest queued sample
+     ARG     : p_sample
+     RET     : false when none is waiting
+---------------------------------------------------------------------------*/
+bool cMPU9250::fifo_read( mpu9250_sample_t *p_sample )
+{
+  uint32_t tail = sample_tail;
+
+
+  if( tail == sample_head )
+  {
+    return false;
+  }
+
+  __DMB();
+  *p_sample = sample_buf[tail];
+  __DMB();
+
+  sample_tail = (tail + 1) & (MPU9250_SAMPLE_BUF_SIZE - 1);
+
+  return true;
+}
+
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fifo_apply
+     WORK    : decode a sample as acc_get_adc, gyro_get_adc and mag_get_adc do
+     ARG     : p_sample
+     RET     : void
+---------------------------------------------------------------------------*/
+void cMPU9250::fifo_apply( mpu9250_sample_t *p_sample )
+{
+  acc_decode( &p_sample->data[0] );
+  acc_common();
+
+  gyro_decode( &p_sample->data[8] );
+  gyro_common();
+
+  if( mag_decode( &p_sample->data[14] ) == true )
+  {
+    mag_common();
+  }
+}
@@ -28,6 +28,19 @@
 #define MPU_SPI   SPI_IMU
 
 
+#define MPU9250_FIFO_RECORD_SIZE    22    // accel 6, temp 2, gyro 6, AK8963 ST1 .. ST2 8 through slave 0
+#define MPU9250_FIFO_BURST_MAX      16    // records per DMA burst
+#define MPU9250_FIFO_TIMEOUT        10000 // us
+#define MPU9250_SAMPLE_BUF_SIZE     64    // power of 2
+
+
+typedef struct
+{
+  uint32_t time;                              // micros() at which the sensor took the sample
+  uint8_t  data[MPU9250_FIFO_RECORD_SIZE];    // FIFO record, big endian as read
+} mpu9250_sample_t;
+
+
 void read_regs( uint8_t addr, uint8_t reg, uint8_t *p_data, uint32_t length );
 
 
@@ -59,6 +72,12 @@ public:
 
   int16_t AK8963_ASA[3];
 
+  bool     bFifo;
+  uint32_t fifo_period;                 // us between samples
+  volatile uint32_t fifo_sample_cnt;
+  volatile uint32_t fifo_drop_cnt;      // samples lost to a full FIFO or sample buffer
+  volatile uint32_t fifo_error_cnt;     // bursts that did not complete
+
 
 public:
 	cMPU9250();
@@ -83,6 +102,30 @@ public:
 	void mag_cali_start();
 	bool mag_cali_get_done();
 
+  bool fifo_begin( uint32_t sample_rate );
+  void fifo_end( void );
+  void fifo_start_read( void );
+  bool fifo_read( mpu9250_sample_t *p_sample );
+  void fifo_apply( mpu9250_sample_t *p_sample );
+  void fifo_dma_done( void );
+
+private:
+  volatile bool     fifo_busy;
+  volatile bool     fifo_reset_request;
+  uint32_t          fifo_burst_time;     // us, sample time of the first record in the burst
+  uint32_t          fifo_next_time;      // us, expected sample time of the record after the burst
+  bool              fifo_time_valid;
+  uint8_t           fifo_burst_num;
+
+  mpu9250_sample_t  sample_buf[MPU9250_SAMPLE_BUF_SIZE];   // filled by the DMA interrupt, emptied by fifo_read()
+  volatile uint32_t sample_head;
+  volatile uint32_t sample_tail;
+
+  void acc_decode( uint8_t *p_data );
+  void gyro_decode( uint8_t *p_data );
+  bool mag_decode( uint8_t *p_data );
+  void fifo_reset( void );
+  uint32_t fifo_lost_since( uint32_t first_time );
 };
 
 
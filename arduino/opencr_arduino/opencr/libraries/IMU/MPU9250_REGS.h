@@ -209,6 +209,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define MPU9250_GYRO_YOUT (0x20)
 #define MPU9250_GYRO_ZOUT (0x10)
 #define MPU9250_ACCEL (0x08)
+#define MPU9250_SLV0 (0x01)
+#define MPU9250_FIFO_LENGTH (512)
 
 //
 #define SMPLRT_DIV 0
@@ -0,0 +1,42 @@
+//=============================================================================================
+// MahonyAHRS.h
+//=============================================================================================
+//
+// Madgwick's implementation of Mayhony's AHRS algorithm.
+// See: http://www.x-io.co.uk/open-source-imu-and-ahrs-algorithms/
+//
+// A complementary filter, the gyroscope is integrated and the error against the measured
+// gravity (and magnetic field) is fed back through a PI controller.
+//
+// Date			Author			Notes
+// 29/09/2011	SOH Madgwick    Initial release
+// 02/10/2011	SOH Madgwick	Optimised for reduced CPU load
+//
+//=============================================================================================
+#ifndef MahonyAHRS_h
+#define MahonyAHRS_h
+#include <math.h>
+#include "AHRS.h"
+
+//--------------------------------------------------------------------------------------------
+// Variable declaration
+class Mahony : public AHRS{
+private:
+    float twoKp;			// 2 * proportional gain (Kp)
+    float twoKi;			// 2 * integral gain (Ki)
+    float integralFBx;
+    float integralFBy;
+    float integralFBz;	// integral error terms scaled by Ki
+
+    void feedback(float halfex, float halfey, float halfez, float* gx, float* gy, float* gz);
+    void integrate(float gx, float gy, float gz);
+
+//-------------------------------------------------------------------------------------------
+// Function declarations
+public:
+    Mahony(void);
+    void reset(float w, float x, float y, float z);
+    void update(float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz);
+    void updateIMU(float gx, float gy, float gz, float ax, float ay, float az);
+};
+#endif
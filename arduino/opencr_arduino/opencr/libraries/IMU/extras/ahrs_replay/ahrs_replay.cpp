@@ -0,0 +1,563 @@
+//=============================================================================================
+// ahrs_replay.cpp
+//=============================================================================================
+//
+// Host replay of MPU9250 logs through the attitude filters of cIMU (Madgwick, Mahony, EKF).
+//
+// A log has one sample per line, as cIMU::processIMU() gets it from cMPU9250 after the
+// gyro and accelerometer calibration:
+//
+//   time[us] gyroADC[3] accADC[3] magADC[3] [qw qx qy qz]
+//
+// The optional quaternion is the true attitude of a synthetic log. Each sample goes through
+// the same moving average, dead band, scaling and time step as in processIMU(), then through
+// filter->updateIMU(). The errors are measured after the first 5 s:
+//
+//   tilt  : angle between the estimated and the true gravity direction
+//   yaw   : change of heading since the first 5 s against the true change, at the end
+//
+// Without the true attitude, the EKF is the reference and its own errors are not shown.
+//
+// Without a log, the synthetic suite is replayed and every filter has to stay within the tilt
+// limits of each scenario, or the program exits with 1. Driving tilts the measured gravity by the
+// linear and centripetal acceleration, so the drive scenario allows more.
+//
+// usage: ahrs_replay [log ...]
+//        ahrs_replay -w log scenario [minutes [seed]]     scenario: static, drive, tumble
+//
+//=============================================================================================
+
+//-------------------------------------------------------------------------------------------
+// Header files
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "MadgwickAHRS.h"
+#include "MahonyAHRS.h"
+#include "EkfAHRS.h"
+
+//-------------------------------------------------------------------------------------------
+// Definitions
+
+#define IMU_GYRO_FILTER_NUM     3               // as IMU.h
+#define IMU_UPDATE_HZ           200             // cIMU::begin() default
+#define GYRO_RES                (2000.0f/32768.0f)
+#define ACC_RES                 (8.0f/32768.0f)
+#define MAG_RES                 (10.0f*4912.0f/32760.0f)
+#define ACC_1G_LSB              (1.0/ACC_RES)
+
+#define SETTLE_US               5000000         // the filters start at the identity
+#define SUITE_SEED_NUM          2
+
+#define RAD2DEG                 57.29577951
+
+enum
+{
+  FILTER_MADGWICK,
+  FILTER_MAHONY,
+  FILTER_EKF,
+  FILTER_NUM
+};
+
+static const char *filter_name[FILTER_NUM] = {"Madgwick", "Mahony", "EKF"};
+
+struct Scenario
+{
+  const char *name;
+  double tilt_mean_max;   // deg
+  double tilt_max;        // deg
+};
+
+static const Scenario scenario_list[] =
+{
+  {"static", 0.5, 2.0},   // standing still
+  {"drive",  2.5, 5.0},   // a turtlebot turning and driving
+  {"tumble", 0.5, 2.0},   // the board turned by hand
+};
+
+struct Sample
+{
+  uint32_t time;
+  int16_t  gyro[3];
+  int16_t  acc[3];
+  int16_t  mag[3];
+  bool     has_truth;
+  double   q[4];
+};
+
+struct Result
+{
+  double nsec;            // per update
+  double tilt_mean;       // deg
+  double tilt_p99;        // deg
+  double tilt_max;        // deg
+  double yaw_error;       // deg, at the end
+};
+
+
+
+//============================================================================================
+// Quaternion helpers, double
+
+static void multiply(const double *a, const double *b, double *out)
+{
+  out[0] = a[0]*b[0] - a[1]*b[1] - a[2]*b[2] - a[3]*b[3];
+  out[1] = a[0]*b[1] + a[1]*b[0] + a[2]*b[3] - a[3]*b[2];
+  out[2] = a[0]*b[2] - a[1]*b[3] + a[2]*b[0] + a[3]*b[1];
+  out[3] = a[0]*b[3] + a[1]*b[2] - a[2]*b[1] + a[3]*b[0];
+}
+
+// gravity direction in the sensor frame, as the filters use it
+static void getGravity(const double *q, double *g)
+{
+  g[0] = 2.0 * (q[1]*q[3] - q[0]*q[2]);
+  g[1] = 2.0 * (q[0]*q[1] + q[2]*q[3]);
+  g[2] = q[0]*q[0] - q[1]*q[1] - q[2]*q[2] + q[3]*q[3];
+}
+
+// earth frame vector v in the sensor frame
+static void toSensor(const double *q, const double *v, double *out)
+{
+  double r[3][3] =
+  {
+    {1 - 2*(q[2]*q[2] + q[3]*q[3]), 2*(q[1]*q[2] + q[0]*q[3]),     2*(q[1]*q[3] - q[0]*q[2])},
+    {2*(q[1]*q[2] - q[0]*q[3]),     1 - 2*(q[1]*q[1] + q[3]*q[3]), 2*(q[2]*q[3] + q[0]*q[1])},
+    {2*(q[1]*q[3] + q[0]*q[2]),     2*(q[2]*q[3] - q[0]*q[1]),     1 - 2*(q[1]*q[1] + q[2]*q[2])}
+  };
+
+  for (int i = 0; i < 3; i++)
+    out[i] = r[i][0]*v[0] + r[i][1]*v[1] + r[i][2]*v[2];
+}
+
+static double getYaw(const double *q)
+{
+  return atan2(q[1]*q[2] + q[0]*q[3], 0.5 - q[2]*q[2] - q[3]*q[3]);
+}
+
+static double getTiltError(const double *q, const double *q_ref)
+{
+  double g[3], g_ref[3];
+
+  getGravity(q, g);
+  getGravity(q_ref, g_ref);
+
+  double dot = (g[0]*g_ref[0] + g[1]*g_ref[1] + g[2]*g_ref[2]) /
+               sqrt((g[0]*g[0] + g[1]*g[1] + g[2]*g[2]) * (g_ref[0]*g_ref[0] + g_ref[1]*g_ref[1] + g_ref[2]*g_ref[2]));
+  if (dot > 1.0)
+    dot = 1.0;
+  return acos(dot) * RAD2DEG;
+}
+
+static double wrapDegree(double angle)
+{
+  while (angle > 180.0)
+    angle -= 360.0;
+  while (angle < -180.0)
+    angle += 360.0;
+  return angle;
+}
+
+static int16_t toCount(double value)
+{
+  value = floor(value + 0.5);
+  if (value > 32767.0)
+    value = 32767.0;
+  if (value < -32768.0)
+    value = -32768.0;
+  return (int16_t)value;
+}
+
+
+
+//============================================================================================
+// Synthetic MPU9250 logs
+
+// Body rates and linear acceleration of the scenarios, rad/s and g in the sensor frame
+static void getMotion(const std::string &scenario, double t, double *w, double *a)
+{
+  w[0] = w[1] = w[2] = 0.0;
+  a[0] = a[1] = a[2] = 0.0;
+
+  if (scenario == "drive")
+  {
+    // a turtlebot: turns in place and drives, rocking a little on its casters
+    w[0] = 0.05 * sin(2.1 * t);
+    w[1] = 0.04 * sin(1.3 * t + 0.5);
+    w[2] = 1.5 * sin(0.25 * t) * (sin(0.07 * t) > 0.0 ? 1.0 : 0.2);
+    a[0] = 0.05 * sin(0.4 * t);
+    a[1] = 0.02 * w[2];
+  }
+  else if (scenario == "tumble")
+  {
+    // the board turned by hand through large angles
+    w[0] = 0.8 * sin(0.7 * t);
+    w[1] = 0.6 * sin(0.5 * t + 1.0);
+    w[2] = 0.5 * cos(0.3 * t);
+  }
+}
+
+static bool isScenario(const std::string &scenario)
+{
+  for (size_t s = 0; s < sizeof(scenario_list) / sizeof(scenario_list[0]); s++)
+    if (scenario == scenario_list[s].name)
+      return true;
+  return false;
+}
+
+static std::vector<Sample> makeLog(const std::string &scenario, double minutes, unsigned seed)
+{
+  std::mt19937 rng(seed);
+  std::normal_distribution<double>  noise(0.0, 1.0);
+  std::uniform_real_distribution<double> jitter(0.0, 300.0);   // us, the loop polls late
+
+  const double gyro_noise = 0.3;                   // deg/s
+  const double acc_noise  = 0.02;                  // g
+  const double mag_noise  = 5.0;                   // LSB
+  const double field[3]   = {200.0, 0.0, -450.0};  // earth field, mG
+  double gyro_bias[3];                             // deg/s left after the calibration
+  double q[4] = {cos(0.05), sin(0.05), 0.0, 0.0};  // starts tilted
+  double step_us = 1000000.0 / IMU_UPDATE_HZ;
+  double t_us = 0.0;
+  size_t sample_num = (size_t)(minutes * 60.0 * IMU_UPDATE_HZ);
+
+  for (int axis = 0; axis < 3; axis++)
+    gyro_bias[axis] = 0.05 * noise(rng);
+
+  std::vector<Sample> log(sample_num);
+  for (size_t index = 0; index < sample_num; index++)
+  {
+    double next_us = (index + 1) * step_us + jitter(rng);
+    double t = t_us * 1e-6;
+    double w[3], a[3], g[3], m[3];
+
+    // the true attitude moves with fine steps between the samples
+    const int sub_step = 8;
+    double dt = (next_us - t_us) * 1e-6 / sub_step;
+    for (int k = 0; k < sub_step; k++)
+    {
+      getMotion(scenario, t + k * dt, w, a);
+      double dq[4] = {1.0, 0.5 * w[0] * dt, 0.5 * w[1] * dt, 0.5 * w[2] * dt};
+      double r[4];
+      multiply(q, dq, r);
+      double norm = sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2] + r[3]*r[3]);
+      for (int i = 0; i < 4; i++)
+        q[i] = r[i] / norm;
+    }
+    t_us = next_us;
+
+    getMotion(scenario, t_us * 1e-6, w, a);
+    getGravity(q, g);
+    toSensor(q, field, m);
+
+    Sample &sample = log[index];
+    sample.time = (uint32_t)(uint64_t)t_us;
+    for (int axis = 0; axis < 3; axis++)
+    {
+      sample.gyro[axis] = toCount((w[axis] * RAD2DEG + gyro_bias[axis] + gyro_noise * noise(rng)) / GYRO_RES);
+      sample.acc[axis]  = toCount((g[axis] + a[axis] + acc_noise * noise(rng)) * ACC_1G_LSB);
+      sample.mag[axis]  = toCount(m[axis] / MAG_RES + mag_noise * noise(rng));
+    }
+    sample.has_truth = true;
+    for (int i = 0; i < 4; i++)
+      sample.q[i] = q[i];
+  }
+
+  return log;
+}
+
+static bool readLog(const char *file_name, std::vector<Sample> &log)
+{
+  FILE *file = fopen(file_name, "r");
+  if (file == NULL)
+    return false;
+
+  char line[256];
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    Sample sample;
+    int value[9];
+
+    if (line[0] == '#')
+      continue;
+
+    int count = sscanf(line, "%u %d %d %d %d %d %d %d %d %d %lf %lf %lf %lf", &sample.time,
+                       &value[0], &value[1], &value[2], &value[3], &value[4], &value[5], &value[6], &value[7], &value[8],
+                       &sample.q[0], &sample.q[1], &sample.q[2], &sample.q[3]);
+    if (count != 10 && count != 14)
+      continue;
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+      sample.gyro[axis] = value[axis];
+      sample.acc[axis]  = value[3 + axis];
+      sample.mag[axis]  = value[6 + axis];
+    }
+    sample.has_truth = (count == 14);
+    log.push_back(sample);
+  }
+  fclose(file);
+
+  return true;
+}
+
+static bool writeLog(const char *file_name, const std::vector<Sample> &log)
+{
+  FILE *file = fopen(file_name, "w");
+  if (file == NULL)
+    return false;
+
+  fprintf(file, "# time[us] gyroADC[3] accADC[3] magADC[3] qw qx qy qz\n");
+  for (size_t index = 0; index < log.size(); index++)
+  {
+    const Sample &sample = log[index];
+    fprintf(file, "%u %d %d %d %d %d %d %d %d %d %.9f %.9f %.9f %.9f\n", sample.time,
+            sample.gyro[0], sample.gyro[1], sample.gyro[2], sample.acc[0], sample.acc[1], sample.acc[2],
+            sample.mag[0], sample.mag[1], sample.mag[2], sample.q[0], sample.q[1], sample.q[2], sample.q[3]);
+  }
+  fclose(file);
+
+  return true;
+}
+
+
+
+//============================================================================================
+// Replay
+
+static double getNsec()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// cIMU::processIMU() without the sensor: the gyro moving average and dead band, the scaling and the time step
+class Replay
+{
+ public:
+  Replay(AHRS *filter) : filter_(filter), gyro_index_(0), prev_time_(0), is_first_(true)
+  {
+    memset(gyro_buf_, 0, sizeof(gyro_buf_));
+    memset(gyro_sum_, 0, sizeof(gyro_sum_));
+    filter_->begin(IMU_UPDATE_HZ);
+  }
+
+  // returns the ns spent in the filter
+  double process(const Sample &sample)
+  {
+    float g[3], a[3];
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+      gyro_sum_[axis] -= gyro_buf_[gyro_index_][axis];
+      gyro_buf_[gyro_index_][axis] = sample.gyro[axis];
+      gyro_sum_[axis] += gyro_buf_[gyro_index_][axis];
+
+      int32_t gyro = gyro_sum_[axis] / IMU_GYRO_FILTER_NUM;
+      if (abs(gyro) <= 3)
+        gyro = 0;
+
+      g[axis] = (float)gyro * GYRO_RES;
+      a[axis] = (float)sample.acc[axis] * ACC_RES;
+    }
+    gyro_index_ = (gyro_index_ + 1) % IMU_GYRO_FILTER_NUM;
+
+    uint32_t process_time = is_first_ ? 0 : sample.time - prev_time_;
+    prev_time_ = sample.time;
+    is_first_  = false;
+    if ((int32_t)process_time <= 0 || process_time > 100000)
+      process_time = 1000000 / IMU_UPDATE_HZ;
+
+    double start_time = getNsec();
+    filter_->invSampleFreq = (float)process_time / 1000000.0f;
+    filter_->updateIMU(g[0], g[1], g[2], a[0], a[1], a[2]);
+    return getNsec() - start_time;
+  }
+
+  void getQuaternion(double *q)
+  {
+    q[0] = filter_->q0;
+    q[1] = filter_->q1;
+    q[2] = filter_->q2;
+    q[3] = filter_->q3;
+  }
+
+ private:
+  AHRS    *filter_;
+  int32_t  gyro_buf_[IMU_GYRO_FILTER_NUM][3];
+  int32_t  gyro_sum_[3];
+  uint8_t  gyro_index_;
+  uint32_t prev_time_;
+  bool     is_first_;
+};
+
+// replays the log through the three filters, the reference is the true attitude or else the EKF
+static void replayLog(const std::vector<Sample> &log, Result *result)
+{
+  Madgwick madgwick;
+  Mahony   mahony;
+  Ekf      ekf;
+  Replay   replay[FILTER_NUM] = {Replay(&madgwick), Replay(&mahony), Replay(&ekf)};
+  std::vector<double> tilt[FILTER_NUM];
+  double start_yaw[FILTER_NUM + 1];
+  double q[FILTER_NUM][4];
+  double q_ref[4];
+  bool   has_truth = log.front().has_truth;
+  bool   is_settled = false;
+
+  for (int filter = 0; filter < FILTER_NUM; filter++)
+    result[filter].nsec = 0.0;
+
+  for (size_t index = 0; index < log.size(); index++)
+  {
+    for (int filter = 0; filter < FILTER_NUM; filter++)
+    {
+      result[filter].nsec += replay[filter].process(log[index]);
+      replay[filter].getQuaternion(q[filter]);
+    }
+
+    if (has_truth)
+      memcpy(q_ref, log[index].q, sizeof(q_ref));
+    else
+      memcpy(q_ref, q[FILTER_EKF], sizeof(q_ref));
+
+    if ((uint32_t)(log[index].time - log.front().time) < SETTLE_US)
+      continue;
+
+    if (is_settled == false)
+    {
+      for (int filter = 0; filter < FILTER_NUM; filter++)
+        start_yaw[filter] = getYaw(q[filter]);
+      start_yaw[FILTER_NUM] = getYaw(q_ref);
+      is_settled = true;
+    }
+
+    for (int filter = 0; filter < FILTER_NUM; filter++)
+      tilt[filter].push_back(getTiltError(q[filter], q_ref));
+  }
+
+  for (int filter = 0; filter < FILTER_NUM; filter++)
+  {
+    Result &r = result[filter];
+    std::vector<double> &e = tilt[filter];
+
+    r.nsec /= log.size();
+    r.tilt_mean = r.tilt_p99 = r.tilt_max = r.yaw_error = 0.0;
+    if (e.empty())
+      continue;
+
+    for (size_t i = 0; i < e.size(); i++)
+      r.tilt_mean += e[i] / e.size();
+    std::sort(e.begin(), e.end());
+    r.tilt_p99 = e[(size_t)(e.size() * 0.99)];
+    r.tilt_max = e.back();
+    r.yaw_error = wrapDegree(((getYaw(q[filter]) - start_yaw[filter]) - (getYaw(q_ref) - start_yaw[FILTER_NUM])) * RAD2DEG);
+  }
+}
+
+static void printResult(const char *name, const std::vector<Sample> &log, const Result *result)
+{
+  bool has_truth = log.front().has_truth;
+  double duration = (uint32_t)(log.back().time - log.front().time) * 1e-6;
+
+  printf("%s: %zu samples, %.1f min, against %s\n", name, log.size(), duration / 60.0, has_truth ? "the true attitude" : "the EKF");
+  printf("  %-10s %10s %14s %14s %14s %14s\n", "filter", "ns/update", "tilt mean", "tilt p99", "tilt max", "yaw at end");
+  for (int filter = 0; filter < FILTER_NUM; filter++)
+  {
+    const Result &r = result[filter];
+
+    if (has_truth == false && filter == FILTER_EKF)
+      printf("  %-10s %10.1f %14s %14s %14s %14s\n", filter_name[filter], r.nsec, "-", "-", "-", "-");
+    else
+      printf("  %-10s %10.1f %10.3f deg %10.3f deg %10.3f deg %10.2f deg\n", filter_name[filter],
+             r.nsec, r.tilt_mean, r.tilt_p99, r.tilt_max, r.yaw_error);
+  }
+  printf("\n");
+}
+
+static int runSuite()
+{
+  int result_code = 0;
+
+  for (size_t s = 0; s < sizeof(scenario_list) / sizeof(scenario_list[0]); s++)
+  {
+    const Scenario &scenario = scenario_list[s];
+
+    for (unsigned seed = 1; seed <= SUITE_SEED_NUM; seed++)
+    {
+      std::vector<Sample> log = makeLog(scenario.name, 10.0, seed);
+      Result result[FILTER_NUM];
+      char name[64];
+
+      snprintf(name, sizeof(name), "%s, seed %u", scenario.name, seed);
+      replayLog(log, result);
+      printResult(name, log, result);
+
+      for (int filter = 0; filter < FILTER_NUM; filter++)
+      {
+        if (result[filter].tilt_mean > scenario.tilt_mean_max || result[filter].tilt_max > scenario.tilt_max)
+        {
+          printf("%s: %s tilts more than %.1f deg mean or %.1f deg max\n\n", name, filter_name[filter],
+                 scenario.tilt_mean_max, scenario.tilt_max);
+          result_code = 1;
+        }
+      }
+    }
+  }
+
+  return result_code;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc > 3 && strcmp(argv[1], "-w") == 0)
+  {
+    double minutes = (argc > 4) ? atof(argv[4]) : 10.0;
+    unsigned seed  = (argc > 5) ? (unsigned)atoi(argv[5]) : 1;
+
+    if (isScenario(argv[3]) == false)
+    {
+      printf("unknown scenario %s, use static, drive or tumble\n", argv[3]);
+      return 1;
+    }
+    if (writeLog(argv[2], makeLog(argv[3], minutes, seed)) == false)
+    {
+      printf("can't write %s\n", argv[2]);
+      return 1;
+    }
+    return 0;
+  }
+
+  if (argc == 1)
+    return runSuite();
+
+  for (int arg = 1; arg < argc; arg++)
+  {
+    std::vector<Sample> log;
+    Result result[FILTER_NUM];
+
+    if (readLog(argv[arg], log) == false)
+    {
+      printf("can't read %s\n", argv[arg]);
+      return 1;
+    }
+    if (log.size() < 2)
+    {
+      printf("%s has less than 2 samples\n", argv[arg]);
+      return 1;
+    }
+
+    replayLog(log, result);
+    printResult(argv[arg], log, result);
+  }
+
+  return 0;
+}
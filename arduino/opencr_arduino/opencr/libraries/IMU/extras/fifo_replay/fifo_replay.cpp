@@ -0,0 +1,595 @@
+//=============================================================================================
+// fifo_replay.cpp
+//=============================================================================================
+//
+// Host replay of MPU9250 FIFO bytes through the FIFO path of cMPU9250, MPU9250.cpp as it is:
+// fifo_start_read(), the DMA burst, fifo_dma_done(), fifo_read() and fifo_apply().
+//
+// A recording is the byte stream the sensor writes to its FIFO, 22 bytes per sample as
+// fifo_begin() sets it up: accel, temp, gyro, then AK8963 ST1 .. ST2 through slave 0.
+// A simulated sensor writes it at 1 kHz of its own clock into a 512 byte FIFO, which drops its
+// oldest bytes when full. The loop calls fifo_start_read() as cIMU::update() does, with loop
+// jitter and stalls, and the DMA interrupt comes at the end of the SPI transfer.
+//
+// Each sample fifo_read() gives has to be the next whole record the bursts read, and
+// fifo_apply() has to decode it as the reference parser here does. Records are only lost when
+// the loop stalls past the 23 records the FIFO holds or a burst never completes, and
+// fifo_drop_cnt has to count them within 5 %. The time of each sample is compared with the
+// time the sensor took it, on the micros() clock:
+//
+//   error : sample time - true time
+//   step  : time to the previous sample - true time between them, the filter time step
+//
+// Without a recording, a synthetic one of 60 s is replayed. micros() wraps during each run.
+// Every scenario has to stay within its limits, or the program exits with 1.
+//
+// usage: fifo_replay [recording ...]
+//        fifo_replay -w recording [seconds [seed]]
+//
+//=============================================================================================
+
+//-------------------------------------------------------------------------------------------
+// Header files
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <SPI.h>
+#include "MPU9250.h"
+#include "imu_spi.h"
+
+//-------------------------------------------------------------------------------------------
+// Definitions
+
+#define IMU_FIFO_POLL_SAMPLES   4               // as IMU.h
+#define SAMPLE_RATE             1000            // Hz, turtlebot3
+#define RECORD_SIZE             MPU9250_FIFO_RECORD_SIZE
+#define SPI_BYTE_US             (8.0/13.5)      // 13.5 MHz
+#define DMA_LATENCY_US          5.0
+#define CLOCK_START             (0xFFFFFFFFU - 5000000U)    // micros() wraps after 5 s
+#define TAIL_RECORDS            100             // the sensor goes on after the recording
+
+struct Scenario
+{
+  const char *name;
+  double drift_ppm;       // sensor clock against the MCU clock
+  double loop_min_us;
+  double loop_max_us;
+  double stall_every_us;  // the loop is held up this often
+  double stall_us;
+  int    dma_error_every; // this burst never completes
+  bool   may_lose;        // records may be lost, if counted
+  double error_max_us;    // limits of |error| and |step|
+  double step_max_us;
+};
+
+static const Scenario scenario_list[] =
+{
+  {"steady",          0.0, 100.0,  600.0,       0.0,     0.0,   0, false, 650.0, 200.0},
+  {"clock +1%",   10000.0, 100.0,  600.0,       0.0,     0.0,   0, false, 650.0, 200.0},
+  {"clock -1%",  -10000.0, 100.0,  600.0,       0.0,     0.0,   0, false, 650.0, 200.0},
+  {"stall 15 ms",     0.0, 100.0,  600.0, 1000000.0, 15000.0,   0, false, 650.0, 200.0},
+  {"stall 40 ms",     0.0, 100.0,  600.0, 1000000.0, 40000.0,   0, true,  650.0, 200.0},
+  {"dma error",       0.0, 100.0,  600.0,       0.0,     0.0, 500, true,  650.0, 200.0},
+};
+
+// a record as the bursts read it: the recording record of each byte, and its offset in it
+struct Tag
+{
+  int record;
+  int offset;
+};
+
+struct Result
+{
+  int    written;         // records the sensor wrote to its FIFO
+  int    delivered;
+  int    lost;            // written, never delivered
+  int    counted;         // fifo_drop_cnt
+  int    errors;          // fifo_error_cnt
+  int    broken;          // samples that are not the next whole record or do not decode
+  double error_mean;      // us
+  double error_p99;
+  double error_max;
+  double step_max;
+};
+
+
+
+//============================================================================================
+// Simulated clock, sensor and SPI DMA
+
+SPIClass SPI_IMU;
+
+static double   sim_us;
+static std::mt19937 sim_random;
+
+static const std::vector<uint8_t> *recording;
+static int      record_num;
+
+static const Scenario *scenario;
+static double   sensor_period_us;
+static double   sensor_next_us;
+static int      sensor_next_record;
+static std::vector<double> record_time;     // us, when the sensor took each record
+
+static uint8_t  user_ctrl;
+static std::deque<uint8_t> fifo;
+static std::deque<Tag>     fifo_tag;
+
+static bool     dma_pending;
+static double   dma_done_us;
+static void   (*dma_done_func)(void);
+static int      dma_count;
+static std::vector<Tag> dma_tag;
+static std::deque<Tag>  ring_tag;            // the records fifo_read() has to give, in order
+
+uint32_t micros(void)
+{
+  return CLOCK_START + (uint32_t)sim_us;
+}
+
+static void runSensor(void)
+{
+  while (sensor_next_us <= sim_us && sensor_next_record < record_num + TAIL_RECORDS)
+  {
+    if (user_ctrl & MPU9250_FIFO_ENABLE)
+    {
+      int record = sensor_next_record++;
+      int source = std::min(record, record_num - 1);
+
+      record_time[record] = sensor_next_us;
+      for (int i = 0; i < RECORD_SIZE; i++)
+      {
+        fifo.push_back((*recording)[source*RECORD_SIZE + i]);
+        fifo_tag.push_back({record, i});
+      }
+      while (fifo.size() > MPU9250_FIFO_LENGTH)
+      {
+        fifo.pop_front();
+        fifo_tag.pop_front();
+      }
+    }
+    sensor_next_us += sensor_period_us;
+  }
+}
+
+void delay(uint32_t ms)
+{
+  sim_us += ms * 1000.0;
+  runSensor();
+}
+
+int imu_spi_reads(uint8_t slave_addr, uint8_t reg_addr, uint8_t length, uint8_t *data)
+{
+  UNUSED(slave_addr);
+
+  runSensor();
+  memset(data, 0, length);
+  if (reg_addr == MPU9250_FIFO_COUNTH && length == 2)
+  {
+    data[0] = fifo.size() >> 8;
+    data[1] = fifo.size() & 0xFF;
+  }
+  return 0;
+}
+
+uint8_t imu_spi_read(uint8_t addr, uint8_t reg_addr)
+{
+  UNUSED(addr);
+  return (reg_addr == MPU9250_USER_CTRL) ? user_ctrl : 0;
+}
+
+int imu_spi_write(uint8_t addr, uint8_t reg_addr, uint8_t data)
+{
+  UNUSED(addr);
+
+  runSensor();
+  if (reg_addr == MPU9250_USER_CTRL)
+  {
+    if (data & MPU9250_FIFO_RST)
+    {
+      fifo.clear();
+      fifo_tag.clear();
+    }
+    user_ctrl = data & ~MPU9250_FIFO_RST;
+  }
+  return 0;
+}
+
+bool imu_spi_dma_begin(void)
+{
+  return true;
+}
+
+// the burst takes the records out of the FIFO at its start, the interrupt comes at its end
+bool imu_spi_dma_start(uint8_t *p_tx, uint8_t *p_rx, uint32_t length, void (*done_func)(void))
+{
+  UNUSED(p_tx);
+
+  uint32_t read = length - 1;
+
+  runSensor();
+  if (scenario->dma_error_every > 0 && ++dma_count % scenario->dma_error_every == 0)
+  {
+    // the burst stops half way and never completes
+    read /= 2;
+  }
+  else
+  {
+    dma_pending   = true;
+    dma_done_us   = sim_us + length * SPI_BYTE_US + DMA_LATENCY_US;
+    dma_done_func = done_func;
+  }
+
+  dma_tag.clear();
+  p_rx[0] = 0;
+  for (uint32_t i = 0; i < read && !fifo.empty(); i++)
+  {
+    p_rx[1 + i] = fifo.front();
+    dma_tag.push_back(fifo_tag.front());
+    fifo.pop_front();
+    fifo_tag.pop_front();
+  }
+  return true;
+}
+
+void imu_spi_dma_stop(void)
+{
+  dma_pending = false;
+}
+
+void imu_spi_init(void) {}
+void imu_spi_initFast(void) {}
+int  imu_spi_writes(uint8_t slave_addr, uint8_t reg_addr, uint8_t length, uint8_t *data)        { UNUSED(slave_addr); UNUSED(reg_addr); UNUSED(length); UNUSED(data); return 0; }
+int  imu_spi_ak8963_reads(uint8_t akm_addr, uint8_t reg_addr, uint8_t len, uint8_t *data)       { UNUSED(akm_addr); UNUSED(reg_addr); memset(data, 0, len); return 0; }
+int  imu_spi_ak8963_writes(uint8_t akm_addr, uint8_t reg_addr, uint8_t len, uint8_t *data)      { UNUSED(akm_addr); UNUSED(reg_addr); UNUSED(len); UNUSED(data); return 0; }
+int  imu_spi_ak8963_write(uint8_t akm_addr, uint8_t reg_addr, uint8_t data)                     { UNUSED(akm_addr); UNUSED(reg_addr); UNUSED(data); return 0; }
+
+// the DMA interrupt: the records of the burst go to the sample ring of cMPU9250
+static void completeDma(void)
+{
+  dma_pending = false;
+
+  for (size_t i = 0; i + RECORD_SIZE <= dma_tag.size(); i += RECORD_SIZE)
+  {
+    Tag tag = dma_tag[i];
+
+    for (int j = 1; j < RECORD_SIZE; j++)
+    {
+      if (dma_tag[i + j].record != tag.record || dma_tag[i + j].offset != tag.offset + j)
+        tag.record = -1;
+    }
+    if (tag.offset != 0)
+      tag.record = -1;
+    ring_tag.push_back(tag);
+  }
+  dma_done_func();
+}
+
+
+
+//============================================================================================
+// Reference parser
+
+static int16_t getBigEndian(const uint8_t *p)
+{
+  return (int16_t)((p[0] << 8) | p[1]);
+}
+
+static int16_t getLittleEndian(const uint8_t *p)
+{
+  return (int16_t)((p[1] << 8) | p[0]);
+}
+
+// returns false when fifo_apply() did not decode the record as the reference does
+static bool checkDecode(const cMPU9250 &mpu, const uint8_t *record, int16_t *mag)
+{
+  const uint8_t *st1 = &record[14];
+  bool ok = true;
+
+  if ((st1[0] & MPU9250_AK8963_DATA_READY) && !(st1[0] & MPU9250_AK8963_DATA_OVERRUN) &&
+      !(st1[7] & MPU9250_AK8963_OVERFLOW))
+  {
+    for (int i = 0; i < 3; i++)
+      mag[i] = getLittleEndian(&st1[1 + 2*i]);
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    ok &= (mpu.accRAW[i]  == getBigEndian(&record[2*i]));
+    ok &= (mpu.gyroRAW[i] == getBigEndian(&record[8 + 2*i]));
+    ok &= (mpu.magRAW[i]  == mag[i]);
+  }
+  return ok;
+}
+
+
+
+//============================================================================================
+// Replay
+
+static Result replay(const std::vector<uint8_t> &data, const Scenario &s, unsigned seed)
+{
+  Result result = {};
+  std::vector<double> error_list;
+  cMPU9250 *mpu = new cMPU9250;
+  mpu9250_sample_t sample;
+  int16_t  mag[3] = {0, 0, 0};
+  int      prev_record = -1;
+  uint32_t prev_time = 0;
+  uint32_t poll_time = 0;
+  double   next_loop_us;
+  double   next_stall_us = s.stall_every_us;
+  double   end_us;
+
+  recording  = &data;
+  record_num = data.size() / RECORD_SIZE;
+  scenario   = &s;
+  sim_random.seed(seed);
+  sim_us     = 0.0;
+  user_ctrl  = 0;
+  fifo.clear();
+  fifo_tag.clear();
+  ring_tag.clear();
+  dma_pending = false;
+  dma_count   = 0;
+  record_time.assign(record_num + TAIL_RECORDS, 0.0);
+
+  sensor_period_us   = 1000000.0 / SAMPLE_RATE * (1.0 + s.drift_ppm * 1e-6);
+  sensor_next_us     = std::uniform_real_distribution<double>(0.0, sensor_period_us)(sim_random);
+  sensor_next_record = 0;
+
+  mpu->bConnected = true;
+  for (int i = 0; i < 3; i++)
+    mpu->AK8963_ASA[i] = 256;
+  mpu->fifo_begin(SAMPLE_RATE);
+
+  std::uniform_real_distribution<double> loop_us(s.loop_min_us, s.loop_max_us);
+
+  next_loop_us = sim_us;
+  end_us       = sensor_next_us + (record_num + TAIL_RECORDS) * sensor_period_us;
+  while (sim_us < end_us)
+  {
+    if (dma_pending && dma_done_us <= next_loop_us)
+    {
+      sim_us = dma_done_us;
+      runSensor();
+      completeDma();
+      continue;
+    }
+    sim_us = next_loop_us;
+    runSensor();
+
+    // cIMU::update() in IMU_MODE_FIFO
+    if ((micros() - poll_time) >= mpu->fifo_period * IMU_FIFO_POLL_SAMPLES)
+    {
+      poll_time = micros();
+      mpu->fifo_start_read();
+    }
+    while (mpu->fifo_read(&sample) == true)
+    {
+      Tag tag = {-1, 0};
+
+      mpu->fifo_apply(&sample);
+      if (!ring_tag.empty())
+      {
+        tag = ring_tag.front();
+        ring_tag.pop_front();
+      }
+      if (tag.record >= record_num)
+      {
+        continue;
+      }
+      if (tag.record < 0 || tag.record <= prev_record ||
+          memcmp(sample.data, &data[tag.record*RECORD_SIZE], RECORD_SIZE) != 0 ||
+          checkDecode(*mpu, &data[tag.record*RECORD_SIZE], mag) == false)
+      {
+        result.broken++;
+        continue;
+      }
+
+      uint32_t true_time = CLOCK_START + (uint32_t)record_time[tag.record];
+      double   error     = (int32_t)(sample.time - true_time);
+
+      error_list.push_back(error);
+      if (prev_record >= 0 && tag.record == prev_record + 1)
+      {
+        double step = (int32_t)(sample.time - prev_time) - (record_time[tag.record] - record_time[prev_record]);
+        result.step_max = std::max(result.step_max, fabs(step));
+      }
+      prev_record = tag.record;
+      prev_time   = sample.time;
+      result.delivered++;
+    }
+
+    next_loop_us = sim_us + loop_us(sim_random);
+    if (s.stall_every_us > 0.0 && sim_us >= next_stall_us)
+    {
+      next_loop_us  += s.stall_us;
+      next_stall_us += s.stall_every_us;
+    }
+  }
+
+  result.written = std::min(sensor_next_record, record_num);
+  result.lost    = result.written - result.delivered - result.broken;
+  result.counted = mpu->fifo_drop_cnt;
+  result.errors  = mpu->fifo_error_cnt;
+
+  if (!error_list.empty())
+  {
+    double sum = 0.0;
+
+    for (double e : error_list)
+      sum += e;
+    result.error_mean = sum / error_list.size();
+    for (double &e : error_list)
+      e = fabs(e);
+    std::sort(error_list.begin(), error_list.end());
+    result.error_p99 = error_list[error_list.size() * 99 / 100];
+    result.error_max = error_list.back();
+  }
+
+  delete mpu;
+  return result;
+}
+
+// returns false when the result is outside the limits of the scenario
+static bool printResult(const Scenario &s, const Result &r)
+{
+  bool ok = true;
+
+  ok &= (r.broken == 0);
+  ok &= (r.delivered > 0);
+  ok &= (s.may_lose || r.lost == 0);
+  ok &= (abs(r.counted - r.lost) <= r.lost / 20);
+  ok &= (s.dma_error_every == 0 || r.errors > 0);
+  ok &= (r.error_max <= s.error_max_us);
+  ok &= (r.step_max <= s.step_max_us);
+
+  printf("  %-12s %8d %9d %6d %7d %6d %6d %8.1f %7.1f %7.1f %8.1f  %s\n",
+         s.name, r.written, r.delivered, r.lost, r.counted, r.errors, r.broken,
+         r.error_mean, r.error_p99, r.error_max, r.step_max, ok ? "OK" : "NG");
+
+  return ok;
+}
+
+static bool replayAll(const std::vector<uint8_t> &data, const char *name)
+{
+  bool ok = true;
+
+  printf("%s: %u records\n", name, (unsigned)(data.size() / RECORD_SIZE));
+  printf("  scenario      written delivered   lost counted errors broken   error mean/p99/max us  step max us\n");
+  for (const Scenario &s : scenario_list)
+  {
+    ok &= printResult(s, replay(data, s, 1));
+  }
+  return ok;
+}
+
+
+
+//============================================================================================
+// Recordings
+
+// A turtlebot standing and turning: gravity and the yaw rate with noise, the AK8963 at 100 Hz.
+// The temperature bytes count the records, so one out of order cannot pass for the next.
+static std::vector<uint8_t> writeSynthetic(double seconds, unsigned seed)
+{
+  std::mt19937 random(seed);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  int num = (int)(seconds * SAMPLE_RATE);
+  std::vector<uint8_t> data(num * RECORD_SIZE);
+  uint8_t slave[8] = {0};
+
+  for (int k = 0; k < num; k++)
+  {
+    uint8_t *p = &data[k * RECORD_SIZE];
+    double   t = (double)k / SAMPLE_RATE;
+    int16_t  value[7];
+
+    value[0] = (int16_t)(  800.0 + 160.0 * noise(random));      // accel, 16384 LSB/g
+    value[1] = (int16_t)( -300.0 + 160.0 * noise(random));
+    value[2] = (int16_t)(16300.0 + 160.0 * noise(random));
+    value[3] = (int16_t)k;                                       // temp
+    value[4] = (int16_t)(  5.0 * noise(random));                 // gyro, 16.4 LSB/(deg/s)
+    value[5] = (int16_t)(  5.0 * noise(random));
+    value[6] = (int16_t)(1200.0 * sin(0.5 * t) + 5.0 * noise(random));
+    for (int i = 0; i < 7; i++)
+    {
+      p[2*i]     = (uint16_t)value[i] >> 8;
+      p[2*i + 1] = (uint16_t)value[i] & 0xFF;
+    }
+
+    // EXT_SENS_DATA holds the last slave 0 read, a new one every 10 records
+    if (k % 10 == 0)
+    {
+      int16_t field[3] = {(int16_t)(200.0 * cos(0.5 * t)), (int16_t)(200.0 * sin(0.5 * t)), -400};
+
+      slave[0] = MPU9250_AK8963_DATA_READY | ((k % 3000 == 1500) ? MPU9250_AK8963_DATA_OVERRUN : 0);
+      for (int i = 0; i < 3; i++)
+      {
+        slave[1 + 2*i] = (uint16_t)field[i] & 0xFF;
+        slave[2 + 2*i] = (uint16_t)field[i] >> 8;
+      }
+      slave[7] = 0x10 | ((k % 5000 == 2500) ? MPU9250_AK8963_OVERFLOW : 0);
+    }
+    memcpy(&p[14], slave, 8);
+  }
+
+  return data;
+}
+
+static bool readRecording(const char *name, std::vector<uint8_t> &data)
+{
+  FILE *fp = fopen(name, "rb");
+  uint8_t buf[4096];
+  size_t  length;
+
+  if (fp == NULL)
+  {
+    fprintf(stderr, "%s: cannot open\n", name);
+    return false;
+  }
+  data.clear();
+  while ((length = fread(buf, 1, sizeof(buf), fp)) > 0)
+    data.insert(data.end(), buf, buf + length);
+  fclose(fp);
+
+  if (data.size() % RECORD_SIZE != 0)
+  {
+    fprintf(stderr, "%s: %u bytes are not a whole record, ignored\n", name, (unsigned)(data.size() % RECORD_SIZE));
+    data.resize(data.size() - data.size() % RECORD_SIZE);
+  }
+  return true;
+}
+
+
+
+//============================================================================================
+// Main
+
+int main(int argc, char *argv[])
+{
+  bool ok = true;
+
+  if (argc >= 3 && strcmp(argv[1], "-w") == 0)
+  {
+    double   seconds = (argc > 3) ? atof(argv[3]) : 60.0;
+    unsigned seed    = (argc > 4) ? atoi(argv[4]) : 1;
+    std::vector<uint8_t> data = writeSynthetic(seconds, seed);
+    FILE *fp = fopen(argv[2], "wb");
+
+    if (fp == NULL || fwrite(data.data(), 1, data.size(), fp) != data.size())
+    {
+      fprintf(stderr, "%s: cannot write\n", argv[2]);
+      return 1;
+    }
+    fclose(fp);
+    return 0;
+  }
+
+  if (argc == 1)
+  {
+    ok &= replayAll(writeSynthetic(60.0, 1), "synthetic, 60 s");
+  }
+  for (int i = 1; i < argc; i++)
+  {
+    std::vector<uint8_t> data;
+
+    if (readRecording(argv[i], data) == false)
+    {
+      ok = false;
+      continue;
+    }
+    ok &= replayAll(data, argv[i]);
+  }
+
+  return ok ? 0 : 1;
+}
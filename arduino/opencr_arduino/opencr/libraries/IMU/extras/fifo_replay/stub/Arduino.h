@@ -0,0 +1,41 @@
+//=============================================================================================
+// Arduino.h
+//=============================================================================================
+//
+// Host stand-in of the OpenCR core for fifo_replay, as much as MPU9250.cpp uses.
+// micros() and delay() run on the simulated clock of fifo_replay.cpp.
+//
+//=============================================================================================
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PI              3.1415926535897932384626433832795
+#define HIGH            1
+#define LOW             0
+#define OUTPUT          1
+#define ENABLE          1
+
+#define BDPIN_SPI_CS_IMU          0
+
+#define UNUSED(x)                 (void)(x)
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define __DMB()                                     do { } while (0)
+#define SCB_InvalidateDCache_by_Addr(addr, length)  ((void)(addr), (void)(length))
+
+uint32_t micros(void);
+void     delay(uint32_t ms);
+
+inline void pinMode(uint8_t pin, uint8_t mode)       { UNUSED(pin); UNUSED(mode); }
+inline void digitalWrite(uint8_t pin, uint8_t value) { UNUSED(pin); UNUSED(value); }
+
+// the DMA interrupt of fifo_replay.cpp only comes between two calls of the loop
+inline void noInterrupts(void) {}
+inline void interrupts(void)   {}
+
+#endif
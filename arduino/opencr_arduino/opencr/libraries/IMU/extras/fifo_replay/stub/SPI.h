@@ -0,0 +1,30 @@
+//=============================================================================================
+// SPI.h
+//=============================================================================================
+//
+// Host stand-in of the OpenCR SPI library for fifo_replay, the transfers go through
+// the imu_spi functions of fifo_replay.cpp.
+//
+//=============================================================================================
+#ifndef SPI_H
+#define SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE3           3
+#define MSBFIRST            1
+#define SPI_CLOCK_DIV8      8
+#define SPI_CLOCK_DIV128    128
+
+class SPIClass
+{
+public:
+  void begin(void) {}
+  void setDataMode(uint8_t mode)     { UNUSED(mode); }
+  void setBitOrder(uint8_t order)    { UNUSED(order); }
+  void setClockDivider(uint8_t div)  { UNUSED(div); }
+};
+
+extern SPIClass SPI_IMU;
+
+#endif
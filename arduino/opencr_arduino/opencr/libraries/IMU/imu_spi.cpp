@@ -5,6 +5,8 @@
 
 
 
+static void (*imu_spi_dma_done_func)(void) = NULL;
+static volatile bool imu_spi_dma_busy = false;
 
 
 void imu_spi_init(void)
@@ -163,3 +165,53 @@ int imu_spi_ak8963_write(uint8_t akm_addr, uint8_t reg_addr, uint8_t data)
 
   return imu_spi_ak8963_writes(akm_addr,reg_addr, 1, param);
 }
+
+/*---------------------------------------------------------------------------
+     TITLE   : imu_spi_dma_begin
+     WORK    : switch SPI_IMU to DMA, the caller sets the mode and clock again
+---------------------------------------------------------------------------*/
+bool imu_spi_dma_begin(void)
+{
+  SPI_IMU.beginFast();
+
+  return drv_spi_dma_enabled(&hspi1);
+}
+
+static void imu_spi_dma_callback(SPI_HandleTypeDef* hspi)
+{
+  UNUSED(hspi);
+
+  digitalWrite( BDPIN_SPI_CS_IMU, HIGH);
+  imu_spi_dma_busy = false;
+
+  if (imu_spi_dma_done_func != NULL)
+  {
+    (*imu_spi_dma_done_func)();
+  }
+}
+
+/*---------------------------------------------------------------------------
+     TITLE   : imu_spi_dma_start
+     WORK    : one chip-select burst, done_func runs in the DMA interrupt after CS is released
+---------------------------------------------------------------------------*/
+bool imu_spi_dma_start(uint8_t *p_tx, uint8_t *p_rx, uint32_t length, void (*done_func)(void))
+{
+  if (imu_spi_dma_busy == true)
+  {
+    return false;
+  }
+
+  imu_spi_dma_busy      = true;
+  imu_spi_dma_done_func = done_func;
+
+  digitalWrite( BDPIN_SPI_CS_IMU, LOW);
+  drv_spi_start_dma_txrx(&hspi1, p_tx, p_rx, length, imu_spi_dma_callback);
+  return true;
+}
+
+void imu_spi_dma_stop(void)
+{
+  HAL_SPI_DMAStop(&hspi1);
+  digitalWrite( BDPIN_SPI_CS_IMU, HIGH);
+  imu_spi_dma_busy = false;
+}
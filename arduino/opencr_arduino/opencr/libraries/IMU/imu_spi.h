@@ -19,6 +19,10 @@ int imu_spi_ak8963_write(uint8_t akm_addr, uint8_t reg_addr, uint8_t data);
 uint8_t imu_spi_read(uint8_t addr, uint8_t reg_addr);
 int     imu_spi_write(uint8_t addr, uint8_t reg_addr, uint8_t data);
 
+bool imu_spi_dma_begin(void);
+bool imu_spi_dma_start(uint8_t *p_tx, uint8_t *p_rx, uint32_t length, void (*done_func)(void));
+void imu_spi_dma_stop(void);
+
 
 #if defined(__cplusplus)
 }
@@ -0,0 +1,93 @@
+/*
+  Cycles of the Cortex-M7 (DWT cycle counter) per update of the attitude filters
+  cIMU can run (IMU_FILTER_MADGWICK, IMU_FILTER_MAHONY, IMU_FILTER_EKF).
+  Every sample of the IMU goes through all three, and once a second the mean and
+  the largest cycles per update are printed with the roll and pitch of each filter.
+  The accuracy of the filters is measured by libraries/IMU/extras/ahrs_replay on a PC.
+ */
+
+#include <IMU.h>
+
+
+cIMU     IMU;
+
+Madgwick madgwick;
+Mahony   mahony;
+Ekf      ekf;
+AHRS    *filter[3]      = {&madgwick, &mahony, &ekf};
+const char *filter_name[3] = {"Madgwick", "Mahony  ", "EKF     "};
+
+uint32_t cycle_sum[3];
+uint32_t cycle_max[3];
+uint32_t update_count;
+
+
+
+void setup()
+{
+  Serial.begin(115200);
+
+  IMU.begin();
+
+  for( int i=0; i<3; i++ )
+  {
+    filter[i]->begin(200);
+  }
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = 0xC5ACCE55; // unlock the cycle counter of the Cortex-M7
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+
+
+
+void loop()
+{
+  static uint32_t tTime = 0;
+  uint16_t process_us;
+
+
+  process_us = IMU.update();
+  if( process_us > 0 )
+  {
+    for( int i=0; i<3; i++ )
+    {
+      filter[i]->invSampleFreq = (float)process_us/1000000.0f;
+
+      uint32_t start_cycle = DWT->CYCCNT;
+      filter[i]->updateIMU(IMU.gx, IMU.gy, IMU.gz, IMU.ax, IMU.ay, IMU.az);
+      uint32_t cycle = DWT->CYCCNT - start_cycle;
+
+      cycle_sum[i] += cycle;
+      if( cycle > cycle_max[i] ) cycle_max[i] = cycle;
+    }
+    update_count++;
+  }
+
+
+  if( (millis()-tTime) >= 1000 && update_count > 0 )
+  {
+    tTime = millis();
+
+    for( int i=0; i<3; i++ )
+    {
+      Serial.print(filter_name[i]);
+      Serial.print(" : ");
+      Serial.print(cycle_sum[i]/update_count);
+      Serial.print(" cycles/update, max ");
+      Serial.print(cycle_max[i]);
+      Serial.print(", roll ");
+      Serial.print(filter[i]->getRoll());
+      Serial.print(" pitch ");
+      Serial.println(filter[i]->getPitch());
+
+      cycle_sum[i] = 0;
+      cycle_max[i] = 0;
+    }
+    Serial.println();
+    update_count = 0;
+  }
+}
@@ -0,0 +1,58 @@
+/*
+  Prints the MPU9250 samples as cIMU::processIMU() gets them, one line per sample:
+
+    time[us] gyroADC[3] accADC[3] magADC[3]
+
+  Save the output to a file and replay it through the attitude filters on a PC
+  with libraries/IMU/extras/ahrs_replay. Keep the board still until "Start.." is printed,
+  the gyro is calibrated then.
+ */
+
+#include <IMU.h>
+
+
+#define LOG_HZ      200     // cIMU::begin() default
+
+
+cIMU    IMU;
+
+
+
+void setup()
+{
+  Serial.begin(115200);
+  while(!Serial);
+
+  IMU.begin(LOG_HZ, IMU_MODE_POLLING);
+
+  Serial.println("# Start..");
+  Serial.println("# time[us] gyroADC[3] accADC[3] magADC[3]");
+}
+
+
+
+
+
+void loop()
+{
+  static uint32_t tTime = 0;
+  uint32_t sample_time;
+
+
+  if( (micros()-tTime) >= 1000000/LOG_HZ )
+  {
+    tTime = micros();
+
+    // the same reads as cIMU::computeIMU(), without the filter
+    IMU.SEN.acc_get_adc();
+    IMU.SEN.gyro_get_adc();
+    IMU.SEN.mag_get_adc();
+    sample_time = micros();
+
+    Serial.print(sample_time);
+    for( int i=0; i<3; i++ ) { Serial.print(" "); Serial.print(IMU.SEN.gyroADC[i]); }
+    for( int i=0; i<3; i++ ) { Serial.print(" "); Serial.print(IMU.SEN.accADC[i]); }
+    for( int i=0; i<3; i++ ) { Serial.print(" "); Serial.print(IMU.SEN.magADC[i]); }
+    Serial.println();
+  }
+}
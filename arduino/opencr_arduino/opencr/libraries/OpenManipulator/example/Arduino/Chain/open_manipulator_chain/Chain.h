@@ -53,7 +53,7 @@
 
 OPEN_MANIPULATOR::OpenManipulator chain;
 
-OPEN_MANIPULATOR::Kinematics *kinematics = new OM_KINEMATICS::Chain();
+OPEN_MANIPULATOR::Kinematics *kinematics = new OM_KINEMATICS::FixedChain<ACTIVE_JOINT_SIZE>();
 #ifdef PLATFORM ////////////////////////////////////Actuator init
 OPEN_MANIPULATOR::Actuator *actuator = new OM_DYNAMIXEL::Dynamixel();
 #endif /////////////////////////////////////////////
@@ -111,21 +111,21 @@ void fromProcessing(String data)
       SCARA.setRadiusForDrawing(CIRCLE, radius);  
       SCARA.setStartPositionForDrawing(CIRCLE, SCARA.getComponentPositionToWorld(TOOL));
       SCARA.setStartAngularPositionForDrawing(CIRCLE, start_angular_position);
-      SCARA.draw(CIRCLE);
+      SCARA.draw(TOOL, CIRCLE);
 
       // radius = 0.040f;          
       // SCARA.drawInit(RHOMBUS, move_time, p_init_arg);
       // SCARA.setRadiusForDrawing(RHOMBUS, radius);  
       // SCARA.setStartPositionForDrawing(RHOMBUS, SCARA.getComponentPositionToWorld(TOOL));
       // SCARA.setStartAngularPositionForDrawing(RHOMBUS, start_angular_position);
-      // SCARA.draw(RHOMBUS);
+      // SCARA.draw(TOOL, RHOMBUS);
 
       // radius = 0.050f;
       // SCARA.drawInit(HEART, move_time, p_init_arg);
       // SCARA.setRadiusForDrawing(HEART, radius);  
       // SCARA.setStartPositionForDrawing(HEART, SCARA.getComponentPositionToWorld(TOOL));
       // SCARA.setStartAngularPositionForDrawing(HEART, start_angular_position);
-      // SCARA.draw(HEART);
+      // SCARA.draw(TOOL, HEART);
     }
     else if (cmd[1] == "stop")
     {
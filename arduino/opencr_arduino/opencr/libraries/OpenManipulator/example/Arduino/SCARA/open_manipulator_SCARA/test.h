@@ -93,7 +93,7 @@ void test()
         SCARA.setRadiusForDrawing(CIRCLE, radius);  
         SCARA.setStartPositionForDrawing(CIRCLE, SCARA.getComponentPositionToWorld(TOOL));
         SCARA.setStartAngularPositionForDrawing(CIRCLE, start_angular_position);
-        SCARA.draw(CIRCLE);
+        SCARA.draw(TOOL, CIRCLE);
 
         motion_erase = 1;
         motion_page++;
@@ -105,7 +105,7 @@ void test()
         SCARA.setRadiusForDrawing(CIRCLE, radius);  
         SCARA.setStartPositionForDrawing(CIRCLE, SCARA.getComponentPositionToWorld(TOOL));
         SCARA.setStartAngularPositionForDrawing(CIRCLE, start_angular_position);
-        SCARA.draw(CIRCLE);
+        SCARA.draw(TOOL, CIRCLE);
 
         motion_repeat++;
         start_angular_position = start_angular_position + 2*PI/6;
@@ -124,7 +124,7 @@ void test()
         SCARA.setRadiusForDrawing(RHOMBUS, radius);  
         SCARA.setStartPositionForDrawing(RHOMBUS, SCARA.getComponentPositionToWorld(TOOL));
         SCARA.setStartAngularPositionForDrawing(RHOMBUS, start_angular_position);
-        SCARA.draw(RHOMBUS);
+        SCARA.draw(TOOL, RHOMBUS);
 
         motion_erase = 1;
         motion_page++;
@@ -136,7 +136,7 @@ void test()
         SCARA.setRadiusForDrawing(RHOMBUS, radius);  
         SCARA.setStartPositionForDrawing(RHOMBUS, SCARA.getComponentPositionToWorld(TOOL));
         SCARA.setStartAngularPositionForDrawing(RHOMBUS, start_angular_position);
-        SCARA.draw(RHOMBUS);
+        SCARA.draw(TOOL, RHOMBUS);
 
         radius += 0.007f;
         motion_repeat++;
@@ -155,7 +155,7 @@ void test()
         SCARA.setRadiusForDrawing(HEART, radius);  
         SCARA.setStartPositionForDrawing(HEART, SCARA.getComponentPositionToWorld(TOOL));
         SCARA.setStartAngularPositionForDrawing(HEART, start_angular_position);
-        SCARA.draw(HEART);
+        SCARA.draw(TOOL, HEART);
 
         motion_erase = 1;
         motion_page++;
@@ -167,7 +167,7 @@ void test()
       //   SCARA.setRadiusForDrawing(RHOMBUS, radius);  
       //   SCARA.setStartPositionForDrawing(RHOMBUS, SCARA.getComponentPositionToWorld(TOOL));
       //   SCARA.setStartAngularPositionForDrawing(RHOMBUS, start_angular_position);
-      //   SCARA.draw(RHOMBUS);
+      //   SCARA.draw(TOOL, RHOMBUS);
 
       //   motion_repeat++;
       //   start_angular_position = start_angular_position + PI/4;
@@ -185,7 +185,7 @@ void test()
       //   SCARA.setRadiusForDrawing(HEART, radius);  
       //   SCARA.setStartPositionForDrawing(HEART, SCARA.getComponentPositionToWorld(TOOL));
       //   SCARA.setStartAngularPositionForDrawing(HEART, start_angular_position);
-      //   SCARA.draw(HEART);
+      //   SCARA.draw(TOOL, HEART);
 
       //   motion_repeat++;
       //   start_angular_position = start_angular_position + PI/4;
@@ -0,0 +1,96 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Darby Lim, Hye-Jong KIM, Ryan Shim, Yong-Ho Na */
+
+#include <OMPath.h>
+#include <OMDebug.h>
+#include <vector>
+
+#define CONTROL_TIME 0.010f
+#define MOVE_TIME 3.0f
+#define TICK_NUM 300
+
+// Cycles spent per control tick to get position, velocity and acceleration of every joint
+void benchmark(uint8_t joint_num)
+{
+  OM_PATH::JointTrajectory joint_trajectory(joint_num);
+  std::vector<Trajectory> start_trajectory;
+  std::vector<Trajectory> goal_trajectory;
+
+  for (uint8_t index = 0; index < joint_num; index++)
+  {
+    Trajectory start, goal;
+
+    start.position = -0.1f * index;
+    start.velocity = 0.0f;
+    start.acceleration = 0.0f;
+    start_trajectory.push_back(start);
+
+    goal.position = 0.2f * index;
+    goal.velocity = 0.0f;
+    goal.acceleration = 0.0f;
+    goal_trajectory.push_back(goal);
+  }
+
+  joint_trajectory.init(start_trajectory, goal_trajectory, MOVE_TIME, CONTROL_TIME);
+
+  std::vector<float> goal_position(joint_num), goal_velocity(joint_num), goal_acceleration(joint_num);
+  uint32_t vector_cycle = 0;
+  uint32_t fused_cycle = 0;
+
+  for (uint16_t step_cnt = 0; step_cnt < TICK_NUM; step_cnt++)
+  {
+    float tick_time = CONTROL_TIME * step_cnt;
+    uint32_t start_cycle = DWT->CYCCNT;
+
+    goal_position = joint_trajectory.getPosition(tick_time);
+    goal_velocity = joint_trajectory.getVelocity(tick_time);
+    goal_acceleration = joint_trajectory.getAcceleration(tick_time);
+
+    vector_cycle += DWT->CYCCNT - start_cycle;
+    start_cycle = DWT->CYCCNT;
+
+    joint_trajectory.getState(tick_time, &goal_position[0], &goal_velocity[0], &goal_acceleration[0]);
+
+    fused_cycle += DWT->CYCCNT - start_cycle;
+  }
+
+  USB.print("Joint : "); USB.print(joint_num);
+  USB.print(" | getPosition/Velocity/Acceleration : "); USB.print(vector_cycle / TICK_NUM);
+  USB.print(" cycles | getState : "); USB.print(fused_cycle / TICK_NUM);
+  USB.println(" cycles");
+}
+
+void setup()
+{
+  Serial.begin(57600);
+  while (!Serial); // Wait for openning Serial port
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = 0xC5ACCE55; // unlock the cycle counter of the Cortex-M7
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  LOG::INFO("Joint trajectory cycles per tick");
+  benchmark(4);
+  benchmark(6);
+  benchmark(12);
+}
+
+void loop()
+{
+}
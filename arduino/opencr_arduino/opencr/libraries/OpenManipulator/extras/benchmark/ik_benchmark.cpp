@@ -0,0 +1,200 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Hye-Jong KIM, Darby Lim, Ryan Shim, Yong-Ho Na */
+
+// Host side cost of one inverse kinematics solve of the OpenManipulator Chain (example/Arduino/Chain):
+//   Chain                : Chain::inverse(), the solver of OMKinematics.cpp
+//   FixedChain           : FixedChain<4>::inverse() returning std::vector<float>
+//   FixedChain (array)   : FixedChain<4>::inverse() writing into a float array
+// The targets are the tool poses of random joint angles, and every solve starts from those angles
+// moved by up to +-0.15 rad, like the small steps of a task space move.
+// The position error is the distance from the forward kinematics of the solution to the target,
+// and FixedChain must reach the targets as well as Chain does.
+// The same source is built against the tree before FixedChain (ik_benchmark_baseline, KINEMATICS_BASELINE defined),
+// where only Chain exists.
+//
+// usage: ik_benchmark [targets [repeat]]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "OMManager.h"
+#include "OMKinematics.h"
+
+#define DOF         4
+#define TOOL        5
+
+#define X_AXIS OM_MATH::makeVector3(1.0, 0.0, 0.0)
+#define Y_AXIS OM_MATH::makeVector3(0.0, 1.0, 0.0)
+#define Z_AXIS OM_MATH::makeVector3(0.0, 0.0, 1.0)
+
+enum
+{
+  SOLVER_CHAIN,
+  SOLVER_FIXED,
+  SOLVER_FIXED_ARRAY,
+  SOLVER_NUM
+};
+
+static const char *solver_name[SOLVER_NUM] = {"Chain", "FixedChain", "FixedChain (array)"};
+
+struct Result
+{
+  double usec;            // per solve, best of the repeats
+  double mean_error;      // m
+  double max_error;       // m
+  double max_angle_diff;  // rad, against Chain
+};
+
+static double getUsec()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec * 1e-3;
+}
+
+static float getRandom(float range)
+{
+  return ((float)rand() / (float)RAND_MAX - 0.5f) * range;
+}
+
+static void initManipulator(OM_MANAGER::Manipulator *manipulator)
+{
+  manipulator->addWorld(0, 1);
+  manipulator->addComponent(1, 0, 2, OM_MATH::makeVector3(-0.278, 0.0, 0.017), Matrix3f::Identity(), Z_AXIS, 11);
+  manipulator->addComponent(2, 1, 3, OM_MATH::makeVector3(0.0, 0.0, 0.058), Matrix3f::Identity(), Y_AXIS, 12);
+  manipulator->addComponent(3, 2, 4, OM_MATH::makeVector3(0.024, 0.0, 0.128), Matrix3f::Identity(), Y_AXIS, 13);
+  manipulator->addComponent(4, 3, TOOL, OM_MATH::makeVector3(0.124, 0.0, 0.0), Matrix3f::Identity(), Y_AXIS, 14);
+  manipulator->addTool(TOOL, 4, OM_MATH::makeVector3(0.130, 0.0, 0.0), Matrix3f::Identity(), 15, 1.0f);
+}
+
+int main(int argc, char *argv[])
+{
+  int target_num = (argc > 1) ? atoi(argv[1]) : 300;
+  int repeat     = (argc > 2) ? atoi(argv[2]) : 5;
+
+  OM_MANAGER::Manipulator manipulator;
+  OM_KINEMATICS::Chain chain;
+#ifndef KINEMATICS_BASELINE
+  OM_KINEMATICS::FixedChain<DOF> fixed_chain;
+  int solver_num = SOLVER_NUM;
+#else
+  int solver_num = SOLVER_CHAIN + 1;
+#endif
+
+  initManipulator(&manipulator);
+
+  std::vector<Pose> target(target_num);
+  std::vector<std::vector<float> > start(target_num, std::vector<float>(DOF));
+  std::vector<std::vector<float> > chain_angle(target_num);
+
+  srand(1);
+  for (int index = 0; index < target_num; index++)
+  {
+    std::vector<float> angle(DOF);
+    for (int joint = 0; joint < DOF; joint++)
+    {
+      angle[joint] = getRandom(1.2f);
+      start[index][joint] = angle[joint] + getRandom(0.3f);
+    }
+    manipulator.setAllActiveJointAngle(angle);
+    chain.forward(&manipulator);
+    target[index].position = manipulator.getComponentPositionToWorld(TOOL);
+    target[index].orientation = manipulator.getComponentOrientationToWorld(TOOL);
+  }
+
+  printf("%d targets, best of %d runs\n\n", target_num, repeat);
+  printf("  %-20s %12s %14s %14s %16s\n", "solver", "usec/solve", "mean err [m]", "max err [m]", "max diff [rad]");
+
+  Result result[SOLVER_NUM];
+  for (int solver = 0; solver < solver_num; solver++)
+  {
+    Result &r = result[solver];
+    r.usec = 1e30;
+    r.mean_error = r.max_error = r.max_angle_diff = 0.0;
+
+    for (int run = 0; run < repeat; run++)
+    {
+      double usec = 0.0;
+      for (int index = 0; index < target_num; index++)
+      {
+        std::vector<float> angle;
+        manipulator.setAllActiveJointAngle(start[index]);
+        chain.forward(&manipulator);
+
+        double start_time = getUsec();
+        if (solver == SOLVER_CHAIN)
+        {
+          angle = chain.inverse(&manipulator, TOOL, target[index]);
+        }
+#ifndef KINEMATICS_BASELINE
+        else if (solver == SOLVER_FIXED)
+        {
+          angle = fixed_chain.inverse(&manipulator, TOOL, target[index]);
+        }
+        else
+        {
+          float array[DOF];
+          fixed_chain.inverse(&manipulator, TOOL, target[index], array);
+          usec += getUsec() - start_time;
+          angle.assign(array, array + DOF);
+          start_time = getUsec();
+        }
+#endif
+        usec += getUsec() - start_time;
+
+        if (run > 0)
+          continue;
+
+        manipulator.setAllActiveJointAngle(angle);
+        chain.forward(&manipulator);
+        double error = (manipulator.getComponentPositionToWorld(TOOL) - target[index].position).norm();
+        r.mean_error += error / target_num;
+        if (error > r.max_error)
+          r.max_error = error;
+
+        if (solver == SOLVER_CHAIN)
+          chain_angle[index] = angle;
+        for (int joint = 0; joint < DOF; joint++)
+          if (fabs(angle[joint] - chain_angle[index][joint]) > r.max_angle_diff)
+            r.max_angle_diff = fabs(angle[joint] - chain_angle[index][joint]);
+      }
+      if (usec / target_num < r.usec)
+        r.usec = usec / target_num;
+    }
+
+    printf("  %-20s %12.2f %14.2e %14.2e %16.2e\n", solver_name[solver], r.usec, r.mean_error, r.max_error, r.max_angle_diff);
+  }
+
+  int result_code = 0;
+  for (int solver = SOLVER_CHAIN + 1; solver < solver_num; solver++)
+  {
+    // the same damped least squares steps in a different order of float operations
+    if (result[solver].mean_error > result[SOLVER_CHAIN].mean_error * 1.1 + 1e-5)
+    {
+      printf("\n%s reaches the targets worse than Chain\n", solver_name[solver]);
+      result_code = 1;
+    }
+  }
+
+  if (solver_num > SOLVER_FIXED)
+    printf("\nFixedChain is %.1fx faster than Chain\n", result[SOLVER_CHAIN].usec / result[SOLVER_FIXED_ARRAY].usec);
+
+  return result_code;
+}
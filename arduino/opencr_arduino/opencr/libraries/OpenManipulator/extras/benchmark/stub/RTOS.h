@@ -0,0 +1,9 @@
+#pragma once
+// host stand-in for the OpenCR core RTOS.h, only what OpenManipulator uses
+#define osMutexDef(n) int n
+#define osMutexId(n) int n
+#define osMutex(n) n
+#define osWaitForever 0
+inline int osMutexCreate(int) { return 0; }
+inline void osMutexWait(int, int) {}
+inline void osMutexRelease(int) {}
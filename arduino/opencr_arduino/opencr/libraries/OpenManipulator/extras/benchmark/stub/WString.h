@@ -0,0 +1,17 @@
+#pragma once
+// host stand-in for the OpenCR core WString.h, only what OpenManipulator uses
+#include <string>
+class String : public std::string {
+public:
+  String() {}
+  String(const char *s) : std::string(s) {}
+  String(const std::string &s) : std::string(s) {}
+  template <typename T> String(T v) : std::string(std::to_string(v)) {}
+  void trim() {}
+  int indexOf(char c) const { size_t p = find(c); return p == npos ? -1 : (int)p; }
+  String substring(int a, int b = -1) const { return String(substr(a, b < 0 ? npos : b - a)); }
+  float toFloat() const { return std::stof(*this); }
+  int toInt() const { return std::stoi(*this); }
+};
+inline String operator+(const char *a, const String &b) { return String(std::string(a) + b); }
+inline String operator+(const String &a, const String &b) { return String(std::string(a) + std::string(b)); }
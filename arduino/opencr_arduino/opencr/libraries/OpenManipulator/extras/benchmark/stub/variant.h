@@ -0,0 +1,20 @@
+#pragma once
+// host stand-in for the OpenCR core variant.h, only what OpenManipulator uses
+#include <cstdio>
+#include <cstdint>
+#include <string>
+struct FakeSerial {
+  template <typename T> void print(T) {}
+  template <typename T> void print(T, int) {}
+  template <typename T> void println(T) {}
+  template <typename T> void println(T, int) {}
+  void println() {}
+};
+static FakeSerial Serial, SerialBT2;
+#ifndef PI
+#define PI 3.14159265358979f
+#endif
+#include <chrono>
+inline uint32_t micros() { return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+inline uint32_t millis() { return micros() / 1000; }
+inline void delay(uint32_t) {}
@@ -113,6 +113,8 @@ public:
   Component getComponent(OM_MANAGER::Manipulator *manipulator, Name name);
   Name getComponentParentName(OM_MANAGER::Manipulator *manipulator, Name name);
   std::vector<Name> getComponentChildName(OM_MANAGER::Manipulator *manipulator, Name name);
+  int8_t getComponentChildSize(OM_MANAGER::Manipulator *manipulator, Name name);
+  Name getComponentChildName(OM_MANAGER::Manipulator *manipulator, Name name, int8_t index);
   Pose getComponentPoseToWorld(OM_MANAGER::Manipulator *manipulator, Name name);
   Vector3f getComponentPositionToWorld(OM_MANAGER::Manipulator *manipulator, Name name);
   Matrix3f getComponentOrientationToWorld(OM_MANAGER::Manipulator *manipulator, Name name);
@@ -138,6 +140,11 @@ public:
   Matrix3f getComponentInertiaTensor(OM_MANAGER::Manipulator *manipulator, Name name);
   Vector3f getComponentCenterOfMass(OM_MANAGER::Manipulator *manipulator, Name name);
 
+  bool getComponentMoved(OM_MANAGER::Manipulator *manipulator, Name name);
+  bool getComponentChildMoved(OM_MANAGER::Manipulator *manipulator, Name name);
+  void clearComponentMoved(OM_MANAGER::Manipulator *manipulator, Name name);
+  Matrix3f getComponentJointRotation(OM_MANAGER::Manipulator *manipulator, Name name);
+
   std::vector<float> getAllJointAngle(OM_MANAGER::Manipulator *manipulator);
   std::vector<float> getAllActiveJointAngle(OM_MANAGER::Manipulator *manipulator);
   std::vector<uint8_t> getAllActiveJointID(OM_MANAGER::Manipulator *manipulator);
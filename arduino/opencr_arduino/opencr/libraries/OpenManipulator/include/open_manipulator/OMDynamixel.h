@@ -60,8 +60,17 @@ private:
   std::vector<float> radian_value_;
   std::vector<float> torque_value_;
 
+  int8_t goal_position_session_;
+  int8_t present_session_;
+  ItemHandle present_position_;
+  ItemHandle present_current_;
+  bool has_present_current_;
+
+  // Sync Read (Protocol 2.0) or one Read per ID of an item, for when no session could be added
+  uint8_t readItem(ItemHandle item, int32_t *data, bool *available);
+
 public:
-  Dynamixel(){};
+  Dynamixel() : goal_position_session_(-1), present_session_(-1), has_present_current_(false){};
   virtual ~Dynamixel(){};
 
   bool init(uint32_t baud_rate);
@@ -84,6 +93,8 @@ public:
   bool setAngle(uint8_t id, float radian);
   std::vector<float> getAngle();
   std::vector<float> getCurrent();
+  uint8_t getAngle(float *radian, bool *available = NULL);
+  uint8_t getCurrent(float *torque, bool *available = NULL);
 
   uint8_t getDynamixelSize();
   std::vector<uint8_t> getDynamixelIDs();
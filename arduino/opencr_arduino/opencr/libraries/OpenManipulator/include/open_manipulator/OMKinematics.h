@@ -47,11 +47,239 @@ public:
 
   virtual std::vector<float> inverse(OM_MANAGER::Manipulator *manipulator, Name tool_name, Pose target_pose);
 
+  void forward(OM_MANAGER::Manipulator *manipulator, Name component_name, bool is_parent_moved);
+
   std::vector<float> inverseKinematics(OM_MANAGER::Manipulator *manipulator, Name tool_name, Pose target_pose);
   std::vector<float> srInverseKinematics(OM_MANAGER::Manipulator *manipulator, Name tool_name, Pose target_pose);
   std::vector<float> positionOnlyInverseKinematics(OM_MANAGER::Manipulator *manipulator, Name tool_name, Pose target_pose);
 };
 
+/*
+  Chain kinematics with the number of active joints fixed at compile time.
+
+  The joints from the world to the tool are copied once into flat arrays with parent indices,
+  so forward kinematics, the jacobian and the damped least squares inverse kinematics
+  run on fixed size matrices without copying the manipulator or allocating memory.
+  Falls back to Chain when the tool is not reached through DOF active joints.
+*/
+template <int8_t DOF>
+class FixedChain : public Chain
+{
+private:
+  typedef Matrix<float, 6, 1> PoseVector;
+  typedef Matrix<float, 6, DOF> Jacobian;
+  typedef Matrix<float, DOF, 1> JointVector;
+  typedef Matrix<float, DOF, DOF> JointMatrix;
+
+  bool is_built_;
+  Name tool_name_;
+
+  Name joint_name_[DOF];
+  int8_t parent_[DOF];                // index of the parent joint, -1 for the world
+  Vector3f relative_position_[DOF];   // to the parent joint, fixed components folded in
+  Vector3f axis_[DOF];
+  Vector3f tool_relative_position_;   // to the last joint
+
+  Vector3f world_position_;
+  Matrix3f world_orientation_;
+
+  Vector3f position_[DOF];            // result of solveForward()
+  Matrix3f orientation_[DOF];
+  Vector3f tool_position_;
+  Matrix3f tool_orientation_;
+
+public:
+  FixedChain() : is_built_(false), tool_name_(-1){};
+  virtual ~FixedChain(){};
+
+  virtual std::vector<float> inverse(OM_MANAGER::Manipulator *manipulator, Name tool_name, Pose target_pose)
+  {
+    float angle[DOF];
+
+    if (inverse(manipulator, tool_name, target_pose, angle) == false)
+      return Chain::inverse(manipulator, tool_name, target_pose);
+
+    return std::vector<float>(angle, angle + DOF);
+  }
+
+  // angle is ordered as getAllActiveJointAngle(), returns false when the chain can not be built
+  bool inverse(OM_MANAGER::Manipulator *manipulator, Name tool_name, Pose target_pose, float *angle)
+  {
+    if (is_built_ == false || tool_name != tool_name_)
+      is_built_ = build(manipulator, tool_name);
+
+    if (is_built_ == false)
+      return false;
+
+    world_position_ = getWorldPosition(manipulator);
+    world_orientation_ = getWorldOrientation(manipulator);
+
+    for (int8_t index = 0; index < DOF; index++)
+      angle[index] = getComponentJointAngle(manipulator, joint_name_[index]);
+
+    solveInverse(target_pose, angle);
+    return true;
+  }
+
+  bool build(OM_MANAGER::Manipulator *manipulator, Name tool_name)
+  {
+    Name path[DOF];
+    Vector3f offset = getComponentRelativePositionToParent(manipulator, tool_name);
+    int8_t joint_num = 0;
+    Name name = getComponentParentName(manipulator, tool_name);
+
+    if (getDOF(manipulator) != DOF)
+      return false;
+
+    // walk from the tool to the world, folding fixed components into the offset of the joint below them
+    while (name != getWorldName(manipulator))
+    {
+      if (getComponentJointId(manipulator, name) != -1)
+      {
+        if (joint_num >= DOF)
+          return false;
+
+        path[joint_num] = name;
+        if (joint_num == 0)
+          tool_relative_position_ = offset;
+        else
+          relative_position_[DOF - joint_num] = offset;
+
+        offset = getComponentRelativePositionToParent(manipulator, name);
+        joint_num++;
+      }
+      else
+      {
+        // a passive joint can not be folded
+        if (getComponentJointAxis(manipulator, name) != ZERO_VECTOR)
+          return false;
+
+        offset += getComponentRelativePositionToParent(manipulator, name);
+      }
+      name = getComponentParentName(manipulator, name);
+    }
+
+    if (joint_num != DOF)
+      return false;
+
+    relative_position_[0] = offset;
+
+    for (int8_t index = 0; index < DOF; index++)
+    {
+      joint_name_[index] = path[DOF - 1 - index];
+      axis_[index] = getComponentJointAxis(manipulator, joint_name_[index]);
+      parent_[index] = index - 1;
+    }
+
+    // joints are ordered as getAllActiveJointAngle() (by name), which must be the path order
+    for (int8_t index = 1; index < DOF; index++)
+    {
+      if (joint_name_[index] < joint_name_[index - 1])
+        return false;
+    }
+
+    tool_name_ = tool_name;
+    return true;
+  }
+
+  void solveForward(const float *angle)
+  {
+    for (int8_t index = 0; index < DOF; index++)
+    {
+      const Vector3f &parent_position = (parent_[index] < 0) ? world_position_ : position_[parent_[index]];
+      const Matrix3f &parent_orientation = (parent_[index] < 0) ? world_orientation_ : orientation_[parent_[index]];
+
+      position_[index] = parent_orientation * relative_position_[index] + parent_position;
+      orientation_[index] = parent_orientation * OM_MATH::rodriguesRotationMatrix(axis_[index], angle[index]);
+    }
+
+    tool_position_ = orientation_[DOF - 1] * tool_relative_position_ + position_[DOF - 1];
+    tool_orientation_ = orientation_[DOF - 1];
+  }
+
+  void solveJacobian(Jacobian *jacobian)
+  {
+    for (int8_t index = 0; index < DOF; index++)
+    {
+      const Matrix3f &parent_orientation = (parent_[index] < 0) ? world_orientation_ : orientation_[parent_[index]];
+      Vector3f joint_axis = parent_orientation * axis_[index];
+
+      jacobian->col(index).template head<3>() = OM_MATH::skewSymmetricMatrix(joint_axis) * (tool_position_ - position_[index]);
+      jacobian->col(index).template tail<3>() = joint_axis;
+    }
+  }
+
+  // same damped least squares as Chain::srInverseKinematics(), angle is the initial guess and the result
+  void solveInverse(const Pose &target_pose, float *angle)
+  {
+    const float param = 0.002;
+    const int8_t iteration = 50;
+
+    Jacobian jacobian;
+    JointMatrix updated_jacobian;
+    JointVector gerr;
+    JointVector angle_changed;
+    PoseVector pose_changed;
+    PoseVector We;
+
+    float wn_pos = 1 / 0.3;
+    float wn_ang = 1 / (2 * M_PI);
+    float Ek = 0.0;
+    float Ek2 = 0.0;
+
+    We << wn_pos, wn_pos, wn_pos, wn_ang, wn_ang, wn_ang;
+
+    solveForward(angle);
+    poseDifference(target_pose, &pose_changed);
+    Ek = pose_changed.dot(We.asDiagonal() * pose_changed);
+
+    for (int8_t count = 0; count < iteration; count++)
+    {
+      solveJacobian(&jacobian);
+
+      updated_jacobian = jacobian.transpose() * We.asDiagonal() * jacobian;
+      updated_jacobian.diagonal().array() += Ek + param;
+      gerr = jacobian.transpose() * (We.asDiagonal() * pose_changed);
+
+      angle_changed = updated_jacobian.ldlt().solve(gerr);
+
+      for (int8_t index = 0; index < DOF; index++)
+        angle[index] += angle_changed(index);
+
+      solveForward(angle);
+      poseDifference(target_pose, &pose_changed);
+
+      Ek2 = pose_changed.dot(We.asDiagonal() * pose_changed);
+
+      if (Ek2 < 1E-12)
+      {
+        return;
+      }
+      else if (Ek2 < Ek)
+      {
+        Ek = Ek2;
+      }
+      else
+      {
+        for (int8_t index = 0; index < DOF; index++)
+          angle[index] -= angle_changed(index);
+
+        solveForward(angle);
+      }
+    }
+  }
+
+  Vector3f getToolPosition() { return tool_position_; }
+  Matrix3f getToolOrientation() { return tool_orientation_; }
+
+private:
+  void poseDifference(const Pose &target_pose, PoseVector *pose_changed)
+  {
+    pose_changed->template head<3>() = target_pose.position - tool_position_;
+    pose_changed->template tail<3>() = OM_MATH::orientationDifference(target_pose.orientation, tool_orientation_);
+  }
+};
+
 class SCARA : public OPEN_MANIPULATOR::Kinematics
 {
 public:
@@ -75,6 +75,14 @@ typedef struct
   State origin;
 } World;
 
+typedef struct
+{
+  bool is_moved;        //pose_to_world is out of date
+  bool has_moved_child; //a component below this one is out of date
+  float angle;          //joint angle the rotation was computed with
+  Matrix3f rotation;    //rodrigues rotation of the joint axis by angle
+} ForwardCache;
+
 typedef struct
 {
   Name parent;
@@ -85,6 +93,7 @@ typedef struct
   Joint joint;
   Tool tool;
   Inertia inertia;
+  ForwardCache cache;
 } Component;
 
 namespace OM_MANAGER
@@ -127,9 +136,15 @@ private:
   component_.at(name).inertia.mass
   component_.at(name).inertia.inertia_tensor
   component_.at(name).inertia.center_of_mass
+  component_.at(name).cache.is_moved
+  component_.at(name).cache.has_moved_child
+  component_.at(name).cache.angle
+  component_.at(name).cache.rotation
   */
   /////////////////////////////////////////////////////////////////////////////
 
+  void setComponentMoved(Name name);
+
 public:
   Manipulator() : dof_(0){};
   virtual ~Manipulator(){};
@@ -210,6 +225,8 @@ public:
   Component getComponent(Name name);
   Name getComponentParentName(Name name);
   std::vector<Name> getComponentChildName(Name name);
+  int8_t getComponentChildSize(Name name);
+  Name getComponentChildName(Name name, int8_t index);
   Pose getComponentPoseToWorld(Name name);
   Vector3f getComponentPositionToWorld(Name name);
   Matrix3f getComponentOrientationToWorld(Name name);
@@ -235,6 +252,13 @@ public:
   Matrix3f getComponentInertiaTensor(Name name);
   Vector3f getComponentCenterOfMass(Name name);
 
+  ////////////////////////////Forward kinematics cache//////////////////////////
+
+  bool getComponentMoved(Name name);
+  bool getComponentChildMoved(Name name);
+  void clearComponentMoved(Name name);
+  Matrix3f getComponentJointRotation(Name name);
+
   std::vector<float> getAllJointAngle();
   std::vector<float> getAllActiveJointAngle();
   std::vector<uint8_t> getAllActiveJointID();
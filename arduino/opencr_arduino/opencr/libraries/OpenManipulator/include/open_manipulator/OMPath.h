@@ -25,6 +25,7 @@
 
 #include <math.h>
 #include <vector>
+#include <algorithm>
 
 #include "OMAPI.h"
 #include "OMDebug.h"
@@ -63,7 +64,7 @@ private:
   MinimumJerk path_generator_;
 
   uint8_t joint_num_;
-  MatrixXf coefficient_;
+  std::vector<float> coefficient_; // structure of arrays, coefficient_[order * joint_num_ + joint]
   std::vector<float> position_;
   std::vector<float> velocity_;
   std::vector<float> acceleration_;
@@ -80,9 +81,46 @@ public:
   std::vector<float> getPosition(float tick);
   std::vector<float> getVelocity(float tick);
   std::vector<float> getAcceleration(float tick);
+  void getState(float tick, float *position, float *velocity, float *acceleration);
 
   MatrixXf getCoefficient();
 };
+
+// Joint positions solved ahead of time at a fixed sample time and linearly interpolated on playback.
+// With quantize, each joint is stored as 16 bit steps between its own minimum and maximum.
+class SampledJointTrajectory
+{
+private:
+  uint8_t joint_num_;
+  uint16_t sample_num_;
+  float sample_time_;
+  float move_time_;
+  bool quantize_;
+
+  std::vector<float> sample_;              // joint_num_ values per sample
+  std::vector<int16_t> quantized_sample_;
+  std::vector<float> offset_;              // position = offset_ + scale_ * (quantized_sample_ + 32768)
+  std::vector<float> scale_;
+  float max_jump_;
+
+  std::vector<float> position_;
+
+  float getSample(uint16_t sample, uint8_t joint);
+
+public:
+  SampledJointTrajectory();
+  virtual ~SampledJointTrajectory();
+
+  void init(uint8_t joint_num, uint16_t sample_num, float sample_time, float move_time, bool quantize = false);
+  void setSample(uint16_t sample, std::vector<float> position);
+  void complete();
+
+  std::vector<float> getPosition(float tick);
+
+  uint16_t getSampleNum();
+  float getMaxJump();
+};
+
 class Line
 {
 private:
@@ -54,6 +54,13 @@ typedef struct
   Pose pose;
 } Goal;
 
+typedef struct
+{
+  uint16_t sample_num;
+  float planning_time;  //[s]
+  float max_joint_jump; //[rad] between two samples
+} DrawingReport;
+
 class OpenManipulator
 {
 private:
@@ -87,6 +94,11 @@ private:
   Name object_;
   uint16_t draw_cnt_;
 
+  OM_PATH::SampledJointTrajectory drawing_trajectory_;
+  DrawingReport drawing_report_;
+  bool drawing_planned_;
+  Name planned_object_;
+
   String cmd_[50];
 
 public:
@@ -230,6 +242,9 @@ public:
   void setStartAngularPositionForDrawing(Name name, float start_position);
 
   Pose getPoseForDrawing(Name name, float tick);
+  DrawingReport planDrawing(Name tool_name, Name object, bool quantize = false, uint8_t control_step = 1);
+  DrawingReport getDrawingReport();
+  void draw(Name tool_name, Name object);
   void draw(Name object);
   bool drawing();
   void jointControlForDrawing(Name tool_name);
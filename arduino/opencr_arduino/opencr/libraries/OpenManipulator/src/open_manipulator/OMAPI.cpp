@@ -248,6 +248,16 @@ std::vector<Name> Manager::getComponentChildName(OM_MANAGER::Manipulator *manipu
   return manipulator->getComponentChildName(name);
 }
 
+int8_t Manager::getComponentChildSize(OM_MANAGER::Manipulator *manipulator, Name name)
+{
+  return manipulator->getComponentChildSize(name);
+}
+
+Name Manager::getComponentChildName(OM_MANAGER::Manipulator *manipulator, Name name, int8_t index)
+{
+  return manipulator->getComponentChildName(name, index);
+}
+
 Pose Manager::getComponentPoseToWorld(OM_MANAGER::Manipulator *manipulator, Name name)
 {
   return manipulator->getComponentPoseToWorld(name);
@@ -382,6 +392,26 @@ Vector3f Manager::getComponentCenterOfMass(OM_MANAGER::Manipulator *manipulator,
   return manipulator->getComponentCenterOfMass(name);
 }
 
+bool Manager::getComponentMoved(OM_MANAGER::Manipulator *manipulator, Name name)
+{
+  return manipulator->getComponentMoved(name);
+}
+
+bool Manager::getComponentChildMoved(OM_MANAGER::Manipulator *manipulator, Name name)
+{
+  return manipulator->getComponentChildMoved(name);
+}
+
+void Manager::clearComponentMoved(OM_MANAGER::Manipulator *manipulator, Name name)
+{
+  manipulator->clearComponentMoved(name);
+}
+
+Matrix3f Manager::getComponentJointRotation(OM_MANAGER::Manipulator *manipulator, Name name)
+{
+  return manipulator->getComponentJointRotation(name);
+}
+
 std::vector<uint8_t> Manager::getAllActiveJointID(OM_MANAGER::Manipulator *manipulator)
 {
   return manipulator->getAllActiveJointID();
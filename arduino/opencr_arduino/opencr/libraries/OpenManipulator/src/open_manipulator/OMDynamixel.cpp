@@ -38,12 +38,29 @@ bool Dynamixel::init(uint32_t baud_rate)
   else
     return false;
 
-  radian_value_.reserve(dxl_info_.size);
-  torque_value_.reserve(dxl_info_.size);
+  radian_value_.resize(dxl_info_.size);
+  torque_value_.resize(dxl_info_.size);
 
+  dxl_wb_.getItemHandle(dxl_id_.at(0), PRESENT_POSITION, &present_position_);
+  has_present_current_ = dxl_wb_.getItemHandle(dxl_id_.at(0), PRESENT_CURRENT, &present_current_);
+
+  // the handlers serve getAngle() and getCurrent() when no session could be added
   dxl_wb_.addSyncWrite(GOAL_POSITION);
   if (dxl_wb_.getProtocolVersion() == 2.0)
+  {
     dxl_wb_.addSyncRead(PRESENT_POSITION);
+    if (has_present_current_)
+      dxl_wb_.addSyncRead(PRESENT_CURRENT);
+  }
+
+  // Present_Current sits right before Present_Position on X series,
+  // so one transaction serves both getAngle() and getCurrent()
+  goal_position_session_ = dxl_wb_.addSyncWriteSession(&dxl_id_[0], dxl_info_.size, GOAL_POSITION);
+
+  if (has_present_current_)
+    present_session_ = dxl_wb_.addSyncReadSession(&dxl_id_[0], dxl_info_.size, PRESENT_CURRENT, PRESENT_POSITION);
+  if (present_session_ < 0)
+    present_session_ = dxl_wb_.addSyncReadSession(&dxl_id_[0], dxl_info_.size, PRESENT_POSITION);
 
   return true;
 }
@@ -130,6 +147,9 @@ bool Dynamixel::setAngle(std::vector<float> radian_vector)
   for (uint8_t index = 0; index < dxl_info_.size; index++)
     set_position[index] = dxl_wb_.convertRadian2Value(dxl_id_.at(index), radian_vector.at(index));
 
+  if (goal_position_session_ >= 0)
+    return dxl_wb_.syncWriteSession(goal_position_session_, &set_position[0]);
+
   return dxl_wb_.syncWrite(GOAL_POSITION, &set_position[0]);
 }
 
@@ -176,34 +196,94 @@ int32_t Dynamixel::getData(uint8_t id, uint16_t addr, uint8_t length)
 
 std::vector<float> Dynamixel::getAngle()
 {
-  int32_t *get_position_ptr = NULL;
-  radian_value_.clear();
+  getAngle(&radian_value_[0]);
 
-  if (dxl_wb_.getProtocolVersion() == 2.0)
+  return radian_value_;
+}
+
+std::vector<float> Dynamixel::getCurrent()
+{
+  getCurrent(&torque_value_[0]);
+
+  return torque_value_;
+}
+
+uint8_t Dynamixel::getAngle(float *radian, bool *available)
+{
+  int32_t get_position[MAX_SESSION_ID_NUM] = {0, };
+  bool get_available[MAX_SESSION_ID_NUM] = {false, };
+  uint8_t available_cnt = 0;
+
+  if (present_session_ >= 0)
   {
-    get_position_ptr = dxl_wb_.syncRead(PRESENT_POSITION);    
+    dxl_wb_.syncReadSession(present_session_);
+    available_cnt = dxl_wb_.getSyncReadSessionData(present_session_, present_position_, get_position, get_available);
+  }
+  else
+  {
+    available_cnt = readItem(present_position_, get_position, get_available);
+  }
 
-    for (uint8_t index = 0; index < dxl_info_.size; index++)
-      radian_value_.push_back(dxl_wb_.convertValue2Radian(dxl_id_.at(index), get_position_ptr[index]));
+  for (uint8_t index = 0; index < dxl_info_.size; index++)
+  {
+    if (get_available[index])
+      radian[index] = dxl_wb_.convertValue2Radian(dxl_id_.at(index), get_position[index]);
+    if (available != NULL)
+      available[index] = get_available[index];
+  }
+
+  return available_cnt;
+}
+
+uint8_t Dynamixel::getCurrent(float *torque, bool *available)
+{
+  int32_t get_current[MAX_SESSION_ID_NUM] = {0, };
+  bool get_available[MAX_SESSION_ID_NUM] = {false, };
+  uint8_t available_cnt = 0;
+
+  if (has_present_current_ == false)
+    return 0;
+
+  if (present_session_ >= 0)
+  {
+    dxl_wb_.syncReadSession(present_session_);
+    available_cnt = dxl_wb_.getSyncReadSessionData(present_session_, present_current_, get_current, get_available);
   }
   else
   {
-    for (uint8_t index = 0; index < dxl_info_.size; index++)
-      radian_value_.push_back(dxl_wb_.convertValue2Radian(dxl_id_.at(index), dxl_wb_.itemRead(dxl_id_.at(index), PRESENT_POSITION)));
+    available_cnt = readItem(present_current_, get_current, get_available);
   }
 
-  return radian_value_;
+  for (uint8_t index = 0; index < dxl_info_.size; index++)
+  {
+    if (get_available[index])
+      torque[index] = dxl_wb_.convertValue2Torque(dxl_id_.at(index), get_current[index]);
+    if (available != NULL)
+      available[index] = get_available[index];
+  }
+
+  return available_cnt;
 }
 
-std::vector<float> Dynamixel::getCurrent()
+uint8_t Dynamixel::readItem(ItemHandle item, int32_t *data, bool *available)
 {
-  int32_t *get_current_ptr = NULL;
-  get_current_ptr = dxl_wb_.syncRead(PRESENT_CURRENT);
+  if (dxl_wb_.getProtocolVersion() == 2.0)
+  {
+    int32_t *get_data_ptr = dxl_wb_.syncRead(item);
+
+    for (uint8_t index = 0; index < dxl_info_.size; index++)
+      data[index] = get_data_ptr[index];
+  }
+  else
+  {
+    for (uint8_t index = 0; index < dxl_info_.size; index++)
+      data[index] = dxl_wb_.itemRead(dxl_id_.at(index), item);
+  }
 
   for (uint8_t index = 0; index < dxl_info_.size; index++)
-    torque_value_.push_back(dxl_wb_.convertValue2Torque(dxl_id_.at(index), get_current_ptr[index]));
+    available[index] = true;
 
-  return torque_value_;
+  return dxl_info_.size;
 }
 
 int32_t Dynamixel::convertRadian2Value(uint8_t id, float radian)
@@ -60,7 +60,7 @@ MatrixXf Chain::jacobian(OM_MANAGER::Manipulator *manipulator, Name tool_name)
 
     jacobian.col(index) = pose_changed;
     index++;
-    my_name = getComponentChildName(manipulator, my_name).at(0); // Get Child name which has active joint
+    my_name = getComponentChildName(manipulator, my_name, 0); // Get Child name which has active joint
   }
   return jacobian;
 }
@@ -71,36 +71,51 @@ void Chain::forward(OM_MANAGER::Manipulator *manipulator)
 }
 
 void Chain::forward(OM_MANAGER::Manipulator *manipulator, Name component_name)
+{
+  forward(manipulator, component_name, false);
+}
+
+// Only the components whose joint angle (or a parent pose) changed since the last call are recomputed.
+// Branches without a moved component are skipped and unchanged joints reuse their cached rotation.
+void Chain::forward(OM_MANAGER::Manipulator *manipulator, Name component_name, bool is_parent_moved)
 {
   Name my_name = component_name;
-  Name parent_name = getComponentParentName(manipulator, my_name);
-  int8_t number_of_child = getComponentChildName(manipulator, my_name).size();
+  bool is_moved = is_parent_moved || getComponentMoved(manipulator, my_name);
 
-  Vector3f parent_position_to_world, my_position_to_world;
-  Matrix3f parent_orientation_to_world, my_orientation_to_world;
+  if (!is_moved && !getComponentChildMoved(manipulator, my_name))
+    return;
 
-  if (parent_name == getWorldName(manipulator))
-  {
-    parent_position_to_world = getWorldPosition(manipulator);
-    parent_orientation_to_world = getWorldOrientation(manipulator);
-  }
-  else
+  if (is_moved)
   {
-    parent_position_to_world = getComponentPositionToWorld(manipulator, parent_name);
-    parent_orientation_to_world = getComponentOrientationToWorld(manipulator, parent_name);
-  }
+    Name parent_name = getComponentParentName(manipulator, my_name);
+
+    Vector3f parent_position_to_world, my_position_to_world;
+    Matrix3f parent_orientation_to_world, my_orientation_to_world;
 
-  my_position_to_world = parent_orientation_to_world * getComponentRelativePositionToParent(manipulator, my_name) + parent_position_to_world;
-  my_orientation_to_world = parent_orientation_to_world * OM_MATH::rodriguesRotationMatrix(getComponentJointAxis(manipulator, my_name), getComponentJointAngle(manipulator, my_name));
+    if (parent_name == getWorldName(manipulator))
+    {
+      parent_position_to_world = getWorldPosition(manipulator);
+      parent_orientation_to_world = getWorldOrientation(manipulator);
+    }
+    else
+    {
+      parent_position_to_world = getComponentPositionToWorld(manipulator, parent_name);
+      parent_orientation_to_world = getComponentOrientationToWorld(manipulator, parent_name);
+    }
 
-  setComponentPositionToWorld(manipulator, my_name, my_position_to_world);
-  setComponentOrientationToWorld(manipulator, my_name, my_orientation_to_world);
+    my_position_to_world = parent_orientation_to_world * getComponentRelativePositionToParent(manipulator, my_name) + parent_position_to_world;
+    my_orientation_to_world = parent_orientation_to_world * getComponentJointRotation(manipulator, my_name);
+
+    setComponentPositionToWorld(manipulator, my_name, my_position_to_world);
+    setComponentOrientationToWorld(manipulator, my_name, my_orientation_to_world);
+  }
 
+  int8_t number_of_child = getComponentChildSize(manipulator, my_name);
   for (int8_t index = 0; index < number_of_child; index++)
   {
-    Name child_name = getComponentChildName(manipulator, my_name).at(index);
-    forward(manipulator, child_name);
+    forward(manipulator, getComponentChildName(manipulator, my_name, index), is_moved);
   }
+  clearComponentMoved(manipulator, my_name);
 }
 
 std::vector<float> Chain::inverse(OM_MANAGER::Manipulator *manipulator, Name tool_name, Pose target_pose)
@@ -136,9 +151,9 @@ std::vector<float> Chain::inverseKinematics(OM_MANAGER::Manipulator *manipulator
     ColPivHouseholderQR<MatrixXf> dec(jacobian);
     angle_changed = lambda * dec.solve(pose_changed);
 
-    std::vector<float> set_angle_changed;
+    std::vector<float> set_angle_changed = getAllActiveJointAngle(&_manipulator);
     for (int8_t index = 0; index < getDOF(&_manipulator); index++)
-      set_angle_changed.push_back(getAllActiveJointAngle(&_manipulator).at(index) + angle_changed(index));
+      set_angle_changed.at(index) += angle_changed(index);
 
     setAllActiveJointAngle(&_manipulator, set_angle_changed);
   }
@@ -191,9 +206,9 @@ std::vector<float> Chain::srInverseKinematics(OM_MANAGER::Manipulator *manipulat
     ColPivHouseholderQR<MatrixXf> dec(updated_jacobian);
     angle_changed = dec.solve(gerr);
 
-    std::vector<float> set_angle_changed;
+    std::vector<float> set_angle_changed = getAllActiveJointAngle(&_manipulator);
     for (int8_t index = 0; index < getDOF(&_manipulator); index++)
-      set_angle_changed.push_back(getAllActiveJointAngle(&_manipulator).at(index) + angle_changed(index));
+      set_angle_changed.at(index) += angle_changed(index);
 
     setAllActiveJointAngle(&_manipulator, set_angle_changed);
 
@@ -213,9 +228,9 @@ std::vector<float> Chain::srInverseKinematics(OM_MANAGER::Manipulator *manipulat
     }
     else
     {
-      std::vector<float> set_angle_changed;
+      std::vector<float> set_angle_changed = getAllActiveJointAngle(&_manipulator);
       for (int8_t index = 0; index < getDOF(&_manipulator); index++)
-        set_angle_changed.push_back(getAllActiveJointAngle(&_manipulator).at(index) - angle_changed(index));
+        set_angle_changed.at(index) -= angle_changed(index);
 
       setAllActiveJointAngle(&_manipulator, set_angle_changed);
 
@@ -271,9 +286,9 @@ std::vector<float> Chain::positionOnlyInverseKinematics(OM_MANAGER::Manipulator
     ColPivHouseholderQR<MatrixXf> dec(updated_jacobian);
     angle_changed = dec.solve(gerr);
 
-    std::vector<float> set_angle_changed;
+    std::vector<float> set_angle_changed = getAllActiveJointAngle(&_manipulator);
     for (int8_t index = 0; index < getDOF(&_manipulator); index++)
-      set_angle_changed.push_back(getAllActiveJointAngle(&_manipulator).at(index) + angle_changed(index));
+      set_angle_changed.at(index) += angle_changed(index);
 
     setAllActiveJointAngle(&_manipulator, set_angle_changed);
 
@@ -292,9 +307,9 @@ std::vector<float> Chain::positionOnlyInverseKinematics(OM_MANAGER::Manipulator
     }
     else
     {
-      std::vector<float> set_angle_changed;
+      std::vector<float> set_angle_changed = getAllActiveJointAngle(&_manipulator);
       for (int8_t index = 0; index < getDOF(&_manipulator); index++)
-        set_angle_changed.push_back(getAllActiveJointAngle(&_manipulator).at(index) - angle_changed(index));
+        set_angle_changed.at(index) -= angle_changed(index);
 
       setAllActiveJointAngle(&_manipulator, set_angle_changed);
 
@@ -416,9 +431,9 @@ void Link::forward(OM_MANAGER::Manipulator *manipulator)
   setComponentPoseToWorld(manipulator, getWorldChildName(manipulator), result_pose);
 
   //Next Component Pose Set
-  for (int i = 0; i < getComponentChildName(manipulator, getWorldChildName(manipulator)).size(); i++)
+  for (int8_t i = 0; i < getComponentChildSize(manipulator, getWorldChildName(manipulator)); i++)
   {
-    solveKinematicsSinglePoint(manipulator, getComponentChildName(manipulator, getWorldChildName(manipulator)).at(i));
+    solveKinematicsSinglePoint(manipulator, getComponentChildName(manipulator, getWorldChildName(manipulator), i));
   }
 }
 
@@ -442,9 +457,9 @@ void Link::solveKinematicsSinglePoint(OM_MANAGER::Manipulator *manipulator, Name
   result_pose.orientation = parent_pose.orientation * link_relative_pose.orientation * rodrigues_rotation_matrix;
 
   setComponentPoseToWorld(manipulator, component_name, result_pose);
-  for (int i = 0; i < getComponentChildName(manipulator, component_name).size(); i++)
+  for (int8_t i = 0; i < getComponentChildSize(manipulator, component_name); i++)
   {
-    solveKinematicsSinglePoint(manipulator, getComponentChildName(manipulator, component_name).at(i));
+    solveKinematicsSinglePoint(manipulator, getComponentChildName(manipulator, component_name, i));
   }
 }
 
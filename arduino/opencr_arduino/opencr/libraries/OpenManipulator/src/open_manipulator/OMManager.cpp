@@ -17,6 +17,7 @@
 /* Authors: Hye-Jong KIM, Darby Lim, Ryan Shim, Yong-Ho Na */
 
 #include "../../include/open_manipulator/OMManager.h"
+#include "../../include/open_manipulator/OMMath.h"
 
 using namespace Eigen;
 
@@ -72,8 +73,13 @@ void OM_MANAGER::Manipulator::addComponent(Name my_name,
   temp_component.inertia.mass = mass;
   temp_component.inertia.inertia_tensor = inertia_tensor;
   temp_component.inertia.center_of_mass = center_of_mass;
+  temp_component.cache.is_moved = true;
+  temp_component.cache.has_moved_child = false;
+  temp_component.cache.angle = 0.0;
+  temp_component.cache.rotation = Matrix3f::Identity(3, 3);
 
   component_.insert(std::make_pair(my_name, temp_component));
+  setComponentMoved(my_name);
 }
 
 void OM_MANAGER::Manipulator::addComponentChild(Name my_name, Name child_name)
@@ -113,8 +119,13 @@ void OM_MANAGER::Manipulator::addTool(Name my_name,
   temp_component.inertia.mass = mass;
   temp_component.inertia.inertia_tensor = inertia_tensor;
   temp_component.inertia.center_of_mass = center_of_mass;
+  temp_component.cache.is_moved = true;
+  temp_component.cache.has_moved_child = false;
+  temp_component.cache.angle = 0.0;
+  temp_component.cache.rotation = Matrix3f::Identity(3, 3);
 
   component_.insert(std::make_pair(my_name, temp_component));
+  setComponentMoved(my_name);
 }
 
 void OM_MANAGER::Manipulator::checkManipulatorSetting()
@@ -192,16 +203,25 @@ void OM_MANAGER::Manipulator::checkManipulatorSetting()
 void OM_MANAGER::Manipulator::setWorldPose(Pose world_pose)
 {
   world_.pose = world_pose;
+
+  if (component_.find(world_.child) != component_.end())
+    setComponentMoved(world_.child);
 }
 
 void OM_MANAGER::Manipulator::setWorldPosition(Vector3f world_position)
 {
   world_.pose.position = world_position;
+
+  if (component_.find(world_.child) != component_.end())
+    setComponentMoved(world_.child);
 }
 
 void OM_MANAGER::Manipulator::setWorldOrientation(Matrix3f world_orientation)
 {
   world_.pose.orientation = world_orientation;
+
+  if (component_.find(world_.child) != component_.end())
+    setComponentMoved(world_.child);
 }
 
 void OM_MANAGER::Manipulator::setWorldState(State world_state)
@@ -328,7 +348,11 @@ void OM_MANAGER::Manipulator::setComponentJointAngle(Name name, float angle)
   {
     if (component_.find(name) != component_.end())
     {
-      component_.at(name).joint.angle = angle;
+      if (component_.at(name).joint.angle != angle)
+      {
+        component_.at(name).joint.angle = angle;
+        setComponentMoved(name);
+      }
     }
     else
     {
@@ -420,9 +444,13 @@ void OM_MANAGER::Manipulator::setAllActiveJointAngle(std::vector<float> angle_ve
 
   for (it = component_.begin(); it != component_.end(); it++)
   {
-    if (component_.at(it->first).joint.id != -1)
+    if (it->second.joint.id != -1)
     {
-      component_.at(it->first).joint.angle = angle_vector.at(index);
+      if (it->second.joint.angle != angle_vector.at(index))
+      {
+        it->second.joint.angle = angle_vector.at(index);
+        setComponentMoved(it->first);
+      }
       index++;
     }
   }
@@ -510,6 +538,16 @@ std::vector<Name> OM_MANAGER::Manipulator::getComponentChildName(Name name)
   return component_.at(name).child;
 }
 
+int8_t OM_MANAGER::Manipulator::getComponentChildSize(Name name)
+{
+  return component_.at(name).child.size();
+}
+
+Name OM_MANAGER::Manipulator::getComponentChildName(Name name, int8_t index)
+{
+  return component_.at(name).child.at(index);
+}
+
 Pose OM_MANAGER::Manipulator::getComponentPoseToWorld(Name name)
 {
   return component_.at(name).pose_to_world;
@@ -677,3 +715,49 @@ std::vector<uint8_t> OM_MANAGER::Manipulator::getAllActiveJointID()
   return active_joint_id;
 }
 
+////////////////////////////Forward kinematics cache//////////////////////////
+
+// Marks the pose of a component out of date and flags every parent up to the world,
+// so forward kinematics only has to visit the branches that actually moved.
+void OM_MANAGER::Manipulator::setComponentMoved(Name name)
+{
+  component_.at(name).cache.is_moved = true;
+
+  Name parent_name = component_.at(name).parent;
+  while (component_.find(parent_name) != component_.end())
+  {
+    if (component_.at(parent_name).cache.has_moved_child)
+      break; // parents above are already flagged
+
+    component_.at(parent_name).cache.has_moved_child = true;
+    parent_name = component_.at(parent_name).parent;
+  }
+}
+
+bool OM_MANAGER::Manipulator::getComponentMoved(Name name)
+{
+  return component_.at(name).cache.is_moved;
+}
+
+bool OM_MANAGER::Manipulator::getComponentChildMoved(Name name)
+{
+  return component_.at(name).cache.has_moved_child;
+}
+
+void OM_MANAGER::Manipulator::clearComponentMoved(Name name)
+{
+  component_.at(name).cache.is_moved = false;
+  component_.at(name).cache.has_moved_child = false;
+}
+
+Matrix3f OM_MANAGER::Manipulator::getComponentJointRotation(Name name)
+{
+  Component *component = &component_.at(name);
+
+  if (component->cache.angle != component->joint.angle)
+  {
+    component->cache.rotation = OM_MATH::rodriguesRotationMatrix(component->joint.axis, component->joint.angle);
+    component->cache.angle = component->joint.angle;
+  }
+  return component->cache.rotation;
+}
@@ -28,36 +28,33 @@ MinimumJerk::MinimumJerk()
 
 MinimumJerk::~MinimumJerk() {}
 
+// Closed form of the quintic that matches position, velocity and acceleration at both ends.
 void MinimumJerk::calcCoefficient(Trajectory start,
                                   Trajectory goal,
                                   float move_time,
                                   float control_time)
 {
-  uint16_t step_time = uint16_t(floor(move_time / control_time) + 1.0);
+  uint16_t step_time = uint16_t(floor(move_time / control_time) + 1.0f);
   move_time = float(step_time - 1) * control_time;
 
-  Matrix3f A = Matrix3f::Identity(3, 3);
-  Vector3f x = Vector3f::Zero();
-  Vector3f b = Vector3f::Zero();
-
-  A << pow(move_time, 3), pow(move_time, 4), pow(move_time, 5),
-      3 * pow(move_time, 2), 4 * pow(move_time, 3), 5 * pow(move_time, 4),
-      6 * pow(move_time, 1), 12 * pow(move_time, 2), 20 * pow(move_time, 3);
+  float T1 = move_time;
+  float T2 = T1 * T1;
+  float T3 = T2 * T1;
+  float distance = goal.position - start.position;
 
   coefficient_(0) = start.position;
   coefficient_(1) = start.velocity;
-  coefficient_(2) = 0.5 * start.acceleration;
-
-  b << (goal.position - start.position - (start.velocity * move_time + 0.5 * start.acceleration * pow(move_time, 2))),
-      (goal.velocity - start.velocity - (start.acceleration * move_time)),
-      (goal.acceleration - start.acceleration);
-
-  ColPivHouseholderQR<Matrix3f> dec(A);
-  x = dec.solve(b);
+  coefficient_(2) = 0.5f * start.acceleration;
 
-  coefficient_(3) = x(0);
-  coefficient_(4) = x(1);
-  coefficient_(5) = x(2);
+  coefficient_(3) = (20.0f * distance
+                     - (8.0f * goal.velocity + 12.0f * start.velocity) * T1
+                     - (3.0f * start.acceleration - goal.acceleration) * T2) / (2.0f * T3);
+  coefficient_(4) = (-30.0f * distance
+                     + (14.0f * goal.velocity + 16.0f * start.velocity) * T1
+                     + (3.0f * start.acceleration - 2.0f * goal.acceleration) * T2) / (2.0f * T3 * T1);
+  coefficient_(5) = (12.0f * distance
+                     - 6.0f * (goal.velocity + start.velocity) * T1
+                     - (start.acceleration - goal.acceleration) * T2) / (2.0f * T3 * T2);
 }
 
 VectorXf MinimumJerk::getCoefficient()
@@ -68,7 +65,7 @@ VectorXf MinimumJerk::getCoefficient()
 JointTrajectory::JointTrajectory(uint8_t joint_num)
 {
   joint_num_ = joint_num;
-  coefficient_ = MatrixXf::Identity(6, joint_num);
+  coefficient_.assign(6 * joint_num, 0.0f);
   position_.reserve(joint_num);
   velocity_.reserve(joint_num);
   acceleration_.reserve(joint_num);
@@ -88,68 +85,205 @@ void JointTrajectory::init(std::vector<Trajectory> start,
                                     move_time,
                                     control_time);
 
-    coefficient_.col(index) = path_generator_.getCoefficient();
+    VectorXf coefficient = path_generator_.getCoefficient();
+    for (uint8_t order = 0; order < 6; order++)
+      coefficient_[order * joint_num_ + index] = coefficient(order);
   }
 }
 
 std::vector<float> JointTrajectory::getPosition(float tick)
 {
-  position_.clear();
-  for (uint8_t index = 0; index < joint_num_; index++)
-  {
-    float result = 0.0;
-    result = coefficient_(0, index) +
-             coefficient_(1, index) * pow(tick, 1) +
-             coefficient_(2, index) * pow(tick, 2) +
-             coefficient_(3, index) * pow(tick, 3) +
-             coefficient_(4, index) * pow(tick, 4) +
-             coefficient_(5, index) * pow(tick, 5);
-
-    position_.push_back(result);
-  }
+  position_.resize(joint_num_);
+  getState(tick, &position_[0], NULL, NULL);
 
   return position_;
 }
 
 std::vector<float> JointTrajectory::getVelocity(float tick)
 {
-  velocity_.clear();
-  for (uint8_t index = 0; index < joint_num_; index++)
-  {
-    float result = 0.0;
-    result = coefficient_(1, index) +
-             2 * coefficient_(2, index) * pow(tick, 1) +
-             3 * coefficient_(3, index) * pow(tick, 2) +
-             4 * coefficient_(4, index) * pow(tick, 3) +
-             5 * coefficient_(5, index) * pow(tick, 4);
-
-    velocity_.push_back(result);
-  }
+  velocity_.resize(joint_num_);
+  getState(tick, NULL, &velocity_[0], NULL);
 
   return velocity_;
 }
 
 std::vector<float> JointTrajectory::getAcceleration(float tick)
 {
-  acceleration_.clear();
+  acceleration_.resize(joint_num_);
+  getState(tick, NULL, NULL, &acceleration_[0]);
+
+  return acceleration_;
+}
+
+// Evaluates every joint in one Horner pass in single precision.
+// Any of the output arrays (joint_num_ floats each) may be NULL.
+void JointTrajectory::getState(float tick, float *position, float *velocity, float *acceleration)
+{
+  const float *c0 = &coefficient_[0];
+  const float *c1 = c0 + joint_num_;
+  const float *c2 = c1 + joint_num_;
+  const float *c3 = c2 + joint_num_;
+  const float *c4 = c3 + joint_num_;
+  const float *c5 = c4 + joint_num_;
+  const float t = tick;
+
+  if (position != NULL)
+  {
+    for (uint8_t index = 0; index < joint_num_; index++)
+      position[index] = c0[index] + t * (c1[index] + t * (c2[index] + t * (c3[index] + t * (c4[index] + t * c5[index]))));
+  }
+
+  if (velocity != NULL)
+  {
+    for (uint8_t index = 0; index < joint_num_; index++)
+      velocity[index] = c1[index] + t * (2.0f * c2[index] + t * (3.0f * c3[index] + t * (4.0f * c4[index] + t * 5.0f * c5[index])));
+  }
+
+  if (acceleration != NULL)
+  {
+    for (uint8_t index = 0; index < joint_num_; index++)
+      acceleration[index] = 2.0f * c2[index] + t * (6.0f * c3[index] + t * (12.0f * c4[index] + t * 20.0f * c5[index]));
+  }
+}
+
+MatrixXf JointTrajectory::getCoefficient()
+{
+  MatrixXf coefficient = MatrixXf::Zero(6, joint_num_);
+
+  for (uint8_t index = 0; index < joint_num_; index++)
+    for (uint8_t order = 0; order < 6; order++)
+      coefficient(order, index) = coefficient_[order * joint_num_ + index];
+
+  return coefficient;
+}
+
+SampledJointTrajectory::SampledJointTrajectory()
+    : joint_num_(0),
+      sample_num_(0),
+      sample_time_(1.0f),
+      move_time_(0.0f),
+      quantize_(false),
+      max_jump_(0.0f)
+{
+}
+
+SampledJointTrajectory::~SampledJointTrajectory() {}
+
+void SampledJointTrajectory::init(uint8_t joint_num, uint16_t sample_num, float sample_time, float move_time, bool quantize)
+{
+  joint_num_ = joint_num;
+  sample_num_ = sample_num;
+  sample_time_ = sample_time;
+  move_time_ = move_time;
+  quantize_ = quantize;
+  max_jump_ = 0.0f;
+
+  sample_.assign(joint_num * sample_num, 0.0f);
+  std::vector<int16_t>().swap(quantized_sample_);
+  offset_.assign(joint_num, 0.0f);
+  scale_.assign(joint_num, 0.0f);
+  position_.reserve(joint_num);
+}
+
+void SampledJointTrajectory::setSample(uint16_t sample, std::vector<float> position)
+{
   for (uint8_t index = 0; index < joint_num_; index++)
+    sample_.at(sample * joint_num_ + index) = position.at(index);
+}
+
+void SampledJointTrajectory::complete()
+{
+  for (uint16_t sample = 1; sample < sample_num_; sample++)
   {
-    float result = 0.0;
+    for (uint8_t index = 0; index < joint_num_; index++)
+    {
+      float jump = fabs(sample_[sample * joint_num_ + index] - sample_[(sample - 1) * joint_num_ + index]);
+      if (jump > max_jump_)
+        max_jump_ = jump;
+    }
+  }
 
-    result = 2 * coefficient_(2, index) +
-             6 * coefficient_(3, index) * pow(tick, 1) +
-             12 * coefficient_(4, index) * pow(tick, 2) +
-             20 * coefficient_(5, index) * pow(tick, 3);
+  if (quantize_ == false || sample_num_ == 0)
+    return;
 
-    acceleration_.push_back(result);
+  quantized_sample_.resize(sample_.size());
+  for (uint8_t index = 0; index < joint_num_; index++)
+  {
+    float min = sample_[index];
+    float max = sample_[index];
+
+    for (uint16_t sample = 1; sample < sample_num_; sample++)
+    {
+      min = std::min(min, sample_[sample * joint_num_ + index]);
+      max = std::max(max, sample_[sample * joint_num_ + index]);
+    }
+
+    offset_[index] = min;
+    scale_[index] = (max - min) / 65535.0f;
+
+    for (uint16_t sample = 0; sample < sample_num_; sample++)
+    {
+      float step = 0.0f;
+      if (scale_[index] > 0.0f)
+        step = roundf((sample_[sample * joint_num_ + index] - min) / scale_[index]);
+
+      quantized_sample_[sample * joint_num_ + index] = int16_t(int32_t(step) - 32768);
+    }
   }
+  std::vector<float>().swap(sample_); // keep only the quantized samples
+}
 
-  return acceleration_;
+float SampledJointTrajectory::getSample(uint16_t sample, uint8_t joint)
+{
+  if (quantize_)
+    return offset_[joint] + scale_[joint] * (int32_t(quantized_sample_[sample * joint_num_ + joint]) + 32768);
+  else
+    return sample_[sample * joint_num_ + joint];
 }
 
-MatrixXf JointTrajectory::getCoefficient()
+std::vector<float> SampledJointTrajectory::getPosition(float tick)
 {
-  return coefficient_;
+  position_.clear();
+  if (sample_num_ == 0)
+    return position_;
+
+  uint16_t sample = sample_num_ - 1;
+  float ratio = 0.0f;
+
+  if (tick < move_time_ && sample_num_ > 1)
+  {
+    sample = uint16_t(tick / sample_time_);
+    if (sample >= sample_num_ - 1)
+      sample = sample_num_ - 2;
+
+    float start_time = sample * sample_time_;
+    float end_time = std::min((sample + 1) * sample_time_, move_time_); // the last sample sits on move_time_
+
+    if (end_time > start_time)
+      ratio = std::min((tick - start_time) / (end_time - start_time), 1.0f);
+  }
+
+  for (uint8_t index = 0; index < joint_num_; index++)
+  {
+    float start = getSample(sample, index);
+
+    if (ratio > 0.0f)
+      position_.push_back(start + (getSample(sample + 1, index) - start) * ratio);
+    else
+      position_.push_back(start);
+  }
+
+  return position_;
+}
+
+uint16_t SampledJointTrajectory::getSampleNum()
+{
+  return sample_num_;
+}
+
+float SampledJointTrajectory::getMaxJump()
+{
+  return max_jump_;
 }
 
 Line::Line() {}
@@ -273,11 +407,11 @@ Pose Circle::getPose(float tick)
   float get_time_var = 0.0;
 
   get_time_var = coefficient_(0) +
-                 coefficient_(1) * pow(tick, 1) +
-                 coefficient_(2) * pow(tick, 2) +
-                 coefficient_(3) * pow(tick, 3) +
-                 coefficient_(4) * pow(tick, 4) +
-                 coefficient_(5) * pow(tick, 5);
+                 tick * (coefficient_(1) +
+                 tick * (coefficient_(2) +
+                 tick * (coefficient_(3) +
+                 tick * (coefficient_(4) +
+                 tick * coefficient_(5)))));
 
   return circle(get_time_var);
 }
@@ -376,11 +510,11 @@ Pose Rhombus::getPose(float tick)
   float get_time_var = 0.0;
 
   get_time_var = coefficient_(0) +
-                 coefficient_(1) * pow(tick, 1) +
-                 coefficient_(2) * pow(tick, 2) +
-                 coefficient_(3) * pow(tick, 3) +
-                 coefficient_(4) * pow(tick, 4) +
-                 coefficient_(5) * pow(tick, 5);
+                 tick * (coefficient_(1) +
+                 tick * (coefficient_(2) +
+                 tick * (coefficient_(3) +
+                 tick * (coefficient_(4) +
+                 tick * coefficient_(5)))));
 
   return rhombus(get_time_var);
 }
@@ -451,11 +585,11 @@ Pose Heart::getPose(float tick)
   float get_time_var = 0.0;
 
   get_time_var = coefficient_(0) +
-                 coefficient_(1) * pow(tick, 1) +
-                 coefficient_(2) * pow(tick, 2) +
-                 coefficient_(3) * pow(tick, 3) +
-                 coefficient_(4) * pow(tick, 4) +
-                 coefficient_(5) * pow(tick, 5);
+                 tick * (coefficient_(1) +
+                 tick * (coefficient_(2) +
+                 tick * (coefficient_(3) +
+                 tick * (coefficient_(4) +
+                 tick * coefficient_(5)))));
 
   return heart(get_time_var);
 }
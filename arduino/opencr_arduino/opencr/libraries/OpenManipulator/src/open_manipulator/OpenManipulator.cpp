@@ -39,8 +39,14 @@ OpenManipulator::OpenManipulator() : move_time_(1.0f),
                                      platform_(false),
                                      processing_(false),
                                      drawing_(false),
-                                     draw_cnt_(0)
+                                     draw_cnt_(0),
+                                     drawing_planned_(false),
+                                     planned_object_(0)
 {
+  drawing_report_.sample_num = 0;
+  drawing_report_.planning_time = 0.0f;
+  drawing_report_.max_joint_jump = 0.0f;
+
   manager_ = new Manager();
 }
 
@@ -615,22 +621,26 @@ void OpenManipulator::actuatorDisable()
 void OpenManipulator::drawInit(Name name, float drawing_time, const void *arg)
 {
   drawing_time_ = drawing_time;
+  drawing_planned_ = false;
 
   draw_.at(name)->initDraw(arg);
 }
 
 void OpenManipulator::setRadiusForDrawing(Name name, float radius)
 {
+  drawing_planned_ = false;
   draw_.at(name)->setRadius(radius);
 }
 
 void OpenManipulator::setStartPositionForDrawing(Name name, Vector3f start_position)
 {
+  drawing_planned_ = false;
   draw_.at(name)->setStartPosition(start_position);
 }
 
 void OpenManipulator::setStartAngularPositionForDrawing(Name name, float start_angular_position)
 {
+  drawing_planned_ = false;
   draw_.at(name)->setAngularStartPosition(start_angular_position);
 }
 
@@ -639,6 +649,67 @@ Pose OpenManipulator::getPoseForDrawing(Name name, float tick)
   return draw_.at(name)->getPose(tick);
 }
 
+// Solves the inverse kinematics of every sample of a drawing before it starts,
+// so jointControlForDrawing only has to interpolate the stored joint positions.
+// Called by draw(tool_name, object) and drawLine, or ahead of time to choose quantize and control_step.
+// Each sample starts the solver from the solution of the previous one.
+DrawingReport OpenManipulator::planDrawing(Name tool_name, Name object, bool quantize, uint8_t control_step)
+{
+  uint32_t start_time = micros();
+
+  if (control_step == 0)
+    control_step = 1;
+
+  uint16_t step_time = uint16_t(floor(drawing_time_ / control_time_) + 1.0);
+  uint16_t sample_num = (step_time - 1 + control_step - 1) / control_step + 1;
+  float sample_time = control_time_ * control_step;
+  float end_time = control_time_ * (step_time - 1);
+
+  OM_MANAGER::Manipulator planner = manipulator_;
+  if (previous_goal_.position.size() == (uint8_t)manipulator_.getDOF())
+    planner.setAllActiveJointAngle(previous_goal_.position);
+
+  drawing_trajectory_.init(manipulator_.getDOF(), sample_num, sample_time, end_time, quantize);
+
+  for (uint16_t sample = 0; sample < sample_num; sample++)
+  {
+    float tick_time = std::min(sample * sample_time, end_time);
+    std::vector<float> goal_position;
+
+    if (object == LINE)
+      goal_position = kinematics_->inverse(&planner, tool_name, line_.getPose(tick_time));
+    else
+      goal_position = kinematics_->inverse(&planner, tool_name, getPoseForDrawing(object, tick_time));
+
+    planner.setAllActiveJointAngle(goal_position);
+    drawing_trajectory_.setSample(sample, goal_position);
+  }
+  drawing_trajectory_.complete();
+
+  drawing_planned_ = true;
+  planned_object_ = object;
+
+  drawing_report_.sample_num = sample_num;
+  drawing_report_.planning_time = (micros() - start_time) * 0.000001f;
+  drawing_report_.max_joint_jump = drawing_trajectory_.getMaxJump();
+
+  return drawing_report_;
+}
+
+DrawingReport OpenManipulator::getDrawingReport()
+{
+  return drawing_report_;
+}
+
+void OpenManipulator::draw(Name tool_name, Name object)
+{
+  if (drawing_planned_ == false || planned_object_ != object)
+    planDrawing(tool_name, object);
+
+  draw(object);
+}
+
+// plays the drawing planned by planDrawing, nothing is drawn without a plan of the object
 void OpenManipulator::draw(Name object)
 {
   object_ = object;
@@ -750,14 +821,17 @@ void OpenManipulator::jointControlForDrawing(Name tool_name)
 
   if (drawing_)
   {
+    if (drawing_planned_ == false || planned_object_ != object_)
+    {
+      drawing_ = false;
+      return;
+    }
+
     if (draw_cnt_ < step_time)
     {
       tick_time = control_time_ * draw_cnt_;
 
-      if (object_ == LINE)
-        goal_position = kinematics_->inverse(&manipulator_, tool_name, line_.getPose(tick_time));
-      else
-        goal_position = kinematics_->inverse(&manipulator_, tool_name, getPoseForDrawing(object_, tick_time));
+      goal_position = drawing_trajectory_.getPosition(tick_time);
 
       if (platform_)
       {
@@ -779,6 +853,7 @@ void OpenManipulator::jointControlForDrawing(Name tool_name)
     {
       draw_cnt_ = 0;
       drawing_ = false;
+      drawing_planned_ = false;
     }
   }
 }
@@ -800,17 +875,17 @@ void OpenManipulator::jointControl()
   {
     tick_time = present_time_ - start_time_;
 
+    goal_position.resize(manipulator_.getDOF());
+    goal_velocity.resize(manipulator_.getDOF());
+    goal_acceleration.resize(manipulator_.getDOF());
+
     if(tick_time < move_time_)
     {
-      goal_position = joint_trajectory_->getPosition(tick_time);
-      goal_velocity = joint_trajectory_->getVelocity(tick_time);
-      goal_acceleration = joint_trajectory_->getAcceleration(tick_time);  
+      joint_trajectory_->getState(tick_time, &goal_position[0], &goal_velocity[0], &goal_acceleration[0]);
     }
     else
     {
-      goal_position = joint_trajectory_->getPosition(move_time_);
-      goal_velocity = joint_trajectory_->getVelocity(move_time_);
-      goal_acceleration = joint_trajectory_->getAcceleration(move_time_);  
+      joint_trajectory_->getState(move_time_, &goal_position[0], &goal_velocity[0], &goal_acceleration[0]);
       moving_   = false; 
       start_time_ = present_time_;
     }
@@ -959,6 +1034,7 @@ void OpenManipulator::drawLine(Name tool_name, Vector3f meter, float move_time)
   line_.init(start, end, move_time, control_time_);
   setMoveTime(move_time);
 
+  planDrawing(tool_name, LINE);
   draw(LINE);
 }
 
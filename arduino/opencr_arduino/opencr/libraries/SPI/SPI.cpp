@@ -67,7 +67,11 @@ void SPIClass::begin(void) {
 }
 
 void SPIClass::beginFast(void) {
-  drv_spi_enable_dma(_hspi);
+  // HAL_SPI_Init() sets up the DMA streams in HAL_SPI_MspInit(), which only runs on a reset handle
+  if (!drv_spi_dma_enabled(_hspi)) {
+    drv_spi_enable_dma(_hspi);
+    HAL_SPI_DeInit(_hspi);
+  }
   init();
 }
 
@@ -42,6 +42,18 @@ void setup()
   nh.advertise(joint_states_pub);
   nh.advertise(battery_state_pub);
   nh.advertise(mag_pub);
+  nh.advertise(publish_stats_pub);
+
+  // When the USB transmit buffer backs up, higher numbers give way first
+  odom_pub.setPriority(0);
+  joint_states_pub.setPriority(0);
+  imu_pub.setPriority(1);
+  sensor_state_pub.setPriority(1);
+  cmd_vel_rc100_pub.setPriority(1);
+  battery_state_pub.setPriority(2);
+  mag_pub.setPriority(2);
+  version_info_pub.setPriority(3);
+  publish_stats_pub.setPriority(3);
 
   tf_broadcaster.init(nh);
 
@@ -58,14 +70,32 @@ void setup()
   controllers.init(MAX_LINEAR_VELOCITY, MAX_ANGULAR_VELOCITY);
 
   // Setting for SLAM and navigation (odometry, joint states, TF)
+  kinematics.init(WHEEL_RADIUS, WHEEL_SEPARATION);
+
   initOdom();
 
   initJointStates();
 
-  prev_update_time = millis();
+  prev_update_time = micros();
 
   pinMode(LED_WORKING_CHECK, OUTPUT);
 
+  // Odometry runs from the timer interrupt, so it never waits behind ROS serialization. The motor
+  // task waits for the Dynamixel status packets, so it runs first of the loop() tasks instead,
+  // ahead of the publishers in rate monotonic order.
+  scheduler.init();
+  scheduler.addTask("motor",   controlMotorSpeed,         CONTROL_MOTOR_SPEED_FREQUENCY,         0, SCHEDULER_CONTEXT_LOOP);
+  scheduler.addTask("odom",    calcDriveInformation,      CONTROL_MOTOR_SPEED_FREQUENCY,         1, SCHEDULER_CONTEXT_TIMER);
+  scheduler.addTask("imu",     publishImuInformation,     IMU_PUBLISH_FREQUENCY,                 2, SCHEDULER_CONTEXT_LOOP);
+  scheduler.addTask("cmd_vel", publishCmdVelFromRC100Msg, CMD_VEL_PUBLISH_FREQUENCY,             3, SCHEDULER_CONTEXT_LOOP);
+  scheduler.addTask("drive",   publishSensorInformation,  DRIVE_INFORMATION_PUBLISH_FREQUENCY,   4, SCHEDULER_CONTEXT_LOOP);
+#ifdef DEBUG
+  scheduler.addTask("debug",   sendDebuglog,              DEBUG_LOG_FREQUENCY,                   5, SCHEDULER_CONTEXT_LOOP);
+#endif
+  scheduler.addTask("version", publishVersionInfoMsg,     VERSION_INFORMATION_PUBLISH_FREQUENCY, 6, SCHEDULER_CONTEXT_LOOP);
+  scheduler.addTask("stats",   publishPublishStatsMsg,    PUBLISH_STATS_FREQUENCY,               7, SCHEDULER_CONTEXT_LOOP);
+  scheduler.start();
+
   setup_end = true;
 }
 
@@ -74,52 +104,14 @@ void setup()
 *******************************************************************************/
 void loop()
 {
-  uint32_t t = millis();
   updateTime();
   updateVariable(nh.connected());
   updateTFPrefix(nh.connected());
 
-  if ((t-tTime[0]) >= (1000 / CONTROL_MOTOR_SPEED_FREQUENCY))
-  {
-    updateGoalVelocity();
-    motor_driver.controlMotor(WHEEL_SEPARATION, goal_velocity);
-    tTime[0] = t;
-  }
-
-  if ((t-tTime[1]) >= (1000 / CMD_VEL_PUBLISH_FREQUENCY))
-  {
-    publishCmdVelFromRC100Msg();
-    tTime[1] = t;
-  }
-
-  if ((t-tTime[2]) >= (1000 / DRIVE_INFORMATION_PUBLISH_FREQUENCY))
-  {
-    publishSensorStateMsg();
-    publishBatteryStateMsg();
-    publishDriveInformation();
-    tTime[2] = t;
-  }
-
-  if ((t-tTime[3]) >= (1000 / IMU_PUBLISH_FREQUENCY))
-  {
-    publishImuMsg();
-    publishMagMsg();
-    tTime[3] = t;
-  }
-
-  if ((t-tTime[4]) >= (1000 / VERSION_INFORMATION_PUBLISH_FREQUENCY))
-  {
-    publishVersionInfoMsg();
-    tTime[4] = t;
-  }
-
-#ifdef DEBUG
-  if ((t-tTime[5]) >= (1000 / DEBUG_LOG_FREQUENCY))
-  {
-    sendDebuglog();
-    tTime[5] = t;
-  }
-#endif
+  // Publish the msgs released by the scheduler, coalesced into one USB write
+  nh.beginBatch();
+  scheduler.run();
+  nh.flushBatch();
 
   // Send log message after ROS connection
   sendLogMsg();
@@ -130,12 +122,16 @@ void loop()
   // Check push button pressed for simple test drive
   driveTest(diagnosis.getButtonPress(3000));
 
-  // Update the IMU unit
+  // Update the IMU unit and hand the orientation to the odometry task
   sensors.updateIMU();
 
+  uint32_t lock_state = Turtlebot3Scheduler::lock();
+  memcpy(imu_orientation, sensors.getOrientation(), sizeof(imu_orientation));
+  Turtlebot3Scheduler::unlock(lock_state);
+
   // TODO
   // Update sonar data
-  // sensors.updateSonar(t);
+  // sensors.updateSonar(millis());
 
   // Start Gyro Calibration after ROS connection
   updateGyroCali(nh.connected());
@@ -180,7 +176,8 @@ void motorPowerCallback(const std_msgs::Bool& power_msg)
 {
   bool dxl_power = power_msg.data;
 
-  motor_driver.setTorque(dxl_power);
+  // The motor task owns the Dynamixel bus
+  torque_request = dxl_power;
 }
 
 /*******************************************************************************
@@ -225,7 +222,7 @@ void publishImuMsg(void)
   imu_msg.header.stamp    = rosNow();
   imu_msg.header.frame_id = imu_frame_id;
 
-  imu_pub.publish(&imu_msg);
+  imu_pub.publish(&imu_template);
 }
 
 /*******************************************************************************
@@ -251,11 +248,11 @@ void publishSensorStateMsg(void)
   sensor_state_msg.header.stamp = rosNow();
   sensor_state_msg.battery = sensors.checkVoltage();
 
-  dxl_comm_result = motor_driver.readEncoder(sensor_state_msg.left_encoder, sensor_state_msg.right_encoder);
+  dxl_comm_result = present_encoder_valid;
+  sensor_state_msg.left_encoder  = present_encoder[LEFT];
+  sensor_state_msg.right_encoder = present_encoder[RIGHT];
 
-  if (dxl_comm_result == true)
-    updateMotorInfo(sensor_state_msg.left_encoder, sensor_state_msg.right_encoder);
-  else
+  if (dxl_comm_result == false)
     return;
 
   sensor_state_msg.bumper = sensors.checkPushBumper();
@@ -286,6 +283,25 @@ void publishVersionInfoMsg(void)
   version_info_pub.publish(&version_info_msg);
 }
 
+/*******************************************************************************
+* Publish msgs (publish stats)
+*******************************************************************************/
+void publishPublishStatsMsg(void)
+{
+  ros::PublishStats stats = nh.getPublishStats();
+
+  publish_stats[0] = stats.frames;
+  publish_stats[1] = stats.writes;
+  publish_stats[2] = stats.stale;
+  publish_stats[3] = stats.throttled;
+  publish_stats[4] = stats.dropped;
+
+  publish_stats_msg.data_length = 5;
+  publish_stats_msg.data = publish_stats;
+
+  publish_stats_pub.publish(&publish_stats_msg);
+}
+
 /*******************************************************************************
 * Publish msgs (battery_state)
 *******************************************************************************/
@@ -309,19 +325,17 @@ void publishBatteryStateMsg(void)
 *******************************************************************************/
 void publishDriveInformation(void)
 {
-  unsigned long time_now = millis();
-  unsigned long step_time = time_now - prev_update_time;
-
-  prev_update_time = time_now;
   ros::Time stamp_now = rosNow();
 
-  // calculate odometry
-  calcOdometry((double)(step_time * 0.001));
+  // take the odometry calculated by the odometry task
+  uint32_t lock_state = Turtlebot3Scheduler::lock();
+  updateOdometry();
+  updateJointStates();
+  Turtlebot3Scheduler::unlock(lock_state);
 
   // odometry
-  updateOdometry();
   odom.header.stamp = stamp_now;
-  odom_pub.publish(&odom);
+  odom_pub.publish(&odom_template);
 
   // odometry tf
   updateTF(odom_tf);
@@ -329,9 +343,84 @@ void publishDriveInformation(void)
   tf_broadcaster.sendTransform(odom_tf);
 
   // joint states
-  updateJointStates();
   joint_states.header.stamp = stamp_now;
-  joint_states_pub.publish(&joint_states);
+  joint_states_pub.publish(&joint_states_template);
+}
+
+/*******************************************************************************
+* Publish msgs (IMU, magnetic field)
+*******************************************************************************/
+void publishImuInformation(void)
+{
+  publishImuMsg();
+  publishMagMsg();
+}
+
+/*******************************************************************************
+* Publish msgs (sensor state, battery state, odometry, joint states, tf)
+*******************************************************************************/
+void publishSensorInformation(void)
+{
+  publishSensorStateMsg();
+  publishBatteryStateMsg();
+  publishDriveInformation();
+}
+
+/*******************************************************************************
+* Motor task (first loop task): all bus I/O with the wheel Dynamixels
+*******************************************************************************/
+void controlMotorSpeed(void)
+{
+  int32_t left_tick  = 0;
+  int32_t right_tick = 0;
+
+  if (torque_request >= 0)
+  {
+    motor_driver.setTorque(torque_request == 1);
+    torque_request = -1;
+  }
+
+  updateGoalVelocity();
+  motor_driver.controlMotor(WHEEL_SEPARATION, goal_velocity);
+
+  present_encoder_valid = motor_driver.readEncoder(left_tick, right_tick);
+
+  if (present_encoder_valid == true)
+  {
+    uint32_t time_read = micros();
+
+    // The odometry task takes the ticks with the time they were read
+    uint32_t lock_state = Turtlebot3Scheduler::lock();
+    present_encoder[LEFT]  = left_tick;
+    present_encoder[RIGHT] = right_tick;
+    present_encoder_time   = time_read;
+    encoder_updated        = true;
+    Turtlebot3Scheduler::unlock(lock_state);
+  }
+}
+
+/*******************************************************************************
+* Odometry task (timer interrupt): calculation only, from the last encoder and IMU data
+*******************************************************************************/
+void calcDriveInformation(void)
+{
+  if (odom_reset_request == true)
+  {
+    kinematics.reset();
+    odom_reset_request = false;
+  }
+
+  // A failed read is made up by the next one, so its ticks and time are not lost
+  if (encoder_updated == false)
+    return;
+
+  uint32_t step_time = present_encoder_time - prev_update_time;
+
+  prev_update_time = present_encoder_time;
+  encoder_updated  = false;
+
+  updateMotorInfo(present_encoder[LEFT], present_encoder[RIGHT]);
+  calcOdometry((float)step_time * 0.000001f);
 }
 
 /*******************************************************************************
@@ -400,16 +489,26 @@ void updateTFPrefix(bool isConnected)
 *******************************************************************************/
 void updateOdometry(void)
 {
+  float* pose     = kinematics.getPose();
+  float* velocity = kinematics.getVelocity();
+  float orientation[4];
+
+  kinematics.getOrientation(orientation);
+
   odom.header.frame_id = odom_header_frame_id;
   odom.child_frame_id  = odom_child_frame_id;
 
-  odom.pose.pose.position.x = odom_pose[0];
-  odom.pose.pose.position.y = odom_pose[1];
+  odom.pose.pose.position.x = pose[0];
+  odom.pose.pose.position.y = pose[1];
   odom.pose.pose.position.z = 0;
-  odom.pose.pose.orientation = tf::createQuaternionFromYaw(odom_pose[2]);
 
-  odom.twist.twist.linear.x  = odom_vel[0];
-  odom.twist.twist.angular.z = odom_vel[2];
+  odom.pose.pose.orientation.x = orientation[1];
+  odom.pose.pose.orientation.y = orientation[2];
+  odom.pose.pose.orientation.z = orientation[3];
+  odom.pose.pose.orientation.w = orientation[0];
+
+  odom.twist.twist.linear.x  = velocity[0];
+  odom.twist.twist.angular.z = velocity[2];
 }
 
 /*******************************************************************************
@@ -421,14 +520,15 @@ void updateJointStates(void)
   static float joint_states_vel[WHEEL_NUM] = {0.0, 0.0};
   static float joint_states_eff[WHEEL_NUM] = {0.0, 0.0};
 
-  joint_states_pos[LEFT]  = last_rad[LEFT];
-  joint_states_pos[RIGHT] = last_rad[RIGHT];
+  joint_states_pos[LEFT]  = kinematics.getWheelAngle()[LEFT];
+  joint_states_pos[RIGHT] = kinematics.getWheelAngle()[RIGHT];
 
-  joint_states_vel[LEFT]  = last_velocity[LEFT];
-  joint_states_vel[RIGHT] = last_velocity[RIGHT];
+  joint_states_vel[LEFT]  = kinematics.getWheelVelocity()[LEFT];
+  joint_states_vel[RIGHT] = kinematics.getWheelVelocity()[RIGHT];
 
   joint_states.position = joint_states_pos;
   joint_states.velocity = joint_states_vel;
+  joint_states.effort   = joint_states_eff;
 }
 
 /*******************************************************************************
@@ -449,98 +549,16 @@ void updateTF(geometry_msgs::TransformStamped& odom_tf)
 *******************************************************************************/
 void updateMotorInfo(int32_t left_tick, int32_t right_tick)
 {
-  int32_t current_tick = 0;
-  static int32_t last_tick[WHEEL_NUM] = {0.0, 0.0};
-  
-  if (init_encoder)
-  {
-    for (int index = 0; index < WHEEL_NUM; index++)
-    {
-      last_diff_tick[index] = 0.0;
-      last_tick[index]      = 0.0;
-      last_rad[index]       = 0.0;
-
-      last_velocity[index]  = 0.0;
-    }  
-
-    last_tick[LEFT] = left_tick;
-    last_tick[RIGHT] = right_tick;
-
-    init_encoder = false;
-    return;
-  }
-
-  current_tick = left_tick;
-
-  last_diff_tick[LEFT] = current_tick - last_tick[LEFT];
-  last_tick[LEFT]      = current_tick;
-  last_rad[LEFT]       += TICK2RAD * (double)last_diff_tick[LEFT];
-
-  current_tick = right_tick;
-
-  last_diff_tick[RIGHT] = current_tick - last_tick[RIGHT];
-  last_tick[RIGHT]      = current_tick;
-  last_rad[RIGHT]       += TICK2RAD * (double)last_diff_tick[RIGHT];
+  kinematics.updateEncoder(left_tick, right_tick);
 }
 
 /*******************************************************************************
 * Calculate the odometry
 *******************************************************************************/
-bool calcOdometry(double diff_time)
+bool calcOdometry(float diff_time)
 {
-  float* orientation;
-  double wheel_l, wheel_r;      // rotation value of wheel [rad]
-  double delta_s, theta, delta_theta;
-  static double last_theta = 0.0;
-  double v, w;                  // v = translational velocity [m/s], w = rotational velocity [rad/s]
-  double step_time;
-
-  wheel_l = wheel_r = 0.0;
-  delta_s = delta_theta = theta = 0.0;
-  v = w = 0.0;
-  step_time = 0.0;
-
-  step_time = diff_time;
-
-  if (step_time == 0)
-    return false;
-
-  wheel_l = TICK2RAD * (double)last_diff_tick[LEFT];
-  wheel_r = TICK2RAD * (double)last_diff_tick[RIGHT];
-
-  if (isnan(wheel_l))
-    wheel_l = 0.0;
-
-  if (isnan(wheel_r))
-    wheel_r = 0.0;
-
-  delta_s     = WHEEL_RADIUS * (wheel_r + wheel_l) / 2.0;
-  // theta = WHEEL_RADIUS * (wheel_r - wheel_l) / WHEEL_SEPARATION;  
-  orientation = sensors.getOrientation();
-  theta       = atan2f(orientation[1]*orientation[2] + orientation[0]*orientation[3], 
-                0.5f - orientation[2]*orientation[2] - orientation[3]*orientation[3]);
-
-  delta_theta = theta - last_theta;
-
-  // compute odometric pose
-  odom_pose[0] += delta_s * cos(odom_pose[2] + (delta_theta / 2.0));
-  odom_pose[1] += delta_s * sin(odom_pose[2] + (delta_theta / 2.0));
-  odom_pose[2] += delta_theta;
-
-  // compute odometric instantaneouse velocity
-
-  v = delta_s / step_time;
-  w = delta_theta / step_time;
-
-  odom_vel[0] = v;
-  odom_vel[1] = 0.0;
-  odom_vel[2] = w;
-
-  last_velocity[LEFT]  = wheel_l / step_time;
-  last_velocity[RIGHT] = wheel_r / step_time;
-  last_theta = theta;
-
-  return true;
+  // The heading comes from the IMU, the travelled distance from the wheels
+  return kinematics.updateOdometry(diff_time, imu_orientation);
 }
 
 /*******************************************************************************
@@ -552,9 +570,7 @@ void driveTest(uint8_t buttons)
   static int32_t saved_tick[2] = {0, 0};
   static double diff_encoder = 0.0;
 
-  int32_t current_tick[2] = {0, 0};
-
-  motor_driver.readEncoder(current_tick[LEFT], current_tick[RIGHT]);
+  int32_t current_tick[2] = {present_encoder[LEFT], present_encoder[RIGHT]};
 
   if (buttons & (1<<0))  
   {
@@ -745,13 +761,8 @@ void sendLogMsg(void)
 *******************************************************************************/
 void initOdom(void)
 {
-  init_encoder = true;
-
-  for (int index = 0; index < 3; index++)
-  {
-    odom_pose[index] = 0.0;
-    odom_vel[index]  = 0.0;
-  }
+  // The odometry task resets the kinematics the next time it runs
+  odom_reset_request = true;
 
   odom.pose.pose.position.x = 0.0;
   odom.pose.pose.position.y = 0.0;
@@ -825,17 +836,19 @@ void sendDebuglog(void)
   DEBUG_SERIAL.println("---------------------------------------");
   DEBUG_SERIAL.println("Torque : " + String(motor_driver.getTorque()));
 
-  int32_t encoder[WHEEL_NUM] = {0, 0};
-  motor_driver.readEncoder(encoder[LEFT], encoder[RIGHT]);
-  
-  DEBUG_SERIAL.println("Encoder(left) : " + String(encoder[LEFT]));
-  DEBUG_SERIAL.println("Encoder(right) : " + String(encoder[RIGHT]));
+  DEBUG_SERIAL.println("Encoder(left) : " + String(present_encoder[LEFT]));
+  DEBUG_SERIAL.println("Encoder(right) : " + String(present_encoder[RIGHT]));
 
   DEBUG_SERIAL.println("---------------------------------------");
   DEBUG_SERIAL.println("TurtleBot3");
   DEBUG_SERIAL.println("---------------------------------------");
   DEBUG_SERIAL.println("Odometry : ");   
-  DEBUG_SERIAL.print("         x : "); DEBUG_SERIAL.println(odom_pose[0]);
-  DEBUG_SERIAL.print("         y : "); DEBUG_SERIAL.println(odom_pose[1]);
-  DEBUG_SERIAL.print("     theta : "); DEBUG_SERIAL.println(odom_pose[2]);
+  DEBUG_SERIAL.print("         x : "); DEBUG_SERIAL.println(kinematics.getPose()[0]);
+  DEBUG_SERIAL.print("         y : "); DEBUG_SERIAL.println(kinematics.getPose()[1]);
+  DEBUG_SERIAL.print("     theta : "); DEBUG_SERIAL.println(kinematics.getPose()[2]);
+
+  DEBUG_SERIAL.println("---------------------------------------");
+  DEBUG_SERIAL.println("SCHEDULER");
+  DEBUG_SERIAL.println("---------------------------------------");
+  scheduler.printStatistics(DEBUG_SERIAL);
 }
@@ -0,0 +1,124 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Yoonseok Pyo, Leon Jung, Darby Lim, HanCheol Cho, Gilbert */
+
+// Cycles of the Cortex-M7 (DWT cycle counter) per serialization of the imu, odom, joint_states and tf
+// messages of turtlebot3_core, by the generated serialize() and by their ros::MsgTemplate, and whether
+// both give the same bytes. The host side check over random samples is extras/msg_template of turtlebot3_ros_lib.
+// Nothing is published, so no rosserial host is needed.
+
+#include <ros.h>
+#include <ros/msg_template.h>
+#include <sensor_msgs/Imu.h>
+#include <sensor_msgs/JointState.h>
+#include <nav_msgs/Odometry.h>
+#include <tf/tfMessage.h>
+
+#define PUBLISH_NUM             1000
+
+unsigned char generated_buffer[1024];
+unsigned char template_buffer[1024];
+
+sensor_msgs::Imu imu_msg;
+ros::ImuTemplate imu_template(imu_msg);
+
+nav_msgs::Odometry odom;
+ros::OdometryTemplate odom_template(odom);
+
+char *joint_name[2] = {(char *)"wheel_left_joint", (char *)"wheel_right_joint"};
+float joint_position[2], joint_velocity[2], joint_effort[2];
+sensor_msgs::JointState joint_states;
+ros::JointStateTemplate joint_states_template(joint_states);
+
+geometry_msgs::TransformStamped odom_tf;
+tf::tfMessage tf_msg;
+ros::TFMessageTemplate tf_template(tf_msg);
+
+void runBenchmark(const char *name, ros::Msg &msg, ros::Msg &msg_template, uint32_t *stamp, float *value)
+{
+  uint32_t generated_cycle = 0, template_cycle = 0;
+  bool is_identical = true;
+
+  for (uint32_t index = 0; index < PUBLISH_NUM; index++)
+  {
+    *stamp = index;
+    *value = 0.001f * index - 0.3f;
+
+    uint32_t start_cycle = DWT->CYCCNT;
+    int generated_length = msg.serialize(generated_buffer);
+    uint32_t middle_cycle = DWT->CYCCNT;
+    int template_length = msg_template.serialize(template_buffer);
+    uint32_t end_cycle = DWT->CYCCNT;
+
+    generated_cycle += middle_cycle - start_cycle;
+    template_cycle  += end_cycle - middle_cycle;
+    if (generated_length != template_length || memcmp(generated_buffer, template_buffer, generated_length) != 0)
+      is_identical = false;
+  }
+
+  Serial.print(name); Serial.print(" : ");
+  Serial.print(msg.serialize(generated_buffer)); Serial.print(" bytes, generated ");
+  Serial.print(generated_cycle / PUBLISH_NUM); Serial.print(" cycles, template ");
+  Serial.print(template_cycle / PUBLISH_NUM); Serial.print(" cycles, ");
+  Serial.println(is_identical ? "identical" : "DIFFERENT");
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  while(!Serial);
+
+  Serial.println("Start..");
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = 0xC5ACCE55; // unlock the cycle counter of the Cortex-M7
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  // the messages as turtlebot3_core sets them up
+  imu_msg.header.frame_id = "imu_link";
+  for (int i = 0; i < 9; i++)
+  {
+    imu_msg.orientation_covariance[i]         = (i % 4 == 0) ? 0.0025 : 0.0;
+    imu_msg.angular_velocity_covariance[i]    = (i % 4 == 0) ? 0.02 : 0.0;
+    imu_msg.linear_acceleration_covariance[i] = (i % 4 == 0) ? 0.04 : 0.0;
+  }
+
+  odom.header.frame_id = "odom";
+  odom.child_frame_id  = "base_footprint";
+
+  joint_states.header.frame_id = "base_link";
+  joint_states.name     = joint_name;
+  joint_states.position = joint_position;
+  joint_states.velocity = joint_velocity;
+  joint_states.effort   = joint_effort;
+  joint_states.name_length = joint_states.position_length = joint_states.velocity_length = joint_states.effort_length = 2;
+
+  odom_tf.header.frame_id = "odom";
+  odom_tf.child_frame_id  = "base_footprint";
+  tf_msg.transforms_length = 1;
+  tf_msg.transforms        = &odom_tf;
+
+  runBenchmark("imu         ", imu_msg, imu_template, &imu_msg.header.stamp.nsec, &imu_msg.angular_velocity.z);
+  runBenchmark("odom        ", odom, odom_template, &odom.header.stamp.nsec, &odom.pose.pose.position.x);
+  runBenchmark("joint_states", joint_states, joint_states_template, &joint_states.header.stamp.nsec, &joint_position[0]);
+  runBenchmark("tf          ", tf_msg, tf_template, &odom_tf.header.stamp.nsec, &odom_tf.transform.translation.x);
+}
+
+void loop()
+{
+}
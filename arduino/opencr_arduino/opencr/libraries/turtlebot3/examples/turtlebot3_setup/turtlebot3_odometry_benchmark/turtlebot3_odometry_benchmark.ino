@@ -0,0 +1,142 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Yoonseok Pyo, Leon Jung, Darby Lim, HanCheol Cho, Gilbert */
+
+// Cycles of the Cortex-M7 (DWT cycle counter) per odometry tick of Turtlebot3Kinematics and of the double
+// odometry that turtlebot3_core used before it, on the synthetic log of extras/odometry/odometry_replay
+// (a wobbly figure eight at 30 Hz starting near the int32 wrap of the encoders), and the position error
+// of Turtlebot3Kinematics against the double odometry. No Dynamixel is needed.
+
+#include <TurtleBot3.h>
+
+#define WHEEL_RADIUS            0.033
+#define WHEEL_SEPARATION        0.160
+#define ODOMETRY_FREQUENCY      30
+#define TICK_NUM                (ODOMETRY_FREQUENCY * 60 * 10)   // 10 minutes
+
+Turtlebot3Kinematics kinematics;
+
+double reference_pose[3];
+double reference_last_yaw;
+int32_t reference_last_tick[2];
+
+// the odometry of turtlebot3_core before Turtlebot3Kinematics
+__attribute__((noinline)) void updateReference(int32_t* tick, float* q)
+{
+  double wheel_l = TURTLEBOT3_TICK2RAD * (double)(int32_t)((uint32_t)tick[LEFT]  - (uint32_t)reference_last_tick[LEFT]);
+  double wheel_r = TURTLEBOT3_TICK2RAD * (double)(int32_t)((uint32_t)tick[RIGHT] - (uint32_t)reference_last_tick[RIGHT]);
+  double yaw     = atan2((double)q[1]*q[2] + (double)q[0]*q[3], 0.5 - (double)q[2]*q[2] - (double)q[3]*q[3]);
+  double delta_s = WHEEL_RADIUS * (wheel_r + wheel_l) / 2.0;
+  double delta_theta = yaw - reference_last_yaw;
+
+  while (delta_theta > M_PI)
+    delta_theta -= 2.0 * M_PI;
+  while (delta_theta < -M_PI)
+    delta_theta += 2.0 * M_PI;
+
+  reference_pose[0] += delta_s * cos(reference_pose[2] + (delta_theta / 2.0));
+  reference_pose[1] += delta_s * sin(reference_pose[2] + (delta_theta / 2.0));
+  reference_pose[2] += delta_theta;
+
+  reference_last_yaw = yaw;
+  reference_last_tick[LEFT]  = tick[LEFT];
+  reference_last_tick[RIGHT] = tick[RIGHT];
+}
+
+__attribute__((noinline)) void updateKinematics(int32_t* tick, float* q)
+{
+  kinematics.updateEncoder(tick[LEFT], tick[RIGHT]);
+  kinematics.updateOdometry(1.0f / ODOMETRY_FREQUENCY, q);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  while(!Serial);
+
+  Serial.println("Start..");
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = 0xC5ACCE55; // unlock the cycle counter of the Cortex-M7
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  double wheel[2] = {2147483000.0, 2147483000.0};
+  double yaw = 0.3;
+  double dt = 1.0 / ODOMETRY_FREQUENCY;
+  int32_t tick[2];
+  float q[4] = {(float)cos(yaw / 2.0), 0.0f, 0.0f, (float)sin(yaw / 2.0)};
+
+  uint32_t reference_cycle = 0, reference_max_cycle = 0;
+  uint32_t kinematics_cycle = 0, kinematics_max_cycle = 0;
+  double max_error = 0.0;
+
+  // start both at the first tick, as turtlebot3_core does after the odometry reset
+  for (int side = 0; side < 2; side++)
+    tick[side] = reference_last_tick[side] = (int32_t)(uint32_t)(uint64_t)llround(wheel[side]);
+  reference_last_yaw = Turtlebot3Kinematics::getYaw(q);
+  kinematics.init(WHEEL_RADIUS, WHEEL_SEPARATION);
+  kinematics.updateEncoder(tick[LEFT], tick[RIGHT]);
+  kinematics.updateOdometry(dt, q);
+  kinematics.reset();
+  kinematics.updateEncoder(tick[LEFT], tick[RIGHT]);
+
+  for (uint32_t index = 1; index < TICK_NUM; index++)
+  {
+    double t = index * dt;
+    double v = 0.2 + 0.02 * sin(t * 0.05);
+    double w = 1.2 * sin(t * 0.1);
+
+    wheel[LEFT]  += (v - w * WHEEL_SEPARATION / 2.0) / WHEEL_RADIUS * dt / TURTLEBOT3_TICK2RAD;
+    wheel[RIGHT] += (v + w * WHEEL_SEPARATION / 2.0) / WHEEL_RADIUS * dt / TURTLEBOT3_TICK2RAD;
+    yaw += w * dt;
+
+    for (int side = 0; side < 2; side++)
+      tick[side] = (int32_t)(uint32_t)(uint64_t)llround(wheel[side]);
+    q[0] = cos(yaw / 2.0);
+    q[3] = sin(yaw / 2.0);
+
+    uint32_t start_cycle = DWT->CYCCNT;
+    updateReference(tick, q);
+    uint32_t middle_cycle = DWT->CYCCNT;
+    updateKinematics(tick, q);
+    uint32_t end_cycle = DWT->CYCCNT;
+
+    reference_cycle  += middle_cycle - start_cycle;
+    kinematics_cycle += end_cycle - middle_cycle;
+    if (middle_cycle - start_cycle > reference_max_cycle)
+      reference_max_cycle = middle_cycle - start_cycle;
+    if (end_cycle - middle_cycle > kinematics_max_cycle)
+      kinematics_max_cycle = end_cycle - middle_cycle;
+
+    float* pose = kinematics.getPose();
+    double error = hypot(pose[0] - reference_pose[0], pose[1] - reference_pose[1]);
+    if (error > max_error)
+      max_error = error;
+  }
+
+  Serial.print("Ticks : "); Serial.println(TICK_NUM);
+  Serial.print("double odometry      : "); Serial.print(reference_cycle / (TICK_NUM - 1));
+  Serial.print(" cycles/tick, max "); Serial.println(reference_max_cycle);
+  Serial.print("Turtlebot3Kinematics : "); Serial.print(kinematics_cycle / (TICK_NUM - 1));
+  Serial.print(" cycles/tick, max "); Serial.println(kinematics_max_cycle);
+  Serial.print("max position error against double : "); Serial.print(max_error * 1000000.0, 1); Serial.println(" um");
+}
+
+void loop()
+{
+}
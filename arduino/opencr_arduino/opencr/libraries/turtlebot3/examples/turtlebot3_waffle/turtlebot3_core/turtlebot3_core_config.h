@@ -21,9 +21,11 @@
 
 #include <ros.h>
 #include <ros/time.h>
+#include <ros/msg_template.h>
 #include <std_msgs/Bool.h>
 #include <std_msgs/Empty.h>
 #include <std_msgs/Int32.h>
+#include <std_msgs/UInt32MultiArray.h>
 #include <sensor_msgs/Imu.h>
 #include <sensor_msgs/JointState.h>
 #include <sensor_msgs/BatteryState.h>
@@ -51,6 +53,7 @@
 #define DRIVE_INFORMATION_PUBLISH_FREQUENCY    30   //hz
 #define VERSION_INFORMATION_PUBLISH_FREQUENCY  1    //hz 
 #define DEBUG_LOG_FREQUENCY                    10   //hz 
+#define PUBLISH_STATS_FREQUENCY                1    //hz
 
 #define WHEEL_NUM                        2
 
@@ -63,8 +66,6 @@
 #define DEG2RAD(x)                       (x * 0.01745329252)  // *PI/180
 #define RAD2DEG(x)                       (x * 57.2957795131)  // *180/PI
 
-#define TICK2RAD                         0.001533981  // 0.087890625[deg] * 3.14159265359 / 180 = 0.001533981f
-
 #define TEST_DISTANCE                    0.300     // meter
 #define TEST_RADIAN                      3.14      // 180 degree
 
@@ -85,6 +86,9 @@ void publishSensorStateMsg(void);
 void publishVersionInfoMsg(void);
 void publishBatteryStateMsg(void);
 void publishDriveInformation(void);
+void publishImuInformation(void);
+void publishSensorInformation(void);
+void publishPublishStatsMsg(void);
 
 ros::Time rosNow(void);
 ros::Time addMicros(ros::Time & t, uint32_t _micros); // deprecated
@@ -99,12 +103,16 @@ void updateGyroCali(bool isConnected);
 void updateGoalVelocity(void);
 void updateTFPrefix(bool isConnected);
 
+void controlMotorSpeed(void);
+void calcDriveInformation(void);
+
 void initOdom(void);
 void initJointStates(void);
 
-bool calcOdometry(double diff_time);
+bool calcOdometry(float diff_time);
 
 void sendLogMsg(void);
+void sendDebuglog(void);
 void waitForSerialLink(bool isConnected);
 
 /*******************************************************************************
@@ -152,6 +160,7 @@ ros::Publisher version_info_pub("firmware_version", &version_info_msg);
 
 // IMU of Turtlebot3
 sensor_msgs::Imu imu_msg;
+ros::ImuTemplate imu_template(imu_msg);
 ros::Publisher imu_pub("imu", &imu_msg);
 
 // Command velocity of Turtlebot3 using RC100 remote controller
@@ -160,10 +169,12 @@ ros::Publisher cmd_vel_rc100_pub("cmd_vel_rc100", &cmd_vel_rc100_msg);
 
 // Odometry of Turtlebot3
 nav_msgs::Odometry odom;
+ros::OdometryTemplate odom_template(odom);
 ros::Publisher odom_pub("odom", &odom);
 
 // Joint(Dynamixel) state of Turtlebot3
 sensor_msgs::JointState joint_states;
+ros::JointStateTemplate joint_states_template(joint_states);
 ros::Publisher joint_states_pub("joint_states", &joint_states);
 
 // Battey state of Turtlebot3
@@ -174,6 +185,11 @@ ros::Publisher battery_state_pub("battery_state", &battery_state_msg);
 sensor_msgs::MagneticField mag_msg;
 ros::Publisher mag_pub("magnetic_field", &mag_msg);
 
+// Counters of the batching publisher (frames, writes, stale, throttled, dropped)
+std_msgs::UInt32MultiArray publish_stats_msg;
+uint32_t publish_stats[5];
+ros::Publisher publish_stats_pub("publish_stats", &publish_stats_msg);
+
 /*******************************************************************************
 * Transform Broadcaster
 *******************************************************************************/
@@ -182,26 +198,26 @@ geometry_msgs::TransformStamped odom_tf;
 tf::TransformBroadcaster tf_broadcaster;
 
 /*******************************************************************************
-* SoftwareTimer of Turtlebot3
+* Scheduler of Turtlebot3
 *******************************************************************************/
-static uint32_t tTime[10];
+Turtlebot3Scheduler scheduler;
 
 /*******************************************************************************
 * Declaration for motor
 *******************************************************************************/
 Turtlebot3MotorDriver motor_driver;
 
-/*******************************************************************************
-* Calculation for odometry
-*******************************************************************************/
-bool init_encoder = true;
-int32_t last_diff_tick[WHEEL_NUM] = {0.0, 0.0};
-double  last_rad[WHEEL_NUM]       = {0.0, 0.0};
+// Written by the motor task in loop(), under Turtlebot3Scheduler::lock() for the odometry task
+int32_t present_encoder[WHEEL_NUM] = {0, 0};
+uint32_t present_encoder_time      = 0;     // micros() when present_encoder was read
+bool present_encoder_valid         = false;
+volatile bool encoder_updated      = false;
+int8_t torque_request              = -1;    // -1 : none, 0 : off, 1 : on
 
 /*******************************************************************************
-* Update Joint State
+* Calculation for odometry
 *******************************************************************************/
-double  last_velocity[WHEEL_NUM]  = {0.0, 0.0};
+Turtlebot3Kinematics kinematics;
 
 /*******************************************************************************
 * Declaration for sensors
@@ -225,9 +241,9 @@ Turtlebot3Diagnosis diagnosis;
 /*******************************************************************************
 * Declaration for SLAM and navigation
 *******************************************************************************/
-unsigned long prev_update_time;
-float odom_pose[3];
-double odom_vel[3];
+uint32_t prev_update_time;
+float imu_orientation[4] = {1.0, 0.0, 0.0, 0.0};
+volatile bool odom_reset_request = false;
 
 /*******************************************************************************
 * Declaration for Battery
@@ -61,6 +61,8 @@ void setup()
   controllers.init(MAX_LINEAR_VELOCITY, MAX_ANGULAR_VELOCITY);
 
   // Setting for SLAM and navigation (odometry, joint states, TF)
+  kinematics.init(WHEEL_RADIUS, WHEEL_SEPARATION);
+
   initOdom();
 
   initJointStates();
@@ -345,7 +347,7 @@ void publishDriveInformation(void)
   ros::Time stamp_now = rosNow();
 
   // calculate odometry
-  calcOdometry((double)(step_time * 0.001));
+  calcOdometry((float)step_time * 0.001f);
 
   // odometry
   updateOdometry();
@@ -429,16 +431,26 @@ void updateTFPrefix(bool isConnected)
 *******************************************************************************/
 void updateOdometry(void)
 {
+  float* pose     = kinematics.getPose();
+  float* velocity = kinematics.getVelocity();
+  float orientation[4];
+
+  kinematics.getOrientation(orientation);
+
   odom.header.frame_id = odom_header_frame_id;
   odom.child_frame_id  = odom_child_frame_id;
 
-  odom.pose.pose.position.x = odom_pose[0];
-  odom.pose.pose.position.y = odom_pose[1];
+  odom.pose.pose.position.x = pose[0];
+  odom.pose.pose.position.y = pose[1];
   odom.pose.pose.position.z = 0;
-  odom.pose.pose.orientation = tf::createQuaternionFromYaw(odom_pose[2]);
 
-  odom.twist.twist.linear.x  = odom_vel[0];
-  odom.twist.twist.angular.z = odom_vel[2];
+  odom.pose.pose.orientation.x = orientation[1];
+  odom.pose.pose.orientation.y = orientation[2];
+  odom.pose.pose.orientation.z = orientation[3];
+  odom.pose.pose.orientation.w = orientation[0];
+
+  odom.twist.twist.linear.x  = velocity[0];
+  odom.twist.twist.angular.z = velocity[2];
 }
 
 /*******************************************************************************
@@ -456,8 +468,8 @@ void updateJointStates(void)
   joint_driver.readPosition(get_joint_position);
   joint_driver.readVelocity(get_joint_velocity);
 
-  joint_states_pos[LEFT]  = last_rad[LEFT];
-  joint_states_pos[RIGHT] = last_rad[RIGHT];
+  joint_states_pos[LEFT]  = kinematics.getWheelAngle()[LEFT];
+  joint_states_pos[RIGHT] = kinematics.getWheelAngle()[RIGHT];
   joint_states_pos[2] = get_joint_position[0];
   joint_states_pos[3] = get_joint_position[1];
   joint_states_pos[4] = get_joint_position[2];
@@ -465,8 +477,8 @@ void updateJointStates(void)
   joint_states_pos[6] = mapd(get_joint_position[4], 0.90, -0.80, -0.01, 0.01);
   joint_states_pos[7] = joint_states_pos[6];
 
-  joint_states_vel[LEFT]  = last_velocity[LEFT];
-  joint_states_vel[RIGHT] = last_velocity[RIGHT];
+  joint_states_vel[LEFT]  = kinematics.getWheelVelocity()[LEFT];
+  joint_states_vel[RIGHT] = kinematics.getWheelVelocity()[RIGHT];
   joint_states_vel[2] = get_joint_velocity[0];
   joint_states_vel[3] = get_joint_velocity[1];
   joint_states_vel[4] = get_joint_velocity[2];
@@ -497,98 +509,16 @@ void updateTF(geometry_msgs::TransformStamped& odom_tf)
 *******************************************************************************/
 void updateMotorInfo(int32_t left_tick, int32_t right_tick)
 {
-  int32_t current_tick = 0;
-  static int32_t last_tick[WHEEL_NUM] = {0.0, 0.0};
-  
-  if (init_encoder)
-  {
-    for (int index = 0; index < WHEEL_NUM; index++)
-    {
-      last_diff_tick[index] = 0.0;
-      last_tick[index]      = 0.0;
-      last_rad[index]       = 0.0;
-
-      last_velocity[index]  = 0.0;
-    }  
-
-    last_tick[LEFT] = left_tick;
-    last_tick[RIGHT] = right_tick;
-
-    init_encoder = false;
-    return;
-  }
-
-  current_tick = left_tick;
-
-  last_diff_tick[LEFT] = current_tick - last_tick[LEFT];
-  last_tick[LEFT]      = current_tick;
-  last_rad[LEFT]       += TICK2RAD * (double)last_diff_tick[LEFT];
-
-  current_tick = right_tick;
-
-  last_diff_tick[RIGHT] = current_tick - last_tick[RIGHT];
-  last_tick[RIGHT]      = current_tick;
-  last_rad[RIGHT]       += TICK2RAD * (double)last_diff_tick[RIGHT];
+  kinematics.updateEncoder(left_tick, right_tick);
 }
 
 /*******************************************************************************
 * Calculate the odometry
 *******************************************************************************/
-bool calcOdometry(double diff_time)
+bool calcOdometry(float diff_time)
 {
-  float* orientation;
-  double wheel_l, wheel_r;      // rotation value of wheel [rad]
-  double delta_s, theta, delta_theta;
-  static double last_theta = 0.0;
-  double v, w;                  // v = translational velocity [m/s], w = rotational velocity [rad/s]
-  double step_time;
-
-  wheel_l = wheel_r = 0.0;
-  delta_s = delta_theta = theta = 0.0;
-  v = w = 0.0;
-  step_time = 0.0;
-
-  step_time = diff_time;
-
-  if (step_time == 0)
-    return false;
-
-  wheel_l = TICK2RAD * (double)last_diff_tick[LEFT];
-  wheel_r = TICK2RAD * (double)last_diff_tick[RIGHT];
-
-  if (isnan(wheel_l))
-    wheel_l = 0.0;
-
-  if (isnan(wheel_r))
-    wheel_r = 0.0;
-
-  delta_s     = WHEEL_RADIUS * (wheel_r + wheel_l) / 2.0;
-  // theta = WHEEL_RADIUS * (wheel_r - wheel_l) / WHEEL_SEPARATION;  
-  orientation = sensors.getOrientation();
-  theta       = atan2f(orientation[1]*orientation[2] + orientation[0]*orientation[3], 
-                0.5f - orientation[2]*orientation[2] - orientation[3]*orientation[3]);
-
-  delta_theta = theta - last_theta;
-
-  // compute odometric pose
-  odom_pose[0] += delta_s * cos(odom_pose[2] + (delta_theta / 2.0));
-  odom_pose[1] += delta_s * sin(odom_pose[2] + (delta_theta / 2.0));
-  odom_pose[2] += delta_theta;
-
-  // compute odometric instantaneouse velocity
-
-  v = delta_s / step_time;
-  w = delta_theta / step_time;
-
-  odom_vel[0] = v;
-  odom_vel[1] = 0.0;
-  odom_vel[2] = w;
-
-  last_velocity[LEFT]  = wheel_l / step_time;
-  last_velocity[RIGHT] = wheel_r / step_time;
-  last_theta = theta;
-
-  return true;
+  // The heading comes from the IMU, the travelled distance from the wheels
+  return kinematics.updateOdometry(diff_time, sensors.getOrientation());
 }
 
 /*******************************************************************************
@@ -792,13 +722,7 @@ void sendLogMsg(void)
 *******************************************************************************/
 void initOdom(void)
 {
-  init_encoder = true;
-
-  for (int index = 0; index < 3; index++)
-  {
-    odom_pose[index] = 0.0;
-    odom_vel[index]  = 0.0;
-  }
+  kinematics.reset();
 
   odom.pose.pose.position.x = 0.0;
   odom.pose.pose.position.y = 0.0;
@@ -899,7 +823,7 @@ void sendDebuglog(void)
   DEBUG_SERIAL.println("TurtleBot3");
   DEBUG_SERIAL.println("---------------------------------------");
   DEBUG_SERIAL.println("Odometry : ");   
-  DEBUG_SERIAL.print("         x : "); DEBUG_SERIAL.println(odom_pose[0]);
-  DEBUG_SERIAL.print("         y : "); DEBUG_SERIAL.println(odom_pose[1]);
-  DEBUG_SERIAL.print("     theta : "); DEBUG_SERIAL.println(odom_pose[2]);
+  DEBUG_SERIAL.print("         x : "); DEBUG_SERIAL.println(kinematics.getPose()[0]);
+  DEBUG_SERIAL.print("         y : "); DEBUG_SERIAL.println(kinematics.getPose()[1]);
+  DEBUG_SERIAL.print("     theta : "); DEBUG_SERIAL.println(kinematics.getPose()[2]);
 }
\ No newline at end of file
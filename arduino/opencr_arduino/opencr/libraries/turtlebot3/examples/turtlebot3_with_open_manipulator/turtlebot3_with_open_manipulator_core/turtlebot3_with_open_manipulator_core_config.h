@@ -64,8 +64,6 @@
 #define DEG2RAD(x)                       (x * 0.01745329252)  // *PI/180
 #define RAD2DEG(x)                       (x * 57.2957795131)  // *180/PI
 
-#define TICK2RAD                         0.001533981  // 0.087890625[deg] * 3.14159265359 / 180 = 0.001533981f
-
 #define TEST_DISTANCE                    0.300     // meter
 #define TEST_RADIAN                      3.14      // 180 degree
 
@@ -105,7 +103,7 @@ void updateTFPrefix(bool isConnected);
 void initOdom(void);
 void initJointStates(void);
 
-bool calcOdometry(double diff_time);
+bool calcOdometry(float diff_time);
 
 void sendLogMsg(void);
 void waitForSerialLink(bool isConnected);
@@ -204,14 +202,7 @@ OpenManipulatorMotorDriver joint_driver;
 /*******************************************************************************
 * Calculation for odometry
 *******************************************************************************/
-bool init_encoder = true;
-int32_t last_diff_tick[WHEEL_NUM] = {0.0, 0.0};
-double  last_rad[WHEEL_NUM]       = {0.0, 0.0};
-
-/*******************************************************************************
-* Update Joint State
-*******************************************************************************/
-double  last_velocity[WHEEL_NUM]  = {0.0, 0.0};
+Turtlebot3Kinematics kinematics;
 
 /*******************************************************************************
 * Declaration for sensors
@@ -236,8 +227,6 @@ Turtlebot3Diagnosis diagnosis;
 * Declaration for SLAM and navigation
 *******************************************************************************/
 unsigned long prev_update_time;
-float odom_pose[3];
-double odom_vel[3];
 
 /*******************************************************************************
 * Declaration for Battery
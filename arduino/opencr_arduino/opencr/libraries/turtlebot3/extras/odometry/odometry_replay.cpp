@@ -0,0 +1,319 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Yoonseok Pyo, Leon Jung, Darby Lim, HanCheol Cho, Gilbert */
+
+// Replays an encoder/IMU log through Turtlebot3Kinematics and compares the pose with a double precision reference.
+//   reference   : the odometry of turtlebot3_core before Turtlebot3Kinematics, in double
+//   kinematics  : Turtlebot3Kinematics (float, Kahan summed position)
+//   plain float : the reference algorithm in float without Kahan summation
+// The log has one odometry tick per line, as the core publishes it:
+//   time[s] left_tick right_tick qw qx qy qz
+// Without a log, a synthetic one is replayed: 4 hours at 30 Hz of a wobbly figure eight
+// starting near the int32 wrap of the encoders. -w writes that log to a file.
+//
+// usage: odometry_replay [log]
+//        odometry_replay -w log [hours]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "turtlebot3_kinematics.h"
+
+#define WHEEL_RADIUS            0.033
+#define WHEEL_SEPARATION        0.160
+#define ODOMETRY_FREQUENCY      30
+
+struct Tick
+{
+  double  time;
+  int32_t encoder[2];
+  float   orientation[4];   // w, x, y, z
+};
+
+// the odometry of turtlebot3_core before Turtlebot3Kinematics
+class ReferenceOdometry
+{
+ public:
+  double pose[3];
+  double last_yaw;
+  int32_t last_tick[2];
+  int32_t diff_tick[2];
+  bool init_encoder;
+
+  ReferenceOdometry() : last_yaw(0.0), init_encoder(true)
+  {
+    pose[0] = pose[1] = pose[2] = 0.0;
+  }
+
+  void update(const Tick &tick, bool is_first)
+  {
+    for (int index = 0; index < 2; index++)
+    {
+      diff_tick[index] = init_encoder ? 0 : (int32_t)((uint32_t)tick.encoder[index] - (uint32_t)last_tick[index]);
+      last_tick[index] = tick.encoder[index];
+    }
+    init_encoder = false;
+
+    const float *q = tick.orientation;
+    double yaw = atan2((double)q[1]*q[2] + (double)q[0]*q[3], 0.5 - (double)q[2]*q[2] - (double)q[3]*q[3]);
+    if (is_first)
+      last_yaw = yaw;
+
+    double wheel_l = TURTLEBOT3_TICK2RAD * (double)diff_tick[LEFT];
+    double wheel_r = TURTLEBOT3_TICK2RAD * (double)diff_tick[RIGHT];
+    double delta_s = WHEEL_RADIUS * (wheel_r + wheel_l) / 2.0;
+    double delta_theta = yaw - last_yaw;
+
+    while (delta_theta > M_PI)
+      delta_theta -= 2.0 * M_PI;
+    while (delta_theta < -M_PI)
+      delta_theta += 2.0 * M_PI;
+
+    pose[0] += delta_s * cos(pose[2] + (delta_theta / 2.0));
+    pose[1] += delta_s * sin(pose[2] + (delta_theta / 2.0));
+    pose[2] += delta_theta;
+    last_yaw = yaw;
+  }
+};
+
+// the same algorithm in plain float, to show what the Kahan sums of Turtlebot3Kinematics are for
+class FloatOdometry
+{
+ public:
+  float pose[3];
+  float last_yaw;
+  int32_t last_tick[2];
+  bool init_encoder;
+
+  FloatOdometry() : last_yaw(0.0f), init_encoder(true)
+  {
+    pose[0] = pose[1] = pose[2] = 0.0f;
+  }
+
+  void update(const Tick &tick, bool is_first)
+  {
+    int32_t diff_tick[2];
+    for (int index = 0; index < 2; index++)
+    {
+      diff_tick[index] = init_encoder ? 0 : (int32_t)((uint32_t)tick.encoder[index] - (uint32_t)last_tick[index]);
+      last_tick[index] = tick.encoder[index];
+    }
+    init_encoder = false;
+
+    float yaw = Turtlebot3Kinematics::getYaw((float *)tick.orientation);
+    if (is_first)
+      last_yaw = yaw;
+
+    float delta_s = (float)WHEEL_RADIUS * TURTLEBOT3_TICK2RAD * (float)(diff_tick[RIGHT] + diff_tick[LEFT]) * 0.5f;
+    float delta_theta = yaw - last_yaw;
+
+    while (delta_theta > (float)M_PI)
+      delta_theta -= 2.0f * (float)M_PI;
+    while (delta_theta < -(float)M_PI)
+      delta_theta += 2.0f * (float)M_PI;
+
+    pose[0] += delta_s * cosf(pose[2] + (delta_theta * 0.5f));
+    pose[1] += delta_s * sinf(pose[2] + (delta_theta * 0.5f));
+    pose[2] += delta_theta;
+    last_yaw = yaw;
+  }
+};
+
+struct Error
+{
+  double max_position;    // m
+  double final_position;  // m
+  double max_heading;     // rad
+};
+
+static double getNsec()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double wrapAngle(double angle)
+{
+  return atan2(sin(angle), cos(angle));
+}
+
+static void updateError(Error &error, double x, double y, double theta, const ReferenceOdometry &reference)
+{
+  double position = hypot(x - reference.pose[0], y - reference.pose[1]);
+  double heading  = fabs(wrapAngle(theta - reference.pose[2]));
+
+  if (position > error.max_position)
+    error.max_position = position;
+  if (heading > error.max_heading)
+    error.max_heading = heading;
+  error.final_position = position;
+}
+
+static std::vector<Tick> makeLog(double hours)
+{
+  std::vector<Tick> log((size_t)(hours * 3600.0 * ODOMETRY_FREQUENCY));
+  double dt = 1.0 / ODOMETRY_FREQUENCY;
+  double wheel[2] = {2147483000.0, 2147483000.0};   // ticks, near the int32 wrap
+  double yaw = 0.3;
+
+  for (size_t index = 0; index < log.size(); index++)
+  {
+    double t = index * dt;
+    double v = 0.2 + 0.02 * sin(t * 0.05);
+    double w = 1.2 * sin(t * 0.1);
+
+    wheel[LEFT]  += (v - w * WHEEL_SEPARATION / 2.0) / WHEEL_RADIUS * dt / TURTLEBOT3_TICK2RAD;
+    wheel[RIGHT] += (v + w * WHEEL_SEPARATION / 2.0) / WHEEL_RADIUS * dt / TURTLEBOT3_TICK2RAD;
+    yaw += w * dt;
+
+    log[index].time = t;
+    for (int side = 0; side < 2; side++)
+      log[index].encoder[side] = (int32_t)(uint32_t)(uint64_t)llround(wheel[side]);
+    log[index].orientation[0] = cos(yaw / 2.0);
+    log[index].orientation[1] = 0.0f;
+    log[index].orientation[2] = 0.0f;
+    log[index].orientation[3] = sin(yaw / 2.0);
+  }
+
+  return log;
+}
+
+static bool readLog(const char *file_name, std::vector<Tick> &log)
+{
+  FILE *file = fopen(file_name, "r");
+  if (file == NULL)
+    return false;
+
+  char line[256];
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    Tick tick;
+    if (line[0] == '#')
+      continue;
+    if (sscanf(line, "%lf %d %d %f %f %f %f", &tick.time, &tick.encoder[LEFT], &tick.encoder[RIGHT],
+               &tick.orientation[0], &tick.orientation[1], &tick.orientation[2], &tick.orientation[3]) == 7)
+      log.push_back(tick);
+  }
+  fclose(file);
+
+  return true;
+}
+
+static bool writeLog(const char *file_name, const std::vector<Tick> &log)
+{
+  FILE *file = fopen(file_name, "w");
+  if (file == NULL)
+    return false;
+
+  fprintf(file, "# time[s] left_tick right_tick qw qx qy qz\n");
+  for (size_t index = 0; index < log.size(); index++)
+    fprintf(file, "%.4f %d %d %.9g %.9g %.9g %.9g\n", log[index].time, log[index].encoder[LEFT], log[index].encoder[RIGHT],
+            log[index].orientation[0], log[index].orientation[1], log[index].orientation[2], log[index].orientation[3]);
+  fclose(file);
+
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  std::vector<Tick> log;
+
+  if (argc > 2 && strcmp(argv[1], "-w") == 0)
+  {
+    double hours = (argc > 3) ? atof(argv[3]) : 4.0;
+    if (writeLog(argv[2], makeLog(hours)) == false)
+    {
+      printf("can't write %s\n", argv[2]);
+      return 1;
+    }
+    return 0;
+  }
+
+  if (argc > 1)
+  {
+    if (readLog(argv[1], log) == false)
+    {
+      printf("can't read %s\n", argv[1]);
+      return 1;
+    }
+  }
+  else
+  {
+    log = makeLog(4.0);
+  }
+
+  if (log.size() < 2)
+  {
+    printf("the log has less than 2 ticks\n");
+    return 1;
+  }
+
+  ReferenceOdometry reference;
+  FloatOdometry float_odometry;
+  Turtlebot3Kinematics kinematics;
+  Error kinematics_error = {0.0, 0.0, 0.0};
+  Error float_error = {0.0, 0.0, 0.0};
+  double reference_time = 0.0;
+  double kinematics_time = 0.0;
+
+  kinematics.init((float)WHEEL_RADIUS, (float)WHEEL_SEPARATION);
+
+  for (size_t index = 0; index < log.size(); index++)
+  {
+    const Tick &tick = log[index];
+    bool is_first = (index == 0);
+    float diff_time = is_first ? (float)(1.0 / ODOMETRY_FREQUENCY) : (float)(tick.time - log[index - 1].time);
+
+    double start_time = getNsec();
+    reference.update(tick, is_first);
+    double middle_time = getNsec();
+    kinematics.updateEncoder(tick.encoder[LEFT], tick.encoder[RIGHT]);
+    if (is_first)
+    {
+      // the core resets the odometry at the first IMU orientation
+      kinematics.updateOdometry(diff_time, (float *)tick.orientation);
+      kinematics.reset();
+      kinematics.updateEncoder(tick.encoder[LEFT], tick.encoder[RIGHT]);
+    }
+    kinematics.updateOdometry(diff_time, (float *)tick.orientation);
+    double end_time = getNsec();
+
+    float_odometry.update(tick, is_first);
+
+    reference_time  += middle_time - start_time;
+    kinematics_time += end_time - middle_time;
+
+    float *pose = kinematics.getPose();
+    updateError(kinematics_error, pose[0], pose[1], pose[2], reference);
+    updateError(float_error, float_odometry.pose[0], float_odometry.pose[1], float_odometry.pose[2], reference);
+  }
+
+  double duration = log.back().time - log.front().time;
+  printf("%zu ticks, %.2f h, reference ends at x %.3f m y %.3f m\n\n", log.size(), duration / 3600.0, reference.pose[0], reference.pose[1]);
+  printf("  %-22s %16s %16s %16s\n", "against double", "max pos [m]", "final pos [m]", "max heading [rad]");
+  printf("  %-22s %16.2e %16.2e %16.2e\n", "Turtlebot3Kinematics", kinematics_error.max_position, kinematics_error.final_position, kinematics_error.max_heading);
+  printf("  %-22s %16.2e %16.2e %16.2e\n", "plain float", float_error.max_position, float_error.final_position, float_error.max_heading);
+  printf("\nhost cost per tick: double reference %.0f ns, Turtlebot3Kinematics %.0f ns\n",
+         reference_time / log.size(), kinematics_time / log.size());
+
+  return 0;
+}
@@ -2,3 +2,5 @@
 #include "turtlebot3_sensor.h"
 #include "turtlebot3_controller.h"
 #include "turtlebot3_diagnosis.h"
+#include "turtlebot3_kinematics.h"
+#include "turtlebot3_scheduler.h"
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Yoonseok Pyo, Leon Jung, Darby Lim, HanCheol Cho, Gilbert */
+
+#ifndef TURTLEBOT3_KINEMATICS_H_
+#define TURTLEBOT3_KINEMATICS_H_
+
+#include <stdint.h>
+#include <math.h>
+
+#define TURTLEBOT3_TICK2RAD               0.001533981f  // 0.087890625[deg] * 3.14159265359 / 180
+
+#define LEFT                              0
+#define RIGHT                             1
+
+// Running sum that carries the rounding error of every addition (Kahan summation),
+// so a float pose integrated over hours does not drift more than a double one.
+typedef struct KAHAN_SUM
+{
+  float sum;
+  float compensation;
+}KahanSum;
+
+class Turtlebot3Kinematics
+{
+ public:
+  Turtlebot3Kinematics();
+  ~Turtlebot3Kinematics();
+
+  void init(float wheel_radius, float wheel_separation);
+  void reset(void);
+
+  // Odometry
+  void updateEncoder(int32_t left_tick, int32_t right_tick);
+  bool updateOdometry(float diff_time, float* orientation);
+
+  float* getPose(void);
+  float* getVelocity(void);
+  void getOrientation(float* orientation);
+
+  // Joint states
+  float* getWheelAngle(void);
+  float* getWheelVelocity(void);
+
+  static float getYaw(float* orientation);
+
+ private:
+  float wheel_radius_;
+  float wheel_separation_;
+
+  bool init_encoder_;
+  int32_t last_tick_[2];
+  int32_t diff_tick_[2];
+
+  KahanSum wheel_angle_sum_[2];
+  KahanSum pose_sum_[2];
+  float yaw_offset_;
+  float last_yaw_;
+
+  float pose_[3];            // x[m], y[m], theta[rad]
+  float velocity_[3];        // v[m/s], 0, w[rad/s]
+  float wheel_angle_[2];     // [rad]
+  float wheel_velocity_[2];  // [rad/s]
+
+  static void addKahanSum(KahanSum* kahan_sum, float value);
+  static float normalizeAngle(float angle);
+};
+
+#endif // TURTLEBOT3_KINEMATICS_H_
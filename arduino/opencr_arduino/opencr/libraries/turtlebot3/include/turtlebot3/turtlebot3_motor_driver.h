@@ -73,7 +73,7 @@ class Turtlebot3MotorDriver
   bool setTorque(bool onoff);
   bool getTorque();
   bool readEncoder(int32_t &left_value, int32_t &right_value);
-  bool writeVelocity(int64_t left_value, int64_t right_value);
+  bool writeVelocity(int32_t left_value, int32_t right_value);
   bool controlMotor(const float wheel_separation, float* value);
 
  private:
@@ -0,0 +1,97 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Yoonseok Pyo, Leon Jung, Darby Lim, HanCheol Cho, Gilbert */
+
+#ifndef TURTLEBOT3_SCHEDULER_H_
+#define TURTLEBOT3_SCHEDULER_H_
+
+#include <Arduino.h>
+
+#define SCHEDULER_TASK_MAX               12
+#define SCHEDULER_HISTOGRAM_SIZE         10    // bucket n counts execution times below (32 << n) us, the last one everything above
+#define SCHEDULER_TICK_PERIOD            1000  // us
+
+// A timer task runs inside the timer interrupt, so it preempts loop() and never waits behind ROS serialization.
+// It must not touch anything loop() uses without Turtlebot3Scheduler::lock(), and must not wait for a bus:
+// a blocking transfer there stalls loop(), and every interrupt of the timer priority or lower, for its whole timeout.
+// A loop task is released by the timer and run from run() in loop().
+#define SCHEDULER_CONTEXT_TIMER          0
+#define SCHEDULER_CONTEXT_LOOP           1
+
+typedef void (*SchedulerFunc)(void);
+
+typedef struct SCHEDULER_TASK
+{
+  const char* name;
+  SchedulerFunc func;
+  uint32_t period;                 // us, also the relative deadline
+  uint8_t  priority;               // 0 is the highest, give shorter periods higher priorities (rate monotonic)
+  uint8_t  context;
+
+  volatile bool     released;
+  volatile uint32_t release_time;  // us
+  uint32_t next_release;           // us
+
+  uint32_t run_count;
+  volatile uint32_t deadline_miss; // a release found the last one still waiting, or a run ended after its deadline
+  uint32_t max_execution_time;     // us
+  uint32_t histogram[SCHEDULER_HISTOGRAM_SIZE];
+}SchedulerTask;
+
+class Turtlebot3Scheduler
+{
+ public:
+  Turtlebot3Scheduler();
+  ~Turtlebot3Scheduler();
+
+  bool init(uint8_t timer_channel = TIMER_CH1, uint32_t tick_period = SCHEDULER_TICK_PERIOD);
+  bool addTask(const char* name, SchedulerFunc func, uint32_t frequency, uint8_t priority, uint8_t context);
+
+  void start(void);
+  void stop(void);
+
+  void run(void);
+  void tick(void);
+
+  uint8_t getTaskNum(void);
+  SchedulerTask* getTask(uint8_t index);
+  void clearStatistics(void);
+  void printStatistics(Print& out);
+
+  static uint32_t getHistogramBound(uint8_t bucket);
+
+  // Masks the scheduler timer and the interrupts of its priority or lower by raising BASEPRI,
+  // SysTick, USB and the UARTs keep running. Locks nest, unlock() takes what lock() returned.
+  static uint32_t lock(void);
+  static void unlock(uint32_t state);
+
+ private:
+  HardwareTimer* timer_;
+  uint32_t tick_period_;
+  bool is_started_;
+
+  SchedulerTask task_[SCHEDULER_TASK_MAX];
+  uint8_t task_num_;
+
+  void runTask(SchedulerTask* task, uint32_t release_time);
+
+  static Turtlebot3Scheduler* instance_;
+  static IRQn_Type timer_irq_;
+  static void timerHandler(void);
+};
+
+#endif // TURTLEBOT3_SCHEDULER_H_
@@ -0,0 +1,198 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Yoonseok Pyo, Leon Jung, Darby Lim, HanCheol Cho, Gilbert */
+
+#include "../../include/turtlebot3/turtlebot3_kinematics.h"
+
+Turtlebot3Kinematics::Turtlebot3Kinematics()
+: wheel_radius_(0.033f),
+  wheel_separation_(0.160f),
+  yaw_offset_(0.0f),
+  last_yaw_(0.0f)
+{
+  reset();
+}
+
+Turtlebot3Kinematics::~Turtlebot3Kinematics()
+{
+}
+
+void Turtlebot3Kinematics::init(float wheel_radius, float wheel_separation)
+{
+  wheel_radius_     = wheel_radius;
+  wheel_separation_ = wheel_separation;
+
+  reset();
+}
+
+void Turtlebot3Kinematics::reset(void)
+{
+  init_encoder_ = true;
+
+  for (int index = 0; index < 2; index++)
+  {
+    last_tick_[index] = 0;
+    diff_tick_[index] = 0;
+
+    wheel_angle_sum_[index].sum          = 0.0f;
+    wheel_angle_sum_[index].compensation = 0.0f;
+    pose_sum_[index].sum                 = 0.0f;
+    pose_sum_[index].compensation        = 0.0f;
+
+    wheel_angle_[index]    = 0.0f;
+    wheel_velocity_[index] = 0.0f;
+  }
+
+  for (int index = 0; index < 3; index++)
+  {
+    pose_[index]     = 0.0f;
+    velocity_[index] = 0.0f;
+  }
+
+  // The heading restarts from zero at the yaw the IMU reports now
+  yaw_offset_ = last_yaw_;
+}
+
+/*******************************************************************************
+* Update the wheel angles from the raw encoder values
+*******************************************************************************/
+void Turtlebot3Kinematics::updateEncoder(int32_t left_tick, int32_t right_tick)
+{
+  int32_t current_tick[2] = {left_tick, right_tick};
+
+  if (init_encoder_)
+  {
+    for (int index = 0; index < 2; index++)
+    {
+      last_tick_[index] = current_tick[index];
+      diff_tick_[index] = 0;
+    }
+
+    init_encoder_ = false;
+    return;
+  }
+
+  for (int index = 0; index < 2; index++)
+  {
+    int32_t diff_tick = (int32_t)((uint32_t)current_tick[index] - (uint32_t)last_tick_[index]);
+
+    diff_tick_[index] += diff_tick; // until the next odometry update
+    last_tick_[index]  = current_tick[index];
+
+    addKahanSum(&wheel_angle_sum_[index], TURTLEBOT3_TICK2RAD * (float)diff_tick);
+    wheel_angle_[index] = wheel_angle_sum_[index].sum;
+  }
+}
+
+/*******************************************************************************
+* Integrate the pose with the last encoder step and the IMU orientation (w, x, y, z)
+*******************************************************************************/
+bool Turtlebot3Kinematics::updateOdometry(float diff_time, float* orientation)
+{
+  float wheel_l, wheel_r;      // rotation value of wheel [rad]
+  float delta_s, yaw, delta_theta, theta;
+
+  if (diff_time <= 0.0f)
+    return false;
+
+  wheel_l = TURTLEBOT3_TICK2RAD * (float)diff_tick_[LEFT];
+  wheel_r = TURTLEBOT3_TICK2RAD * (float)diff_tick_[RIGHT];
+
+  delta_s     = wheel_radius_ * (wheel_r + wheel_l) * 0.5f;
+  yaw         = getYaw(orientation);
+  delta_theta = normalizeAngle(yaw - last_yaw_);
+  theta       = pose_[2] + (delta_theta * 0.5f);
+
+  // compute odometric pose
+  addKahanSum(&pose_sum_[0], delta_s * cosf(theta));
+  addKahanSum(&pose_sum_[1], delta_s * sinf(theta));
+
+  pose_[0] = pose_sum_[0].sum;
+  pose_[1] = pose_sum_[1].sum;
+  pose_[2] = normalizeAngle(yaw - yaw_offset_); // absolute, so the heading never accumulates error
+
+  // compute odometric instantaneouse velocity
+  velocity_[0] = delta_s / diff_time;
+  velocity_[1] = 0.0f;
+  velocity_[2] = delta_theta / diff_time;
+
+  wheel_velocity_[LEFT]  = wheel_l / diff_time;
+  wheel_velocity_[RIGHT] = wheel_r / diff_time;
+
+  // the same encoder step is never integrated twice
+  diff_tick_[LEFT]  = 0;
+  diff_tick_[RIGHT] = 0;
+  last_yaw_ = yaw;
+
+  return true;
+}
+
+float* Turtlebot3Kinematics::getPose(void)
+{
+  return pose_;
+}
+
+float* Turtlebot3Kinematics::getVelocity(void)
+{
+  return velocity_;
+}
+
+/*******************************************************************************
+* Quaternion (w, x, y, z) of the odometric heading
+*******************************************************************************/
+void Turtlebot3Kinematics::getOrientation(float* orientation)
+{
+  orientation[0] = cosf(pose_[2] * 0.5f);
+  orientation[1] = 0.0f;
+  orientation[2] = 0.0f;
+  orientation[3] = sinf(pose_[2] * 0.5f);
+}
+
+float* Turtlebot3Kinematics::getWheelAngle(void)
+{
+  return wheel_angle_;
+}
+
+float* Turtlebot3Kinematics::getWheelVelocity(void)
+{
+  return wheel_velocity_;
+}
+
+float Turtlebot3Kinematics::getYaw(float* orientation)
+{
+  return atan2f(orientation[1]*orientation[2] + orientation[0]*orientation[3],
+                0.5f - orientation[2]*orientation[2] - orientation[3]*orientation[3]);
+}
+
+void Turtlebot3Kinematics::addKahanSum(KahanSum* kahan_sum, float value)
+{
+  float y = value - kahan_sum->compensation;
+  float t = kahan_sum->sum + y;
+
+  kahan_sum->compensation = (t - kahan_sum->sum) - y;
+  kahan_sum->sum          = t;
+}
+
+float Turtlebot3Kinematics::normalizeAngle(float angle)
+{
+  while (angle > (float)M_PI)
+    angle -= 2.0f * (float)M_PI;
+  while (angle < -(float)M_PI)
+    angle += 2.0f * (float)M_PI;
+
+  return angle;
+}
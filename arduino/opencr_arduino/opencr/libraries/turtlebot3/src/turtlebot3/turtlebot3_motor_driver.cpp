@@ -58,7 +58,18 @@ bool Turtlebot3MotorDriver::init(String turtlebot3)
 
   groupSyncWriteVelocity_ = new dynamixel::GroupSyncWrite(portHandler_, packetHandler_, ADDR_X_GOAL_VELOCITY, LEN_X_GOAL_VELOCITY);
   groupSyncReadEncoder_   = new dynamixel::GroupSyncRead(portHandler_, packetHandler_, ADDR_X_PRESENT_POSITION, LEN_X_PRESENT_POSITION);
-  
+
+  // The wheel IDs never change, so the sync packets are made once here and only re-sent in the control loop
+  uint8_t data_byte[4] = {0, };
+
+  groupSyncWriteVelocity_->addParam(left_wheel_id_, (uint8_t*)&data_byte);
+  groupSyncWriteVelocity_->addParam(right_wheel_id_, (uint8_t*)&data_byte);
+  groupSyncWriteVelocity_->freezeParam();
+
+  groupSyncReadEncoder_->addParam(left_wheel_id_);
+  groupSyncReadEncoder_->addParam(right_wheel_id_);
+  groupSyncReadEncoder_->freezeParam();
+
   if (turtlebot3 == "Burger")
     dynamixel_limit_max_velocity_ = BURGER_DXL_LIMIT_MAX_VELOCITY;
   else if (turtlebot3 == "Waffle or Waffle Pi")
@@ -122,18 +133,8 @@ void Turtlebot3MotorDriver::close(void)
 bool Turtlebot3MotorDriver::readEncoder(int32_t &left_value, int32_t &right_value)
 {
   int dxl_comm_result = COMM_TX_FAIL;              // Communication result
-  bool dxl_addparam_result = false;                // addParam result
   bool dxl_getdata_result = false;                 // GetParam result
 
-  // Set parameter
-  dxl_addparam_result = groupSyncReadEncoder_->addParam(left_wheel_id_);
-  if (dxl_addparam_result != true)
-    return false;
-
-  dxl_addparam_result = groupSyncReadEncoder_->addParam(right_wheel_id_);
-  if (dxl_addparam_result != true)
-    return false;
-
   // Syncread present position
   dxl_comm_result = groupSyncReadEncoder_->txRxPacket();
   if (dxl_comm_result != COMM_SUCCESS)
@@ -152,16 +153,16 @@ bool Turtlebot3MotorDriver::readEncoder(int32_t &left_value, int32_t &right_valu
   left_value  = groupSyncReadEncoder_->getData(left_wheel_id_,  ADDR_X_PRESENT_POSITION, LEN_X_PRESENT_POSITION);
   right_value = groupSyncReadEncoder_->getData(right_wheel_id_, ADDR_X_PRESENT_POSITION, LEN_X_PRESENT_POSITION);
 
-  groupSyncReadEncoder_->clearParam();
   return true;
 }
 
-bool Turtlebot3MotorDriver::writeVelocity(int64_t left_value, int64_t right_value)
+bool Turtlebot3MotorDriver::writeVelocity(int32_t left_value, int32_t right_value)
 {
-  bool dxl_addparam_result;
+  bool dxl_changeparam_result;
   int8_t dxl_comm_result;
 
-  int64_t value[2] = {left_value, right_value};
+  uint8_t id[2] = {left_wheel_id_, right_wheel_id_};
+  int32_t value[2] = {left_value, right_value};
   uint8_t data_byte[4] = {0, };
 
   for (uint8_t index = 0; index < 2; index++)
@@ -171,8 +172,8 @@ bool Turtlebot3MotorDriver::writeVelocity(int64_t left_value, int64_t right_valu
     data_byte[2] = DXL_LOBYTE(DXL_HIWORD(value[index]));
     data_byte[3] = DXL_HIBYTE(DXL_HIWORD(value[index]));
 
-    dxl_addparam_result = groupSyncWriteVelocity_->addParam(index+1, (uint8_t*)&data_byte);
-    if (dxl_addparam_result != true)
+    dxl_changeparam_result = groupSyncWriteVelocity_->changeParam(id[index], (uint8_t*)&data_byte);
+    if (dxl_changeparam_result != true)
       return false;
   }
 
@@ -183,7 +184,6 @@ bool Turtlebot3MotorDriver::writeVelocity(int64_t left_value, int64_t right_valu
     return false;
   }
 
-  groupSyncWriteVelocity_->clearParam();
   return true;
 }
 
@@ -196,13 +196,15 @@ bool Turtlebot3MotorDriver::controlMotor(const float wheel_separation, float* va
   float lin_vel = value[LEFT];
   float ang_vel = value[RIGHT];
 
-  wheel_velocity_cmd[LEFT]   = lin_vel - (ang_vel * wheel_separation / 2);
-  wheel_velocity_cmd[RIGHT]  = lin_vel + (ang_vel * wheel_separation / 2);
+  float max_velocity = (float)dynamixel_limit_max_velocity_;
+
+  wheel_velocity_cmd[LEFT]   = lin_vel - (ang_vel * wheel_separation * 0.5f);
+  wheel_velocity_cmd[RIGHT]  = lin_vel + (ang_vel * wheel_separation * 0.5f);
 
-  wheel_velocity_cmd[LEFT]  = constrain(wheel_velocity_cmd[LEFT]  * VELOCITY_CONSTANT_VALUE, -dynamixel_limit_max_velocity_, dynamixel_limit_max_velocity_);
-  wheel_velocity_cmd[RIGHT] = constrain(wheel_velocity_cmd[RIGHT] * VELOCITY_CONSTANT_VALUE, -dynamixel_limit_max_velocity_, dynamixel_limit_max_velocity_);
+  wheel_velocity_cmd[LEFT]  = constrain(wheel_velocity_cmd[LEFT]  * (float)VELOCITY_CONSTANT_VALUE, -max_velocity, max_velocity);
+  wheel_velocity_cmd[RIGHT] = constrain(wheel_velocity_cmd[RIGHT] * (float)VELOCITY_CONSTANT_VALUE, -max_velocity, max_velocity);
 
-  dxl_comm_result = writeVelocity((int64_t)wheel_velocity_cmd[LEFT], (int64_t)wheel_velocity_cmd[RIGHT]);
+  dxl_comm_result = writeVelocity((int32_t)wheel_velocity_cmd[LEFT], (int32_t)wheel_velocity_cmd[RIGHT]);
   if (dxl_comm_result == false)
     return false;
 
@@ -0,0 +1,307 @@
+/*******************************************************************************
+* Copyright 2016 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/* Authors: Yoonseok Pyo, Leon Jung, Darby Lim, HanCheol Cho, Gilbert */
+
+#include "../../include/turtlebot3/turtlebot3_scheduler.h"
+
+Turtlebot3Scheduler* Turtlebot3Scheduler::instance_ = NULL;
+IRQn_Type Turtlebot3Scheduler::timer_irq_ = TIM4_IRQn;
+
+// The interrupt of each HardwareTimer channel, see drv_timer.c
+static const IRQn_Type timer_channel_irq[] = {TIM4_IRQn, TIM1_UP_TIM10_IRQn, TIM8_UP_TIM13_IRQn, TIM8_TRG_COM_TIM14_IRQn};
+
+Turtlebot3Scheduler::Turtlebot3Scheduler()
+: timer_(NULL),
+  tick_period_(SCHEDULER_TICK_PERIOD),
+  is_started_(false),
+  task_num_(0)
+{
+}
+
+Turtlebot3Scheduler::~Turtlebot3Scheduler()
+{
+  stop();
+}
+
+bool Turtlebot3Scheduler::init(uint8_t timer_channel, uint32_t tick_period)
+{
+  if (instance_ != NULL && instance_ != this)
+    return false;
+  if (timer_channel >= sizeof(timer_channel_irq) / sizeof(timer_channel_irq[0]))
+    return false;
+
+  instance_    = this;
+  timer_irq_   = timer_channel_irq[timer_channel];
+  timer_       = new HardwareTimer(timer_channel);
+  tick_period_ = tick_period;
+  task_num_    = 0;
+
+  return true;
+}
+
+bool Turtlebot3Scheduler::addTask(const char* name, SchedulerFunc func, uint32_t frequency, uint8_t priority, uint8_t context)
+{
+  if (task_num_ >= SCHEDULER_TASK_MAX || is_started_ == true || frequency == 0)
+    return false;
+
+  // Keep the table sorted by priority so both dispatchers only have to scan it in order
+  uint8_t index = task_num_;
+  while (index > 0 && task_[index - 1].priority > priority)
+  {
+    task_[index] = task_[index - 1];
+    index--;
+  }
+
+  SchedulerTask* task = &task_[index];
+
+  task->name     = name;
+  task->func     = func;
+  task->period   = 1000000 / frequency;
+  task->priority = priority;
+  task->context  = context;
+
+  task->released     = false;
+  task->release_time = 0;
+  task->next_release = 0;
+
+  task_num_++;
+  clearStatistics();
+
+  return true;
+}
+
+void Turtlebot3Scheduler::start(void)
+{
+  if (timer_ == NULL || is_started_ == true)
+    return;
+
+  uint32_t now = micros();
+
+  for (uint8_t index = 0; index < task_num_; index++)
+  {
+    task_[index].released     = false;
+    task_[index].next_release = now;
+  }
+
+  is_started_ = true;
+
+  timer_->pause();
+  timer_->setPeriod(tick_period_);
+  timer_->attachInterrupt(timerHandler);
+  timer_->refresh();
+  timer_->resume();
+}
+
+void Turtlebot3Scheduler::stop(void)
+{
+  if (timer_ == NULL || is_started_ == false)
+    return;
+
+  timer_->pause();
+  timer_->detachInterrupt();
+
+  is_started_ = false;
+}
+
+void Turtlebot3Scheduler::tick(void)
+{
+  uint32_t now = micros();
+
+  for (uint8_t index = 0; index < task_num_; index++)
+  {
+    SchedulerTask* task = &task_[index];
+
+    if ((int32_t)(now - task->next_release) < 0)
+      continue;
+
+    // The last job never started, so it is dropped in favour of this one
+    if (task->released == true)
+      task->deadline_miss++;
+
+    task->release_time  = task->next_release;
+    task->released      = true;
+    task->next_release += task->period;
+
+    // Ticks held off for longer than a period are not made up with a burst of releases
+    while ((int32_t)(now - task->next_release) >= 0)
+    {
+      task->next_release += task->period;
+      task->deadline_miss++;
+    }
+  }
+
+  for (uint8_t index = 0; index < task_num_; index++)
+  {
+    SchedulerTask* task = &task_[index];
+
+    if (task->context == SCHEDULER_CONTEXT_TIMER && task->released == true)
+    {
+      task->released = false;
+      runTask(task, task->release_time);
+    }
+  }
+}
+
+void Turtlebot3Scheduler::run(void)
+{
+  uint32_t done = 0;
+  uint8_t index = 0;
+
+  // Every released task runs once per call, highest priority first.
+  // The scan restarts after each run because the timer may have released a more urgent one meanwhile.
+  while (index < task_num_)
+  {
+    SchedulerTask* task = &task_[index];
+
+    if (task->context == SCHEDULER_CONTEXT_LOOP && task->released == true && (done & (1 << index)) == 0)
+    {
+      uint32_t state = lock();
+      uint32_t release_time = task->release_time;
+      task->released = false;
+      unlock(state);
+
+      runTask(task, release_time);
+
+      done |= (1 << index);
+      index = 0;
+    }
+    else
+    {
+      index++;
+    }
+  }
+}
+
+void Turtlebot3Scheduler::runTask(SchedulerTask* task, uint32_t release_time)
+{
+  uint32_t start_time = micros();
+  task->func();
+  uint32_t end_time = micros();
+
+  // Wall time, so a loop task also counts the timer tasks that preempted it
+  uint32_t execution_time = end_time - start_time;
+  uint8_t  bucket = 0;
+
+  while (bucket < SCHEDULER_HISTOGRAM_SIZE - 1 && execution_time >= getHistogramBound(bucket))
+    bucket++;
+
+  task->run_count++;
+  task->histogram[bucket]++;
+
+  if (execution_time > task->max_execution_time)
+    task->max_execution_time = execution_time;
+
+  if (end_time - release_time > task->period)
+  {
+    if (task->context == SCHEDULER_CONTEXT_LOOP)
+    {
+      uint32_t state = lock();
+      task->deadline_miss++;
+      unlock(state);
+    }
+    else
+    {
+      task->deadline_miss++;
+    }
+  }
+}
+
+uint8_t Turtlebot3Scheduler::getTaskNum(void)
+{
+  return task_num_;
+}
+
+SchedulerTask* Turtlebot3Scheduler::getTask(uint8_t index)
+{
+  if (index >= task_num_)
+    return NULL;
+
+  return &task_[index];
+}
+
+void Turtlebot3Scheduler::clearStatistics(void)
+{
+  uint32_t state = lock();
+  for (uint8_t index = 0; index < task_num_; index++)
+  {
+    task_[index].run_count          = 0;
+    task_[index].deadline_miss      = 0;
+    task_[index].max_execution_time = 0;
+
+    for (uint8_t bucket = 0; bucket < SCHEDULER_HISTOGRAM_SIZE; bucket++)
+      task_[index].histogram[bucket] = 0;
+  }
+  unlock(state);
+}
+
+void Turtlebot3Scheduler::printStatistics(Print& out)
+{
+  out.print("task : period[us] run miss max[us] |");
+  for (uint8_t bucket = 0; bucket < SCHEDULER_HISTOGRAM_SIZE - 1; bucket++)
+  {
+    out.print(" <");
+    out.print(getHistogramBound(bucket));
+  }
+  out.println(" more");
+
+  for (uint8_t index = 0; index < task_num_; index++)
+  {
+    SchedulerTask* task = &task_[index];
+
+    out.print(task->name);
+    out.print(task->context == SCHEDULER_CONTEXT_TIMER ? "(timer) : " : " : ");
+    out.print(task->period);             out.print(" ");
+    out.print(task->run_count);          out.print(" ");
+    out.print(task->deadline_miss);      out.print(" ");
+    out.print(task->max_execution_time); out.print(" |");
+
+    for (uint8_t bucket = 0; bucket < SCHEDULER_HISTOGRAM_SIZE; bucket++)
+    {
+      out.print(" ");
+      out.print(task->histogram[bucket]);
+    }
+    out.println();
+  }
+}
+
+uint32_t Turtlebot3Scheduler::getHistogramBound(uint8_t bucket)
+{
+  return (uint32_t)32 << bucket;
+}
+
+uint32_t Turtlebot3Scheduler::lock(void)
+{
+  uint32_t state = __get_BASEPRI();
+
+  // The priority is read each time, the timer sets it up when it is first started.
+  // Only raises BASEPRI, so a lock inside a lock or inside a higher interrupt keeps the stronger mask.
+  __set_BASEPRI_MAX(NVIC_GetPriority(timer_irq_) << (8 - __NVIC_PRIO_BITS));
+  __ISB();
+
+  return state;
+}
+
+void Turtlebot3Scheduler::unlock(uint32_t state)
+{
+  __set_BASEPRI(state);
+}
+
+void Turtlebot3Scheduler::timerHandler(void)
+{
+  if (instance_ != NULL)
+    instance_->tick();
+}
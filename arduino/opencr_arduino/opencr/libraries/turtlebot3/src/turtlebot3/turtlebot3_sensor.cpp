@@ -44,7 +44,7 @@ bool Turtlebot3Sensor::init(void)
   battery_state_msg_.design_capacity = NAN;
   battery_state_msg_.percentage      = NAN;
 
-  get_error_code = imu_.begin();
+  get_error_code = imu_.begin(1000, IMU_MODE_FIFO);
 
   if (get_error_code != 0x00)
     DEBUG_SERIAL.println("Failed to init Sensor");
@@ -56,7 +56,7 @@ bool Turtlebot3Sensor::init(void)
 
 void Turtlebot3Sensor::initIMU(void)
 {
-  imu_.begin();
+  imu_.begin(1000, IMU_MODE_FIFO);
 }
 
 void Turtlebot3Sensor::updateIMU(void)
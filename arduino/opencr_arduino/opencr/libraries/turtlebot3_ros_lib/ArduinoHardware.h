@@ -57,6 +57,7 @@
 #else
   #include <HardwareSerial.h>  // Arduino AVR
   #define SERIAL_CLASS USBSerial // USBSerial / UARTClass (Bluetooth Device) on OpenCR
+  #define ROSSERIAL_ZERO_COPY_WRITE
 #endif
 
 class ArduinoHardware {
@@ -123,6 +124,14 @@ class ArduinoHardware {
       #endif
     }
 
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+    // A frame is serialized straight into the USB tx buffer and sent as soon as it is committed.
+    // reserveWrite() returns NULL instead of waiting when the buffer is full.
+    uint8_t* reserveWrite(int length){return iostream->reserveWrite(length);}
+    void commitWrite(int length){iostream->commitWrite(length);}
+    int availableForWrite(){return iostream->availableForWrite();}
+#endif
+
     unsigned long time(){return millis();}
 
   protected:
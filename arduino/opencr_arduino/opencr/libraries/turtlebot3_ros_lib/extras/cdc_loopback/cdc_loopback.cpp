@@ -0,0 +1,363 @@
+/*
+ *  cdc_loopback.cpp
+ *
+ *  host loopback of rosserial publishing over the OpenCR USB CDC
+ */
+
+// End to end publish latency and throughput from NodeHandle_::publish() to the bytes the host receives.
+// The real NodeHandle_ and message serialization of this library write into the real usbd_cdc_interface.c
+// of the OpenCR variant, whose IN endpoint is the model of usb_fs_model.c (19 x 64 byte packets per 1 ms frame).
+// The host side parses the byte stream as rosserial frames and checks every frame byte for byte against
+// the frame serialized at publish time. Latency is from the publish to the last byte of the frame at the host.
+//
+//   topics    : the turtlebot3_core topic mix at its rates and priorities, published per loop in one batch
+//   saturate  : joint_states of random length as fast as the loop runs
+//
+// cdc_loopback is built with ROSSERIAL_ZERO_COPY_WRITE (the frames are serialized in the USB tx ring),
+// cdc_loopback_baseline without it and with usbd_cdc_interface.c before the zero copy path, taken from git.
+// There write() spins like vcp_write() until the ring takes the whole frame or 100 ms passed.
+//
+// usage: cdc_loopback [seconds [saturate]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "ros/node_handle.h"
+#include "geometry_msgs/Twist.h"
+#include "nav_msgs/Odometry.h"
+#include "sensor_msgs/BatteryState.h"
+#include "sensor_msgs/Imu.h"
+#include "sensor_msgs/JointState.h"
+#include "sensor_msgs/MagneticField.h"
+#include "tf/tfMessage.h"
+#include "turtlebot3_msgs/SensorState.h"
+
+#include "usb_fs_model.h"
+
+#define VCP_WRITE_TIMEOUT_USEC    100000.0
+#define FRAME_OVERHEAD            8
+
+static double now_usec = 0.0;
+static std::vector<uint8_t> host_stream;
+static std::vector<double>  host_time;
+
+static double   blocked_usec     = 0.0;   // the loop spinning in write()
+static double   max_blocked_usec = 0.0;
+static uint32_t write_timeout    = 0;
+
+// one packet slot of the USB bus
+static void runBus()
+{
+  uint8_t packet[64];
+  uint32_t length = usb_model_step(packet);
+
+  for (uint32_t i = 0; i < length; i++)
+  {
+    host_stream.push_back(packet[i]);
+    host_time.push_back(now_usec);
+  }
+  now_usec += USB_MODEL_SLOT_USEC;
+}
+
+class LoopbackHardware
+{
+ public:
+  void init() {}
+  int  read() { return -1; }
+  unsigned long time() { return (unsigned long)(now_usec / 1000.0); }
+
+  // vcp_write(): the USB interrupt keeps draining the ring while the loop spins here
+  void write(uint8_t *data, int length)
+  {
+    double start_usec = now_usec;
+
+    while (true)
+    {
+      int32_t ret = CDC_Itf_Write(data, length);
+
+      if (ret < 0 || ret == length)
+        break;
+      if (now_usec - start_usec > VCP_WRITE_TIMEOUT_USEC)
+      {
+        write_timeout++;
+        break;
+      }
+      runBus();
+    }
+
+    blocked_usec += now_usec - start_usec;
+    max_blocked_usec = std::max(max_blocked_usec, now_usec - start_usec);
+  }
+
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+  uint8_t *reserveWrite(int length) { return CDC_Itf_TxReserve(length); }
+  void commitWrite(int length)      { CDC_Itf_TxCommit(length); }
+  int  availableForWrite()          { return CDC_Itf_TxAvailable(); }
+#endif
+};
+
+class LoopbackNodeHandle : public ros::NodeHandle_<LoopbackHardware, 25, 25, 1024, 1024>
+{
+ public:
+  // the host never negotiates the topics here
+  void setConfigured() { configured_ = true; }
+};
+
+struct Topic
+{
+  ros::Publisher *publisher;
+  double period_usec;
+  double next_usec;
+};
+
+struct Frame
+{
+  double publish_usec;
+  std::vector<uint8_t> data;
+};
+
+static LoopbackNodeHandle nh;
+static std::map<int, std::deque<Frame> > expected_frame;   // per topic id, in publish order
+static uint32_t published_num = 0;
+static uint32_t seq = 0;
+
+sensor_msgs::Imu           imu_msg;
+sensor_msgs::MagneticField mag_msg;
+turtlebot3_msgs::SensorState sensor_state_msg;
+sensor_msgs::BatteryState  battery_state_msg;
+nav_msgs::Odometry         odom_msg;
+tf::tfMessage              tf_msg;
+geometry_msgs::TransformStamped odom_tf;
+sensor_msgs::JointState    joint_states_msg;
+geometry_msgs::Twist       cmd_vel_msg;
+
+ros::Publisher imu_pub("imu", &imu_msg);
+ros::Publisher mag_pub("magnetic_field", &mag_msg);
+ros::Publisher sensor_state_pub("sensor_state", &sensor_state_msg);
+ros::Publisher battery_state_pub("battery_state", &battery_state_msg);
+ros::Publisher odom_pub("odom", &odom_msg);
+ros::Publisher tf_pub("tf", &tf_msg);
+ros::Publisher joint_states_pub("joint_states", &joint_states_msg);
+ros::Publisher cmd_vel_pub("cmd_vel_rc100", &cmd_vel_msg);
+
+static char joint_name_buffer[64][16];
+static char *joint_name[64];
+static float joint_value[3][64];
+
+static void initMessages()
+{
+  imu_msg.header.frame_id = "imu_link";
+  mag_msg.header.frame_id = "mag_link";
+  odom_msg.header.frame_id = "odom";
+  odom_msg.child_frame_id  = "base_footprint";
+  odom_tf.header.frame_id  = "odom";
+  odom_tf.child_frame_id   = "base_footprint";
+  tf_msg.transforms_length = 1;
+  tf_msg.transforms        = &odom_tf;
+
+  for (int i = 0; i < 64; i++)
+  {
+    snprintf(joint_name_buffer[i], sizeof(joint_name_buffer[i]), "wheel_%d_joint", i);
+    joint_name[i] = joint_name_buffer[i];
+  }
+  joint_states_msg.header.frame_id = "base_link";
+  joint_states_msg.name     = joint_name;
+  joint_states_msg.position = joint_value[0];
+  joint_states_msg.velocity = joint_value[1];
+  joint_states_msg.effort   = joint_value[2];
+  joint_states_msg.name_length = joint_states_msg.position_length = 2;
+  joint_states_msg.velocity_length = joint_states_msg.effort_length = 2;
+}
+
+// a new sample, so no two frames of a topic are alike; the other messages may still wait in the batch
+static void updateMessage(ros::Publisher *publisher)
+{
+  seq++;
+  if (publisher == &imu_pub)                imu_msg.header.seq = seq;
+  else if (publisher == &mag_pub)           mag_msg.header.seq = seq;
+  else if (publisher == &sensor_state_pub)  sensor_state_msg.header.seq = seq;
+  else if (publisher == &battery_state_pub) battery_state_msg.header.seq = seq;
+  else if (publisher == &odom_pub)          odom_msg.header.seq = seq;
+  else if (publisher == &tf_pub)            odom_tf.header.seq = seq;
+  else if (publisher == &joint_states_pub)  joint_states_msg.header.seq = seq;
+  else                                      cmd_vel_msg.linear.x = (float)seq;
+}
+
+// the frame the host must receive for this sample
+static void expectFrame(ros::Publisher *publisher, double publish_usec)
+{
+  static uint8_t buffer[2048];
+  Frame frame;
+
+  frame.publish_usec = publish_usec;
+  int length = nh.serializeFrame(buffer, publisher->id_, publisher->msg_);
+  frame.data.assign(buffer, buffer + length);
+  expected_frame[publisher->id_].push_back(frame);
+  published_num++;
+}
+
+int main(int argc, char *argv[])
+{
+  double duration_usec = ((argc > 1) ? atof(argv[1]) : 10.0) * 1e6;
+  bool saturate = (argc > 2) ? (atoi(argv[2]) != 0) : false;
+
+  Topic topic[] =
+  {
+    // period, as turtlebot3_core releases them
+    {&imu_pub,           1e6 / 200, 0.0},
+    {&mag_pub,           1e6 / 200, 0.0},
+    {&odom_pub,          1e6 / 30,  0.0},
+    {&tf_pub,            1e6 / 30,  0.0},
+    {&joint_states_pub,  1e6 / 30,  0.0},
+    {&sensor_state_pub,  1e6 / 30,  0.0},
+    {&battery_state_pub, 1e6 / 30,  0.0},
+    {&cmd_vel_pub,       1e6 / 30,  0.0},
+  };
+  const int topic_num = sizeof(topic) / sizeof(topic[0]);
+
+  usb_model_open();
+  nh.initNode();
+  for (int i = 0; i < topic_num; i++)
+    nh.advertise(*topic[i].publisher);
+  nh.setConfigured();
+  initMessages();
+
+  // priorities of turtlebot3_core
+  odom_pub.setPriority(0);
+  tf_pub.setPriority(0);
+  joint_states_pub.setPriority(0);
+  imu_pub.setPriority(1);
+  sensor_state_pub.setPriority(1);
+  cmd_vel_pub.setPriority(1);
+  battery_state_pub.setPriority(2);
+  mag_pub.setPriority(2);
+
+  srand(1);
+  while (now_usec < duration_usec)
+  {
+    std::vector<ros::Publisher *> released;
+
+    // the loop runs once per packet slot
+    runBus();
+
+    if (saturate)
+    {
+      int joint_num = 1 + rand() % 20;   // frames of 90 to 880 bytes, below OUTPUT_SIZE
+      joint_states_msg.name_length = joint_states_msg.position_length = joint_num;
+      joint_states_msg.velocity_length = joint_states_msg.effort_length = joint_num;
+      released.push_back(&joint_states_pub);
+    }
+    else
+    {
+      for (int i = 0; i < topic_num; i++)
+      {
+        if (now_usec >= topic[i].next_usec)
+        {
+          topic[i].next_usec += topic[i].period_usec;
+          released.push_back(topic[i].publisher);
+        }
+      }
+    }
+
+    if (released.empty())
+      continue;
+
+    double publish_usec = now_usec;
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+    nh.beginBatch();
+#endif
+    for (size_t i = 0; i < released.size(); i++)
+    {
+      updateMessage(released[i]);
+      expectFrame(released[i], publish_usec);
+      released[i]->publish(released[i]->msg_);
+    }
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+    nh.flushBatch();
+#endif
+  }
+
+  // let the ring drain
+  for (int i = 0; i < 200 * USB_MODEL_SLOT_NUM; i++)
+    runBus();
+
+  // the host: parse the stream and match every frame against the samples of its topic
+  std::vector<double> latency;
+  size_t offset = 0;
+  uint32_t skipped = 0;
+
+  while (offset + FRAME_OVERHEAD <= host_stream.size())
+  {
+    const uint8_t *p = &host_stream[offset];
+    if (p[0] != 0xff || p[1] != ros::PROTOCOL_VER || p[4] != (uint8_t)(255 - ((p[2] + p[3]) % 256)))
+    {
+      printf("stream corrupt at byte %zu: no frame header\n", offset);
+      return 1;
+    }
+
+    size_t length = (size_t)p[2] + ((size_t)p[3] << 8) + FRAME_OVERHEAD;
+    int id = p[5] + (p[6] << 8);
+    if (offset + length > host_stream.size())
+    {
+      printf("stream ends inside a frame\n");
+      return 1;
+    }
+
+    std::deque<Frame> &frames = expected_frame[id];
+    while (frames.empty() == false &&
+           (frames.front().data.size() != length || memcmp(frames.front().data.data(), p, length) != 0))
+    {
+      frames.pop_front();   // throttled, dropped or replaced before it was written
+      skipped++;
+    }
+    if (frames.empty())
+    {
+      printf("frame of topic %d at byte %zu matches no published sample\n", id, offset);
+      return 1;
+    }
+
+    latency.push_back(host_time[offset + length - 1] - frames.front().publish_usec);
+    frames.pop_front();
+    offset += length;
+  }
+
+  if (latency.empty())
+  {
+    printf("no frame reached the host\n");
+    return 1;
+  }
+
+  std::vector<double> sorted = latency;
+  std::sort(sorted.begin(), sorted.end());
+  double latency_sum = 0.0;
+  for (size_t i = 0; i < latency.size(); i++)
+    latency_sum += latency[i];
+
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+  ros::PublishStats stats = nh.getPublishStats();
+  const char *build = "zero copy, batched";
+#else
+  const char *build = "baseline, vcp_write";
+#endif
+
+  printf("%s, %s, %.0f s\n", build, saturate ? "saturate" : "turtlebot3_core topics", duration_usec / 1e6);
+  printf("  frames     : %u published, %zu delivered intact, %u not sent\n",
+         published_num, latency.size(), published_num - (uint32_t)latency.size());
+  printf("  throughput : %.1f KB/s\n", host_stream.size() / (duration_usec / 1e6) / 1024.0);
+  printf("  latency    : mean %.0f us, p99 %.0f us, max %.0f us\n",
+         latency_sum / latency.size(), sorted[(size_t)(sorted.size() * 0.99)], sorted.back());
+  printf("  loop       : %.1f ms blocked in write(), longest %.0f us, %u writes timed out\n",
+         blocked_usec / 1000.0, max_blocked_usec, write_timeout);
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+  printf("  batching   : %u writes, %u throttled, %u dropped, %u stale\n",
+         stats.writes, stats.throttled, stats.dropped, stats.stale);
+#endif
+  (void)skipped;
+
+  return 0;
+}
@@ -0,0 +1,13 @@
+/* host stand-in for the STM32 HAL, only what the USB CDC headers use */
+#ifndef STM32F7XX_HAL_H
+#define STM32F7XX_HAL_H
+
+#include <stdint.h>
+
+#define __IO      volatile
+#define UNUSED(x) ((void)(x))
+
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ *  usb_fs_model.c
+ *
+ *  host model of the USB full speed IN endpoint
+ */
+
+/* Model of the USB full speed IN endpoint under usbd_cdc_interface.c:
+   the class functions the interface calls, and one 64 byte packet slot per usb_model_step().
+   A 1 ms frame has USB_MODEL_SLOT_NUM slots and starts with the SOF interrupt. */
+
+#include "usbd_cdc_interface.h"
+#include "usb_fs_model.h"
+
+USBD_HandleTypeDef USBD_Device;
+
+extern USBD_CDC_ItfTypeDef USBD_CDC_fops;
+void CDC_Itf_SofISR(void);
+
+static USBD_CDC_HandleTypeDef cdc_handle;
+static uint8_t  *xfer_buf;
+static uint32_t  xfer_length;
+static uint32_t  xfer_sent;
+static uint32_t  slot_index;
+
+
+uint8_t USBD_CDC_SetTxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff, uint16_t length)
+{
+  (void)pdev;
+  cdc_handle.TxBuffer = pbuff;
+  cdc_handle.TxLength = length;
+  return USBD_OK;
+}
+
+uint8_t USBD_CDC_SetRxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff)
+{
+  (void)pdev;
+  cdc_handle.RxBuffer = pbuff;
+  return USBD_OK;
+}
+
+uint8_t USBD_CDC_ReceivePacket(USBD_HandleTypeDef *pdev)
+{
+  (void)pdev;
+  return USBD_OK;
+}
+
+uint8_t USBD_CDC_TransmitPacket(USBD_HandleTypeDef *pdev)
+{
+  (void)pdev;
+  if (cdc_handle.TxState != 0)
+  {
+    return USBD_BUSY;
+  }
+
+  cdc_handle.TxState = 1;
+  xfer_buf    = cdc_handle.TxBuffer;
+  xfer_length = cdc_handle.TxLength;
+  xfer_sent   = 0;
+
+  return USBD_OK;
+}
+
+void usb_model_open(void)
+{
+  USBD_SetupReqTypedef req = {0};
+
+  USBD_Device.pClassData = &cdc_handle;
+  USBD_Device.dev_state  = USBD_STATE_CONFIGURED;
+  USBD_Device.dev_config = 1;
+  slot_index = 0;
+
+  USBD_CDC_fops.Init();
+
+  req.wValue = 0x01;  /* DTR, the host opened the port */
+  USBD_CDC_fops.Control(CDC_SET_CONTROL_LINE_STATE, (uint8_t *)&req, 0);
+}
+
+uint32_t usb_model_step(uint8_t *p_data)
+{
+  uint32_t length = 0;
+
+  if (slot_index == 0)
+  {
+    CDC_Itf_SofISR();
+  }
+
+  if (cdc_handle.TxState != 0)
+  {
+    length = xfer_length - xfer_sent;
+    if (length > CDC_DATA_FS_MAX_PACKET_SIZE)
+    {
+      length = CDC_DATA_FS_MAX_PACKET_SIZE;
+    }
+    memcpy(p_data, &xfer_buf[xfer_sent], length);
+    xfer_sent += length;
+
+    /* a short packet ends the transfer, like USBD_CDC_DataIn() */
+    if (xfer_sent >= xfer_length)
+    {
+      cdc_handle.TxState = 0;
+      if (USBD_CDC_fops.TransmitCplt != NULL)
+      {
+        USBD_CDC_fops.TransmitCplt(cdc_handle.TxBuffer, &cdc_handle.TxLength, CDC_IN_EP);
+      }
+    }
+  }
+
+  slot_index++;
+  if (slot_index == USB_MODEL_SLOT_NUM)
+  {
+    slot_index = 0;
+  }
+
+  return length;
+}
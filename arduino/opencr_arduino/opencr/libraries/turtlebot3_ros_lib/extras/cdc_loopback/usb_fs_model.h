@@ -0,0 +1,32 @@
+/*
+ *  usb_fs_model.h
+ *
+ *  host model of the USB full speed IN endpoint, see usb_fs_model.c
+ */
+
+#ifndef USB_FS_MODEL_H
+#define USB_FS_MODEL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define USB_MODEL_SLOT_NUM      19    /* 64 byte bulk packets in a 1 ms frame, next to the other traffic */
+#define USB_MODEL_SLOT_USEC     (1000.0 / USB_MODEL_SLOT_NUM)
+
+void     usb_model_open(void);
+uint32_t usb_model_step(uint8_t *p_data);   /* one packet slot, returns the bytes the host got */
+
+/* the interface of usbd_cdc_interface.c the harness uses, without its headers */
+int32_t  CDC_Itf_Write( uint8_t *p_buf, uint32_t length );
+uint32_t CDC_Itf_TxAvailable( void );
+uint8_t *CDC_Itf_TxReserve( uint32_t length );
+void     CDC_Itf_TxCommit( uint32_t length );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
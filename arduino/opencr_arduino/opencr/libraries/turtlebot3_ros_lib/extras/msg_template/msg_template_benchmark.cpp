@@ -0,0 +1,221 @@
+/*
+ *  msg_template_benchmark.cpp
+ *
+ *  host benchmark of ros::MsgTemplate against the generated serialize()
+ */
+
+// Bytes and time per publish of the turtlebot3_core messages, serialized by the generated serialize()
+// and by their ros::MsgTemplate. Every sample is serialized both ways first and the outputs must be
+// byte identical, including the samples that rebuild the template:
+//   Imu         : tf_prefix rewrites the frame id in place
+//   Odometry    : child_frame_id points to another string
+//   JointState  : the position array moves, then one joint less is published
+//   tfMessage   : the frame id gets longer
+// The dynamic fields take random values, with negative zero, denormals, infinities and NaN among them.
+// The cycles on the Cortex-M7 are measured by the turtlebot3_setup/turtlebot3_msg_template_benchmark sketch.
+//
+// usage: msg_template_benchmark [samples [publishes]]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ros/msg_template.h"
+
+static unsigned char generated_buffer[1024];
+static unsigned char template_buffer[1024];
+
+static char imu_frame_id[32]   = "imu_link";
+static char odom_frame_id[32]  = "odom";
+static char child_frame_id[32] = "base_footprint";
+static char base_frame_id[32]  = "base_link";
+
+static char *joint_name[2] = {(char *)"wheel_left_joint", (char *)"wheel_right_joint"};
+static float joint_position[2], joint_velocity[2], joint_effort[2], joint_moved_position[2];
+
+static double getNsec()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// mostly ordinary values, sometimes the ones serializeAvrFloat64() treats specially
+static float getValue()
+{
+  switch (rand() % 16)
+  {
+    case 0:  return -0.0f;
+    case 1:  return 1e-40f;
+    case 2:  return -1e-40f;
+    case 3:  return INFINITY;
+    case 4:  return NAN;
+    default: return ((float)rand() / (float)RAND_MAX - 0.5f) * 20.0f;
+  }
+}
+
+static void updateImu(sensor_msgs::Imu &msg, int sample)
+{
+  msg.header.seq        = sample;
+  msg.header.stamp.sec  = sample / 100;
+  msg.header.stamp.nsec = rand();
+  msg.orientation.x = getValue();
+  msg.orientation.y = getValue();
+  msg.orientation.z = getValue();
+  msg.orientation.w = getValue();
+  msg.angular_velocity.x = getValue();
+  msg.angular_velocity.z = getValue();
+  msg.linear_acceleration.y = getValue();
+  msg.linear_acceleration.z = getValue();
+
+  if (sample == 1000)
+    strcpy(imu_frame_id, "tb3_0/imu_link");
+}
+
+static void updateOdometry(nav_msgs::Odometry &msg, int sample)
+{
+  msg.header.seq        = sample;
+  msg.header.stamp.nsec = rand();
+  msg.pose.pose.position.x    = getValue();
+  msg.pose.pose.position.y    = getValue();
+  msg.pose.pose.orientation.z = getValue();
+  msg.pose.pose.orientation.w = getValue();
+  msg.twist.twist.linear.x    = getValue();
+  msg.twist.twist.angular.z   = getValue();
+
+  if (sample == 500)
+    msg.child_frame_id = base_frame_id;
+}
+
+static void updateJointState(sensor_msgs::JointState &msg, int sample)
+{
+  msg.header.stamp.nsec = rand();
+  msg.position[0] = getValue();
+  msg.position[1] = getValue();
+  msg.velocity[0] = getValue();
+  msg.velocity[1] = getValue();
+
+  if (sample == 700)
+    msg.position = joint_moved_position;
+  if (sample == 900)
+    msg.name_length = msg.position_length = msg.velocity_length = msg.effort_length = 1;
+}
+
+static void updateTFMessage(tf::tfMessage &msg, int sample)
+{
+  geometry_msgs::TransformStamped &transform = msg.transforms[0];
+
+  transform.header.stamp.sec = sample;
+  transform.transform.translation.x = getValue();
+  transform.transform.translation.y = getValue();
+  transform.transform.rotation.z    = getValue();
+  transform.transform.rotation.w    = getValue();
+
+  if (sample == 300)
+    strcpy(odom_frame_id, "tb3_0/odom");
+}
+
+// returns the number of samples whose bytes differ, stamp is the field the timed publishes change
+template<class Message, class Template>
+static int runBenchmark(const char *name, Message &msg, Template &msg_template, void (*update)(Message &, int),
+                        uint32_t *stamp, int sample_num, int publish_num)
+{
+  int mismatch = 0;
+
+  srand(1);
+  for (int sample = 0; sample < sample_num; sample++)
+  {
+    update(msg, sample);
+    int generated_length = msg.serialize(generated_buffer);
+    int template_length  = msg_template.serialize(template_buffer);
+
+    if (generated_length != template_length || memcmp(generated_buffer, template_buffer, generated_length) != 0)
+    {
+      if (mismatch == 0)
+        printf("  %s: sample %d differs (%d bytes generated, %d bytes template)\n", name, sample, generated_length, template_length);
+      mismatch++;
+    }
+  }
+
+  // the stamp changes on every publish, as in the core
+  volatile int sink = 0;
+  double start_time = getNsec();
+  for (int publish = 0; publish < publish_num; publish++)
+  {
+    *stamp = publish;
+    sink += msg.serialize(generated_buffer);
+  }
+  double middle_time = getNsec();
+  for (int publish = 0; publish < publish_num; publish++)
+  {
+    *stamp = publish;
+    sink += msg_template.serialize(template_buffer);
+  }
+  double end_time = getNsec();
+
+  double generated_nsec = (middle_time - start_time) / publish_num;
+  double template_nsec  = (end_time - middle_time) / publish_num;
+
+  printf("  %-12s %6d %14.1f %14.1f %8.1fx %10d\n", name, msg.serialize(generated_buffer),
+         generated_nsec, template_nsec, generated_nsec / template_nsec, mismatch);
+
+  return mismatch;
+}
+
+int main(int argc, char *argv[])
+{
+  int sample_num  = (argc > 1) ? atoi(argv[1]) : 2000;
+  int publish_num = (argc > 2) ? atoi(argv[2]) : 2000000;
+  int mismatch = 0;
+
+  // the messages as turtlebot3_core sets them up
+  sensor_msgs::Imu imu_msg;
+  ros::ImuTemplate imu_template(imu_msg);
+  imu_msg.header.frame_id = imu_frame_id;
+  for (int i = 0; i < 9; i++)
+  {
+    imu_msg.orientation_covariance[i]         = (i % 4 == 0) ? 0.0025 : 0.0;
+    imu_msg.angular_velocity_covariance[i]    = (i % 4 == 0) ? 0.02 : 0.0;
+    imu_msg.linear_acceleration_covariance[i] = (i % 4 == 0) ? 0.04 : 0.0;
+  }
+
+  nav_msgs::Odometry odom;
+  ros::OdometryTemplate odom_template(odom);
+  odom.header.frame_id = odom_frame_id;
+  odom.child_frame_id  = child_frame_id;
+
+  sensor_msgs::JointState joint_states;
+  ros::JointStateTemplate joint_states_template(joint_states);
+  joint_states.header.frame_id = base_frame_id;
+  joint_states.name     = joint_name;
+  joint_states.position = joint_position;
+  joint_states.velocity = joint_velocity;
+  joint_states.effort   = joint_effort;
+  joint_states.name_length = joint_states.position_length = joint_states.velocity_length = joint_states.effort_length = 2;
+
+  tf::tfMessage tf_msg;
+  ros::TFMessageTemplate tf_template(tf_msg);
+  geometry_msgs::TransformStamped odom_tf;
+  odom_tf.header.frame_id = odom_frame_id;
+  odom_tf.child_frame_id  = child_frame_id;
+  tf_msg.transforms_length = 1;
+  tf_msg.transforms        = &odom_tf;
+
+  printf("%d samples checked, %d publishes timed\n\n", sample_num, publish_num);
+  printf("  %-12s %6s %14s %14s %9s %10s\n", "message", "bytes", "generated [ns]", "template [ns]", "speedup", "mismatches");
+
+  mismatch += runBenchmark("Imu", imu_msg, imu_template, updateImu, &imu_msg.header.stamp.nsec, sample_num, publish_num);
+  mismatch += runBenchmark("Odometry", odom, odom_template, updateOdometry, &odom.header.stamp.nsec, sample_num, publish_num);
+  mismatch += runBenchmark("JointState", joint_states, joint_states_template, updateJointState, &joint_states.header.stamp.nsec, sample_num, publish_num);
+  mismatch += runBenchmark("tfMessage", tf_msg, tf_template, updateTFMessage, &odom_tf.header.stamp.nsec, sample_num, publish_num);
+
+  if (mismatch > 0)
+  {
+    printf("\nthe templates are not byte identical to serialize()\n");
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,451 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2011, Willow Garage, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of Willow Garage, Inc. nor the names of its
+ *    contributors may be used to endorse or promote prducts derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ROS_MSG_TEMPLATE_H_
+#define _ROS_MSG_TEMPLATE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ros/msg.h"
+#include "std_msgs/Header.h"
+#include "sensor_msgs/Imu.h"
+#include "sensor_msgs/JointState.h"
+#include "nav_msgs/Odometry.h"
+#include "tf/tfMessage.h"
+
+namespace ros
+{
+
+#define MSG_TEMPLATE_PATCH_MAX  24
+#define MSG_TEMPLATE_GUARD_MAX  12
+
+/* A message serialized once into a template buffer.
+ *
+ * Publishing the template instead of the message copies the buffer and
+ * patches only the dynamic fields (stamps, poses, joint values) in place,
+ * so frame ids and covariances are not serialized again on every publish.
+ * The constant parts are checked against the message each time (strings by
+ * content, array lengths by value) and the template is built again when
+ * they changed. Patches are written with word stores, so the wire format
+ * (little endian) must match the CPU, as it does on Cortex-M.
+ */
+class MsgTemplate : public Msg
+{
+public:
+  MsgTemplate(Msg & msg, unsigned char * buffer, int size) :
+    msg_(&msg),
+    buffer_(buffer),
+    size_(size),
+    length_(0),
+    patch_num_(0),
+    guard_num_(0),
+    built_(false)
+  {
+  }
+
+  virtual int serialize(unsigned char *outbuffer) const
+  {
+    if (!built_ || !isCurrent())
+      build();
+
+    if (!built_)
+      return msg_->serialize(outbuffer);
+
+    memcpy(outbuffer, buffer_, length_);
+
+    for (int i = 0; i < patch_num_; i++)
+    {
+      const Patch & patch = patch_[i];
+      unsigned char * out = outbuffer + patch.offset;
+
+      switch (patch.type)
+      {
+        case PATCH_UINT32:
+          memcpy(out, patch.src, 4);
+          break;
+
+        case PATCH_FLOAT64:
+          serializeFloat64(out, *(const float *)patch.src);
+          break;
+
+        case PATCH_FLOAT64_ARRAY:
+        {
+          const float * array = *(float * const *)patch.src;
+          for (int j = 0; j < patch.count; j++)
+            serializeFloat64(out + j * 8, array[j]);
+          break;
+        }
+      }
+    }
+
+    return length_;
+  }
+
+  virtual int deserialize(unsigned char *inbuffer)
+  {
+    built_ = false;
+    return msg_->deserialize(inbuffer);
+  }
+
+  const char * getType(){ return msg_->getType(); };
+  const char * getMD5(){ return msg_->getMD5(); };
+
+  bool isBuilt() const
+  {
+    return built_;
+  }
+
+  int getLength() const
+  {
+    return length_;
+  }
+
+  /* Same bytes as serializeAvrFloat64(), written as two words */
+  static void serializeFloat64(unsigned char * outbuffer, const float f)
+  {
+    uint32_t sig;
+    uint32_t word[2];
+
+    memcpy(&sig, &f, 4);
+
+    uint32_t exp = (sig >> 23) & 255;
+    if (exp != 0)
+    {
+      exp += 1023 - 127;
+    }
+
+    word[0] = sig << 29;
+    word[1] = (exp << 20) | ((sig >> 3) & 0xFFFFF);
+    if (f < 0)
+    {
+      word[1] |= 0x80000000;
+    }
+
+    memcpy(outbuffer, word, 8);
+  }
+
+protected:
+  enum
+  {
+    PATCH_UINT32,
+    PATCH_FLOAT64,
+    PATCH_FLOAT64_ARRAY,   // src is the address of the array pointer, which may move between publishes
+
+    GUARD_VALUE,           // the field must keep the bytes it had when the template was built
+    GUARD_STRING           // the string must keep the content that was serialized at offset
+  };
+
+  struct Patch
+  {
+    uint16_t offset;
+    uint8_t  type;
+    uint8_t  count;
+    const void * src;
+  };
+
+  struct Guard
+  {
+    uint16_t offset;
+    uint8_t  type;
+    uint8_t  size;
+    const void * field;
+    uint8_t  value[8];
+  };
+
+  /* Register the patches and guards of the message and return its serialized length, -1 if it does not fit the tables */
+  virtual int layout() const = 0;
+
+  bool addPatch(int offset, uint8_t type, const void * src, int count = 1) const
+  {
+    if (patch_num_ >= MSG_TEMPLATE_PATCH_MAX || count > 255)
+      return false;
+
+    patch_[patch_num_].offset = offset;
+    patch_[patch_num_].type   = type;
+    patch_[patch_num_].count  = count;
+    patch_[patch_num_].src    = src;
+    patch_num_++;
+    return true;
+  }
+
+  bool addGuard(int offset, uint8_t type, const void * field, int size) const
+  {
+    if (guard_num_ >= MSG_TEMPLATE_GUARD_MAX || size > 8)
+      return false;
+
+    guard_[guard_num_].offset = offset;
+    guard_[guard_num_].type   = type;
+    guard_[guard_num_].size   = size;
+    guard_[guard_num_].field  = field;
+    if (type == GUARD_VALUE)
+      memcpy(guard_[guard_num_].value, field, size);
+    guard_num_++;
+    return true;
+  }
+
+  /* Layout helpers, each returns the offset after the field or -1 */
+  int layoutFloat64(int offset, const float * value) const
+  {
+    if (offset < 0 || !addPatch(offset, PATCH_FLOAT64, value))
+      return -1;
+    return offset + 8;
+  }
+
+  int layoutString(int offset, const char * const * value) const
+  {
+    int length = strlen(*value);
+
+    if (offset < 0 || length > 0xFFFF || !addGuard(offset + 4, GUARD_STRING, value, 0))
+      return -1;
+    guard_[guard_num_ - 1].value[0] = length & 0xFF;
+    guard_[guard_num_ - 1].value[1] = length >> 8;
+    return offset + 4 + length;
+  }
+
+  int layoutHeader(int offset, const std_msgs::Header & header) const
+  {
+    if (offset < 0 ||
+        !addPatch(offset + 0, PATCH_UINT32, &header.seq) ||
+        !addPatch(offset + 4, PATCH_UINT32, &header.stamp.sec) ||
+        !addPatch(offset + 8, PATCH_UINT32, &header.stamp.nsec))
+      return -1;
+    return layoutString(offset + 12, &header.frame_id);
+  }
+
+  int layoutVector3(int offset, const geometry_msgs::Vector3 & vector) const
+  {
+    offset = layoutFloat64(offset, &vector.x);
+    offset = layoutFloat64(offset, &vector.y);
+    return layoutFloat64(offset, &vector.z);
+  }
+
+  int layoutPoint(int offset, const geometry_msgs::Point & point) const
+  {
+    offset = layoutFloat64(offset, &point.x);
+    offset = layoutFloat64(offset, &point.y);
+    return layoutFloat64(offset, &point.z);
+  }
+
+  int layoutQuaternion(int offset, const geometry_msgs::Quaternion & quaternion) const
+  {
+    offset = layoutFloat64(offset, &quaternion.x);
+    offset = layoutFloat64(offset, &quaternion.y);
+    offset = layoutFloat64(offset, &quaternion.z);
+    return layoutFloat64(offset, &quaternion.w);
+  }
+
+  /* A variable length float64[] whose length stays fixed while the template is used */
+  int layoutFloat64Array(int offset, const uint32_t * length, float * const * array) const
+  {
+    if (offset < 0 ||
+        !addGuard(offset, GUARD_VALUE, length, sizeof(*length)) ||
+        (*length > 0 && !addPatch(offset + 4, PATCH_FLOAT64_ARRAY, array, *length)))
+      return -1;
+    return offset + 4 + *length * 8;
+  }
+
+  Msg * msg_;
+
+private:
+  unsigned char * buffer_;
+  int size_;
+
+  mutable int length_;
+  mutable Patch patch_[MSG_TEMPLATE_PATCH_MAX];
+  mutable int patch_num_;
+  mutable Guard guard_[MSG_TEMPLATE_GUARD_MAX];
+  mutable int guard_num_;
+  mutable bool built_;
+
+  bool isCurrent() const
+  {
+    for (int i = 0; i < guard_num_; i++)
+    {
+      const Guard & guard = guard_[i];
+
+      if (guard.type == GUARD_VALUE)
+      {
+        if (memcmp(guard.field, guard.value, guard.size) != 0)
+          return false;
+      }
+      else
+      {
+        const char * string = *(const char * const *)guard.field;
+        uint32_t length = guard.value[0] | (guard.value[1] << 8);
+
+        if (memcmp(string, buffer_ + guard.offset, length) != 0 || string[length] != '\0')
+          return false;
+      }
+    }
+    return true;
+  }
+
+  void build() const
+  {
+    patch_num_ = 0;
+    guard_num_ = 0;
+    built_ = false;
+
+    int length = layout();
+    if (length < 0 || length > size_)
+      return;
+
+    if (msg_->serialize(buffer_) != length)
+      return;
+
+    length_ = length;
+    built_ = true;
+  }
+};
+
+
+/* sensor_msgs/Imu, the covariances are constant */
+class ImuTemplate : public MsgTemplate
+{
+public:
+  ImuTemplate(sensor_msgs::Imu & msg) : MsgTemplate(msg, buffer_storage_, sizeof(buffer_storage_)) {}
+
+protected:
+  virtual int layout() const
+  {
+    const sensor_msgs::Imu & msg = *(const sensor_msgs::Imu *)msg_;
+
+    int offset = layoutHeader(0, msg.header);
+    offset = layoutQuaternion(offset, msg.orientation);
+    offset = (offset < 0) ? -1 : offset + 9 * 8;
+    offset = layoutVector3(offset, msg.angular_velocity);
+    offset = (offset < 0) ? -1 : offset + 9 * 8;
+    offset = layoutVector3(offset, msg.linear_acceleration);
+    offset = (offset < 0) ? -1 : offset + 9 * 8;
+    return offset;
+  }
+
+private:
+  unsigned char buffer_storage_[384];
+};
+
+
+/* nav_msgs/Odometry, the covariances are constant */
+class OdometryTemplate : public MsgTemplate
+{
+public:
+  OdometryTemplate(nav_msgs::Odometry & msg) : MsgTemplate(msg, buffer_storage_, sizeof(buffer_storage_)) {}
+
+protected:
+  virtual int layout() const
+  {
+    const nav_msgs::Odometry & msg = *(const nav_msgs::Odometry *)msg_;
+
+    int offset = layoutHeader(0, msg.header);
+    offset = layoutString(offset, &msg.child_frame_id);
+    offset = layoutPoint(offset, msg.pose.pose.position);
+    offset = layoutQuaternion(offset, msg.pose.pose.orientation);
+    offset = (offset < 0) ? -1 : offset + 36 * 8;
+    offset = layoutVector3(offset, msg.twist.twist.linear);
+    offset = layoutVector3(offset, msg.twist.twist.angular);
+    offset = (offset < 0) ? -1 : offset + 36 * 8;
+    return offset;
+  }
+
+private:
+  unsigned char buffer_storage_[832];
+};
+
+
+/* sensor_msgs/JointState, the joint names and the number of joints are constant */
+class JointStateTemplate : public MsgTemplate
+{
+public:
+  JointStateTemplate(sensor_msgs::JointState & msg) : MsgTemplate(msg, buffer_storage_, sizeof(buffer_storage_)) {}
+
+protected:
+  virtual int layout() const
+  {
+    const sensor_msgs::JointState & msg = *(const sensor_msgs::JointState *)msg_;
+
+    int offset = layoutHeader(0, msg.header);
+    if (offset < 0 ||
+        !addGuard(offset, GUARD_VALUE, &msg.name_length, sizeof(msg.name_length)) ||
+        !addGuard(offset, GUARD_VALUE, &msg.name, sizeof(msg.name)))
+      return -1;
+    offset += 4;
+    for (uint32_t i = 0; i < msg.name_length; i++)
+      offset = layoutString(offset, (const char * const *)&msg.name[i]);
+    offset = layoutFloat64Array(offset, &msg.position_length, &msg.position);
+    offset = layoutFloat64Array(offset, &msg.velocity_length, &msg.velocity);
+    offset = layoutFloat64Array(offset, &msg.effort_length, &msg.effort);
+    return offset;
+  }
+
+private:
+  unsigned char buffer_storage_[256];
+};
+
+
+/* tf/tfMessage, the number of transforms, where they are and their frame ids are constant */
+class TFMessageTemplate : public MsgTemplate
+{
+public:
+  TFMessageTemplate(tf::tfMessage & msg) : MsgTemplate(msg, buffer_storage_, sizeof(buffer_storage_)) {}
+
+protected:
+  virtual int layout() const
+  {
+    const tf::tfMessage & msg = *(const tf::tfMessage *)msg_;
+
+    if (!addGuard(0, GUARD_VALUE, &msg.transforms_length, sizeof(msg.transforms_length)) ||
+        !addGuard(0, GUARD_VALUE, &msg.transforms, sizeof(msg.transforms)))
+      return -1;
+
+    int offset = 4;
+    for (uint32_t i = 0; i < msg.transforms_length; i++)
+    {
+      const geometry_msgs::TransformStamped & transform = msg.transforms[i];
+
+      offset = layoutHeader(offset, transform.header);
+      offset = layoutString(offset, &transform.child_frame_id);
+      offset = layoutVector3(offset, transform.transform.translation);
+      offset = layoutQuaternion(offset, transform.transform.rotation);
+    }
+    return offset;
+  }
+
+private:
+  unsigned char buffer_storage_[192];
+};
+
+}  // namespace ros
+
+#endif
@@ -93,6 +93,16 @@ const uint8_t MODE_MSG_CHECKSUM   = 8;    // checksum for msg and topic id
 
 const uint8_t SERIAL_MSG_TIMEOUT  = 20;   // 20 milliseconds to recieve all of message data
 
+/* Counters of the batching publisher */
+struct PublishStats
+{
+  uint32_t frames;     // frames written
+  uint32_t writes;     // transport writes the frames were coalesced into
+  uint32_t stale;      // samples replaced by a newer one of the same topic before they were written
+  uint32_t throttled;  // samples of low priority topics held back while the transmit buffer was backed up
+  uint32_t dropped;    // samples that found no room in the transmit buffer
+};
+
 using rosserial_msgs::TopicInfo;
 
 /* Node Handle */
@@ -127,6 +137,11 @@ protected:
 public:
   NodeHandle_() : configured_(false)
   {
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+    batching_ = false;
+    batch_length_ = 0;
+    clearPublishStats();
+#endif
 
     for (unsigned int i = 0; i < MAX_PUBLISHERS; i++)
       publishers[i] = 0;
@@ -513,24 +528,34 @@ public:
     if (id >= 100 && !configured_)
       return 0;
 
-    /* serialize message */
-    int l = msg->serialize(message_out + 7);
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+    if (id >= 100 && batching_)
+      return queueBatch(id, msg);
 
-    /* setup the header */
-    message_out[0] = 0xff;
-    message_out[1] = PROTOCOL_VER;
-    message_out[2] = (uint8_t)((uint16_t)l & 255);
-    message_out[3] = (uint8_t)((uint16_t)l >> 8);
-    message_out[4] = 255 - ((message_out[2] + message_out[3]) % 256);
-    message_out[5] = (uint8_t)((int16_t)id & 255);
-    message_out[6] = (uint8_t)((int16_t)id >> 8);
+    /* topic data goes straight into the transmit buffer and is dropped instead of waited for when that is full,
+       the negotiation, log and time frames below 100 keep the blocking path so none of them is lost */
+    if (id >= 100)
+    {
+      uint8_t* frame = hardware_.reserveWrite(OUTPUT_SIZE);
+      if (frame == NULL)
+        return -1;
 
-    /* calculate checksum */
-    int chk = 0;
-    for (int i = 5; i < l + 7; i++)
-      chk += message_out[i];
-    l += 7;
-    message_out[l++] = 255 - (chk % 256);
+      int l = serializeFrame(frame, id, msg);
+      if (l <= OUTPUT_SIZE)
+      {
+        hardware_.commitWrite(l);
+        return l;
+      }
+      else
+      {
+        hardware_.commitWrite(0);
+        logerror("Message from device dropped: message larger than buffer.");
+        return -1;
+      }
+    }
+#endif
+
+    int l = serializeFrame(message_out, id, msg);
 
     if (l <= OUTPUT_SIZE)
     {
@@ -544,6 +569,183 @@ public:
     }
   }
 
+#if defined(ROSSERIAL_ZERO_COPY_WRITE)
+  /********************************************************************
+   * Batching
+   *
+   * Topics published between beginBatch() and flushBatch() are queued and
+   * written together, so the frames due in one tick share a transport write.
+   * Each message must stay valid until flushBatch(), and a topic published
+   * twice is written once, with its latest message.
+   */
+  void beginBatch()
+  {
+    batching_ = true;
+  }
+
+  int flushBatch()
+  {
+    const int BATCH_SIZE = OUTPUT_SIZE * 2;
+
+    uint8_t* block = NULL;
+    int block_size = 0;
+    int used = 0;
+    int written = 0;
+    int room = hardware_.availableForWrite();
+
+    batching_ = false;
+
+    /* highest priority first, so the important frames get the room */
+    for (int i = 1; i < batch_length_; i++)
+    {
+      BatchEntry entry = batch_[i];
+      int j = i;
+      while (j > 0 && batch_[j - 1].priority > entry.priority)
+      {
+        batch_[j] = batch_[j - 1];
+        j--;
+      }
+      batch_[j] = entry;
+    }
+
+    for (int i = 0; i < batch_length_; i++)
+    {
+      /* each priority step asks for another half frame of headroom left in the transmit buffer */
+      if (batch_[i].priority * (OUTPUT_SIZE / 2) > room - written)
+      {
+        publish_stats_.throttled++;
+        continue;
+      }
+
+      if (block == NULL || block_size - used < OUTPUT_SIZE)
+      {
+        if (block != NULL)
+        {
+          hardware_.commitWrite(used);
+          publish_stats_.writes++;
+        }
+
+        block_size = BATCH_SIZE;
+        block = hardware_.reserveWrite(block_size);
+        if (block == NULL)
+        {
+          block_size = OUTPUT_SIZE;
+          block = hardware_.reserveWrite(block_size);
+        }
+        used = 0;
+
+        if (block == NULL)
+        {
+          publish_stats_.dropped++;
+          continue;
+        }
+      }
+
+      int l = serializeFrame(block + used, batch_[i].id, batch_[i].msg);
+      if (l > OUTPUT_SIZE)
+      {
+        publish_stats_.dropped++;
+        continue;
+      }
+      used += l;
+      written += l;
+      publish_stats_.frames++;
+    }
+
+    if (block != NULL)
+    {
+      hardware_.commitWrite(used);
+      if (used > 0)
+        publish_stats_.writes++;
+    }
+
+    batch_length_ = 0;
+    return written;
+  }
+
+  PublishStats getPublishStats()
+  {
+    return publish_stats_;
+  }
+
+  void clearPublishStats()
+  {
+    publish_stats_.frames = 0;
+    publish_stats_.writes = 0;
+    publish_stats_.stale = 0;
+    publish_stats_.throttled = 0;
+    publish_stats_.dropped = 0;
+  }
+
+protected:
+  struct BatchEntry
+  {
+    int id;
+    int priority;
+    const Msg * msg;
+  };
+
+  BatchEntry batch_[MAX_PUBLISHERS];
+  int batch_length_;
+  bool batching_;
+  PublishStats publish_stats_;
+
+  int queueBatch(int id, const Msg * msg)
+  {
+    for (int i = 0; i < batch_length_; i++)
+    {
+      if (batch_[i].id == id)
+      {
+        batch_[i].msg = msg;
+        publish_stats_.stale++;
+        return 0;
+      }
+    }
+
+    if (batch_length_ >= MAX_PUBLISHERS)
+    {
+      publish_stats_.dropped++;
+      return -1;
+    }
+
+    int index = id - 100 - MAX_SUBSCRIBERS;
+    Publisher * p = (index >= 0 && index < MAX_PUBLISHERS) ? publishers[index] : 0;
+
+    batch_[batch_length_].id = id;
+    batch_[batch_length_].priority = (p != 0) ? p->priority_ : 0;
+    batch_[batch_length_].msg = msg;
+    batch_length_++;
+    return 0;
+  }
+
+public:
+#endif
+
+  /* Write a whole frame (header, message, checksum) to frame and return its length */
+  int serializeFrame(uint8_t* frame, int id, const Msg * msg)
+  {
+    /* serialize message */
+    int l = msg->serialize(frame + 7);
+
+    /* setup the header */
+    frame[0] = 0xff;
+    frame[1] = PROTOCOL_VER;
+    frame[2] = (uint8_t)((uint16_t)l & 255);
+    frame[3] = (uint8_t)((uint16_t)l >> 8);
+    frame[4] = 255 - ((frame[2] + frame[3]) % 256);
+    frame[5] = (uint8_t)((int16_t)id & 255);
+    frame[6] = (uint8_t)((int16_t)id >> 8);
+
+    /* calculate checksum */
+    int chk = 0;
+    for (int i = 5; i < l + 7; i++)
+      chk += frame[i];
+    l += 7;
+    frame[l++] = 255 - (chk % 256);
+
+    return l;
+  }
+
   /********************************************************************
    * Logging
    */
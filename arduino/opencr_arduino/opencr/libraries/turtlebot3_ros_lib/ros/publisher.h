@@ -48,6 +48,7 @@ public:
   Publisher(const char * topic_name, Msg * msg, int endpoint = rosserial_msgs::TopicInfo::ID_PUBLISHER) :
     topic_(topic_name),
     msg_(msg),
+    priority_(0),
     endpoint_(endpoint) {};
 
   int publish(const Msg * msg)
@@ -59,8 +60,15 @@ public:
     return endpoint_;
   }
 
+  /* 0 is never throttled, higher numbers give way first when the transmit buffer backs up */
+  void setPriority(int priority)
+  {
+    priority_ = priority;
+  }
+
   const char * topic_;
   Msg *msg_;
+  int priority_;
   // id_ and no_ are set by NodeHandle when we advertise
   int id_;
   NodeHandleBase_* nh_;
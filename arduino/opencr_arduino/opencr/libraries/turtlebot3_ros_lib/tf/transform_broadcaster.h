@@ -36,6 +36,7 @@
 #define ROS_TRANSFORM_BROADCASTER_H_
 
 #include "ros.h"
+#include "ros/msg_template.h"
 #include "tfMessage.h"
 
 namespace tf
@@ -44,7 +45,7 @@ namespace tf
 class TransformBroadcaster
 {
 public:
-  TransformBroadcaster() : publisher_("/tf", &internal_msg) {}
+  TransformBroadcaster() : publisher_("/tf", &internal_msg), internal_template(internal_msg) {}
 
   void init(ros::NodeHandle &nh)
   {
@@ -55,12 +56,13 @@ public:
   {
     internal_msg.transforms_length = 1;
     internal_msg.transforms = &transform;
-    publisher_.publish(&internal_msg);
+    publisher_.publish(&internal_template);
   }
 
 private:
   tf::tfMessage internal_msg;
   ros::Publisher publisher_;
+  ros::TFMessageTemplate internal_template;
 };
 
 }
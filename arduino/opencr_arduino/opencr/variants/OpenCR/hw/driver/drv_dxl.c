@@ -6,9 +6,25 @@
  */
 
 #include "drv_dxl.h"
+#include "drv_uart.h"
 #include "variant.h"
 
 
+//-- internal definition
+//
+#define DRV_DXL_UART_NUM        DRV_UART_NUM_3
+
+
+//-- internal variable
+//
+static volatile BOOL is_tx_release_pending = FALSE;
+static void (*drv_dxl_tx_done_func)(void) = NULL;
+
+
+//-- internal functions definition
+//
+static void drv_dxl_tx_done_isr(void);
+
 
 
 
@@ -25,12 +41,62 @@ int drv_dxl_init()
 
   drv_dxl_tx_enable(FALSE);
 
+  drv_uart_set_tx_done_callback(DRV_DXL_UART_NUM, drv_dxl_tx_done_isr);
+
   return 0;
 }
 
 
 void drv_dxl_tx_enable( BOOL enable )
 {
-  if( enable == TRUE )  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_9, GPIO_PIN_SET);
-  else                  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_9, GPIO_PIN_RESET);
+  uint32_t primask;
+
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  if( enable == TRUE )
+  {
+    is_tx_release_pending = FALSE;
+    HAL_GPIO_WritePin(GPIOC, GPIO_PIN_9, GPIO_PIN_SET);
+  }
+  else if( drv_uart_tx_done(DRV_DXL_UART_NUM) != TRUE )
+  {
+    // the uart is still sending: drv_dxl_tx_done_isr() releases the bus after the last stop bit
+    is_tx_release_pending = TRUE;
+  }
+  else
+  {
+    is_tx_release_pending = FALSE;
+    HAL_GPIO_WritePin(GPIOC, GPIO_PIN_9, GPIO_PIN_RESET);
+  }
+
+  __set_PRIMASK(primask);
+}
+
+
+BOOL drv_dxl_tx_done( void )
+{
+  return drv_uart_tx_done(DRV_DXL_UART_NUM);
+}
+
+
+void drv_dxl_set_tx_done_callback( void (*p_func)(void) )
+{
+  drv_dxl_tx_done_func = p_func;
+}
+
+
+static void drv_dxl_tx_done_isr(void)
+{
+  if( is_tx_release_pending == TRUE )
+  {
+    is_tx_release_pending = FALSE;
+    HAL_GPIO_WritePin(GPIOC, GPIO_PIN_9, GPIO_PIN_RESET);
+  }
+
+  if( drv_dxl_tx_done_func != NULL )
+  {
+    (*drv_dxl_tx_done_func)();
+  }
 }
@@ -25,6 +25,8 @@
 int drv_dxl_init();
 
 void drv_dxl_tx_enable( BOOL enable );
+BOOL drv_dxl_tx_done( void );
+void drv_dxl_set_tx_done_callback( void (*p_func)(void) );
 
 
 #ifdef __cplusplus
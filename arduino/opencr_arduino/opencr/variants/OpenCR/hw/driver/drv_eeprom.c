@@ -6,6 +6,7 @@
  */
 
 #include "drv_eeprom.h"
+#include "drv_micros.h"
 #include "variant.h"
 
 
@@ -15,19 +16,14 @@
 static bool IsInit = false;
 
 
-/* Global variable used to store variable value in read sequence */
-uint16_t DataVar = 0;
-
-
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 static uint16_t EE_Init(void);
-static uint16_t EE_ReadVariable(uint16_t VirtAddress, uint16_t* Data);
-static uint16_t EE_WriteVariable(uint16_t VirtAddress, uint16_t Data);
-static HAL_StatusTypeDef EE_Format(void);
-static uint16_t EE_FindValidPage(uint8_t Operation);
-static uint16_t EE_VerifyPageFullWriteVariable(uint16_t VirtAddress, uint16_t Data);
-static uint16_t EE_PageTransfer(uint16_t VirtAddress, uint16_t Data);
+static uint16_t EE_Format(void);
+static uint16_t EE_ErasePage(uint16_t Page);
+static uint16_t EE_LoadPage(uint16_t Page);
+static uint16_t EE_Compact(void);
+static uint16_t EE_Flush(void);
 static uint16_t EE_VerifyPageFullyErased(uint32_t Address);
 
 
@@ -62,6 +58,10 @@ static uint16_t EE_VerifyPageFullyErased(uint32_t Address);
 #define PAGE0                 ((uint16_t)0x0000)
 #define PAGE1                 ((uint16_t)0x0001) /* Page nb between PAGE0_BASE_ADDRESS & PAGE1_BASE_ADDRESS*/
 
+#define PAGE_BASE(page)       ((uint32_t)(EEPROM_START_ADDRESS + (uint32_t)((page) * PAGE_SIZE)))
+#define PAGE_END(page)        ((uint32_t)(PAGE_BASE(page) + (PAGE_SIZE - 1)))
+#define PAGE_ID(page)         (((page) == PAGE0) ? PAGE0_ID : PAGE1_ID)
+
 /* No valid page define */
 #define NO_VALID_PAGE         ((uint16_t)0x00AB)
 
@@ -70,33 +70,66 @@ static uint16_t EE_VerifyPageFullyErased(uint32_t Address);
 #define RECEIVE_DATA          ((uint16_t)0xEEEE)     /* Page is marked to receive data */
 #define VALID_PAGE            ((uint16_t)0x0000)     /* Page containing valid data */
 
-/* Valid pages in read and write defines */
-#define READ_FROM_VALID_PAGE  ((uint8_t)0x00)
-#define WRITE_IN_VALID_PAGE   ((uint8_t)0x01)
-
-/* Page full define */
-#define PAGE_FULL             ((uint8_t)0x80)
+/* Page layout, a status half-word, the number of compactions since format in the next
+   half-word and then records of data half-word followed by virtual address half-word.
+   A record is programmed as one word so a power loss can not leave half of it. */
+#define GENERATION_OFFSET     2
+#define RECORD_OFFSET         4
+#define RECORD_SIZE           4
+#define RECORD(addr, data)    ((uint32_t)(data) | ((uint32_t)(addr) << 16))
 
 /* Variables' number */
 #define NB_OF_VAR             (4*1024) //4KB
 
+/* Pending writes, a write of a variable already pending only changes the shadow */
+#define JOURNAL_SIZE          64
+
+
+/* RAM copy of every variable, built once at init */
+static uint8_t  ee_shadow[NB_OF_VAR];
+static uint32_t ee_valid[NB_OF_VAR/32];      /* variable has a record in flash */
+static uint32_t ee_dirty[NB_OF_VAR/32];      /* variable is waiting in the journal */
+
+static uint16_t ee_journal[JOURNAL_SIZE];
+static uint16_t ee_journal_cnt = 0;
+static bool     ee_journal_full = false;     /* a dirty variable is not in the journal, only a compaction writes it */
+static uint16_t ee_batch_depth = 0;
+
+static uint16_t ee_page       = NO_VALID_PAGE;
+static uint32_t ee_write_addr = 0;           /* next free record of the active page */
+static uint32_t ee_var_cnt    = 0;
+
+static drv_eeprom_stat_t ee_stat;
 
-/* Virtual address defined by the user: 0xFFFF value is prohibited */
-static uint16_t VirtAddVarTab[NB_OF_VAR];
+
+#define BIT_GET(tbl, i)       (((tbl)[(i)>>5] >> ((i)&31)) & 1)
+#define BIT_SET(tbl, i)       ((tbl)[(i)>>5] |=  (1UL << ((i)&31)))
+#define BIT_CLR(tbl, i)       ((tbl)[(i)>>5] &= ~(1UL << ((i)&31)))
 
 
 
 
 int drv_eeprom_init()
 {
-  uint16_t i;
+  uint32_t pre_time;
+  uint32_t i;
+
 
+  pre_time = drv_micros();
 
+  for( i=0; i<NB_OF_VAR/32; i++ )
+  {
+    ee_valid[i] = 0;
+    ee_dirty[i] = 0;
+  }
   for( i=0; i<NB_OF_VAR; i++ )
   {
-    VirtAddVarTab[i] = i;
+    ee_shadow[i] = 0;
   }
-
+  ee_journal_cnt  = 0;
+  ee_journal_full = false;
+  ee_var_cnt      = 0;
+  IsInit          = false;
 
   HAL_FLASH_Unlock();
 
@@ -105,6 +138,10 @@ int drv_eeprom_init()
     IsInit = true;
   }
 
+  HAL_FLASH_Lock();
+
+  ee_stat.boot_time = drv_micros() - pre_time;
+
   return 0;
 }
 
@@ -112,22 +149,47 @@ int drv_eeprom_init()
 
 uint8_t drv_eeprom_read_byte(int addr)
 {
-  uint16_t read_value;
-
-
   if( IsInit == false ) return 0;
+  if( addr < 0 || addr >= NB_OF_VAR ) return 0;
 
-  EE_ReadVariable((uint16_t)addr,  &read_value);
-
-  return (uint8_t)read_value;
+  return ee_shadow[addr];
 }
 
 
 void drv_eeprom_write_byte(int index, uint8_t data_in)
 {
   if( IsInit == false ) return;
+  if( index < 0 || index >= NB_OF_VAR ) return;
+
+  ee_stat.write_count++;
+
+  if( BIT_GET(ee_valid, index) && ee_shadow[index] == data_in )
+  {
+    ee_stat.skip_count++;
+    return;
+  }
+
+  ee_shadow[index] = data_in;
+
+  if( !BIT_GET(ee_dirty, index) )
+  {
+    BIT_SET(ee_dirty, index);
+    if( ee_journal_cnt < JOURNAL_SIZE )
+    {
+      ee_journal[ee_journal_cnt++] = (uint16_t)index;
+    }
+    else
+    {
+      /* The flush of a full journal failed, the value stays in the shadow until a compaction */
+      ee_journal_full = true;
+      ee_stat.overflow_count++;
+    }
+  }
 
-  EE_WriteVariable(index, (uint16_t)data_in);
+  if( ee_batch_depth == 0 || ee_journal_cnt >= JOURNAL_SIZE )
+  {
+    drv_eeprom_flush();
+  }
 }
 
 
@@ -139,25 +201,87 @@ uint16_t drv_eeprom_get_length(void)
 }
 
 
+void drv_eeprom_begin_batch(void)
+{
+  ee_batch_depth++;
+}
+
+
+void drv_eeprom_end_batch(void)
+{
+  if( ee_batch_depth > 0 )
+  {
+    ee_batch_depth--;
+  }
+
+  if( ee_batch_depth == 0 )
+  {
+    drv_eeprom_flush();
+  }
+}
+
+
+bool drv_eeprom_flush(void)
+{
+  uint16_t status;
+
+
+  if( IsInit == false )    return false;
+  if( ee_journal_cnt == 0 && ee_journal_full == false ) return true;
+
+  HAL_FLASH_Unlock();
+  if( ee_journal_full == true )
+  {
+    status = EE_Compact();
+  }
+  else
+  {
+    status = EE_Flush();
+  }
+  HAL_FLASH_Lock();
+
+  if( status != EE_OK )
+  {
+    ee_stat.flush_fail_count++;
+    return false;
+  }
+
+  return true;
+}
+
+
+void drv_eeprom_get_stat(drv_eeprom_stat_t *p_stat)
+{
+  *p_stat = ee_stat;
+
+  if( ee_page != NO_VALID_PAGE )
+  {
+    p_stat->used = ee_write_addr - PAGE_BASE(ee_page);
+    p_stat->free = PAGE_SIZE - p_stat->used;
+  }
+  p_stat->var_count = ee_var_cnt;
+  p_stat->pending   = ee_journal_cnt;
+}
+
+
 
 
 
 /**
   * @brief  Restore the pages to a known good state in case of page's status
-  *   corruption after a power loss.
+  *   corruption after a power loss and build the RAM shadow.
+  *   A compaction writes the whole shadow to the receiving page before the
+  *   old page is erased, so whichever step it was interrupted at, one page
+  *   still holds every variable.
   * @param  None.
   * @retval - Flash error code: on write Flash error
   *         - FLASH_COMPLETE: on success
   */
-uint16_t EE_Init(void)
+static uint16_t EE_Init(void)
 {
   uint16_t PageStatus0 = 6, PageStatus1 = 6;
-  uint16_t VarIdx = 0;
-  uint16_t EepromStatus = 0, ReadStatus = 0;
-  int16_t x = -1;
-  HAL_StatusTypeDef  FlashStatus;
-  uint32_t SectorError = 0;
-  FLASH_EraseInitTypeDef pEraseInit;
+  uint16_t ValidPage, OtherPage;
+  uint16_t Status;
 
 
   /* Get Page0 status */
@@ -165,356 +289,160 @@ uint16_t EE_Init(void)
   /* Get Page1 status */
   PageStatus1 = (*(__IO uint16_t*)PAGE1_BASE_ADDRESS);
 
-  pEraseInit.TypeErase = TYPEERASE_SECTORS;
-  pEraseInit.Sector = PAGE0_ID;
-  pEraseInit.NbSectors = 1;
-  pEraseInit.VoltageRange = VOLTAGE_RANGE;
+  if (PageStatus0 == VALID_PAGE && PageStatus1 != VALID_PAGE)
+  {
+    ValidPage = PAGE0;
+    OtherPage = PAGE1;
+  }
+  else if (PageStatus1 == VALID_PAGE && PageStatus0 != VALID_PAGE)
+  {
+    ValidPage = PAGE1;
+    OtherPage = PAGE0;
+  }
+  else if (PageStatus0 == RECEIVE_DATA && PageStatus1 == ERASED)
+  {
+    ValidPage = NO_VALID_PAGE;
+    OtherPage = PAGE0;
+  }
+  else if (PageStatus1 == RECEIVE_DATA && PageStatus0 == ERASED)
+  {
+    ValidPage = NO_VALID_PAGE;
+    OtherPage = PAGE1;
+  }
+  else /* First EEPROM access (Page0&1 are erased) or invalid state -> format EEPROM */
+  {
+    return EE_Format();
+  }
 
-  /* Check for invalid header states and repair if necessary */
-  switch (PageStatus0)
+  if (ValidPage == NO_VALID_PAGE)
   {
-    case ERASED:
-      if (PageStatus1 == VALID_PAGE) /* Page0 erased, Page1 valid */
-      {
-          /* Erase Page0 */
-        if(!EE_VerifyPageFullyErased(PAGE0_BASE_ADDRESS))
-        {
-          FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-          /* If erase operation was failed, a Flash error code is returned */
-          if (FlashStatus != HAL_OK)
-          {
-            return FlashStatus;
-          }
-        }
-      }
-      else if (PageStatus1 == RECEIVE_DATA) /* Page0 erased, Page1 receive */
-      {
-        /* Erase Page0 */
-        if(!EE_VerifyPageFullyErased(PAGE0_BASE_ADDRESS))
-        {
-          FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-          /* If erase operation was failed, a Flash error code is returned */
-          if (FlashStatus != HAL_OK)
-          {
-            return FlashStatus;
-          }
-        }
-        /* Mark Page1 as valid */
-        FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE1_BASE_ADDRESS, VALID_PAGE);
-        /* If program operation was failed, a Flash error code is returned */
-        if (FlashStatus != HAL_OK)
-        {
-          return FlashStatus;
-        }
-      }
-      else /* First EEPROM access (Page0&1 are erased) or invalid state -> format EEPROM */
-      {
-        /* Erase both Page0 and Page1 and set Page0 as valid page */
-        FlashStatus = EE_Format();
-        /* If erase/program operation was failed, a Flash error code is returned */
-        if (FlashStatus != HAL_OK)
-        {
-          return FlashStatus;
-        }
-      }
-      break;
+    /* The old page was erased after the transfer had completed, take the receiving page */
+    EE_LoadPage(OtherPage);
 
-    case RECEIVE_DATA:
-      if (PageStatus1 == VALID_PAGE) /* Page0 receive, Page1 valid */
-      {
-        /* Transfer data from Page1 to Page0 */
-        for (VarIdx = 0; VarIdx < NB_OF_VAR; VarIdx++)
-        {
-          if (( *(__IO uint16_t*)(PAGE0_BASE_ADDRESS + 6)) == VirtAddVarTab[VarIdx])
-          {
-            x = VarIdx;
-          }
-          if (VarIdx != x)
-          {
-            /* Read the last variables' updates */
-            ReadStatus = EE_ReadVariable(VirtAddVarTab[VarIdx], &DataVar);
-            /* In case variable corresponding to the virtual address was found */
-            if (ReadStatus != 0x1)
-            {
-              /* Transfer the variable to the Page0 */
-              EepromStatus = EE_VerifyPageFullWriteVariable(VirtAddVarTab[VarIdx], DataVar);
-              /* If program operation was failed, a Flash error code is returned */
-              if (EepromStatus != HAL_OK)
-              {
-                return EepromStatus;
-              }
-            }
-          }
-        }
-        /* Mark Page0 as valid */
-        FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE0_BASE_ADDRESS, VALID_PAGE);
-        /* If program operation was failed, a Flash error code is returned */
-        if (FlashStatus != HAL_OK)
-        {
-          return FlashStatus;
-        }
-        pEraseInit.Sector = PAGE1_ID;
-        pEraseInit.NbSectors = 1;
-        pEraseInit.VoltageRange = VOLTAGE_RANGE;
-        /* Erase Page1 */
-        if(!EE_VerifyPageFullyErased(PAGE1_BASE_ADDRESS))
-        {
-          FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-          /* If erase operation was failed, a Flash error code is returned */
-          if (FlashStatus != HAL_OK)
-          {
-            return FlashStatus;
-          }
-        }
-      }
-      else if (PageStatus1 == ERASED) /* Page0 receive, Page1 erased */
-      {
-        pEraseInit.Sector = PAGE1_ID;
-        pEraseInit.NbSectors = 1;
-        pEraseInit.VoltageRange = VOLTAGE_RANGE;
-        /* Erase Page1 */
-        if(!EE_VerifyPageFullyErased(PAGE1_BASE_ADDRESS))
-        {
-          FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-          /* If erase operation was failed, a Flash error code is returned */
-          if (FlashStatus != HAL_OK)
-          {
-            return FlashStatus;
-          }
-        }
-        /* Mark Page0 as valid */
-        FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE0_BASE_ADDRESS, VALID_PAGE);
-        /* If program operation was failed, a Flash error code is returned */
-        if (FlashStatus != HAL_OK)
-        {
-          return FlashStatus;
-        }
-      }
-      else /* Invalid state -> format eeprom */
-      {
-        /* Erase both Page0 and Page1 and set Page0 as valid page */
-        FlashStatus = EE_Format();
-        /* If erase/program operation was failed, a Flash error code is returned */
-        if (FlashStatus != HAL_OK)
-        {
-          return FlashStatus;
-        }
-      }
-      break;
+    Status = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE_BASE(OtherPage), VALID_PAGE);
+    if (Status != HAL_OK)
+    {
+      return Status;
+    }
+    return EE_ErasePage(OtherPage == PAGE0 ? PAGE1 : PAGE0);
+  }
 
-    case VALID_PAGE:
-      if (PageStatus1 == VALID_PAGE) /* Invalid state -> format eeprom */
-      {
-        /* Erase both Page0 and Page1 and set Page0 as valid page */
-        FlashStatus = EE_Format();
-        /* If erase/program operation was failed, a Flash error code is returned */
-        if (FlashStatus != HAL_OK)
-        {
-          return FlashStatus;
-        }
-      }
-      else if (PageStatus1 == ERASED) /* Page0 valid, Page1 erased */
-      {
-        pEraseInit.Sector = PAGE1_ID;
-        pEraseInit.NbSectors = 1;
-        pEraseInit.VoltageRange = VOLTAGE_RANGE;
-        /* Erase Page1 */
-        if(!EE_VerifyPageFullyErased(PAGE1_BASE_ADDRESS))
-        {
-          FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-          /* If erase operation was failed, a Flash error code is returned */
-          if (FlashStatus != HAL_OK)
-          {
-            return FlashStatus;
-          }
-        }
-      }
-      else /* Page0 valid, Page1 receive */
-      {
-        /* Transfer data from Page0 to Page1 */
-        for (VarIdx = 0; VarIdx < NB_OF_VAR; VarIdx++)
-        {
-          if ((*(__IO uint16_t*)(PAGE1_BASE_ADDRESS + 6)) == VirtAddVarTab[VarIdx])
-          {
-            x = VarIdx;
-          }
-          if (VarIdx != x)
-          {
-            /* Read the last variables' updates */
-            ReadStatus = EE_ReadVariable(VirtAddVarTab[VarIdx], &DataVar);
-            /* In case variable corresponding to the virtual address was found */
-            if (ReadStatus != 0x1)
-            {
-              /* Transfer the variable to the Page1 */
-              EepromStatus = EE_VerifyPageFullWriteVariable(VirtAddVarTab[VarIdx], DataVar);
-              /* If program operation was failed, a Flash error code is returned */
-              if (EepromStatus != HAL_OK)
-              {
-                return EepromStatus;
-              }
-            }
-          }
-        }
-        /* Mark Page1 as valid */
-        FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE1_BASE_ADDRESS, VALID_PAGE);
-        /* If program operation was failed, a Flash error code is returned */
-        if (FlashStatus != HAL_OK)
-        {
-          return FlashStatus;
-        }
-        pEraseInit.Sector = PAGE0_ID;
-        pEraseInit.NbSectors = 1;
-        pEraseInit.VoltageRange = VOLTAGE_RANGE;
-        /* Erase Page0 */
-        if(!EE_VerifyPageFullyErased(PAGE0_BASE_ADDRESS))
-        {
-          FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-          /* If erase operation was failed, a Flash error code is returned */
-          if (FlashStatus != HAL_OK)
-          {
-            return FlashStatus;
-          }
-        }
-      }
-      break;
+  EE_LoadPage(ValidPage);
 
-    default:  /* Any other state -> format eeprom */
-      /* Erase both Page0 and Page1 and set Page0 as valid page */
-      FlashStatus = EE_Format();
-      /* If erase/program operation was failed, a Flash error code is returned */
-      if (FlashStatus != HAL_OK)
-      {
-        return FlashStatus;
-      }
-      break;
+  if ((*(__IO uint16_t*)PAGE_BASE(OtherPage)) == RECEIVE_DATA)
+  {
+    /* Interrupted transfer, its records are as new as the valid page or newer */
+    EE_LoadPage(OtherPage);
+    ee_page = ValidPage;
+    ee_stat.generation = (*(__IO uint16_t*)(PAGE_BASE(ValidPage) + GENERATION_OFFSET));
+    if (ee_stat.generation == ERASED)
+    {
+      ee_stat.generation = 0;
+    }
+    return EE_Compact();
   }
 
-  return HAL_OK;
+  return EE_ErasePage(OtherPage);
 }
 
 /**
-  * @brief  Verify if specified page is fully erased.
-  * @param  Address: page address
-  *   This parameter can be one of the following values:
-  *     @arg PAGE0_BASE_ADDRESS: Page0 base address
-  *     @arg PAGE1_BASE_ADDRESS: Page1 base address
-  * @retval page fully erased status:
-  *           - 0: if Page not erased
-  *           - 1: if Page erased
+  * @brief  Read every record of a page into the RAM shadow, later records win.
+  *   The page becomes the active one and the write address follows its last record.
+  * @param  Page: PAGE0 or PAGE1
+  * @retval EE_OK
   */
-uint16_t EE_VerifyPageFullyErased(uint32_t Address)
+static uint16_t EE_LoadPage(uint16_t Page)
 {
-  uint32_t ReadStatus = 1;
-  uint16_t AddressValue = 0x5555;
+  uint32_t Address = PAGE_BASE(Page) + RECORD_OFFSET;
+  uint32_t PageEndAddress = PAGE_END(Page);
+  uint32_t Record;
+  uint16_t VirtAddress;
 
-  /* Check each active page address starting from end */
-  while (Address <= PAGE0_END_ADDRESS)
+  while (Address < PageEndAddress)
   {
-    /* Get the current location content to be compared with virtual address */
-    AddressValue = (*(__IO uint16_t*)Address);
+    Record = (*(__IO uint32_t*)Address);
 
-    /* Compare the read address with the virtual address */
-    if (AddressValue != ERASED)
+    /* Records are appended, the first erased word ends the page */
+    if (Record == 0xFFFFFFFF)
     {
-
-      /* In case variable value is read, reset ReadStatus flag */
-      ReadStatus = 0;
-
       break;
     }
-    /* Next address location */
-    Address = Address + 4;
+
+    /* Skips a record left with its data but without its address by the old half-word writes */
+    VirtAddress = (uint16_t)(Record >> 16);
+    if (VirtAddress < NB_OF_VAR)
+    {
+      ee_shadow[VirtAddress] = (uint8_t)Record;
+      if (!BIT_GET(ee_valid, VirtAddress))
+      {
+        BIT_SET(ee_valid, VirtAddress);
+        ee_var_cnt++;
+      }
+    }
+    Address = Address + RECORD_SIZE;
   }
 
-  /* Return ReadStatus value: (0: Page not erased, 1: Sector erased) */
-  return ReadStatus;
+  ee_page       = Page;
+  ee_write_addr = Address;
+
+  ee_stat.generation = (*(__IO uint16_t*)(PAGE_BASE(Page) + GENERATION_OFFSET));
+  if (ee_stat.generation == ERASED)
+  {
+    ee_stat.generation = 0;
+  }
+
+  return EE_OK;
 }
 
 /**
-  * @brief  Returns the last stored variable data, if found, which correspond to
-  *   the passed virtual address
-  * @param  VirtAddress: Variable virtual address
-  * @param  Data: Global variable contains the read variable value
-  * @retval Success or error status:
-  *           - 0: if variable was found
-  *           - 1: if the variable was not found
-  *           - NO_VALID_PAGE: if no valid page was found.
+  * @brief  Erase a page unless it already is.
+  * @param  Page: PAGE0 or PAGE1
+  * @retval Status of the erase
   */
-uint16_t EE_ReadVariable(uint16_t VirtAddress, uint16_t* Data)
+static uint16_t EE_ErasePage(uint16_t Page)
 {
-  uint16_t ValidPage = PAGE0;
-  uint16_t AddressValue = 0x5555, ReadStatus = 1;
-  uint32_t Address = EEPROM_START_ADDRESS, PageStartAddress = EEPROM_START_ADDRESS;
-
-  /* Get active Page for read operation */
-  ValidPage = EE_FindValidPage(READ_FROM_VALID_PAGE);
+  uint32_t SectorError = 0;
+  FLASH_EraseInitTypeDef pEraseInit;
 
-  /* Check if there is no valid page */
-  if (ValidPage == NO_VALID_PAGE)
+  if (EE_VerifyPageFullyErased(PAGE_BASE(Page)))
   {
-    return  NO_VALID_PAGE;
+    return HAL_OK;
   }
 
-  /* Get the valid Page start Address */
-  PageStartAddress = (uint32_t)(EEPROM_START_ADDRESS + (uint32_t)(ValidPage * PAGE_SIZE));
-
-  /* Get the valid Page end Address */
-  Address = (uint32_t)((EEPROM_START_ADDRESS - 2) + (uint32_t)((1 + ValidPage) * PAGE_SIZE));
-
-  /* Check each active page address starting from end */
-  while (Address > (PageStartAddress + 2))
-  {
-    /* Get the current location content to be compared with virtual address */
-    AddressValue = (*(__IO uint16_t*)Address);
-
-    /* Compare the read address with the virtual address */
-    if (AddressValue == VirtAddress)
-    {
-      /* Get content of Address-2 which is variable value */
-      *Data = (*(__IO uint16_t*)(Address - 2));
-
-      /* In case variable value is read, reset ReadStatus flag */
-      ReadStatus = 0;
-
-      break;
-    }
-    else
-    {
-      /* Next address location */
-      Address = Address - 4;
-    }
-  }
+  pEraseInit.TypeErase = FLASH_TYPEERASE_SECTORS;
+  pEraseInit.Sector = PAGE_ID(Page);
+  pEraseInit.NbSectors = 1;
+  pEraseInit.VoltageRange = VOLTAGE_RANGE;
 
-  /* Return ReadStatus value: (0: variable exist, 1: variable doesn't exist) */
-  return ReadStatus;
+  return HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
 }
 
 /**
-  * @brief  Writes/upadtes variable data in EEPROM.
-  * @param  VirtAddress: Variable virtual address
-  * @param  Data: 16 bit data to be written
-  * @retval Success or error status:
-  *           - FLASH_COMPLETE: on success
-  *           - PAGE_FULL: if valid page is full
-  *           - NO_VALID_PAGE: if no valid page was found
-  *           - Flash error code: on write Flash error
+  * @brief  Verify if specified page is fully erased.
+  * @param  Address: page address
+  *   This parameter can be one of the following values:
+  *     @arg PAGE0_BASE_ADDRESS: Page0 base address
+  *     @arg PAGE1_BASE_ADDRESS: Page1 base address
+  * @retval page fully erased status:
+  *           - 0: if Page not erased
+  *           - 1: if Page erased
   */
-uint16_t EE_WriteVariable(uint16_t VirtAddress, uint16_t Data)
+static uint16_t EE_VerifyPageFullyErased(uint32_t Address)
 {
-  uint16_t Status = 0;
+  uint32_t PageEndAddress = Address + (PAGE_SIZE - 1);
 
-  /* Write the variable virtual address and value in the EEPROM */
-  Status = EE_VerifyPageFullWriteVariable(VirtAddress, Data);
-
-  /* In case the EEPROM active page is full */
-  if (Status == PAGE_FULL)
+  /* Check each word of the page */
+  while (Address < PageEndAddress)
   {
-    /* Perform Page transfer */
-    Status = EE_PageTransfer(VirtAddress, Data);
+    if ((*(__IO uint32_t*)Address) != 0xFFFFFFFF)
+    {
+      return 0;
+    }
+    /* Next address location */
+    Address = Address + 4;
   }
 
-  /* Return last operation status */
-  return Status;
+  return 1;
 }
 
 /**
@@ -523,283 +451,187 @@ uint16_t EE_WriteVariable(uint16_t VirtAddress, uint16_t Data)
   * @retval Status of the last operation (Flash write or erase) done during
   *         EEPROM formating
   */
-static HAL_StatusTypeDef EE_Format(void)
+static uint16_t EE_Format(void)
 {
-  HAL_StatusTypeDef FlashStatus = HAL_OK;
-  uint32_t SectorError = 0;
-  FLASH_EraseInitTypeDef pEraseInit;
+  uint16_t Status;
+  uint32_t i;
 
-  pEraseInit.TypeErase = FLASH_TYPEERASE_SECTORS;
-  pEraseInit.Sector = PAGE0_ID;
-  pEraseInit.NbSectors = 1;
-  pEraseInit.VoltageRange = VOLTAGE_RANGE;
   /* Erase Page0 */
-  if(!EE_VerifyPageFullyErased(PAGE0_BASE_ADDRESS))
+  Status = EE_ErasePage(PAGE0);
+  if (Status != HAL_OK)
   {
-    FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-    /* If erase operation was failed, a Flash error code is returned */
-    if (FlashStatus != HAL_OK)
-    {
-      return FlashStatus;
-    }
+    return Status;
   }
   /* Set Page0 as valid page: Write VALID_PAGE at Page0 base address */
-  FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE0_BASE_ADDRESS, VALID_PAGE);
-  /* If program operation was failed, a Flash error code is returned */
-  if (FlashStatus != HAL_OK)
+  Status = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE0_BASE_ADDRESS, VALID_PAGE);
+  if (Status != HAL_OK)
   {
-    return FlashStatus;
+    return Status;
   }
-
-  pEraseInit.Sector = PAGE1_ID;
   /* Erase Page1 */
-  if(!EE_VerifyPageFullyErased(PAGE1_BASE_ADDRESS))
+  Status = EE_ErasePage(PAGE1);
+  if (Status != HAL_OK)
   {
-    FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-    /* If erase operation was failed, a Flash error code is returned */
-    if (FlashStatus != HAL_OK)
-    {
-      return FlashStatus;
-    }
+    return Status;
   }
 
-  return HAL_OK;
-}
-
-/**
-  * @brief  Find valid Page for write or read operation
-  * @param  Operation: operation to achieve on the valid page.
-  *   This parameter can be one of the following values:
-  *     @arg READ_FROM_VALID_PAGE: read operation from valid page
-  *     @arg WRITE_IN_VALID_PAGE: write operation from valid page
-  * @retval Valid page number (PAGE or PAGE1) or NO_VALID_PAGE in case
-  *   of no valid page was found
-  */
-static uint16_t EE_FindValidPage(uint8_t Operation)
-{
-  uint16_t PageStatus0 = 6, PageStatus1 = 6;
-
-  /* Get Page0 actual status */
-  PageStatus0 = (*(__IO uint16_t*)PAGE0_BASE_ADDRESS);
-
-  /* Get Page1 actual status */
-  PageStatus1 = (*(__IO uint16_t*)PAGE1_BASE_ADDRESS);
-
-  /* Write or read operation */
-  switch (Operation)
+  for (i = 0; i < NB_OF_VAR/32; i++)
   {
-    case WRITE_IN_VALID_PAGE:   /* ---- Write operation ---- */
-      if (PageStatus1 == VALID_PAGE)
-      {
-        /* Page0 receiving data */
-        if (PageStatus0 == RECEIVE_DATA)
-        {
-          return PAGE0;         /* Page0 valid */
-        }
-        else
-        {
-          return PAGE1;         /* Page1 valid */
-        }
-      }
-      else if (PageStatus0 == VALID_PAGE)
-      {
-        /* Page1 receiving data */
-        if (PageStatus1 == RECEIVE_DATA)
-        {
-          return PAGE1;         /* Page1 valid */
-        }
-        else
-        {
-          return PAGE0;         /* Page0 valid */
-        }
-      }
-      else
-      {
-        return NO_VALID_PAGE;   /* No valid Page */
-      }
-
-    case READ_FROM_VALID_PAGE:  /* ---- Read operation ---- */
-      if (PageStatus0 == VALID_PAGE)
-      {
-        return PAGE0;           /* Page0 valid */
-      }
-      else if (PageStatus1 == VALID_PAGE)
-      {
-        return PAGE1;           /* Page1 valid */
-      }
-      else
-      {
-        return NO_VALID_PAGE ;  /* No valid Page */
-      }
-
-    default:
-      return PAGE0;             /* Page0 valid */
+    ee_valid[i] = 0;
   }
+  ee_var_cnt    = 0;
+  ee_page       = PAGE0;
+  ee_write_addr = PAGE0_BASE_ADDRESS + RECORD_OFFSET;
+  ee_stat.generation = 0;
+
+  return HAL_OK;
 }
 
 /**
-  * @brief  Verify if active page is full and Writes variable in EEPROM.
-  * @param  VirtAddress: 16 bit virtual address of the variable
-  * @param  Data: 16 bit data to be written as variable value
+  * @brief  Program the journal into the active page, compact when it runs full.
+  * @param  None
   * @retval Success or error status:
   *           - FLASH_COMPLETE: on success
-  *           - PAGE_FULL: if valid page is full
-  *           - NO_VALID_PAGE: if no valid page was found
-  *           - Flash error code: on write Flash error
+  *           - Flash error code: on write Flash error, the unwritten entries stay queued
   */
-static uint16_t EE_VerifyPageFullWriteVariable(uint16_t VirtAddress, uint16_t Data)
+static uint16_t EE_Flush(void)
 {
-  HAL_StatusTypeDef FlashStatus = HAL_OK;
-  uint16_t ValidPage = PAGE0;
-  uint32_t Address = EEPROM_START_ADDRESS, PageEndAddress = EEPROM_START_ADDRESS+PAGE_SIZE;
+  uint16_t Status = HAL_OK;
+  uint16_t VirtAddress;
+  uint16_t i, j;
 
-  /* Get valid Page for write operation */
-  ValidPage = EE_FindValidPage(WRITE_IN_VALID_PAGE);
-
-  /* Check if there is no valid page */
-  if (ValidPage == NO_VALID_PAGE)
+  for (i = 0; i < ee_journal_cnt; i++)
   {
-    return  NO_VALID_PAGE;
-  }
-
-  /* Get the valid Page start Address */
-  Address = (uint32_t)(EEPROM_START_ADDRESS + (uint32_t)(ValidPage * PAGE_SIZE));
-
-  /* Get the valid Page end Address */
-  PageEndAddress = (uint32_t)((EEPROM_START_ADDRESS - 1) + (uint32_t)((ValidPage + 1) * PAGE_SIZE));
+    if (ee_write_addr + RECORD_SIZE > PAGE_END(ee_page))
+    {
+      /* The compaction writes the whole shadow, pending entries included */
+      return EE_Compact();
+    }
 
-  /* Check each active page address starting from begining */
-  while (Address < PageEndAddress)
-  {
-    /* Verify if Address and Address+2 contents are 0xFFFFFFFF */
-    if ((*(__IO uint32_t*)Address) == 0xFFFFFFFF)
+    VirtAddress = ee_journal[i];
+    Status = HAL_FLASH_Program(TYPEPROGRAM_WORD, ee_write_addr, RECORD(VirtAddress, ee_shadow[VirtAddress]));
+    if (Status != HAL_OK)
     {
-      /* Set variable data */
-      FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, Address, Data);
-      /* If program operation was failed, a Flash error code is returned */
-      if (FlashStatus != HAL_OK)
-      {
-        return FlashStatus;
-      }
-      /* Set variable virtual address */
-      FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, Address + 2, VirtAddress);
-      /* Return program operation status */
-      return FlashStatus;
+      break;
     }
-    else
+    ee_write_addr += RECORD_SIZE;
+    ee_stat.record_count++;
+
+    BIT_CLR(ee_dirty, VirtAddress);
+    if (!BIT_GET(ee_valid, VirtAddress))
     {
-      /* Next address location */
-      Address = Address + 4;
+      BIT_SET(ee_valid, VirtAddress);
+      ee_var_cnt++;
     }
   }
 
-  /* Return PAGE_FULL in case the valid page is full */
-  return PAGE_FULL;
+  /* Keep what was not written for the next flush */
+  for (j = 0; i < ee_journal_cnt; i++, j++)
+  {
+    ee_journal[j] = ee_journal[i];
+  }
+  ee_journal_cnt = j;
+
+  return Status;
 }
 
 /**
-  * @brief  Transfers last updated variables data from the full Page to
-  *   an empty one.
-  * @param  VirtAddress: 16 bit virtual address of the variable
-  * @param  Data: 16 bit data to be written as variable value
+  * @brief  Write the shadow to the other page and make it the active one.
+  *   RECEIVE_DATA marks the new page until every variable is in it, then the old
+  *   page is erased and the new one marked valid, see EE_Init for the recovery.
+  * @param  None
   * @retval Success or error status:
   *           - FLASH_COMPLETE: on success
-  *           - PAGE_FULL: if valid page is full
   *           - NO_VALID_PAGE: if no valid page was found
   *           - Flash error code: on write Flash error
   */
-static uint16_t EE_PageTransfer(uint16_t VirtAddress, uint16_t Data)
+static uint16_t EE_Compact(void)
 {
-  HAL_StatusTypeDef FlashStatus = HAL_OK;
-  uint32_t NewPageAddress = EEPROM_START_ADDRESS;
-  uint16_t OldPageId=0;
-  uint16_t ValidPage = PAGE0, VarIdx = 0;
-  uint16_t EepromStatus = 0, ReadStatus = 0;
-  uint32_t SectorError = 0;
-  FLASH_EraseInitTypeDef pEraseInit;
-
-  /* Get active Page for read operation */
-  ValidPage = EE_FindValidPage(READ_FROM_VALID_PAGE);
-
-  if (ValidPage == PAGE1)       /* Page1 valid */
+  uint16_t Status;
+  uint16_t OldPage = ee_page;
+  uint16_t NewPage;
+  uint32_t Address;
+  uint32_t Generation;
+  uint16_t VarIdx;
+
+  if (OldPage == NO_VALID_PAGE)
   {
-    /* New page address where variable will be moved to */
-    NewPageAddress = PAGE0_BASE_ADDRESS;
-
-    /* Old page ID where variable will be taken from */
-    OldPageId = PAGE1_ID;
+    return NO_VALID_PAGE;
   }
-  else if (ValidPage == PAGE0)  /* Page0 valid */
-  {
-    /* New page address  where variable will be moved to */
-    NewPageAddress = PAGE1_BASE_ADDRESS;
+  NewPage = (OldPage == PAGE0) ? PAGE1 : PAGE0;
+  Generation = ee_stat.generation + 1;
 
-    /* Old page ID where variable will be taken from */
-    OldPageId = PAGE0_ID;
-  }
-  else
+  Status = EE_ErasePage(NewPage);
+  if (Status != HAL_OK)
   {
-    return NO_VALID_PAGE;       /* No valid Page */
+    return Status;
   }
 
   /* Set the new Page status to RECEIVE_DATA status */
-  FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, NewPageAddress, RECEIVE_DATA);
-  /* If program operation was failed, a Flash error code is returned */
-  if (FlashStatus != HAL_OK)
+  Status = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE_BASE(NewPage), RECEIVE_DATA);
+  if (Status != HAL_OK)
   {
-    return FlashStatus;
+    return Status;
   }
-
-  /* Write the variable passed as parameter in the new active page */
-  EepromStatus = EE_VerifyPageFullWriteVariable(VirtAddress, Data);
-  /* If program operation was failed, a Flash error code is returned */
-  if (EepromStatus != HAL_OK)
+  Status = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE_BASE(NewPage) + GENERATION_OFFSET, (uint16_t)Generation);
+  if (Status != HAL_OK)
   {
-    return EepromStatus;
+    return Status;
   }
 
-  /* Transfer process: transfer variables from old to the new active page */
+  /* Transfer process: every variable once, pending ones included */
+  Address = PAGE_BASE(NewPage) + RECORD_OFFSET;
   for (VarIdx = 0; VarIdx < NB_OF_VAR; VarIdx++)
   {
-    if (VirtAddVarTab[VarIdx] != VirtAddress)  /* Check each variable except the one passed as parameter */
+    if (BIT_GET(ee_valid, VarIdx) || BIT_GET(ee_dirty, VarIdx))
     {
-      /* Read the other last variable updates */
-      ReadStatus = EE_ReadVariable(VirtAddVarTab[VarIdx], &DataVar);
-      /* In case variable corresponding to the virtual address was found */
-      if (ReadStatus != 0x1)
+      Status = HAL_FLASH_Program(TYPEPROGRAM_WORD, Address, RECORD(VarIdx, ee_shadow[VarIdx]));
+      if (Status != HAL_OK)
       {
-        /* Transfer the variable to the new active page */
-        EepromStatus = EE_VerifyPageFullWriteVariable(VirtAddVarTab[VarIdx], DataVar);
-        /* If program operation was failed, a Flash error code is returned */
-        if (EepromStatus != HAL_OK)
-        {
-          return EepromStatus;
-        }
+        return Status;
       }
+      Address += RECORD_SIZE;
+      ee_stat.record_count++;
     }
   }
 
-  pEraseInit.TypeErase = TYPEERASE_SECTORS;
-  pEraseInit.Sector = OldPageId;
-  pEraseInit.NbSectors = 1;
-  pEraseInit.VoltageRange = VOLTAGE_RANGE;
-
   /* Erase the old Page: Set old Page status to ERASED status */
-  FlashStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
-  /* If erase operation was failed, a Flash error code is returned */
-  if (FlashStatus != HAL_OK)
+  Status = EE_ErasePage(OldPage);
+  if (Status != HAL_OK)
   {
-    return FlashStatus;
+    return Status;
   }
 
   /* Set new Page status to VALID_PAGE status */
-  FlashStatus = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, NewPageAddress, VALID_PAGE);
-  /* If program operation was failed, a Flash error code is returned */
-  if (FlashStatus != HAL_OK)
+  Status = HAL_FLASH_Program(TYPEPROGRAM_HALFWORD, PAGE_BASE(NewPage), VALID_PAGE);
+  if (Status != HAL_OK)
+  {
+    return Status;
+  }
+
+  ee_var_cnt = 0;
+  for (VarIdx = 0; VarIdx < NB_OF_VAR; VarIdx++)
   {
-    return FlashStatus;
+    if (BIT_GET(ee_dirty, VarIdx))
+    {
+      BIT_SET(ee_valid, VarIdx);
+    }
+    if (BIT_GET(ee_valid, VarIdx))
+    {
+      ee_var_cnt++;
+    }
   }
+  for (VarIdx = 0; VarIdx < NB_OF_VAR/32; VarIdx++)
+  {
+    ee_dirty[VarIdx] = 0;
+  }
+  ee_journal_cnt  = 0;
+  ee_journal_full = false;
 
-  /* Return last operation flash status */
-  return FlashStatus;
+  ee_page       = NewPage;
+  ee_write_addr = Address;
+  ee_stat.generation = Generation;
+  ee_stat.compact_count++;
+
+  return HAL_OK;
 }
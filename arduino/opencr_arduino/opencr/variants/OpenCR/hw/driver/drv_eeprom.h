@@ -23,6 +23,22 @@
 
 
 
+typedef struct
+{
+  uint32_t boot_time;      // us, init and building the RAM shadow
+  uint32_t write_count;    // drv_eeprom_write_byte() calls
+  uint32_t skip_count;     // writes of the value already stored
+  uint32_t record_count;   // records programmed, compactions included
+  uint32_t compact_count;  // compactions since init
+  uint32_t generation;     // compactions since format, each sector was erased about generation/2 times
+  uint32_t used;           // bytes of the active page
+  uint32_t free;
+  uint32_t var_count;      // variables stored
+  uint32_t pending;        // variables waiting in the journal
+  uint32_t flush_fail_count;  // flushes and compactions that a flash error stopped, their writes stay pending
+  uint32_t overflow_count;    // writes that found the journal full, they wait for the next compaction
+} drv_eeprom_stat_t;
+
 
 int drv_eeprom_init();
 
@@ -30,6 +46,12 @@ uint8_t  drv_eeprom_read_byte(int addr);
 void     drv_eeprom_write_byte(int index, uint8_t data_in);
 uint16_t drv_eeprom_get_length(void);
 
+// Writes between begin and end are journaled and programmed together when the outermost end is reached
+void     drv_eeprom_begin_batch(void);
+void     drv_eeprom_end_batch(void);
+bool     drv_eeprom_flush(void);
+void     drv_eeprom_get_stat(drv_eeprom_stat_t *p_stat);
+
 
 #ifdef __cplusplus
 }
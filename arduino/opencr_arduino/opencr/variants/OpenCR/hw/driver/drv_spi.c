@@ -32,6 +32,8 @@ SPI_HandleTypeDef hspi1;
 SPI_HandleTypeDef hspi2;
 SPI_HandleTypeDef hspi4;
 
+static DMA_HandleTypeDef hdma1_tx;
+static DMA_HandleTypeDef hdma1_rx;
 static DMA_HandleTypeDef hdma2_tx;
 static DMA_HandleTypeDef hdma2_rx;
 static DMA_HandleTypeDef hdma4_tx;
@@ -118,6 +120,7 @@ void drv_spi_enable_dma(SPI_HandleTypeDef* hspi)
 {
   if(hspi->Instance==SPI1)
   {
+    spi_dma[0].use = true;
   }
   else if(hspi->Instance==SPI2)
   {
@@ -174,7 +177,7 @@ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
 //  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_7, 1);    // digitalWrite(0, HIGH);
   volatile spi_dma_t *pspi_dma = drv_map_haspi_to_spi_dma(hspi);
   volatile uint32_t length;
-  if (pspi_dma && (hspi->Instance != SPI1))
+  if (pspi_dma && pspi_dma->use)
   {
     length = pspi_dma->length_left;
 
@@ -205,6 +208,11 @@ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
 
 // SPIx_DMA_TX_IRQHandler(void)
 //
+void DMA2_Stream3_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(hspi1.hdmatx);
+}
+
 void DMA1_Stream4_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(hspi2.hdmatx);
@@ -218,6 +226,11 @@ void DMA2_Stream1_IRQHandler(void)
 
 // SPIx_DMA_RX_IRQHandler(void)
 //
+void DMA2_Stream2_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(hspi1.hdmarx);
+}
+
 void DMA1_Stream3_IRQHandler(void)
 {
   HAL_DMA_IRQHandler(hspi2.hdmarx);
@@ -265,7 +278,7 @@ void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
 {
   volatile spi_dma_t *pspi_dma = drv_map_haspi_to_spi_dma(hspi);
   //HAL_GPIO_WritePin(GPIOC, GPIO_PIN_7, 1);    // digitalWrite(0, HIGH);
-  if (pspi_dma && (hspi->Instance != SPI1))
+  if (pspi_dma && pspi_dma->use)
   {
     volatile uint32_t length = pspi_dma->length_left;
     if(length > 0)
@@ -333,6 +346,64 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef* hspi)
     GPIO_InitStruct.Pin       = GPIO_PIN_5;
     GPIO_InitStruct.Alternate = GPIO_AF5_SPI1;
     HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+
+    if(spi_dma[0].use == true && spi_dma[0].init == false)
+    {
+      spi_dma[0].init = true;
+
+      bsp_mpu_config();
+
+      __HAL_RCC_DMA2_CLK_ENABLE();
+
+      /* Configure the DMA handler for Transmission process */
+      hdma1_tx.Instance                 = DMA2_Stream3;
+      hdma1_tx.Init.Channel             = DMA_CHANNEL_3;
+      hdma1_tx.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+      hdma1_tx.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_FULL;
+      hdma1_tx.Init.MemBurst            = DMA_MBURST_INC4;
+      hdma1_tx.Init.PeriphBurst         = DMA_PBURST_INC4;
+      hdma1_tx.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+      hdma1_tx.Init.PeriphInc           = DMA_PINC_DISABLE;
+      hdma1_tx.Init.MemInc              = DMA_MINC_ENABLE;
+      hdma1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+      hdma1_tx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+      hdma1_tx.Init.Mode                = DMA_NORMAL;
+      hdma1_tx.Init.Priority            = DMA_PRIORITY_HIGH;
+
+      HAL_DMA_Init(&hdma1_tx);
+
+      /* Associate the initialized DMA handle to the the SPI handle */
+      __HAL_LINKDMA(hspi, hdmatx, hdma1_tx);
+
+
+      HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 1, 1);
+      HAL_NVIC_EnableIRQ(DMA2_Stream3_IRQn);
+
+      /* Configure the DMA handler for receive process */
+      hdma1_rx.Instance                 = DMA2_Stream2;
+      hdma1_rx.Init.Channel             = DMA_CHANNEL_3;
+      hdma1_rx.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+      hdma1_rx.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_FULL;
+      hdma1_rx.Init.MemBurst            = DMA_MBURST_INC4;
+      hdma1_rx.Init.PeriphBurst         = DMA_PBURST_INC4;
+      hdma1_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+      hdma1_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
+      hdma1_rx.Init.MemInc              = DMA_MINC_ENABLE;
+      hdma1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+      hdma1_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+      hdma1_rx.Init.Mode                = DMA_NORMAL;
+      hdma1_rx.Init.Priority            = DMA_PRIORITY_HIGH;
+
+      HAL_DMA_Init(&hdma1_rx);
+
+      /* Associate the initialized DMA handle to the the SPI handle */
+      __HAL_LINKDMA(hspi, hdmarx, hdma1_rx);
+
+
+      HAL_NVIC_SetPriority(DMA2_Stream2_IRQn, 1, 1);
+      HAL_NVIC_EnableIRQ(DMA2_Stream2_IRQn);
+    }
   }
   if(hspi->Instance==SPI2)
   {
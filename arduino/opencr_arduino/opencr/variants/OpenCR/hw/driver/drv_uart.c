@@ -16,19 +16,32 @@
 
   USART3
     - RX : DMA1, Channel 4, Stream 1
-    - TX : DMA1, Channel 4, Stream 4
+    - TX : DMA1, Channel 4, Stream 3 / Channel 7, Stream 4 (both are used by SPI2, so TX is driven by TXE interrupt)
 
   USART8
     - RX : DMA1, Channel 5, Stream 6
     - TX : DMA1, Channel 5, Stream 0
+
+  TX
+    - drv_uart_write_buf() copies into the tx ring buffer and returns.
+    - The ring buffer is sent from its tail by DMA, or by TXE interrupt for USART3.
+    - The TC interrupt after the last stop bit sends the rest of the ring buffer,
+      or calls the tx done callback when the ring buffer is empty.
+    - A write to a full ring buffer, and drv_uart_flush(), wait for the tx interrupts.
+      When they can not preempt the caller (interrupts masked, or called from an
+      interrupt of the same or a higher priority) their handlers are polled instead.
+      The wait gives up after DRV_UART_TX_TIMEOUT ms without a byte sent.
 */
 #include "drv_uart.h"
+#include "drv_micros.h"
 #include "variant.h"
 
 
 //-- internal definition
 //
 #define DRV_UART_RX_BUF_LENGTH      1024
+#define DRV_UART_TX_BUF_LENGTH      1024
+#define DRV_UART_TX_TIMEOUT         10      // ms, as the blocking HAL_UART_Transmit() before the ring buffer
 
 
 //-- internal variable
@@ -37,18 +50,41 @@ static uint32_t drv_uart_rx_buf_head[DRV_UART_NUM_MAX];
 static uint32_t drv_uart_rx_buf_tail[DRV_UART_NUM_MAX];
 static uint8_t  drv_uart_rx_buf[DRV_UART_NUM_MAX][DRV_UART_RX_BUF_LENGTH] __attribute__((section(".NoneCacheableMem")));
 
+static volatile uint32_t drv_uart_tx_buf_head[DRV_UART_NUM_MAX];
+static volatile uint32_t drv_uart_tx_buf_tail[DRV_UART_NUM_MAX];
+static volatile uint32_t drv_uart_tx_length[DRV_UART_NUM_MAX];     // length being sent from the tail by DMA, 0 when idle
+static uint8_t  drv_uart_tx_buf[DRV_UART_NUM_MAX][DRV_UART_TX_BUF_LENGTH] __attribute__((section(".NoneCacheableMem")));
+static void   (*drv_uart_tx_done_func[DRV_UART_NUM_MAX])(void);
+
 
 static BOOL is_init[DRV_UART_NUM_MAX];
 static BOOL is_uart_mode[DRV_UART_NUM_MAX];
 
 UART_HandleTypeDef huart[DRV_UART_NUM_MAX];
 DMA_HandleTypeDef  hdma_rx[DRV_UART_NUM_MAX];
+DMA_HandleTypeDef  hdma_tx[DRV_UART_NUM_MAX];
 USART_TypeDef     *huart_inst[DRV_UART_NUM_MAX] = { USART6, USART2, USART3, UART8 };
 
+// the interrupts that send the ring buffer, USART3 has no tx DMA
+static const IRQn_Type drv_uart_tx_irq[DRV_UART_NUM_MAX][2] =
+{
+  { USART6_IRQn, DMA2_Stream6_IRQn },
+  { USART2_IRQn, DMA1_Stream6_IRQn },
+  { USART3_IRQn, USART3_IRQn       },
+  { UART8_IRQn,  DMA1_Stream0_IRQn },
+};
+
 
 //-- internal functions definition
 //
 void drv_uart_err_handler(uint8_t uart_num);
+void drv_uart_idle_handler(uint8_t uart_num);
+void drv_uart_tx_start(uint8_t uart_num);
+void drv_uart_tx_handler(uint8_t uart_num);
+void drv_uart_tx_isr(uint8_t uart_num);
+BOOL drv_uart_tx_irq_blocked(uint8_t uart_num);
+void drv_uart_tx_poll(uint8_t uart_num);
+BOOL drv_uart_tx_wait(uint8_t uart_num, uint32_t *p_sent, uint32_t *p_time);
 
 
 
@@ -65,6 +101,11 @@ int drv_uart_init()
 
     drv_uart_rx_buf_head[i] = 0;
     drv_uart_rx_buf_tail[i] = 0;
+
+    drv_uart_tx_buf_head[i] = 0;
+    drv_uart_tx_buf_tail[i] = 0;
+    drv_uart_tx_length[i]   = 0;
+    drv_uart_tx_done_func[i] = NULL;
   }
 
   return 0;
@@ -74,6 +115,11 @@ void drv_uart_begin(uint8_t uart_num, uint8_t uart_mode, uint32_t baudrate)
 {
   if(uart_num < DRV_UART_NUM_MAX)
   {
+    if(is_init[uart_num] == TRUE)
+    {
+      drv_uart_flush(uart_num);
+    }
+
     huart[uart_num].Instance          = huart_inst[uart_num];
     huart[uart_num].Init.BaudRate     = baudrate;
     huart[uart_num].Init.WordLength   = UART_WORDLENGTH_8B;
@@ -99,13 +145,275 @@ void drv_uart_begin(uint8_t uart_num, uint8_t uart_mode, uint32_t baudrate)
 
 uint32_t drv_uart_write(uint8_t uart_num, const uint8_t wr_data)
 {
-  HAL_UART_Transmit(&huart[uart_num], (uint8_t *)&wr_data, 1, 10);
-  return 1;
+  return drv_uart_write_buf(uart_num, &wr_data, 1);
+}
+
+uint32_t drv_uart_write_buf(uint8_t uart_num, const uint8_t *p_data, uint32_t length)
+{
+  uint32_t i;
+  uint32_t head;
+  uint32_t sent;
+  uint32_t t_time;
+
+
+  if(uart_num >= DRV_UART_NUM_MAX || is_init[uart_num] != TRUE)
+  {
+    return 0;
+  }
+
+  for(i=0; i<length; i++)
+  {
+    // wait for the tx interrupt to make room only when the ring buffer is full
+    if(drv_uart_tx_available(uart_num) == 0)
+    {
+      sent   = 0xFFFFFFFF;
+      t_time = drv_micros();
+
+      while(drv_uart_tx_available(uart_num) == 0)
+      {
+        if(drv_uart_tx_wait(uart_num, &sent, &t_time) != TRUE)
+        {
+          return i;
+        }
+      }
+    }
+
+    head = drv_uart_tx_buf_head[uart_num];
+    drv_uart_tx_buf[uart_num][head] = p_data[i];
+    drv_uart_tx_buf_head[uart_num] = (head + 1) % DRV_UART_TX_BUF_LENGTH;
+  }
+
+  drv_uart_tx_start(uart_num);
+
+  return length;
+}
+
+uint32_t drv_uart_tx_available(uint8_t uart_num)
+{
+  return (  DRV_UART_TX_BUF_LENGTH - 1
+          + drv_uart_tx_buf_tail[uart_num]
+          - drv_uart_tx_buf_head[uart_num] ) % DRV_UART_TX_BUF_LENGTH;
+}
+
+BOOL drv_uart_tx_done(uint8_t uart_num)
+{
+  if(drv_uart_tx_length[uart_num] == 0 && drv_uart_tx_buf_head[uart_num] == drv_uart_tx_buf_tail[uart_num])
+  {
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+void drv_uart_set_tx_done_callback(uint8_t uart_num, void (*p_func)(void))
+{
+  if(uart_num < DRV_UART_NUM_MAX)
+  {
+    drv_uart_tx_done_func[uart_num] = p_func;
+  }
 }
 
 void drv_uart_flush(uint8_t uart_num)
 {
-  UNUSED(uart_num);
+  uint32_t sent;
+  uint32_t t_time;
+
+
+  sent   = 0xFFFFFFFF;
+  t_time = drv_micros();
+
+  while(drv_uart_tx_done(uart_num) != TRUE)
+  {
+    if(drv_uart_tx_wait(uart_num, &sent, &t_time) != TRUE)
+    {
+      break;
+    }
+  }
+}
+
+BOOL drv_uart_tx_irq_blocked(uint8_t uart_num)
+{
+  uint32_t exception;
+  uint32_t basepri;
+  uint32_t priority;
+  uint32_t tx_priority;
+
+
+  if(__get_PRIMASK() != 0)
+  {
+    return TRUE;
+  }
+
+  // the tx interrupts need both of theirs to run, so the lower priority (higher number) counts
+  tx_priority = NVIC_GetPriority(drv_uart_tx_irq[uart_num][0]);
+  priority    = NVIC_GetPriority(drv_uart_tx_irq[uart_num][1]);
+  if(priority > tx_priority) tx_priority = priority;
+
+  basepri = __get_BASEPRI() >> (8 - __NVIC_PRIO_BITS);
+  if(basepri != 0 && basepri <= tx_priority)
+  {
+    return TRUE;
+  }
+
+  exception = __get_IPSR();
+  if(exception == 0)
+  {
+    return FALSE;
+  }
+  if(exception < 4)
+  {
+    // NMI and HardFault
+    return TRUE;
+  }
+
+  priority = NVIC_GetPriority((IRQn_Type)((int32_t)exception - 16));
+
+  return (priority <= tx_priority) ? TRUE : FALSE;
+}
+
+void drv_uart_tx_poll(uint8_t uart_num)
+{
+  // runs the tx interrupt handlers by hand, they check their own flags
+  if(huart[uart_num].hdmatx != NULL)
+  {
+    HAL_DMA_IRQHandler(huart[uart_num].hdmatx);
+    HAL_UART_IRQHandler(&huart[uart_num]);
+  }
+  else
+  {
+    drv_uart_tx_isr(uart_num);
+  }
+}
+
+BOOL drv_uart_tx_wait(uint8_t uart_num, uint32_t *p_sent, uint32_t *p_time)
+{
+  uint32_t sent;
+
+
+  drv_uart_tx_start(uart_num);
+
+  if(drv_uart_tx_irq_blocked(uart_num) == TRUE)
+  {
+    drv_uart_tx_poll(uart_num);
+  }
+
+  // bytes sent so far, the DMA counter moves within a transfer
+  sent = drv_uart_tx_buf_tail[uart_num];
+  if(huart[uart_num].hdmatx != NULL && drv_uart_tx_length[uart_num] > 0)
+  {
+    sent += drv_uart_tx_length[uart_num] - __HAL_DMA_GET_COUNTER(huart[uart_num].hdmatx);
+  }
+
+  if(sent != *p_sent)
+  {
+    *p_sent = sent;
+    *p_time = drv_micros();
+  }
+  else if(drv_micros() - *p_time >= DRV_UART_TX_TIMEOUT * 1000)
+  {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+void drv_uart_tx_start(uint8_t uart_num)
+{
+  uint32_t primask;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t length;
+
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  head = drv_uart_tx_buf_head[uart_num];
+  tail = drv_uart_tx_buf_tail[uart_num];
+
+  if(drv_uart_tx_length[uart_num] == 0 && head != tail)
+  {
+    // send up to the end of the ring buffer, the rest is sent at the next tx complete
+    if(head > tail) length = head - tail;
+    else            length = DRV_UART_TX_BUF_LENGTH - tail;
+
+    if(huart[uart_num].hdmatx != NULL)
+    {
+      drv_uart_tx_length[uart_num] = length;
+
+      if(HAL_UART_Transmit_DMA(&huart[uart_num], &drv_uart_tx_buf[uart_num][tail], length) != HAL_OK)
+      {
+        drv_uart_tx_length[uart_num] = 0;
+      }
+    }
+    else
+    {
+      // drv_uart_tx_isr() sends byte by byte, the length only marks the uart as busy
+      drv_uart_tx_length[uart_num] = 1;
+      __HAL_UART_DISABLE_IT(&huart[uart_num], UART_IT_TC);
+      __HAL_UART_ENABLE_IT(&huart[uart_num], UART_IT_TXE);
+    }
+  }
+
+  __set_PRIMASK(primask);
+}
+
+void drv_uart_tx_handler(uint8_t uart_num)
+{
+  drv_uart_tx_buf_tail[uart_num] = (drv_uart_tx_buf_tail[uart_num] + drv_uart_tx_length[uart_num]) % DRV_UART_TX_BUF_LENGTH;
+  drv_uart_tx_length[uart_num]   = 0;
+
+  if(drv_uart_tx_buf_head[uart_num] != drv_uart_tx_buf_tail[uart_num])
+  {
+    drv_uart_tx_start(uart_num);
+  }
+  else if(drv_uart_tx_done_func[uart_num] != NULL)
+  {
+    (*drv_uart_tx_done_func[uart_num])();
+  }
+}
+
+void drv_uart_tx_isr(uint8_t uart_num)
+{
+  UART_HandleTypeDef *p_huart = &huart[uart_num];
+  uint32_t tail;
+
+
+  // handled here before HAL_UART_IRQHandler(), which only knows the transfers started by HAL
+  if(__HAL_UART_GET_IT_SOURCE(p_huart, UART_IT_TXE) != RESET && __HAL_UART_GET_FLAG(p_huart, UART_FLAG_TXE) != RESET)
+  {
+    tail = drv_uart_tx_buf_tail[uart_num];
+
+    if(tail != drv_uart_tx_buf_head[uart_num])
+    {
+      p_huart->Instance->TDR = drv_uart_tx_buf[uart_num][tail];
+      drv_uart_tx_buf_tail[uart_num] = (tail + 1) % DRV_UART_TX_BUF_LENGTH;
+    }
+    else
+    {
+      __HAL_UART_DISABLE_IT(p_huart, UART_IT_TXE);
+      __HAL_UART_ENABLE_IT(p_huart, UART_IT_TC);
+    }
+  }
+
+  if(__HAL_UART_GET_IT_SOURCE(p_huart, UART_IT_TC) != RESET && __HAL_UART_GET_FLAG(p_huart, UART_FLAG_TC) != RESET)
+  {
+    __HAL_UART_DISABLE_IT(p_huart, UART_IT_TC);
+
+    if(drv_uart_tx_buf_tail[uart_num] != drv_uart_tx_buf_head[uart_num])
+    {
+      __HAL_UART_ENABLE_IT(p_huart, UART_IT_TXE);
+    }
+    else
+    {
+      drv_uart_tx_length[uart_num] = 0;
+
+      if(drv_uart_tx_done_func[uart_num] != NULL)
+      {
+        (*drv_uart_tx_done_func[uart_num])();
+      }
+    }
+  }
 }
 
 void drv_uart_start_rx(uint8_t uart_num)
@@ -117,6 +425,9 @@ void drv_uart_start_rx(uint8_t uart_num)
   else
   {
     HAL_UART_Receive_DMA(&huart[uart_num], (uint8_t *)drv_uart_rx_buf[uart_num], DRV_UART_RX_BUF_LENGTH );
+
+    // DMA receives without an interrupt per byte, so the idle line interrupt wakes up a core sleeping in __WFI()
+    __HAL_UART_ENABLE_IT(&huart[uart_num], UART_IT_IDLE);
   }
 }
 
@@ -173,6 +484,14 @@ int drv_uart_read(uint8_t uart_num)
     return ret;
 }
 
+void drv_uart_idle_handler(uint8_t uart_num)
+{
+  if(__HAL_UART_GET_FLAG(&huart[uart_num], UART_FLAG_IDLE) != RESET)
+  {
+    __HAL_UART_CLEAR_IDLEFLAG(&huart[uart_num]);
+  }
+}
+
 void drv_uart_err_handler(uint8_t uart_num)
 {
   if(is_uart_mode[uart_num] == DRV_UART_IRQ_MODE)
@@ -196,11 +515,14 @@ void USART6_IRQHandler(void)
 
 void USART2_IRQHandler(void)
 {
+  drv_uart_idle_handler(DRV_UART_NUM_2);
   HAL_UART_IRQHandler(&huart[DRV_UART_NUM_2]);
 }
 
 void USART3_IRQHandler(void)
 {
+  drv_uart_idle_handler(DRV_UART_NUM_3);
+  drv_uart_tx_isr(DRV_UART_NUM_3);
   HAL_UART_IRQHandler(&huart[DRV_UART_NUM_3]);
 }
 
@@ -211,11 +533,10 @@ void UART8_IRQHandler(void)
 
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *UartHandle)
 {
-  UNUSED(UartHandle);
-
-  //if( UartHandle->Instance == USART6 ) Tx1_Handler();
-  //if( UartHandle->Instance == USART2 ) Tx2_Handler();
-  //if( UartHandle->Instance == USART3 ) Tx3_Handler();
+  // called at the TC interrupt after the DMA transfer
+  if( UartHandle->Instance == huart_inst[DRV_UART_NUM_1] ) drv_uart_tx_handler(DRV_UART_NUM_1);
+  if( UartHandle->Instance == huart_inst[DRV_UART_NUM_2] ) drv_uart_tx_handler(DRV_UART_NUM_2);
+  if( UartHandle->Instance == huart_inst[DRV_UART_NUM_4] ) drv_uart_tx_handler(DRV_UART_NUM_4);
 }
 
 
@@ -252,6 +573,24 @@ void DMA1_Stream1_IRQHandler(void)
   HAL_DMA_IRQHandler(huart[DRV_UART_NUM_3].hdmarx);
 }
 
+// UART1 TX DMA IRQ
+void DMA2_Stream6_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(huart[DRV_UART_NUM_1].hdmatx);
+}
+
+// UART2 TX DMA IRQ
+void DMA1_Stream6_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(huart[DRV_UART_NUM_2].hdmatx);
+}
+
+// UART4 TX DMA IRQ
+void DMA1_Stream0_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(huart[DRV_UART_NUM_4].hdmatx);
+}
+
 
 void HAL_UART_MspInit(UART_HandleTypeDef* huart)
 {
@@ -268,6 +607,7 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart)
 
     /* Peripheral clock enable */
     __HAL_RCC_USART6_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
 
     GPIO_InitStruct.Pin       = GPIO_PIN_6;
     GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
@@ -281,6 +621,27 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart)
     GPIO_InitStruct.Alternate = GPIO_AF8_USART6;
     HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
 
+
+    // DMA Setup
+    /* Configure the DMA handler for transmission process */
+    hdma_tx[DRV_UART_NUM_1].Instance                 = DMA2_Stream6;
+    hdma_tx[DRV_UART_NUM_1].Init.Channel             = DMA_CHANNEL_5;
+    hdma_tx[DRV_UART_NUM_1].Init.Direction           = DMA_MEMORY_TO_PERIPH;
+    hdma_tx[DRV_UART_NUM_1].Init.PeriphInc           = DMA_PINC_DISABLE;
+    hdma_tx[DRV_UART_NUM_1].Init.MemInc              = DMA_MINC_ENABLE;
+    hdma_tx[DRV_UART_NUM_1].Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_tx[DRV_UART_NUM_1].Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    hdma_tx[DRV_UART_NUM_1].Init.Mode                = DMA_NORMAL;
+    hdma_tx[DRV_UART_NUM_1].Init.Priority            = DMA_PRIORITY_LOW;
+
+    HAL_DMA_Init(&hdma_tx[DRV_UART_NUM_1]);
+
+    /* Associate the initialized DMA handle to the the UART handle */
+    __HAL_LINKDMA(huart, hdmatx, hdma_tx[DRV_UART_NUM_1]);
+
+    HAL_NVIC_SetPriority(DMA2_Stream6_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream6_IRQn);
+
     /* Peripheral interrupt init */
     HAL_NVIC_SetPriority(USART6_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ  (USART6_IRQn);
@@ -331,6 +692,25 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart)
     HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
 
 
+    /* Configure the DMA handler for transmission process */
+    hdma_tx[DRV_UART_NUM_2].Instance                 = DMA1_Stream6;
+    hdma_tx[DRV_UART_NUM_2].Init.Channel             = DMA_CHANNEL_4;
+    hdma_tx[DRV_UART_NUM_2].Init.Direction           = DMA_MEMORY_TO_PERIPH;
+    hdma_tx[DRV_UART_NUM_2].Init.PeriphInc           = DMA_PINC_DISABLE;
+    hdma_tx[DRV_UART_NUM_2].Init.MemInc              = DMA_MINC_ENABLE;
+    hdma_tx[DRV_UART_NUM_2].Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_tx[DRV_UART_NUM_2].Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    hdma_tx[DRV_UART_NUM_2].Init.Mode                = DMA_NORMAL;
+    hdma_tx[DRV_UART_NUM_2].Init.Priority            = DMA_PRIORITY_LOW;
+
+    HAL_DMA_Init(&hdma_tx[DRV_UART_NUM_2]);
+
+    __HAL_LINKDMA(huart, hdmatx, hdma_tx[DRV_UART_NUM_2]);
+
+    HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+
+
     /* Peripheral interrupt init */
     HAL_NVIC_SetPriority(USART2_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ  (USART2_IRQn);
@@ -393,6 +773,7 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart)
 
     /* Peripheral clock enable */
     __HAL_RCC_UART8_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
 
     GPIO_InitStruct.Pin       = GPIO_PIN_1;
     GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
@@ -406,6 +787,26 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart)
     GPIO_InitStruct.Alternate = GPIO_AF8_UART8;
     HAL_GPIO_Init(GPIOE, &GPIO_InitStruct);
 
+
+    // DMA Setup
+    /* Configure the DMA handler for transmission process */
+    hdma_tx[DRV_UART_NUM_4].Instance                 = DMA1_Stream0;
+    hdma_tx[DRV_UART_NUM_4].Init.Channel             = DMA_CHANNEL_5;
+    hdma_tx[DRV_UART_NUM_4].Init.Direction           = DMA_MEMORY_TO_PERIPH;
+    hdma_tx[DRV_UART_NUM_4].Init.PeriphInc           = DMA_PINC_DISABLE;
+    hdma_tx[DRV_UART_NUM_4].Init.MemInc              = DMA_MINC_ENABLE;
+    hdma_tx[DRV_UART_NUM_4].Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_tx[DRV_UART_NUM_4].Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    hdma_tx[DRV_UART_NUM_4].Init.Mode                = DMA_NORMAL;
+    hdma_tx[DRV_UART_NUM_4].Init.Priority            = DMA_PRIORITY_LOW;
+
+    HAL_DMA_Init(&hdma_tx[DRV_UART_NUM_4]);
+
+    __HAL_LINKDMA(huart, hdmatx, hdma_tx[DRV_UART_NUM_4]);
+
+    HAL_NVIC_SetPriority(DMA1_Stream0_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream0_IRQn);
+
     /* Peripheral interrupt init */
     HAL_NVIC_SetPriority(UART8_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ  (UART8_IRQn);
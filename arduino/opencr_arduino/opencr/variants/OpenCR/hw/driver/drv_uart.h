@@ -34,6 +34,10 @@
 int      drv_uart_init();
 void     drv_uart_begin(uint8_t uart_num, uint8_t uart_mode, uint32_t baudrate);
 uint32_t drv_uart_write(uint8_t uart_num, const uint8_t wr_data);
+uint32_t drv_uart_write_buf(uint8_t uart_num, const uint8_t *p_data, uint32_t length);
+uint32_t drv_uart_tx_available(uint8_t uart_num);
+BOOL     drv_uart_tx_done(uint8_t uart_num);
+void     drv_uart_set_tx_done_callback(uint8_t uart_num, void (*p_func)(void));
 void     drv_uart_flush(uint8_t uart_num);
 void     drv_uart_start_rx(uint8_t uart_num);
 uint32_t drv_uart_read_buf(uint8_t uart_num, uint8_t *p_buf, uint32_t length);
@@ -97,6 +97,32 @@ int32_t vcp_write(uint8_t *p_data, uint32_t length)
 }
 
 
+uint32_t vcp_tx_available(void)
+{
+  return CDC_Itf_TxAvailable();
+}
+
+
+uint8_t *vcp_tx_reserve(uint32_t length)
+{
+  uint8_t *p_buf;
+
+  p_buf = CDC_Itf_TxReserve( length );
+
+  if(p_buf == NULL)
+  {
+    usb_cdc_debug_cnt[1]++;
+  }
+  return p_buf;
+}
+
+
+void vcp_tx_commit(uint32_t length)
+{
+  CDC_Itf_TxCommit( length );
+}
+
+
 int32_t vcp_printf( const char *fmt, ...)
 {
   int32_t ret = 0;
@@ -27,6 +27,9 @@ BOOL     vcp_is_connected(void);
 void     vcp_putch(uint8_t ch);
 uint8_t  vcp_getch(void);
 int32_t  vcp_write(uint8_t *p_data, uint32_t length);
+uint32_t vcp_tx_available(void);
+uint8_t *vcp_tx_reserve(uint32_t length);
+void     vcp_tx_commit(uint32_t length);
 
 int32_t  vcp_printf( const char *fmt, ...);
 
@@ -34,7 +34,7 @@
 /* Private define ------------------------------------------------------------*/
 #define APP_RX_BUF_SIZE   (1024*16)
 #define APP_RX_DATA_SIZE  (1024*2)
-#define APP_TX_DATA_SIZE  (1024*2)
+#define APP_TX_DATA_SIZE  (1024*4)
 
 
 const char *JUMP_BOOT_STR = "OpenCR 5555AAAA";
@@ -55,8 +55,7 @@ uint8_t CDC_Reset_Status = 0;
 uint8_t CDC_Reset_Status_Baud = 0;
 
 uint8_t UserRxBuffer[APP_RX_DATA_SIZE];/* Received Data over USB are stored in this buffer */
-uint8_t UserTxBuffer[APP_TX_DATA_SIZE];/* Received Data over UART (CDC interface) are stored in this buffer */
-uint8_t UserTxBufferForUSB[APP_TX_DATA_SIZE];/* Received Data over UART (CDC interface) are stored in this buffer */
+uint8_t UserTxBuffer[APP_TX_DATA_SIZE];/* Data to send over USB, the IN endpoint reads it from here directly */
 
 uint32_t BuffLength;
 static uint32_t UserTxBufPtrIn = 0;/* Increment this pointer or roll it back to
@@ -66,6 +65,10 @@ static uint32_t UserTxBufPtrOut = 0; /* Increment this pointer or roll it back t
 static uint16_t UserTxBufPtrOutShadow = 0; // shadow of above
 static uint8_t  UserTxBufPtrWaitCount = 0; // used to implement a timeout waiting for low-level USB driver
 static uint8_t  UserTxNeedEmptyPacket = 0; // used to flush the USB IN endpoint if the last packet was exactly the endpoint packet size
+static uint32_t UserTxBufPtrEnd = APP_TX_DATA_SIZE; // end of the data when a reserved block wrapped early to stay contiguous
+static uint32_t UserTxBufInFlight = 0;     // bytes the IN endpoint is sending, freed on transmit complete
+static uint32_t UserTxBufPtrReserve = 0;   // start of the block given out by CDC_Itf_TxReserve()
+static BOOL     UserTxReserved = FALSE;
 
 static BOOL is_opened = FALSE;
 static BOOL is_reopen = FALSE;
@@ -89,7 +92,8 @@ static int8_t CDC_Itf_DeInit(void);
 static int8_t CDC_Itf_Control(uint8_t cmd, uint8_t* pbuf, uint16_t length);
        void   CDC_Itf_TxISR(void);
 static int8_t CDC_Itf_Receive(uint8_t* pbuf, uint32_t *Len);
-static uint32_t CDC_Itf_TxAvailable( void );
+static int8_t CDC_Itf_TransmitCplt(uint8_t* pbuf, uint32_t *Len, uint8_t epnum);
+static void     CDC_Itf_TxRollback( void );
 
 
 
@@ -98,7 +102,8 @@ USBD_CDC_ItfTypeDef USBD_CDC_fops =
   CDC_Itf_Init,
   CDC_Itf_DeInit,
   CDC_Itf_Control,
-  CDC_Itf_Receive
+  CDC_Itf_Receive,
+  CDC_Itf_TransmitCplt
 };
 
 uint32_t usb_cdc_bitrate = 0;
@@ -113,7 +118,7 @@ uint32_t usb_cdc_bitrate = 0;
   */
 static int8_t CDC_Itf_Init(void)
 {
-  USBD_CDC_SetTxBuffer(&USBD_Device, UserTxBufferForUSB, 0);
+  USBD_CDC_SetTxBuffer(&USBD_Device, UserTxBuffer, 0);
   USBD_CDC_SetRxBuffer(&USBD_Device, UserRxBuffer);
   is_opened = FALSE;
   LineCoding.bitrate = 0;
@@ -125,6 +130,9 @@ static int8_t CDC_Itf_Init(void)
   UserTxBufPtrOutShadow = 0;
   UserTxBufPtrWaitCount = 0;
   UserTxNeedEmptyPacket = 0;
+  UserTxBufPtrEnd       = APP_TX_DATA_SIZE;
+  UserTxBufInFlight     = 0;
+  UserTxReserved        = FALSE;
 
   rxd_length            = 0;
   rxd_BufPtrIn          = 0;
@@ -258,16 +266,18 @@ void CDC_Itf_TxISR(void)
   {
     return;
   }
-  if(hcdc->TxState != 0)
+  if(hcdc->TxState != 0 || UserTxBufInFlight > 0)
   {
     return;
   }
 
+  CDC_Itf_TxRollback();
+
   if(UserTxBufPtrOut != UserTxBufPtrIn)
   {
     if(UserTxBufPtrOut > UserTxBufPtrIn) /* Rollback */
     {
-      buffsize = APP_TX_DATA_SIZE - UserTxBufPtrOut;
+      buffsize = UserTxBufPtrEnd - UserTxBufPtrOut;
     }
     else
     {
@@ -282,20 +292,58 @@ void CDC_Itf_TxISR(void)
 
     buffptr = UserTxBufPtrOut;
 
-    memcpy(UserTxBufferForUSB, (uint8_t*)&UserTxBuffer[buffptr], buffsize);
-    USBD_CDC_SetTxBuffer(&USBD_Device, UserTxBufferForUSB, buffsize);
+    // No copy: the data stays in the ring until CDC_Itf_TransmitCplt() frees it
+    USBD_CDC_SetTxBuffer(&USBD_Device, (uint8_t*)&UserTxBuffer[buffptr], buffsize);
 
     if(USBD_CDC_TransmitPacket(&USBD_Device) == USBD_OK)
     {
-      UserTxBufPtrOut += buffsize;
-      if (UserTxBufPtrOut == APP_TX_DATA_SIZE)
-      {
-        UserTxBufPtrOut = 0;
-      }
+      UserTxBufInFlight = buffsize;
     }
   }
 }
 
+/**
+  * @brief  CDC_Itf_TransmitCplt
+  *         Frees the data the IN endpoint has sent and starts the next transfer
+  *         at once, instead of waiting for the next SOF
+  * @param  Buf: Buffer of data that was sent
+  * @param  Len: Number of data sent (in bytes)
+  * @param  epnum: IN endpoint number
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t CDC_Itf_TransmitCplt(uint8_t *Buf, uint32_t *Len, uint8_t epnum)
+{
+  UNUSED(Buf);
+  UNUSED(Len);
+  UNUSED(epnum);
+
+  UserTxBufPtrOut  += UserTxBufInFlight;
+  UserTxBufInFlight = 0;
+
+  if (UserTxBufPtrOut == APP_TX_DATA_SIZE)
+  {
+    UserTxBufPtrOut = 0;
+  }
+
+  CDC_Itf_TxISR();
+
+  return (USBD_OK);
+}
+
+/*---------------------------------------------------------------------------
+     TITLE   : CDC_Itf_TxRollback
+     WORK    : Moves the read pointer back to the start once it has sent
+               everything up to an early end of the data
+---------------------------------------------------------------------------*/
+static void CDC_Itf_TxRollback( void )
+{
+  if (UserTxBufPtrOut > UserTxBufPtrIn && UserTxBufPtrOut >= UserTxBufPtrEnd)
+  {
+    UserTxBufPtrOut = 0;
+    UserTxBufPtrEnd = APP_TX_DATA_SIZE;
+  }
+}
+
 /**
   * @brief  CDC_Itf_DataRx
   *         Data received over USB OUT endpoint are sent over CDC interface
@@ -382,6 +430,11 @@ int32_t CDC_Itf_Write( uint8_t *p_buf, uint32_t length )
   {
     return -1;
   }
+  if (UserTxReserved == TRUE)
+  {
+    // a frame is being built in place, bytes written now would land inside it
+    return -1;
+  }
   if (length >= CDC_Itf_TxAvailable())
   {
     return 0;
@@ -405,6 +458,7 @@ int32_t CDC_Itf_Write( uint8_t *p_buf, uint32_t length )
     }
   }
   UserTxBufPtrIn = ptr_index;
+  CDC_Itf_TxISR();
   __enable_irq();
 
   return length;
@@ -561,5 +615,116 @@ BOOL CDC_Itf_IsTxTransmitted( void )
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : CDC_Itf_TxReserve
+     WORK    : Gives out a contiguous block of the tx ring to build data in
+               place, NULL when there is no room right now. It never waits.
+               Only one block is out at a time, CDC_Itf_TxCommit() ends it.
+---------------------------------------------------------------------------*/
+uint8_t *CDC_Itf_TxReserve( uint32_t length )
+{
+  uint32_t index;
+  BOOL     is_found = FALSE;
+
+
+  if( USBD_Device.pClassData == NULL )
+  {
+    return NULL;
+  }
+  if( is_opened == FALSE && is_reopen == FALSE )
+  {
+    return NULL;
+  }
+  if( USBD_Device.dev_state != USBD_STATE_CONFIGURED )
+  {
+    return NULL;
+  }
+  if( UserTxReserved == TRUE )
+  {
+    return NULL;
+  }
+
+  __disable_irq();
+
+  // An empty ring starts over, so the whole of it is contiguous again
+  if (UserTxBufPtrIn == UserTxBufPtrOut)
+  {
+    UserTxBufPtrIn  = 0;
+    UserTxBufPtrOut = 0;
+  }
+
+  index = UserTxBufPtrIn;
+
+  if (UserTxBufPtrIn >= UserTxBufPtrOut)
+  {
+    // In may reach the end only if Out has left the start, or the ring would look empty
+    if (APP_TX_DATA_SIZE - UserTxBufPtrIn - (UserTxBufPtrOut == 0 ? 1 : 0) >= length)
+    {
+      is_found = TRUE;
+    }
+    else if (UserTxBufPtrOut > length)
+    {
+      index    = 0;
+      is_found = TRUE;
+    }
+  }
+  else if (UserTxBufPtrOut - UserTxBufPtrIn > length)
+  {
+    is_found = TRUE;
+  }
+
+  if (is_found == TRUE)
+  {
+    UserTxBufPtrReserve = index;
+    UserTxReserved      = TRUE;
+  }
+
+  __enable_irq();
+
+  if (is_found == FALSE)
+  {
+    return NULL;
+  }
+
+  return &UserTxBuffer[index];
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : CDC_Itf_TxCommit
+     WORK    : Queues the first length bytes of the reserved block and hands
+               them to the IN endpoint right away. 0 gives the block back.
+---------------------------------------------------------------------------*/
+void CDC_Itf_TxCommit( uint32_t length )
+{
+  if( UserTxReserved == FALSE )
+  {
+    return;
+  }
+
+  __disable_irq();
+
+  if (length > 0)
+  {
+    if (UserTxBufPtrReserve != UserTxBufPtrIn)
+    {
+      // the block wrapped to the start, this lap of data ends where In was
+      UserTxBufPtrEnd = UserTxBufPtrIn;
+    }
+
+    UserTxBufPtrIn = UserTxBufPtrReserve + length;
+    if (UserTxBufPtrIn == APP_TX_DATA_SIZE)
+    {
+      UserTxBufPtrIn = 0;
+    }
+  }
+  UserTxReserved = FALSE;
+
+  CDC_Itf_TxISR();
+
+  __enable_irq();
+}
+
+
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
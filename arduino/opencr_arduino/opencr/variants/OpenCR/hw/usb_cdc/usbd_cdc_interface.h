@@ -46,10 +46,13 @@ extern USBD_CDC_ItfTypeDef  USBD_CDC_fops;
 int32_t  CDC_Itf_Write( uint8_t *p_buf, uint32_t length );
 BOOL     CDC_Itf_IsAvailable( void );
 uint32_t CDC_Itf_Available( void );
+uint32_t CDC_Itf_TxAvailable( void );
 uint8_t  CDC_Itf_Getch( void );
 int32_t  CDC_Itf_Peek( void );
 BOOL     CDC_Itf_IsConnected( void );
 BOOL     CDC_Itf_IsTxTransmitted( void );
+uint8_t *CDC_Itf_TxReserve( uint32_t length );
+void     CDC_Itf_TxCommit( uint32_t length );
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
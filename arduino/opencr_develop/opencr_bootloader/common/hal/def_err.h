@@ -29,6 +29,7 @@ typedef uint16_t err_code_t;
 #define ERR_FLASH_PACKET_SIZE               0x0017
 #define ERR_FLASH_SIZE         		    0x0018
 #define ERR_FLASH_CRC         		    0x0019
+#define ERR_FLASH_PACKET_LOST               0x001A
 
 
 
@@ -30,7 +30,7 @@ err_code_t flash_write(uint32_t addr, uint8_t *p_data, uint32_t length)
 
   WriteSize = length / 4; // 32Bit
 
-  if( (WriteSize%4) > 0 ) WriteSize++;
+  if( (length%4) > 0 ) WriteSize++;
 
   DataIndex = 0;
   HAL_FLASH_Unlock();
@@ -131,6 +131,55 @@ err_code_t flash_erase_fw_block( uint32_t length )
 }
 
 
+/*
+ * offset and length from the firmware start, the sectors holding them
+ * are erased. offset must be on a sector boundary
+ */
+err_code_t flash_erase_fw_sectors( uint32_t offset, uint32_t length )
+{
+
+  err_code_t err_code = OK;
+  HAL_StatusTypeDef HAL_FLASHStatus = HAL_OK;
+  FLASH_EraseInitTypeDef pEraseInit;
+  uint32_t SectorError;
+  uint32_t sector_first;
+  uint32_t sector_cnt;
+
+
+  if( offset%(256*1024) > 0 || length == 0 )
+  {
+    return ERR_FLASH_SIZE;
+  }
+
+  sector_first = offset/(256*1024);
+  sector_cnt   = length/(256*1024);
+  if( length%(256*1024) > 0 )
+  {
+    sector_cnt++;
+  }
+  if( sector_first + sector_cnt > (FLASH_SECTOR_TOTAL-FLASH_SECTOR_5) )
+  {
+    return ERR_FLASH_SIZE;
+  }
+
+  pEraseInit.TypeErase = FLASH_TYPEERASE_SECTORS;
+  pEraseInit.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+  pEraseInit.Sector = FLASH_SECTOR_5 + sector_first;
+  pEraseInit.NbSectors = sector_cnt;
+
+  HAL_FLASH_Unlock();
+
+  HAL_FLASHStatus = HAL_FLASHEx_Erase(&pEraseInit, &SectorError);
+  if(HAL_FLASHStatus != HAL_OK)
+  {
+    err_code = ERR_FLASH_ERASE;
+  }
+
+  HAL_FLASH_Lock();
+
+  return err_code;
+}
+
 err_code_t flash_erase_sector(uint32_t sector)
 {
   err_code_t err_code = OK;
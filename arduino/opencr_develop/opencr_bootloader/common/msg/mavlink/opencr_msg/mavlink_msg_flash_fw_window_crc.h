@@ -0,0 +1,237 @@
+// MESSAGE FLASH_FW_WINDOW_CRC PACKING
+
+#define MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC 164
+
+typedef struct MAVLINK_PACKED __mavlink_flash_fw_window_crc_t
+{
+ uint32_t addr; /*< block offset*/
+ uint32_t crc; /*< CRC32 of the block*/
+} mavlink_flash_fw_window_crc_t;
+
+#define MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN 8
+#define MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_MIN_LEN 8
+#define MAVLINK_MSG_ID_164_LEN 8
+#define MAVLINK_MSG_ID_164_MIN_LEN 8
+
+#define MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_CRC 218
+#define MAVLINK_MSG_ID_164_CRC 218
+
+
+
+#if MAVLINK_COMMAND_24BIT
+#define MAVLINK_MESSAGE_INFO_FLASH_FW_WINDOW_CRC { \
+	164, \
+	"FLASH_FW_WINDOW_CRC", \
+	2, \
+	{  { "addr", NULL, MAVLINK_TYPE_UINT32_T, 0, 0, offsetof(mavlink_flash_fw_window_crc_t, addr) }, \
+         { "crc", NULL, MAVLINK_TYPE_UINT32_T, 0, 4, offsetof(mavlink_flash_fw_window_crc_t, crc) }, \
+         } \
+}
+#else
+#define MAVLINK_MESSAGE_INFO_FLASH_FW_WINDOW_CRC { \
+	"FLASH_FW_WINDOW_CRC", \
+	2, \
+	{  { "addr", NULL, MAVLINK_TYPE_UINT32_T, 0, 0, offsetof(mavlink_flash_fw_window_crc_t, addr) }, \
+         { "crc", NULL, MAVLINK_TYPE_UINT32_T, 0, 4, offsetof(mavlink_flash_fw_window_crc_t, crc) }, \
+         } \
+}
+#endif
+
+/**
+ * @brief Pack a flash_fw_window_crc message
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ *
+ * @param addr block offset
+ * @param crc CRC32 of the block
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_flash_fw_window_crc_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg,
+						       uint32_t addr, uint32_t crc)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN];
+	_mav_put_uint32_t(buf, 0, addr);
+	_mav_put_uint32_t(buf, 4, crc);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN);
+#else
+	mavlink_flash_fw_window_crc_t packet;
+	packet.addr = addr;
+	packet.crc = crc;
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_CRC);
+}
+
+/**
+ * @brief Pack a flash_fw_window_crc message on a channel
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param chan The MAVLink channel this message will be sent over
+ * @param msg The MAVLink message to compress the data into
+ * @param addr block offset
+ * @param crc CRC32 of the block
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_flash_fw_window_crc_pack_chan(uint8_t system_id, uint8_t component_id, uint8_t chan,
+							   mavlink_message_t* msg,
+						           uint32_t addr,uint32_t crc)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN];
+	_mav_put_uint32_t(buf, 0, addr);
+	_mav_put_uint32_t(buf, 4, crc);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN);
+#else
+	mavlink_flash_fw_window_crc_t packet;
+	packet.addr = addr;
+	packet.crc = crc;
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC;
+    return mavlink_finalize_message_chan(msg, system_id, component_id, chan, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_CRC);
+}
+
+/**
+ * @brief Encode a flash_fw_window_crc struct
+ *
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ * @param flash_fw_window_crc C-struct to read the message contents from
+ */
+static inline uint16_t mavlink_msg_flash_fw_window_crc_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_flash_fw_window_crc_t* flash_fw_window_crc)
+{
+	return mavlink_msg_flash_fw_window_crc_pack(system_id, component_id, msg, flash_fw_window_crc->addr, flash_fw_window_crc->crc);
+}
+
+/**
+ * @brief Encode a flash_fw_window_crc struct on a channel
+ *
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param chan The MAVLink channel this message will be sent over
+ * @param msg The MAVLink message to compress the data into
+ * @param flash_fw_window_crc C-struct to read the message contents from
+ */
+static inline uint16_t mavlink_msg_flash_fw_window_crc_encode_chan(uint8_t system_id, uint8_t component_id, uint8_t chan, mavlink_message_t* msg, const mavlink_flash_fw_window_crc_t* flash_fw_window_crc)
+{
+	return mavlink_msg_flash_fw_window_crc_pack_chan(system_id, component_id, chan, msg, flash_fw_window_crc->addr, flash_fw_window_crc->crc);
+}
+
+/**
+ * @brief Send a flash_fw_window_crc message
+ * @param chan MAVLink channel to send the message
+ *
+ * @param addr block offset
+ * @param crc CRC32 of the block
+ */
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_flash_fw_window_crc_send(mavlink_channel_t chan, uint32_t addr, uint32_t crc)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN];
+	_mav_put_uint32_t(buf, 0, addr);
+	_mav_put_uint32_t(buf, 4, crc);
+
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC, buf, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_CRC);
+#else
+	mavlink_flash_fw_window_crc_t packet;
+	packet.addr = addr;
+	packet.crc = crc;
+
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC, (const char *)&packet, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_CRC);
+#endif
+}
+
+/**
+ * @brief Send a flash_fw_window_crc message
+ * @param chan MAVLink channel to send the message
+ * @param struct The MAVLink struct to serialize
+ */
+static inline void mavlink_msg_flash_fw_window_crc_send_struct(mavlink_channel_t chan, const mavlink_flash_fw_window_crc_t* flash_fw_window_crc)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+    mavlink_msg_flash_fw_window_crc_send(chan, flash_fw_window_crc->addr, flash_fw_window_crc->crc);
+#else
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC, (const char *)flash_fw_window_crc, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_CRC);
+#endif
+}
+
+#if MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN <= MAVLINK_MAX_PAYLOAD_LEN
+/*
+  This varient of _send() can be used to save stack space by re-using
+  memory from the receive buffer.  The caller provides a
+  mavlink_message_t which is the size of a full mavlink message. This
+  is usually the receive buffer for the channel, and allows a reply to an
+  incoming message with minimum stack space usage.
+ */
+static inline void mavlink_msg_flash_fw_window_crc_send_buf(mavlink_message_t *msgbuf, mavlink_channel_t chan,  uint32_t addr, uint32_t crc)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char *buf = (char *)msgbuf;
+	_mav_put_uint32_t(buf, 0, addr);
+	_mav_put_uint32_t(buf, 4, crc);
+
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC, buf, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_CRC);
+#else
+	mavlink_flash_fw_window_crc_t *packet = (mavlink_flash_fw_window_crc_t *)msgbuf;
+	packet->addr = addr;
+	packet->crc = crc;
+
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC, (const char *)packet, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_CRC);
+#endif
+}
+#endif
+
+#endif
+
+// MESSAGE FLASH_FW_WINDOW_CRC UNPACKING
+
+
+/**
+ * @brief Get field addr from flash_fw_window_crc message
+ *
+ * @return block offset
+ */
+static inline uint32_t mavlink_msg_flash_fw_window_crc_get_addr(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  0);
+}
+
+/**
+ * @brief Get field crc from flash_fw_window_crc message
+ *
+ * @return CRC32 of the block
+ */
+static inline uint32_t mavlink_msg_flash_fw_window_crc_get_crc(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  4);
+}
+
+/**
+ * @brief Decode a flash_fw_window_crc message into a struct
+ *
+ * @param msg The message to decode
+ * @param flash_fw_window_crc C-struct to decode the message contents into
+ */
+static inline void mavlink_msg_flash_fw_window_crc_decode(const mavlink_message_t* msg, mavlink_flash_fw_window_crc_t* flash_fw_window_crc)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	flash_fw_window_crc->addr = mavlink_msg_flash_fw_window_crc_get_addr(msg);
+	flash_fw_window_crc->crc = mavlink_msg_flash_fw_window_crc_get_crc(msg);
+#else
+        uint8_t len = msg->len < MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN? msg->len : MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN;
+        memset(flash_fw_window_crc, 0, MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC_LEN);
+	memcpy(flash_fw_window_crc, _MAV_PAYLOAD(msg), len);
+#endif
+}
@@ -7,6 +7,6 @@
 
 #define MAVLINK_BUILD_DATE "Mon May 30 2016"
 #define MAVLINK_WIRE_PROTOCOL_VERSION "1.0"
-#define MAVLINK_MAX_DIALECT_PAYLOAD_SIZE 134
+#define MAVLINK_MAX_DIALECT_PAYLOAD_SIZE 247
  
 #endif // MAVLINK_VERSION_H
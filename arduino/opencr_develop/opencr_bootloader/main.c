@@ -48,6 +48,7 @@ int main(void)
     }
 #else
     msg_process_vcp();
+    cmd_process();
 #endif
   }
 }
@@ -59,6 +60,7 @@ void main_init()
 
   bsp_init();
   hal_init();
+  cmd_init();
 
   if( wdg_get_reset() == FALSE )
   {
@@ -119,10 +121,26 @@ void msg_process_vcp(void)
 	  cmd_flash_fw_write_block(&msg);
 	  break;
 
+	case MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW:
+	  cmd_flash_fw_write_window(&msg);
+	  break;
+
+	case MAVLINK_MSG_ID_FLASH_FW_WINDOW_CRC:
+	  cmd_flash_fw_window_crc(&msg);
+	  break;
+
 	case MAVLINK_MSG_ID_FLASH_FW_ERASE:
 	  cmd_flash_fw_erase(&msg);
 	  break;
 
+	case MAVLINK_MSG_ID_FLASH_FW_ERASE_SECTOR:
+	  cmd_flash_fw_erase_sector(&msg);
+	  break;
+
+	case MAVLINK_MSG_ID_FLASH_FW_READ_CRC:
+	  cmd_flash_fw_read_crc(&msg);
+	  break;
+
 	case MAVLINK_MSG_ID_FLASH_FW_VERIFY:
 	  cmd_flash_fw_verify(&msg);
 	  break;
@@ -27,6 +27,27 @@
 #define FLASH_BLOCK_PACKET_LENGTH	128
 #define FLASH_BLOCK_MAX_LENGTH		(16*1024)
 
+// Windowed download, protocol 2.
+// The host keeps up to FLASH_WINDOW_BUF_MAX blocks in flight, one block is
+// programmed while the next one is received over USB.
+#define FLASH_WINDOW_PROTOCOL		2
+#define FLASH_WINDOW_PROTOCOL_CRC32	3	// adds a CRC32 per block and for the image
+#define FLASH_WINDOW_BUF_MAX		2
+#define FLASH_WINDOW_PACKET_LENGTH	240	// 255 byte frame, 4 FS endpoint packets
+#define FLASH_WINDOW_PACKET_MAX		32	// one bit each in the received bitmap
+#define FLASH_WINDOW_BLOCK_LENGTH	(FLASH_WINDOW_PACKET_LENGTH*FLASH_WINDOW_PACKET_MAX)
+#define FLASH_WINDOW_WRITE_LENGTH	1024	// programmed per cmd_process() call
+
+#define FLASH_WINDOW_EMPTY		0
+#define FLASH_WINDOW_RECEIVING		1
+#define FLASH_WINDOW_WRITING		2
+#define FLASH_WINDOW_DONE		3
+
+// FLASH_FW_VERIFY param[] from hosts that send a CRC32, older hosts leave
+// param uninitialised and get the additive sum
+#define FLASH_VERIFY_CRC32_KEY		"CRC32"
+#define FLASH_VERIFY_CRC32_KEY_LENGTH	5
+
 
 
 const uint8_t  *board_name   = "OpenCR R1.0";
@@ -49,11 +70,38 @@ typedef struct
 
 
 
+typedef struct
+{
+  uint8_t    state;
+  uint8_t    ch;
+  uint8_t    count;
+  err_code_t err_code;
+
+  uint32_t   addr;
+  uint32_t   length;
+  uint32_t   length_written;
+  uint32_t   received;
+  uint8_t    crc_valid;
+  uint32_t   crc;
+  uint32_t   crc_ret;
+
+  uint8_t    data[FLASH_WINDOW_BLOCK_LENGTH];
+} flash_window_t;
+
+
+
 flash_block_t flash_block;
+flash_window_t flash_window[FLASH_WINDOW_BUF_MAX];
+uint8_t        flash_window_protocol = 0;
 
 
 
 void jump_to_fw(void);
+void resp_ack( uint8_t ch, mavlink_ack_t *p_ack );
+void flash_window_init(void);
+void flash_window_start(flash_window_t *p_window);
+void flash_window_ack(flash_window_t *p_window, err_code_t err_code);
+BOOL flash_window_is_full(flash_window_t *p_window);
 
 
 
@@ -63,7 +111,158 @@ void jump_to_fw(void);
 ---------------------------------------------------------------------------*/
 void cmd_init(void)
 {
+  crc32_init();
+  flash_window_init();
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : cmd_process
+     WORK    : programs a received window block in small pieces so that
+               the packets of the next block keep being parsed meanwhile
+---------------------------------------------------------------------------*/
+void cmd_process(void)
+{
+  flash_window_t *p_window;
+  err_code_t err_code;
+  uint32_t length;
+  uint8_t i;
+
+
+  for( i=0; i<FLASH_WINDOW_BUF_MAX; i++ )
+  {
+    p_window = &flash_window[i];
+
+    if( p_window->state != FLASH_WINDOW_WRITING ) continue;
+
+    length = p_window->length - p_window->length_written;
+    if( length > FLASH_WINDOW_WRITE_LENGTH )
+    {
+      length = FLASH_WINDOW_WRITE_LENGTH;
+    }
+
+    err_code = flash_write( FLASH_FW_ADDR_START + p_window->addr + p_window->length_written,
+                            &p_window->data[p_window->length_written], length);
+
+    p_window->length_written += length;
+
+    if( err_code == OK && p_window->length_written >= p_window->length
+     && flash_window_protocol >= FLASH_WINDOW_PROTOCOL_CRC32 )
+    {
+      // Read back, the host compares it with its own block crc.
+      // the D-cache may still hold lines read before the erase
+      SCB_InvalidateDCache_by_Addr( (uint32_t *)(FLASH_FW_ADDR_START + p_window->addr), FLASH_WINDOW_BLOCK_LENGTH );
+      p_window->crc_ret = crc32_calc( 0, (uint8_t *)(FLASH_FW_ADDR_START + p_window->addr), p_window->length );
+      if( p_window->crc_ret != p_window->crc )
+      {
+        err_code = ERR_FLASH_WRITE;
+      }
+    }
+
+    if( err_code != OK || p_window->length_written >= p_window->length )
+    {
+      p_window->state = FLASH_WINDOW_DONE;
+      flash_window_ack(p_window, err_code);
+    }
+    break;
+  }
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : flash_window_init
+     WORK    :
+---------------------------------------------------------------------------*/
+void flash_window_init(void)
+{
+  uint8_t i;
+
+
+  for( i=0; i<FLASH_WINDOW_BUF_MAX; i++ )
+  {
+    flash_window[i].state    = FLASH_WINDOW_EMPTY;
+    flash_window[i].received = 0;
+  }
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : flash_window_is_full
+     WORK    :
+---------------------------------------------------------------------------*/
+BOOL flash_window_is_full(flash_window_t *p_window)
+{
+  uint32_t mask;
+
+
+  mask = (p_window->count < 32) ? (((uint32_t)1<<p_window->count) - 1) : 0xFFFFFFFF;
+
+  return (p_window->received == mask) ? TRUE : FALSE;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : flash_window_start
+     WORK    : hands a complete block to cmd_process(). with the CRC32
+               protocol the block crc must have arrived and match first
+---------------------------------------------------------------------------*/
+void flash_window_start(flash_window_t *p_window)
+{
+  if( flash_window_protocol >= FLASH_WINDOW_PROTOCOL_CRC32 )
+  {
+    // The crc follows the last packet, the host resends it on a poll
+    if( p_window->crc_valid == FALSE ) return;
+
+    p_window->crc_ret = crc32_calc( 0, p_window->data, p_window->length );
+    if( p_window->crc_ret != p_window->crc )
+    {
+      // Corrupted on the way, nothing is programmed yet so the host
+      // sends the whole block again
+      p_window->received  = 0;
+      p_window->crc_valid = FALSE;
+      flash_window_ack(p_window, ERR_FLASH_CRC);
+      return;
+    }
+  }
+
+  // flash_write() programs whole words, pad the last one with erased bytes
+  memset(&p_window->data[p_window->length], 0xFF, FLASH_WINDOW_BLOCK_LENGTH - p_window->length);
+
+  p_window->state          = FLASH_WINDOW_WRITING;
+  p_window->length_written = 0;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : flash_window_ack
+     WORK    : OK once the block is programmed, ERR_FLASH_PACKET_LOST with
+               the received bitmap while packets are missing.
+               data[8..11] is the crc of the block, read back from flash
+               on OK and of the received data on ERR_FLASH_CRC
+---------------------------------------------------------------------------*/
+void flash_window_ack(flash_window_t *p_window, err_code_t err_code)
+{
+  mavlink_ack_t mav_ack;
+
 
+  p_window->err_code = err_code;
+
+  mav_ack.msg_id   = MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW;
+  mav_ack.err_code = err_code;
+  mav_ack.data[0]  = p_window->addr;
+  mav_ack.data[1]  = p_window->addr>>8;
+  mav_ack.data[2]  = p_window->addr>>16;
+  mav_ack.data[3]  = p_window->addr>>24;
+  mav_ack.data[4]  = p_window->received;
+  mav_ack.data[5]  = p_window->received>>8;
+  mav_ack.data[6]  = p_window->received>>16;
+  mav_ack.data[7]  = p_window->received>>24;
+  mav_ack.data[8]  = p_window->crc_ret;
+  mav_ack.data[9]  = p_window->crc_ret>>8;
+  mav_ack.data[10] = p_window->crc_ret>>16;
+  mav_ack.data[11] = p_window->crc_ret>>24;
+  mav_ack.length   = 12;
+  resp_ack(p_window->ch, &mav_ack);
 }
 
 
@@ -226,10 +425,30 @@ void cmd_flash_fw_write_begin( msg_t *p_msg )
   flash_block.length_total = 0;
   flash_block.length_received = 0;
 
+  flash_window_init();
+
+  flash_window_protocol = 0;
+  if( mav_data.param[0] == FLASH_WINDOW_PROTOCOL || mav_data.param[0] == FLASH_WINDOW_PROTOCOL_CRC32 )
+  {
+    flash_window_protocol = mav_data.param[0];
+  }
+
   if( mav_data.resp == 1 )
   {
     mav_ack.msg_id   = p_msg->p_msg->msgid;
     mav_ack.err_code = err_code;
+    mav_ack.length   = 0;
+
+    // param[0] asks for the windowed download, older loaders send 0 here
+    // and older bootloaders answer without data, both fall back to blocks.
+    if( flash_window_protocol != 0 )
+    {
+      mav_ack.data[0] = flash_window_protocol;
+      mav_ack.data[1] = FLASH_WINDOW_BUF_MAX;
+      mav_ack.data[2] = FLASH_WINDOW_PACKET_LENGTH;
+      mav_ack.data[3] = FLASH_WINDOW_PACKET_MAX;
+      mav_ack.length  = 4;
+    }
     resp_ack(p_msg->ch, &mav_ack);
   }
 }
@@ -304,6 +523,135 @@ void cmd_flash_fw_write_block( msg_t *p_msg )
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : cmd_flash_fw_write_window
+     WORK    : collects the packets of a block, no response per packet.
+               the block is acked by cmd_process() after it is programmed
+---------------------------------------------------------------------------*/
+void cmd_flash_fw_write_window( msg_t *p_msg )
+{
+  mavlink_ack_t     mav_ack;
+  mavlink_flash_fw_write_window_t mav_data;
+  flash_window_t *p_window = NULL;
+  uint32_t offset;
+  uint8_t i;
+
+
+  mavlink_msg_flash_fw_write_window_decode(p_msg->p_msg, &mav_data);
+
+  offset = mav_data.index * FLASH_WINDOW_PACKET_LENGTH;
+
+  if( mav_data.count == 0 || mav_data.count > FLASH_WINDOW_PACKET_MAX
+   || mav_data.index >= mav_data.count
+   || mav_data.length > FLASH_WINDOW_PACKET_LENGTH
+   || mav_data.addr + offset + mav_data.length > FLASH_FW_SIZE )
+  {
+    mav_ack.msg_id   = p_msg->p_msg->msgid;
+    mav_ack.err_code = ERR_FLASH_PACKET_SIZE;
+    mav_ack.length   = 0;
+    resp_ack(p_msg->ch, &mav_ack);
+    return;
+  }
+
+
+  for( i=0; i<FLASH_WINDOW_BUF_MAX; i++ )
+  {
+    if( flash_window[i].state != FLASH_WINDOW_EMPTY && flash_window[i].addr == mav_data.addr )
+    {
+      p_window = &flash_window[i];
+      break;
+    }
+  }
+
+  if( p_window == NULL )
+  {
+    for( i=0; i<FLASH_WINDOW_BUF_MAX; i++ )
+    {
+      if( flash_window[i].state == FLASH_WINDOW_EMPTY || flash_window[i].state == FLASH_WINDOW_DONE )
+      {
+        p_window = &flash_window[i];
+        break;
+      }
+    }
+
+    // The host overran the window, it polls again after its timeout
+    if( p_window == NULL ) return;
+
+    p_window->state     = FLASH_WINDOW_RECEIVING;
+    p_window->ch        = p_msg->ch;
+    p_window->addr      = mav_data.addr;
+    p_window->count     = mav_data.count;
+    p_window->length    = 0;
+    p_window->received  = 0;
+    p_window->crc_valid = FALSE;
+    p_window->crc_ret   = 0;
+  }
+
+
+  if( p_window->state == FLASH_WINDOW_RECEIVING )
+  {
+    if( (p_window->received & ((uint32_t)1<<mav_data.index)) == 0 )
+    {
+      memcpy(&p_window->data[offset], mav_data.data, mav_data.length);
+      p_window->received |= ((uint32_t)1<<mav_data.index);
+
+      if( mav_data.index == p_window->count-1 )
+      {
+        p_window->length = offset + mav_data.length;
+      }
+    }
+
+    if( flash_window_is_full(p_window) == TRUE )
+    {
+      flash_window_start(p_window);
+    }
+    else if( mav_data.index == p_window->count-1 )
+    {
+      // The last packet arrived with holes, ask for the missing ones only
+      flash_window_ack(p_window, ERR_FLASH_PACKET_LOST);
+    }
+  }
+  else if( p_window->state == FLASH_WINDOW_DONE && mav_data.index == p_window->count-1 )
+  {
+    // Lost ack, the host resent the last packet to poll
+    flash_window_ack(p_window, p_window->err_code);
+  }
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : cmd_flash_fw_window_crc
+     WORK    : CRC32 of a block, sent after its packets. a block without
+               a receiving window is dropped, the host polls it again
+---------------------------------------------------------------------------*/
+void cmd_flash_fw_window_crc( msg_t *p_msg )
+{
+  mavlink_flash_fw_window_crc_t mav_data;
+  flash_window_t *p_window;
+  uint8_t i;
+
+
+  mavlink_msg_flash_fw_window_crc_decode(p_msg->p_msg, &mav_data);
+
+  for( i=0; i<FLASH_WINDOW_BUF_MAX; i++ )
+  {
+    p_window = &flash_window[i];
+
+    if( p_window->state == FLASH_WINDOW_RECEIVING && p_window->addr == mav_data.addr )
+    {
+      p_window->crc       = mav_data.crc;
+      p_window->crc_valid = TRUE;
+
+      if( flash_window_is_full(p_window) == TRUE )
+      {
+        flash_window_start(p_window);
+      }
+      break;
+    }
+  }
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : cmd_flash_fw_erase
      WORK    :
@@ -345,6 +693,75 @@ void cmd_flash_fw_erase( msg_t *p_msg )
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : cmd_flash_fw_erase_sector
+     WORK    : erases only the sectors holding addr..addr+length, for the
+               delta update that rewrites the changed sectors
+---------------------------------------------------------------------------*/
+void cmd_flash_fw_erase_sector( msg_t *p_msg )
+{
+  err_code_t err_code = OK;
+  mavlink_ack_t     mav_ack;
+  mavlink_flash_fw_erase_sector_t mav_data;
+
+
+  mavlink_msg_flash_fw_erase_sector_decode(p_msg->p_msg, &mav_data);
+
+  err_code = flash_erase_fw_sectors( mav_data.addr, mav_data.length );
+
+  flash_block.count = 0;
+  flash_block.length_received = 0;
+
+  if( mav_data.resp == 1 )
+  {
+    mav_ack.msg_id   = p_msg->p_msg->msgid;
+    mav_ack.err_code = err_code;
+    mav_ack.length   = 0;
+    resp_ack(p_msg->ch, &mav_ack);
+  }
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : cmd_flash_fw_read_crc
+     WORK    : CRC32 of a part of the firmware, the host compares it
+               with the image to find the sectors that changed
+---------------------------------------------------------------------------*/
+void cmd_flash_fw_read_crc( msg_t *p_msg )
+{
+  err_code_t err_code = OK;
+  mavlink_ack_t     mav_ack;
+  mavlink_flash_fw_read_crc_t mav_data;
+  uint32_t crc = 0;
+
+
+  mavlink_msg_flash_fw_read_crc_decode(p_msg->p_msg, &mav_data);
+
+  if( mav_data.addr > FLASH_FW_SIZE || mav_data.length > FLASH_FW_SIZE - mav_data.addr )
+  {
+    err_code = ERR_FLASH_SIZE;
+  }
+  else
+  {
+    SCB_InvalidateDCache_by_Addr( (uint32_t *)FLASH_FW_ADDR_START, FLASH_FW_SIZE );
+
+    crc = crc32_calc( 0, (uint8_t *)(FLASH_FW_ADDR_START + mav_data.addr), mav_data.length );
+  }
+
+  if( mav_data.resp == 1 )
+  {
+    mav_ack.msg_id   = p_msg->p_msg->msgid;
+    mav_ack.err_code = err_code;
+    mav_ack.data[0]  = crc >> 0;
+    mav_ack.data[1]  = crc >> 8;
+    mav_ack.data[2]  = crc >> 16;
+    mav_ack.data[3]  = crc >> 24;
+    mav_ack.length   = 4;
+    resp_ack(p_msg->ch, &mav_ack);
+  }
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : cmd_flash_fw_verify
      WORK    :
@@ -361,10 +778,24 @@ void cmd_flash_fw_verify( msg_t *p_msg )
 
   mavlink_msg_flash_fw_verify_decode(p_msg->p_msg, &mav_data);
 
-  crc = 0;
-  for( i=0; i<mav_data.length; i++ )
+  if( mav_data.length > FLASH_FW_SIZE )
   {
-    crc = crc_calc( crc, p_fw[i] );
+    mav_data.length = FLASH_FW_SIZE;
+  }
+
+  SCB_InvalidateDCache_by_Addr( (uint32_t *)FLASH_FW_ADDR_START, FLASH_FW_SIZE );
+
+  if( memcmp(mav_data.param, FLASH_VERIFY_CRC32_KEY, FLASH_VERIFY_CRC32_KEY_LENGTH) == 0 )
+  {
+    crc = crc32_calc( 0, p_fw, mav_data.length );
+  }
+  else
+  {
+    crc = 0;
+    for( i=0; i<mav_data.length; i++ )
+    {
+      crc = crc_calc( crc, p_fw[i] );
+    }
   }
 
 
@@ -25,6 +25,7 @@
 
 
 void cmd_init(void);
+void cmd_process(void);
 
 void cmd_send_error( msg_t *p_msg, err_code_t err_code );
 void cmd_read_version( msg_t *p_msg );
@@ -35,7 +36,11 @@ void cmd_flash_fw_write_packet( msg_t *p_msg );
 void cmd_flash_fw_write_begin( msg_t *p_msg );
 void cmd_flash_fw_write_end( msg_t *p_msg );
 void cmd_flash_fw_write_block( msg_t *p_msg );
+void cmd_flash_fw_write_window( msg_t *p_msg );
+void cmd_flash_fw_window_crc( msg_t *p_msg );
 void cmd_flash_fw_erase( msg_t *p_msg );
+void cmd_flash_fw_erase_sector( msg_t *p_msg );
+void cmd_flash_fw_read_crc( msg_t *p_msg );
 void cmd_flash_fw_verify( msg_t *p_msg );
 void cmd_flash_fw_read_block( msg_t *p_msg );
 
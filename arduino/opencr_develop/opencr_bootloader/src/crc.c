@@ -16,9 +16,22 @@
 
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : crc32_init
+     WORK    : CRC unit for crc32_calc()
+---------------------------------------------------------------------------*/
+void crc32_init( void )
+{
+  __HAL_RCC_CRC_CLK_ENABLE();
+
+  CRC->POL = 0x04C11DB7;
+  CRC->CR  = 0;
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : crc_calc
-     WORK    :
+     WORK    : additive sum, still used to verify for older hosts
 ---------------------------------------------------------------------------*/
 uint32_t crc_calc( uint32_t crc_in, uint8_t data_in )
 {
@@ -28,3 +41,34 @@ uint32_t crc_calc( uint32_t crc_in, uint8_t data_in )
 
   return crc_in;
 }
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : crc32_calc
+     WORK    : CRC-32 (IEEE 802.3, same as zlib) on the CRC unit,
+               crc_in is the result of the previous part or 0 to start.
+               input bits are reversed per byte and the words are fed
+               in byte order, the output reversal gives the reflected crc
+---------------------------------------------------------------------------*/
+uint32_t crc32_calc( uint32_t crc_in, uint8_t *p_data, uint32_t length )
+{
+  uint32_t i;
+  uint32_t words = length/4;
+
+
+  CRC->INIT = __RBIT(~crc_in);
+  CRC->CR   = CRC_CR_REV_IN_0 | CRC_CR_REV_OUT | CRC_CR_RESET;
+
+  for( i=0; i<words; i++ )
+  {
+    CRC->DR = (uint32_t)p_data[0]<<24 | p_data[1]<<16 | p_data[2]<<8 | p_data[3];
+    p_data += 4;
+  }
+
+  for( i=words*4; i<length; i++ )
+  {
+    *(__IO uint8_t *)&CRC->DR = *p_data++;
+  }
+
+  return ~CRC->DR;
+}
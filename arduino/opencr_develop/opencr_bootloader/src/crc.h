@@ -24,7 +24,9 @@
 
 
 
+void     crc32_init( void );
 uint32_t crc_calc( uint32_t crc_in, uint8_t data_in );
+uint32_t crc32_calc( uint32_t crc_in, uint8_t *p_data, uint32_t length );
 
 
 
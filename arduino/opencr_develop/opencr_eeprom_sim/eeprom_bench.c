@@ -0,0 +1,152 @@
+/*
+ *  eeprom_bench.c
+ *
+ *  boot time, read latency and write amplification of drv_eeprom.c on flash_sim.c
+ */
+
+// The workload is the one of the setup sketches: a few hundred 16 byte settings put()
+// again and again, most of the time with the value they already have, plus a 1 KB
+// table written once. The driver boots again every 100 puts, so the boot time is
+// seen with the page at every fill level. Built with -DEEPROM_BASELINE for the driver before the RAM
+// shadow, which has no batch.
+//
+// usage: eeprom_bench [puts [seed]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "drv_eeprom.h"
+#include "flash_sim.h"
+
+
+#define SETTING_SIZE      16
+#define SETTING_NUM       64
+#define TABLE_ADDR        2048
+#define TABLE_SIZE        1024
+
+
+static double getNsec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double measureBoot(void)
+{
+  double start_time = getNsec();
+
+  drv_eeprom_init();
+  return (getNsec() - start_time) / 1000.0;
+}
+
+static double measureRead(void)
+{
+  volatile uint32_t sum = 0;
+  double start_time = getNsec();
+  int repeat, addr;
+
+  for (repeat = 0; repeat < 4; repeat++)
+  {
+    for (addr = 0; addr < drv_eeprom_get_length(); addr++)
+    {
+      sum += drv_eeprom_read_byte(addr);
+    }
+  }
+  return (getNsec() - start_time) / (4.0 * drv_eeprom_get_length());
+}
+
+int main(int argc, char *argv[])
+{
+  int put_num = (argc > 1) ? atoi(argv[1]) : 20000;
+  int seed    = (argc > 2) ? atoi(argv[2]) : 1;
+  uint32_t user_bytes = 0;
+  uint32_t changed_bytes = 0;
+  uint8_t  image[TABLE_ADDR + TABLE_SIZE] = {0};
+  bool     written[TABLE_ADDR + TABLE_SIZE] = {false};
+  double   empty_boot, boot, read;
+  double   boot_sum = 0.0, boot_max = 0.0;
+  int      boot_num = 0;
+  int put, i;
+
+  flash_sim_open();
+  empty_boot = measureBoot();
+  flash_sim_clear_stat();
+
+  srand(seed);
+  for (put = 0; put < put_num; put++)
+  {
+    int setting = rand() % SETTING_NUM;
+    int change  = (rand() % 3) == 0;
+
+#ifndef EEPROM_BASELINE
+    drv_eeprom_begin_batch();
+#endif
+    for (i = 0; i < SETTING_SIZE; i++)
+    {
+      int addr = setting * SETTING_SIZE + i;
+      uint8_t data = change ? (uint8_t)rand() : image[addr];
+
+      changed_bytes += (data != image[addr] || !written[addr]) ? 1 : 0;
+      image[addr]   = data;
+      written[addr] = true;
+      drv_eeprom_write_byte(addr, data);
+      user_bytes++;
+    }
+#ifndef EEPROM_BASELINE
+    drv_eeprom_end_batch();
+#endif
+
+    if (put % 100 == 99)
+    {
+      boot = measureBoot();
+      boot_sum += boot;
+      boot_max  = (boot > boot_max) ? boot : boot_max;
+      boot_num++;
+    }
+  }
+
+#ifndef EEPROM_BASELINE
+  drv_eeprom_begin_batch();
+#endif
+  for (i = 0; i < TABLE_SIZE; i++)
+  {
+    image[TABLE_ADDR + i]   = (uint8_t)(i * 7);
+    written[TABLE_ADDR + i] = true;
+    drv_eeprom_write_byte(TABLE_ADDR + i, image[TABLE_ADDR + i]);
+    user_bytes++;
+    changed_bytes++;
+  }
+#ifndef EEPROM_BASELINE
+  drv_eeprom_end_batch();
+#endif
+
+  flash_sim_stat_t write_stat = flash_sim_stat;
+
+  read = measureRead();
+
+  for (i = 0; i < (int)sizeof(image); i++)
+  {
+    if (written[i] && drv_eeprom_read_byte(i) != image[i])
+    {
+      printf("byte %d reads 0x%02X after the reboot, 0x%02X was written\n", i, drv_eeprom_read_byte(i), image[i]);
+      return 1;
+    }
+  }
+
+  printf("%d puts of %d bytes and a %d byte table, %u bytes written, %u of them changed\n\n",
+         put_num, SETTING_SIZE, TABLE_SIZE, user_bytes, changed_bytes);
+  printf("  %-34s %12.0f\n", "boot, erased flash [us]", empty_boot);
+  printf("  %-34s %12.0f\n", "boot, mean every 100 puts [us]", boot_sum / boot_num);
+  printf("  %-34s %12.0f\n", "boot, max every 100 puts [us]", boot_max);
+  printf("  %-34s %12.1f\n", "read [ns/byte]", read);
+  printf("  %-34s %12u\n", "flash programs", write_stat.program_count);
+  printf("  %-34s %12u\n", "flash bytes programmed", write_stat.program_bytes);
+  printf("  %-34s %12u\n", "sector erases", write_stat.erase_count);
+  printf("  %-34s %12.2f\n", "write amplification (all bytes)", (double)write_stat.program_bytes / user_bytes);
+  printf("  %-34s %12.2f\n", "write amplification (changed)", (double)write_stat.program_bytes / changed_bytes);
+
+  return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ *  eeprom_error.c
+ *
+ *  flash error injection into drv_eeprom.c on flash_sim.c
+ */
+
+// The flash returns HAL_ERROR for a while, as a program or erase error would, and
+// the writes go on. Every variable must read the value last written meanwhile, and
+// once the errors stop one flush must store all of them for the next boot.
+//   outage : the flash fails for many more variables than the journal holds, with
+//            single writes and with a batch
+//   window : a random workload during which 1 to 3 operations fail, at every
+//            operation of the first compactions
+//
+// usage: eeprom_error [writes [seed]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "drv_eeprom.h"
+#include "flash_sim.h"
+
+
+#define VAR_NUM           700
+#define OUTAGE_NUM        500
+#define NOT_WRITTEN       -1
+
+
+static int model[4096];
+
+
+static void clearModel(void)
+{
+  int i;
+
+  for (i = 0; i < 4096; i++)
+  {
+    model[i] = NOT_WRITTEN;
+  }
+}
+
+static void writeByte(int addr, int data)
+{
+  drv_eeprom_write_byte(addr, (uint8_t)data);
+  model[addr] = data;
+}
+
+// returns the number of variables that do not read the model
+static int verify(const char *name)
+{
+  int error = 0;
+  int addr;
+
+  for (addr = 0; addr < drv_eeprom_get_length(); addr++)
+  {
+    int data = drv_eeprom_read_byte(addr);
+    int want = (model[addr] == NOT_WRITTEN) ? 0 : model[addr];
+
+    if (data == want)
+    {
+      continue;
+    }
+    if (error++ < 3)
+    {
+      printf("  %s: byte %d reads 0x%02X, 0x%02X was written\n", name, addr, data, want);
+    }
+  }
+
+  return error;
+}
+
+static int runOutage(void)
+{
+  drv_eeprom_stat_t stat;
+  int error = 0;
+  int addr;
+
+  flash_sim_erase_all();
+  clearModel();
+  drv_eeprom_init();
+
+  for (addr = 0; addr < 100; addr++)
+  {
+    writeByte(addr, addr);
+  }
+
+  flash_sim_set_error(1, 1000000);
+  for (addr = 0; addr < OUTAGE_NUM; addr++)
+  {
+    writeByte(addr, 0x80 | (addr & 0x7F));
+  }
+  drv_eeprom_begin_batch();
+  for (addr = 1000; addr < 1000 + OUTAGE_NUM; addr++)
+  {
+    writeByte(addr, addr & 0xFF);
+  }
+  drv_eeprom_end_batch();
+  error += verify("outage, before the flush");
+
+  drv_eeprom_get_stat(&stat);
+  printf("outage: %u flash errors, %u failed flushes, %u writes past the full journal\n",
+         flash_sim_stat.error_count, stat.flush_fail_count, stat.overflow_count);
+  if (stat.flush_fail_count == 0 || stat.overflow_count == 0)
+  {
+    printf("  outage: the failures are not counted\n");
+    error++;
+  }
+
+  flash_sim_set_error(0, 0);
+  if (drv_eeprom_flush() == false)
+  {
+    printf("  outage: the flush after the errors failed\n");
+    error++;
+  }
+  drv_eeprom_get_stat(&stat);
+  if (stat.pending != 0)
+  {
+    printf("  outage: %u writes still pending\n", stat.pending);
+    error++;
+  }
+
+  drv_eeprom_init();
+  error += verify("outage, after the boot");
+
+  return error;
+}
+
+static void runWorkload(int write_num, int seed)
+{
+  int write, i;
+
+  srand(seed);
+  for (write = 0; write < write_num; write++)
+  {
+    int num  = (write % 5 == 0) ? 1 + rand() % 8 : 1;
+    int addr = rand() % VAR_NUM;
+
+    drv_eeprom_begin_batch();
+    for (i = 0; i < num; i++)
+    {
+      writeByte((addr + i) % VAR_NUM, rand() & 0xFF);
+    }
+    drv_eeprom_end_batch();
+  }
+}
+
+static int runWindow(int write_num, int seed)
+{
+  uint32_t op_num;
+  uint32_t error_op;
+  int run_num = 0;
+  int fail_num = 0;
+
+  flash_sim_erase_all();
+  drv_eeprom_init();
+  flash_sim_clear_stat();
+  runWorkload(write_num, seed);
+  op_num = flash_sim_stat.op_count;
+
+  for (error_op = 1; error_op < op_num; error_op += (error_op < 20000) ? 1 : 7)
+  {
+    char name[32];
+    int error;
+
+    flash_sim_erase_all();
+    clearModel();
+    drv_eeprom_init();
+    flash_sim_clear_stat();
+    flash_sim_set_error(error_op, 1 + error_op % 3);
+    runWorkload(write_num, seed);
+
+    snprintf(name, sizeof(name), "error at op %u", error_op);
+    error = verify(name);
+    flash_sim_set_error(0, 0);
+    drv_eeprom_flush();
+    drv_eeprom_init();
+    error += verify(name);
+
+    if (error > 0)
+    {
+      fail_num++;
+    }
+    run_num++;
+  }
+
+  printf("window: %d runs of %d writes, %u flash operations each, %d left the EEPROM inconsistent\n",
+         run_num, write_num, op_num, fail_num);
+
+  return fail_num;
+}
+
+int main(int argc, char *argv[])
+{
+  int write_num = (argc > 1) ? atoi(argv[1]) : 12000;
+  int seed      = (argc > 2) ? atoi(argv[2]) : 7;
+  int fail_num  = 0;
+
+  flash_sim_open();
+
+  if (runOutage() > 0)
+  {
+    fail_num++;
+  }
+  fail_num += runWindow(write_num, seed);
+
+  return (fail_num > 0) ? 1 : 0;
+}
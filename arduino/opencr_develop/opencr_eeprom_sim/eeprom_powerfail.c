@@ -0,0 +1,221 @@
+/*
+ *  eeprom_powerfail.c
+ *
+ *  power fail injection into drv_eeprom.c on flash_sim.c
+ */
+
+// A random workload of single writes and batches runs in a child process and the
+// power fails at one flash operation of it. Another child boots on the flash left
+// behind and every variable must read either the last value whose write returned
+// or a value of the write that was in flight. It then writes, boots again and the
+// write must be there. Every operation of the first compactions fails once, then
+// every 7th one, torn erases included.
+//
+// usage: eeprom_powerfail [writes [seed]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "drv_eeprom.h"
+#include "flash_sim.h"
+
+
+#define VAR_NUM           700
+#define BATCH_SIZE        8
+#define NOT_WRITTEN       -1
+
+
+typedef struct
+{
+  int  model[4096];                 // last value whose write returned
+  int  in_flight_addr[BATCH_SIZE];
+  int  in_flight_data[BATCH_SIZE];
+  int  in_flight_num;
+  bool done;
+} shared_t;
+
+static shared_t *shared;
+static jmp_buf   power_fail;
+
+
+static void runWorkload(int write_num, int seed)
+{
+  int write, i;
+
+  srand(seed);
+  for (write = 0; write < write_num; write++)
+  {
+    int num = (write % 5 == 0) ? 1 + rand() % BATCH_SIZE : 1;
+    int addr = rand() % VAR_NUM;
+
+    for (i = 0; i < num; i++)
+    {
+      shared->in_flight_addr[i] = (addr + i) % VAR_NUM;
+      shared->in_flight_data[i] = rand() & 0xFF;
+    }
+    shared->in_flight_num = num;
+
+    drv_eeprom_begin_batch();
+    for (i = 0; i < num; i++)
+    {
+      drv_eeprom_write_byte(shared->in_flight_addr[i], shared->in_flight_data[i]);
+    }
+    drv_eeprom_end_batch();
+
+    for (i = 0; i < num; i++)
+    {
+      shared->model[shared->in_flight_addr[i]] = shared->in_flight_data[i];
+    }
+    shared->in_flight_num = 0;
+  }
+  shared->done = true;
+}
+
+static bool isInFlight(int addr, int data)
+{
+  int i;
+
+  for (i = 0; i < shared->in_flight_num; i++)
+  {
+    if (shared->in_flight_addr[i] == addr && shared->in_flight_data[i] == data)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// returns the number of variables that read wrong after the power fail
+static int verifyBoot(uint32_t fail_op)
+{
+  int error = 0;
+  int addr;
+
+  drv_eeprom_init();
+
+  for (addr = 0; addr < drv_eeprom_get_length(); addr++)
+  {
+    int data = drv_eeprom_read_byte(addr);
+    int want = shared->model[addr];
+
+    if (data == want || isInFlight(addr, data) || (want == NOT_WRITTEN && data == 0))
+    {
+      continue;
+    }
+    if (error++ < 3)
+    {
+      printf("  power fail at op %u: byte %d reads 0x%02X, 0x%02X was written\n", fail_op, addr, data, want);
+    }
+  }
+
+  drv_eeprom_write_byte(4000, (uint8_t)fail_op);
+  drv_eeprom_init();
+  if (drv_eeprom_read_byte(4000) != (uint8_t)fail_op)
+  {
+    printf("  power fail at op %u: the write after the reboot is lost\n", fail_op);
+    error++;
+  }
+
+  return error;
+}
+
+static int runChild(void (*child)(uint32_t, int, int), uint32_t fail_op, int write_num, int seed)
+{
+  int status;
+  pid_t pid = fork();
+
+  if (pid == 0)
+  {
+    child(fail_op, write_num, seed);
+    _exit(0);
+  }
+  waitpid(pid, &status, 0);
+
+  return WIFEXITED(status) ? WEXITSTATUS(status) : 100;
+}
+
+static void failChild(uint32_t fail_op, int write_num, int seed)
+{
+  drv_eeprom_init();
+  flash_sim_clear_stat();
+  flash_sim_set_power_fail(fail_op, &power_fail);
+  if (setjmp(power_fail) == 0)
+  {
+    runWorkload(write_num, seed);
+  }
+}
+
+static void countChild(uint32_t fail_op, int write_num, int seed)
+{
+  drv_eeprom_stat_t stat;
+
+  (void)fail_op;
+  drv_eeprom_init();
+  flash_sim_clear_stat();
+  runWorkload(write_num, seed);
+  drv_eeprom_get_stat(&stat);
+  printf("%d writes of up to %d bytes on %d variables: %u flash operations, %u compactions\n",
+         write_num, BATCH_SIZE, VAR_NUM, flash_sim_stat.op_count, stat.compact_count);
+  fflush(stdout);
+  _exit(0);
+}
+
+static void verifyChild(uint32_t fail_op, int write_num, int seed)
+{
+  (void)write_num;
+  (void)seed;
+  int error = verifyBoot(fail_op);
+
+  fflush(stdout);
+  _exit(error > 0 ? 1 : 0);
+}
+
+int main(int argc, char *argv[])
+{
+  int write_num = (argc > 1) ? atoi(argv[1]) : 30000;
+  int seed      = (argc > 2) ? atoi(argv[2]) : 7;
+  uint32_t fail_op;
+  int run_num = 0;
+  int fail_num = 0;
+  int i;
+
+  flash_sim_open();
+  shared = mmap(NULL, sizeof(shared_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+  flash_sim_erase_all();
+  fflush(stdout);
+  runChild(countChild, 0, write_num, seed);
+
+  for (fail_op = 1; ; fail_op += (fail_op < 20000) ? 1 : 7)
+  {
+    flash_sim_erase_all();
+    for (i = 0; i < 4096; i++)
+    {
+      shared->model[i] = NOT_WRITTEN;
+    }
+    shared->in_flight_num = 0;
+    shared->done = false;
+
+    fflush(stdout);
+    runChild(failChild, fail_op, write_num, seed);
+    if (shared->done)
+    {
+      break;
+    }
+
+    fflush(stdout);
+    if (runChild(verifyChild, fail_op, write_num, seed) != 0)
+    {
+      fail_num++;
+    }
+    run_num++;
+  }
+
+  printf("%d power fails, %d left the EEPROM inconsistent\n", run_num, fail_num);
+
+  return (fail_num > 0) ? 1 : 0;
+}
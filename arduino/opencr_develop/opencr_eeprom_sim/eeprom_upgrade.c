@@ -0,0 +1,97 @@
+/*
+ *  eeprom_upgrade.c
+ *
+ *  flash image handed over between the drivers before and after the RAM shadow
+ */
+
+// Boots on the image file, checks every variable the earlier runs wrote, writes
+// more and saves the image. The Makefile runs it built with the driver before the
+// RAM shadow, then with the current one and then with the old one again, so the
+// settings survive an update of the firmware and going back.
+//
+// usage: eeprom_upgrade image seed writes
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "drv_eeprom.h"
+#include "flash_sim.h"
+
+
+#define VAR_NUM           512
+#define NOT_WRITTEN       -1
+
+#ifdef EEPROM_BASELINE
+#define DRIVER_NAME       "baseline"
+#else
+#define DRIVER_NAME       "current"
+#endif
+
+
+static int model[4096];
+
+
+int main(int argc, char *argv[])
+{
+  FILE *file;
+  int mismatch = 0;
+  int write_num, write, addr;
+
+  if (argc < 4)
+  {
+    printf("usage: eeprom_upgrade image seed writes\n");
+    return 2;
+  }
+  write_num = atoi(argv[3]);
+
+  flash_sim_open();
+  for (addr = 0; addr < 4096; addr++)
+  {
+    model[addr] = NOT_WRITTEN;
+  }
+
+  file = fopen(argv[1], "rb");
+  if (file != NULL)
+  {
+    if (fread(flash_sim, 1, FLASH_SIM_SIZE, file) != FLASH_SIM_SIZE || fread(model, sizeof(model), 1, file) != 1)
+    {
+      printf("%s is not an image\n", argv[1]);
+      return 2;
+    }
+    fclose(file);
+  }
+
+  drv_eeprom_init();
+  for (addr = 0; addr < 4096; addr++)
+  {
+    if (model[addr] != NOT_WRITTEN && drv_eeprom_read_byte(addr) != model[addr])
+    {
+      if (mismatch++ < 3)
+      {
+        printf("  byte %d reads 0x%02X, 0x%02X was written\n", addr, drv_eeprom_read_byte(addr), model[addr]);
+      }
+    }
+  }
+
+  srand(atoi(argv[2]));
+  for (write = 0; write < write_num; write++)
+  {
+    addr = rand() % VAR_NUM;
+    model[addr] = rand() & 0xFF;
+    drv_eeprom_write_byte(addr, model[addr]);
+  }
+
+  file = fopen(argv[1], "wb");
+  if (file == NULL)
+  {
+    printf("can't write %s\n", argv[1]);
+    return 2;
+  }
+  fwrite(flash_sim, 1, FLASH_SIM_SIZE, file);
+  fwrite(model, sizeof(model), 1, file);
+  fclose(file);
+
+  printf("%-8s driver: %d bytes read wrong, %d written\n", DRIVER_NAME, mismatch, write_num);
+
+  return (mismatch > 0) ? 1 : 0;
+}
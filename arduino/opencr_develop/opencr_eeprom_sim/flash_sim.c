@@ -0,0 +1,171 @@
+/*
+ *  flash_sim.c
+ *
+ *  simulated flash sectors 2 and 3 of the STM32F746 for drv_eeprom.c on a PC
+ */
+
+/* drv_eeprom.c reads the flash through its addresses, so the two sectors are
+   mapped at 0x08010000, shared so that a process forked after a power fail
+   boots on what the failed one left. Programming can only clear bits, as on
+   the chip, and programming a bit back to 1 stops the program. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "bsp.h"
+#include "flash_sim.h"
+
+
+uint8_t          *flash_sim;
+flash_sim_stat_t  flash_sim_stat;
+
+static uint32_t   power_fail_op = 0;
+static jmp_buf   *power_fail_jmp = NULL;
+static uint32_t   error_op  = 0;
+static uint32_t   error_end = 0;
+
+
+void flash_sim_open(void)
+{
+  void *p = mmap((void *)(uintptr_t)FLASH_SIM_BASE, FLASH_SIM_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+  if (p != (void *)(uintptr_t)FLASH_SIM_BASE)
+  {
+    perror("can't map the flash at 0x08010000");
+    exit(2);
+  }
+
+  flash_sim = (uint8_t *)p;
+  flash_sim_erase_all();
+}
+
+void flash_sim_erase_all(void)
+{
+  memset(flash_sim, 0xFF, FLASH_SIM_SIZE);
+}
+
+void flash_sim_clear_stat(void)
+{
+  memset(&flash_sim_stat, 0, sizeof(flash_sim_stat));
+}
+
+void flash_sim_set_power_fail(uint32_t op_count, jmp_buf *p_jmp)
+{
+  power_fail_op  = (op_count > 0) ? flash_sim_stat.op_count + op_count : 0;
+  power_fail_jmp = p_jmp;
+}
+
+void flash_sim_set_error(uint32_t op_count, uint32_t error_num)
+{
+  error_op  = (op_count > 0) ? flash_sim_stat.op_count + op_count : 0;
+  error_end = error_op + error_num;
+}
+
+static bool isError(void)
+{
+  if (error_op != 0 && flash_sim_stat.op_count >= error_op && flash_sim_stat.op_count < error_end)
+  {
+    flash_sim_stat.error_count++;
+    return true;
+  }
+  return false;
+}
+
+static bool isPowerFail(void)
+{
+  flash_sim_stat.op_count++;
+
+  return (power_fail_op != 0 && flash_sim_stat.op_count == power_fail_op);
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+  uint32_t length = 1 << TypeProgram;
+  uint32_t offset = Address - FLASH_SIM_BASE;
+  uint32_t i;
+
+  if (offset + length > FLASH_SIM_SIZE || (Address & (length - 1)) != 0)
+  {
+    printf("flash program out of the sectors or unaligned at 0x%08X\n", Address);
+    exit(3);
+  }
+
+  if (isPowerFail())
+  {
+    longjmp(*power_fail_jmp, 1);
+  }
+  if (isError())
+  {
+    return HAL_ERROR;
+  }
+
+  for (i = 0; i < length; i++)
+  {
+    uint8_t data = (uint8_t)(Data >> (8*i));
+
+    if ((flash_sim[offset + i] & data) != data)
+    {
+      printf("flash program of 0x%02X over 0x%02X at 0x%08X, not erased\n", data, flash_sim[offset + i], Address + i);
+      exit(3);
+    }
+    flash_sim[offset + i] &= data;
+  }
+
+  flash_sim_stat.program_count++;
+  flash_sim_stat.program_bytes += length;
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+  uint32_t offset = (pEraseInit->Sector - FLASH_SECTOR_2) * FLASH_SIM_SECTOR_SIZE;
+
+  *SectorError = 0xFFFFFFFF;
+
+  if (pEraseInit->Sector < FLASH_SECTOR_2 || pEraseInit->Sector + pEraseInit->NbSectors > FLASH_SECTOR_3 + 1)
+  {
+    printf("flash erase of sector %u, not an EEPROM sector\n", pEraseInit->Sector);
+    exit(3);
+  }
+
+  if (isPowerFail())
+  {
+    /* a torn erase, which half is left depends on the operation */
+    if (flash_sim_stat.op_count & 1)
+      offset += FLASH_SIM_SECTOR_SIZE / 2;
+    memset(flash_sim + offset, 0xFF, FLASH_SIM_SECTOR_SIZE / 2);
+    longjmp(*power_fail_jmp, 1);
+  }
+  if (isError())
+  {
+    return HAL_ERROR;
+  }
+
+  memset(flash_sim + offset, 0xFF, pEraseInit->NbSectors * FLASH_SIM_SECTOR_SIZE);
+  flash_sim_stat.erase_count += pEraseInit->NbSectors;
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+  return HAL_OK;
+}
+
+uint32_t drv_micros(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
@@ -0,0 +1,48 @@
+/*
+ *  flash_sim.h
+ *
+ *  simulated flash sectors 2 and 3 of the STM32F746 for drv_eeprom.c on a PC
+ */
+
+#ifndef FLASH_SIM_H
+#define FLASH_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+
+
+#define FLASH_SIM_BASE        0x08010000    /* sector 2, EEPROM_START_ADDRESS of drv_eeprom.c */
+#define FLASH_SIM_SECTOR_SIZE 0x8000
+#define FLASH_SIM_SIZE        (2*FLASH_SIM_SECTOR_SIZE)
+
+
+typedef struct
+{
+  uint32_t op_count;          // programs and erases
+  uint32_t program_count;
+  uint32_t program_bytes;
+  uint32_t erase_count;
+  uint32_t error_count;       // operations that returned HAL_ERROR
+} flash_sim_stat_t;
+
+
+extern uint8_t          *flash_sim;
+extern flash_sim_stat_t  flash_sim_stat;
+
+
+void     flash_sim_open(void);
+void     flash_sim_erase_all(void);
+void     flash_sim_clear_stat(void);
+
+// The power fails at the op_count-th operation from now, 0 never: a program is not
+// done, an erase is done for half of the sector only. Then longjmp(*p_jmp, 1).
+void     flash_sim_set_power_fail(uint32_t op_count, jmp_buf *p_jmp);
+
+// From the op_count-th operation from now, error_num operations return HAL_ERROR and
+// leave the flash as it is. op_count 0 stops the errors.
+void     flash_sim_set_error(uint32_t op_count, uint32_t error_num);
+
+uint32_t drv_micros(void);
+
+#endif
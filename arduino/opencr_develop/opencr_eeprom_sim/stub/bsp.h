@@ -0,0 +1,46 @@
+/*
+ *  bsp.h
+ *
+ *  host stand-in of the OpenCR bsp, the flash HAL of flash_sim.c
+ */
+
+#ifndef BSP_H
+#define BSP_H
+
+#include <stdint.h>
+
+#define __IO    volatile
+
+typedef enum
+{
+  HAL_OK       = 0x00U,
+  HAL_ERROR    = 0x01U,
+  HAL_BUSY     = 0x02U,
+  HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+  uint32_t TypeErase;
+  uint32_t Banks;
+  uint32_t Sector;
+  uint32_t NbSectors;
+  uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+#define FLASH_TYPEERASE_SECTORS     0x00U
+#define TYPEERASE_SECTORS           FLASH_TYPEERASE_SECTORS
+#define FLASH_SECTOR_2              2U
+#define FLASH_SECTOR_3              3U
+#define VOLTAGE_RANGE_3             0x02U
+
+#define TYPEPROGRAM_BYTE            0x00U
+#define TYPEPROGRAM_HALFWORD        0x01U
+#define TYPEPROGRAM_WORD            0x02U
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+
+#endif
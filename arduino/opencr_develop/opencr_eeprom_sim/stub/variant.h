@@ -0,0 +1,5 @@
+/*
+ *  variant.h
+ *
+ *  host stand-in, drv_eeprom.c needs nothing of the variant
+ */
@@ -0,0 +1,251 @@
+/*
+ *  crc_unit_test.c
+ *
+ *  crc32_calc() of the bootloader on a bit-level model of the CRC unit, against zlib
+ */
+
+/* src/crc.c is compiled as it is, but its DR and CR accesses call the model (see
+   the Makefile). The model follows the CRC unit of the F746 (RM0385, CRC):
+     - a write of CR with RESET loads INIT into the CRC, RESET then reads 0
+     - the data written to DR, 8 or 32 bits, is bit reversed as REV_IN selects:
+       per byte, per half-word or per word of the written width
+     - the CRC takes the data MSB first with POL, the 32 bit polynomial size only
+     - a read of DR gives the CRC, bit reversed with REV_OUT
+   The model is first checked on the CRC-32/MPEG-2 check value with its reset
+   configuration. Then crc32_calc() must give zlib's crc32() on random data of
+   every length up to 64 and random lengths up to 64 KB, at unaligned addresses,
+   and when continued from the crc of the previous part, as the blocks of a
+   download are.
+
+   usage: crc_unit_test [cases [seed]] */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#include "crc.h"
+
+
+#define DATA_MAX          (64*1024)
+
+
+CRC_TypeDef emu_crc;
+
+static uint32_t crc_reg;
+static int      polysize_error;
+
+static uint8_t  data_buf[DATA_MAX + 4];
+
+
+uint32_t __RBIT(uint32_t value)
+{
+  uint32_t result = 0;
+  int      bit;
+
+  for (bit = 0; bit < 32; bit++)
+  {
+    result = (result << 1) | (value & 1);
+    value >>= 1;
+  }
+
+  return result;
+}
+
+// bit reverses every unit of unit_bits in the low bits of data
+static uint32_t reverseUnits(uint32_t data, int bits, int unit_bits)
+{
+  uint32_t mask   = (unit_bits == 32) ? 0xFFFFFFFF : ((1U << unit_bits) - 1);
+  uint32_t result = 0;
+  int      shift;
+
+  for (shift = 0; shift < bits; shift += unit_bits)
+  {
+    result |= (__RBIT((data >> shift) & mask) >> (32 - unit_bits)) << shift;
+  }
+
+  return result;
+}
+
+void crc_unit_control(uint32_t cr)
+{
+  if ((cr & CRC_CR_POLYSIZE) != 0)
+  {
+    polysize_error++;
+  }
+  if (cr & CRC_CR_RESET)
+  {
+    crc_reg = emu_crc.INIT;
+  }
+  emu_crc.CR = cr & ~CRC_CR_RESET;
+}
+
+void crc_unit_write(uint32_t data, int bits)
+{
+  int unit_bits;
+  int bit;
+
+  switch (emu_crc.CR & CRC_CR_REV_IN)
+  {
+    case CRC_CR_REV_IN_0:                   unit_bits = 8;  break;
+    case CRC_CR_REV_IN_1:                   unit_bits = 16; break;
+    case CRC_CR_REV_IN_0 | CRC_CR_REV_IN_1: unit_bits = 32; break;
+    default:                                unit_bits = 0;  break;
+  }
+  if (unit_bits > bits)
+  {
+    unit_bits = bits;
+  }
+  if (unit_bits > 0)
+  {
+    data = reverseUnits(data, bits, unit_bits);
+  }
+
+  for (bit = bits - 1; bit >= 0; bit--)
+  {
+    uint32_t msb = (crc_reg >> 31) ^ ((data >> bit) & 1);
+
+    crc_reg <<= 1;
+    if (msb)
+    {
+      crc_reg ^= emu_crc.POL;
+    }
+  }
+}
+
+uint32_t crc_unit_read(void)
+{
+  return (emu_crc.CR & CRC_CR_REV_OUT) ? __RBIT(crc_reg) : crc_reg;
+}
+
+
+// the reset configuration of the unit is CRC-32/MPEG-2, check value 0x0376E6E7
+static int checkModel(void)
+{
+  const uint8_t *check = (const uint8_t *)"123456789";
+  uint32_t by_byte, by_word;
+  int i;
+
+  emu_crc.INIT = 0xFFFFFFFF;
+  emu_crc.POL  = 0x04C11DB7;
+
+  crc_unit_control(CRC_CR_RESET);
+  for (i = 0; i < 9; i++)
+  {
+    crc_unit_write(check[i], 8);
+  }
+  by_byte = crc_unit_read();
+
+  crc_unit_control(CRC_CR_RESET);
+  crc_unit_write((uint32_t)check[0]<<24 | check[1]<<16 | check[2]<<8 | check[3], 32);
+  crc_unit_write((uint32_t)check[4]<<24 | check[5]<<16 | check[6]<<8 | check[7], 32);
+  crc_unit_write(check[8], 8);
+  by_word = crc_unit_read();
+
+  printf("model, CRC-32/MPEG-2 of \"123456789\": 0x%08X by byte, 0x%08X by word, 0x0376E6E7 expected\n",
+         by_byte, by_word);
+
+  return (by_byte == 0x0376E6E7 && by_word == 0x0376E6E7) ? 0 : 1;
+}
+
+// returns 1 if crc32_calc() over data, in parts split at the given offsets, differs from zlib
+static int checkData(const uint8_t *data, uint32_t length, const uint32_t *split, int split_num)
+{
+  uint32_t want = (uint32_t)crc32(0, data, length);
+  uint32_t crc  = 0;
+  uint32_t offset = 0;
+  int i;
+
+  for (i = 0; i <= split_num; i++)
+  {
+    uint32_t end = (i < split_num) ? split[i] : length;
+
+    crc = crc32_calc(crc, (uint8_t *)data + offset, end - offset);
+    offset = end;
+  }
+
+  if (crc != want)
+  {
+    printf("  %u bytes at offset %u in %d parts: 0x%08X, zlib 0x%08X\n",
+           length, (uint32_t)((uintptr_t)data & 3), split_num + 1, crc, want);
+    return 1;
+  }
+
+  return 0;
+}
+
+static int compareSplit(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[])
+{
+  int case_num = (argc > 1) ? atoi(argv[1]) : 2000;
+  int seed     = (argc > 2) ? atoi(argv[2]) : 7;
+  int fail_num = 0;
+  int error;
+  int i;
+
+  if (checkModel() > 0)
+  {
+    printf("  the model is wrong, crc32_calc() is not checked\n");
+    return 1;
+  }
+
+  srand(seed);
+  crc32_init();
+
+  error = checkData((const uint8_t *)"123456789", 9, NULL, 0);
+  printf("crc32_calc, CRC-32 of \"123456789\": 0x%08X, 0xCBF43926 expected\n",
+         crc32_calc(0, (uint8_t *)"123456789", 9));
+  fail_num += error;
+
+  error = 0;
+  for (i = 0; i < DATA_MAX + 4; i++)
+  {
+    data_buf[i] = rand() & 0xFF;
+  }
+  for (i = 0; i <= 64; i++)
+  {
+    error += checkData(data_buf + (i & 3), i, NULL, 0);
+  }
+  for (i = 0; i < case_num; i++)
+  {
+    uint32_t length = rand() % (DATA_MAX + 1);
+
+    error += checkData(data_buf + rand() % 4, length, NULL, 0);
+  }
+  printf("crc32_calc, one part: %d of %d lengths differ from zlib\n", error, 65 + case_num);
+  fail_num += error;
+
+  error = 0;
+  for (i = 0; i < case_num; i++)
+  {
+    uint32_t split[8];
+    uint32_t length    = rand() % (DATA_MAX + 1);
+    int      split_num = 1 + rand() % 8;
+    int      j;
+
+    for (j = 0; j < split_num; j++)
+    {
+      split[j] = (length > 0) ? rand() % (length + 1) : 0;
+    }
+    qsort(split, split_num, sizeof(split[0]), compareSplit);
+
+    error += checkData(data_buf + rand() % 4, length, split, split_num);
+  }
+  printf("crc32_calc, 2 to 9 parts: %d of %d lengths differ from zlib\n", error, case_num);
+  fail_num += error;
+
+  if (polysize_error > 0)
+  {
+    printf("  CR selected a polynomial size other than 32 bits %d times\n", polysize_error);
+    fail_num++;
+  }
+
+  return (fail_num > 0) ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+#!/bin/sh
+#
+# Downloads a random image with opencr_ld to opencr_bootloader_emu and compares
+# the flash of the emulator with it. Runs the current and the baseline opencr_ld
+# against the current and the baseline bootloader, then the current pair with
+# lost bytes and with wrong block CRCs. Then opencr_ld_shell updates the flash
+# of a full update with one byte changed and unchanged, as delta updates, and
+# on the baseline bootloader, which has no delta. Run from opencr_ld, by
+# make emu_test.
+#
+#   SIZE=bytes   size of the image, 600000 by default
+#   EMU="-p 16 -e 1000"   options given to every emulator
+
+BUILD=emu/build
+SIZE=${SIZE:-600000}
+EMU=${EMU:-}
+FAIL=0
+
+head -c $SIZE /dev/urandom > $BUILD/fw.bin
+
+# the .opencr image of opencr_ld_shell, a 1288 byte header then fw.bin
+make_opencr()
+{
+  printf '\252\252\125\125' > $BUILD/fw.opencr
+  head -c 1284 /dev/zero >> $BUILD/fw.opencr
+  cat $BUILD/fw.bin >> $BUILD/fw.opencr
+}
+
+# run name loader image [delta] emulator [emulator options]
+run()
+{
+  name=$1
+  loader=$2
+  image=$3
+  delta=$4
+  emulator=$5
+  shift 5
+
+  rm -f $BUILD/flash.bin $BUILD/emu.txt
+  $emulator -o $BUILD/flash.bin $EMU "$@" > $BUILD/emu.txt 2> $BUILD/emu_err.txt &
+  pid=$!
+
+  pty=""
+  for i in 1 2 3 4 5 6 7 8 9 10; do
+    pty=$(head -n 1 $BUILD/emu.txt)
+    [ -n "$pty" ] && break
+    sleep 0.1
+  done
+
+  start=$(date +%s.%N)
+  $loader $pty 115200 $image 1 $delta > $BUILD/ld.txt 2>&1
+  end=$(date +%s.%N)
+  kill $pid 2> /dev/null
+  wait $pid 2> /dev/null
+
+  tr -d '\r' < $BUILD/ld.txt > $BUILD/ld_lf.txt
+  erase=$(sed -n -E 's/^(\[OK\] )?flash_erase[ \t]*: ([0-9-]+ : )?([0-9.]+) ?s.*/\3/p' $BUILD/ld_lf.txt)
+  write=$(sed -n -E 's/^(\[OK\] )?flash_write[ \t]*: ([0-9-]+ : )?([0-9.]+) ?s.*/\3/p' $BUILD/ld_lf.txt)
+  resend=$(sed -n -E 's/.*flash_write.*resend ([0-9]+).*/\1/p' $BUILD/ld_lf.txt)
+  sent=$(sed -n -E 's/.*delta update[ \t]*: ([0-9]+) bytes.*/\1/p' $BUILD/ld_lf.txt)
+
+  if [ -f $BUILD/flash.bin ] && cmp -s -n $SIZE $BUILD/fw.bin $BUILD/flash.bin; then
+    result=OK
+  else
+    result=FAIL
+    FAIL=1
+    cp $BUILD/ld.txt $BUILD/ld_fail_$(echo $name | tr ' /,' '___').txt
+  fi
+
+  printf "  %-30s %8.2f %8.2f %8s %8s %8.2f %6s\n" "$name" "${erase:-0}" "${write:-0}" "${resend:--}" "${sent:-$SIZE}" \
+         $(echo "$start $end" | awk '{ print $2 - $1 }') $result
+}
+
+echo "$SIZE byte image, erase, write and total time of the loader in s"
+printf "  %-30s %8s %8s %8s %8s %8s %6s\n" "loader / bootloader" "erase" "write" "resend" "sent" "total" "flash"
+
+run "baseline / baseline"         $BUILD/opencr_ld_baseline $BUILD/fw.bin "" $BUILD/opencr_bootloader_emu_baseline
+run "baseline / current"          $BUILD/opencr_ld_baseline $BUILD/fw.bin "" $BUILD/opencr_bootloader_emu
+run "current / baseline"          ./opencr_ld               $BUILD/fw.bin "" $BUILD/opencr_bootloader_emu_baseline
+run "current / current"           ./opencr_ld               $BUILD/fw.bin "" $BUILD/opencr_bootloader_emu
+run "current / current, lost"     ./opencr_ld               $BUILD/fw.bin "" $BUILD/opencr_bootloader_emu -d 20
+run "current / current, crc"      ./opencr_ld               $BUILD/fw.bin "" $BUILD/opencr_bootloader_emu -c 7
+
+make_opencr
+run "shell / current"             $BUILD/opencr_ld_shell $BUILD/fw.opencr "" $BUILD/opencr_bootloader_emu
+cp $BUILD/flash.bin $BUILD/flash_full.bin
+
+printf '\125' | dd of=$BUILD/fw.bin bs=1 seek=1000 conv=notrunc 2> /dev/null
+make_opencr
+run "shell delta / current"       $BUILD/opencr_ld_shell $BUILD/fw.opencr delta $BUILD/opencr_bootloader_emu -i $BUILD/flash_full.bin
+cp $BUILD/flash.bin $BUILD/flash_delta.bin
+run "shell delta / current, same" $BUILD/opencr_ld_shell $BUILD/fw.opencr delta $BUILD/opencr_bootloader_emu -i $BUILD/flash_delta.bin
+run "shell delta / baseline"      $BUILD/opencr_ld_shell $BUILD/fw.opencr delta $BUILD/opencr_bootloader_emu_baseline -i $BUILD/flash_full.bin
+
+exit $FAIL
@@ -0,0 +1,449 @@
+/*
+ *  opencr_bootloader_emu.c
+ *
+ *  the OpenCR bootloader on a PC, behind a pty
+ */
+
+/* main.c, src/cmd.c, common/hal/msg.c and common/hal/flash.c of the bootloader
+   run as they are, the asm of jump_to_fw() excepted (see the Makefile). This file
+   stands in for the rest:
+     vcp    : the pty, paced as USB full speed: the host bytes come in at most
+              -u bytes per 1 ms frame, the replies leave at the next frame
+     flash  : the 768 KB firmware area mapped at 0x08040000, a program can only
+              clear bits and costs -p us per word, an erase -e ms per sector
+     crc    : CRC-32 in software, the value the CRC unit of the F746 gives
+   The firmware area starts erased, or with the -i file. The pty name is printed
+   on the first line. At jump_to_fw the firmware area is written to the -o file
+   and the emulator exits.
+
+   usage: opencr_bootloader_emu [-i image] [-o image] [-u bytes] [-p us] [-e ms] [-d ppm] [-c n]
+     -d ppm : drops host bytes at random, as an overrun of the CDC rx buffer would
+     -c n   : every n-th block CRC of a received window is wrong */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/mman.h>
+
+#include "hal.h"
+#include "crc.h"
+
+
+#define FLASH_FW_ADDR_START       0x08040000
+#define FLASH_FW_SIZE             (768*1024)
+#define FLASH_SECTOR_SIZE         (256*1024)
+
+#define USB_FRAME_US              1000
+#define USB_FRAME_BYTES           1216        // 19 bulk packets of 64 bytes
+#define USB_TX_BUF_LENGTH         (16*1024)
+#define VCP_RX_BUF_LENGTH         (16*1024)
+
+
+SCB_Type emu_scb;
+
+int bootloader_main(void);
+
+static int      pty_fd;
+static uint8_t *flash_fw;
+static const char *image_name = NULL;
+
+static uint32_t usb_frame_bytes = USB_FRAME_BYTES;
+static uint32_t usb_frame;
+static uint32_t usb_frame_rx;
+static uint8_t  usb_tx_buf[USB_TX_BUF_LENGTH];
+static uint32_t usb_tx_length;
+
+static uint8_t  vcp_rx_buf[VCP_RX_BUF_LENGTH];
+static uint32_t vcp_rx_in, vcp_rx_out;
+static uint32_t drop_ppm;
+
+static uint32_t flash_program_us = 16;
+static uint32_t flash_erase_ms   = 1000;
+static uint64_t flash_busy_ns;
+
+static uint32_t crc_corrupt_every;
+static uint32_t crc_block_count;
+
+
+static uint64_t get_nsec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+uint32_t millis()
+{
+  return (uint32_t)(get_nsec() / 1000000);
+}
+
+void delay_ns(uint32_t ns)
+{
+  usleep(ns / 1000);
+}
+
+void delay_us(uint32_t us)
+{
+  usleep(us);
+}
+
+void delay_ms(uint32_t ms)
+{
+  usleep(ms * 1000);
+}
+
+
+void bsp_init(void)
+{
+}
+
+void bsp_deinit(void)
+{
+}
+
+void hal_init(void)
+{
+}
+
+void led_on(uint8_t ch)
+{
+  (void)ch;
+}
+
+void led_toggle(uint8_t ch)
+{
+  (void)ch;
+}
+
+uint8_t button_read(uint8_t ch)
+{
+  (void)ch;
+  return TRUE;
+}
+
+uint8_t wdg_get_reset(void)
+{
+  // stays in the bootloader, as after the reset by opencr_ld
+  return TRUE;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : usb
+     WORK    : one frame per USB_FRAME_US, the host sends at most
+               usb_frame_bytes per frame and the device replies are
+               polled by the host at the next frame
+---------------------------------------------------------------------------*/
+static void usb_update(void)
+{
+  uint32_t frame = (uint32_t)(get_nsec() / (USB_FRAME_US * 1000));
+  uint8_t  buf[USB_FRAME_BYTES * 4];
+  uint32_t length;
+  int      ret;
+  int      i;
+
+
+  if( frame != usb_frame )
+  {
+    usb_frame    = frame;
+    usb_frame_rx = 0;
+
+    if( usb_tx_length > 0 )
+    {
+      // the host may have the pty closed, the reply is lost then as on a closed port
+      ret = write(pty_fd, usb_tx_buf, usb_tx_length);
+      (void)ret;
+      usb_tx_length = 0;
+    }
+  }
+
+  length = usb_frame_bytes - usb_frame_rx;
+  if( length > sizeof(buf) ) length = sizeof(buf);
+  if( length == 0 ) return;
+
+  ret = read(pty_fd, buf, length);
+  if( ret <= 0 )
+  {
+    // nothing sent or no host on the pty
+    usleep(20);
+    return;
+  }
+  usb_frame_rx += ret;
+
+  for( i=0; i<ret; i++ )
+  {
+    if( drop_ppm > 0 && (uint32_t)(rand() % 1000000) < drop_ppm )
+    {
+      continue;
+    }
+    vcp_rx_buf[vcp_rx_in] = buf[i];
+    vcp_rx_in = (vcp_rx_in + 1) % VCP_RX_BUF_LENGTH;
+  }
+}
+
+
+void vcp_init(void)
+{
+}
+
+BOOL vcp_is_available(void)
+{
+  if( vcp_rx_in == vcp_rx_out )
+  {
+    usb_update();
+  }
+
+  return (vcp_rx_in != vcp_rx_out) ? TRUE : FALSE;
+}
+
+uint8_t vcp_getch(void)
+{
+  uint8_t ch = vcp_rx_buf[vcp_rx_out];
+
+  vcp_rx_out = (vcp_rx_out + 1) % VCP_RX_BUF_LENGTH;
+
+  return ch;
+}
+
+void vcp_putch(uint8_t ch)
+{
+  vcp_write(&ch, 1);
+}
+
+int32_t vcp_write(uint8_t *p_data, uint32_t length)
+{
+  if( usb_tx_length + length > USB_TX_BUF_LENGTH )
+  {
+    return 0;
+  }
+  memcpy(&usb_tx_buf[usb_tx_length], p_data, length);
+  usb_tx_length += length;
+
+  return length;
+}
+
+int32_t vcp_printf( const char *fmt, ...)
+{
+  (void)fmt;
+  return 0;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : flash
+     WORK    : the time of the programs and erases is slept once it adds
+               up to a millisecond, nothing is received meanwhile
+---------------------------------------------------------------------------*/
+static void flash_busy(uint64_t ns)
+{
+  flash_busy_ns += ns;
+
+  if( flash_busy_ns >= 1000000 )
+  {
+    usleep(flash_busy_ns / 1000);
+    flash_busy_ns = 0;
+  }
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+  uint32_t length = 1 << TypeProgram;
+  uint32_t offset = Address - FLASH_FW_ADDR_START;
+  uint32_t i;
+
+
+  if( Address < FLASH_FW_ADDR_START || offset + length > FLASH_FW_SIZE )
+  {
+    fprintf(stderr, "emu: program outside of the firmware at 0x%08X\n", Address);
+    return HAL_ERROR;
+  }
+
+  for( i=0; i<length; i++ )
+  {
+    uint8_t data = (uint8_t)(Data >> (8*i));
+
+    if( (flash_fw[offset + i] & data) != data )
+    {
+      fprintf(stderr, "emu: program of 0x%02X over 0x%02X at 0x%08X, not erased\n", data, flash_fw[offset + i], Address + i);
+      return HAL_ERROR;
+    }
+    flash_fw[offset + i] &= data;
+  }
+
+  flash_busy((uint64_t)flash_program_us * 1000);
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+  uint32_t first = pEraseInit->Sector - FLASH_SECTOR_5;
+
+
+  *SectorError = 0xFFFFFFFF;
+
+  if( pEraseInit->Sector < FLASH_SECTOR_5 || first + pEraseInit->NbSectors > FLASH_FW_SIZE/FLASH_SECTOR_SIZE )
+  {
+    fprintf(stderr, "emu: erase of sector %u, not a firmware sector\n", pEraseInit->Sector);
+    return HAL_ERROR;
+  }
+
+  memset(&flash_fw[first * FLASH_SECTOR_SIZE], 0xFF, pEraseInit->NbSectors * FLASH_SECTOR_SIZE);
+  flash_busy((uint64_t)flash_erase_ms * pEraseInit->NbSectors * 1000000);
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+  return HAL_OK;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : crc
+     WORK    : same results as src/crc.c on the CRC unit
+---------------------------------------------------------------------------*/
+void crc32_init( void )
+{
+}
+
+uint32_t crc_calc( uint32_t crc_in, uint8_t data_in )
+{
+  crc_in  ^= data_in;
+  crc_in  += data_in;
+
+  return crc_in;
+}
+
+uint32_t crc32_calc( uint32_t crc_in, uint8_t *p_data, uint32_t length )
+{
+  uint32_t crc = ~crc_in;
+  uint32_t i;
+  int      bit;
+
+
+  for( i=0; i<length; i++ )
+  {
+    crc ^= p_data[i];
+    for( bit=0; bit<8; bit++ )
+    {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+    }
+  }
+
+  // a block in RAM is a received window, the flash is read back
+  if( crc_corrupt_every > 0 && ((uintptr_t)p_data < FLASH_FW_ADDR_START || (uintptr_t)p_data >= FLASH_FW_ADDR_START + FLASH_FW_SIZE) )
+  {
+    if( ++crc_block_count % crc_corrupt_every == 0 )
+    {
+      crc ^= 1;
+    }
+  }
+
+  return ~crc;
+}
+
+
+void emu_jump_to_fw(void)
+{
+  FILE *fp;
+
+
+  if( image_name != NULL )
+  {
+    fp = fopen(image_name, "wb");
+    if( fp == NULL || fwrite(flash_fw, 1, FLASH_FW_SIZE, fp) != FLASH_FW_SIZE )
+    {
+      fprintf(stderr, "emu: can't write %s\n", image_name);
+      exit(1);
+    }
+    fclose(fp);
+  }
+
+  // replies still queued leave with the next frame
+  usleep(2*USB_FRAME_US);
+  usb_update();
+
+  printf("jump to fw\n");
+  exit(0);
+}
+
+
+int main(int argc, char *argv[])
+{
+  struct termios tty;
+  const char *flash_name = NULL;
+  FILE *fp;
+  int opt;
+
+
+  while( (opt = getopt(argc, argv, "i:o:u:p:e:d:c:")) != -1 )
+  {
+    switch( opt )
+    {
+      case 'i': flash_name        = optarg;       break;
+      case 'o': image_name        = optarg;       break;
+      case 'u': usb_frame_bytes   = atoi(optarg); break;
+      case 'p': flash_program_us  = atoi(optarg); break;
+      case 'e': flash_erase_ms    = atoi(optarg); break;
+      case 'd': drop_ppm          = atoi(optarg); break;
+      case 'c': crc_corrupt_every = atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: opencr_bootloader_emu [-i image] [-o image] [-u bytes] [-p us] [-e ms] [-d ppm] [-c n]\n");
+        return 1;
+    }
+  }
+  if( usb_frame_bytes == 0 || usb_frame_bytes > USB_FRAME_BYTES * 4 )
+  {
+    usb_frame_bytes = USB_FRAME_BYTES * 4;
+  }
+
+  flash_fw = mmap((void *)FLASH_FW_ADDR_START, FLASH_FW_SIZE, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+  if( flash_fw != (uint8_t *)FLASH_FW_ADDR_START )
+  {
+    perror("emu: can't map the flash at 0x08040000");
+    return 1;
+  }
+  memset(flash_fw, 0xFF, FLASH_FW_SIZE);
+
+  if( flash_name != NULL )
+  {
+    fp = fopen(flash_name, "rb");
+    if( fp == NULL || fread(flash_fw, 1, FLASH_FW_SIZE, fp) == 0 )
+    {
+      fprintf(stderr, "emu: can't read %s\n", flash_name);
+      return 1;
+    }
+    fclose(fp);
+  }
+
+  pty_fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if( pty_fd < 0 || grantpt(pty_fd) != 0 || unlockpt(pty_fd) != 0 )
+  {
+    perror("emu: can't open a pty");
+    return 1;
+  }
+  tcgetattr(pty_fd, &tty);
+  cfmakeraw(&tty);
+  tcsetattr(pty_fd, TCSANOW, &tty);
+  fcntl(pty_fd, F_SETFL, O_NONBLOCK);
+
+  printf("%s\n", ptsname(pty_fd));
+  fflush(stdout);
+
+  srand(1);
+
+  return bootloader_main();
+}
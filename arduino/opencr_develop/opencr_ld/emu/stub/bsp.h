@@ -0,0 +1,114 @@
+/*
+ *  bsp.h
+ *
+ *  host stand-in of the OpenCR bootloader bsp, for opencr_bootloader_emu.c
+ *  and crc_unit_test.c
+ */
+
+#ifndef BSP_H
+#define BSP_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+
+#include <stdint.h>
+
+
+#define __IO    volatile
+
+typedef struct
+{
+  uint32_t VTOR;
+} SCB_Type;
+
+extern SCB_Type emu_scb;
+
+#define SCB     (&emu_scb)
+
+#define SCB_InvalidateDCache_by_Addr(addr, length)  ((void)(addr), (void)(length))
+
+
+// CRC unit of the F746, DR and CR are accessed through crc_unit_test.c (see the Makefile)
+typedef struct
+{
+  uint32_t DR;
+  uint32_t IDR;
+  uint32_t CR;
+  uint32_t RESERVED;
+  uint32_t INIT;
+  uint32_t POL;
+} CRC_TypeDef;
+
+extern CRC_TypeDef emu_crc;
+
+#define CRC     (&emu_crc)
+
+#define CRC_CR_RESET                0x00000001U
+#define CRC_CR_POLYSIZE             0x00000018U
+#define CRC_CR_REV_IN               0x00000060U
+#define CRC_CR_REV_IN_0             0x00000020U
+#define CRC_CR_REV_IN_1             0x00000040U
+#define CRC_CR_REV_OUT              0x00000080U
+
+#define __HAL_RCC_CRC_CLK_ENABLE()  do { } while (0)
+
+uint32_t __RBIT(uint32_t value);
+
+void     crc_unit_control(uint32_t cr);
+void     crc_unit_write(uint32_t data, int bits);
+uint32_t crc_unit_read(void);
+
+
+typedef enum
+{
+  HAL_OK       = 0x00U,
+  HAL_ERROR    = 0x01U,
+  HAL_BUSY     = 0x02U,
+  HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+  uint32_t TypeErase;
+  uint32_t Banks;
+  uint32_t Sector;
+  uint32_t NbSectors;
+  uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+#define FLASH_TYPEERASE_SECTORS     0x00U
+#define FLASH_VOLTAGE_RANGE_3       0x02U
+#define FLASH_TYPEPROGRAM_BYTE      0x00U
+#define FLASH_TYPEPROGRAM_HALFWORD  0x01U
+#define FLASH_TYPEPROGRAM_WORD      0x02U
+
+#define FLASH_SECTOR_5              5U
+#define FLASH_SECTOR_TOTAL          8U
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+
+
+void bsp_init(void);
+void bsp_deinit(void);
+void hal_init(void);
+
+void led_on(uint8_t ch);
+void led_toggle(uint8_t ch);
+uint8_t button_read(uint8_t ch);
+uint8_t wdg_get_reset(void);
+
+// jump_to_fw() of cmd.c calls it instead of its asm
+void emu_jump_to_fw(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,304 @@
+// MESSAGE FLASH_FW_WRITE_WINDOW PACKING
+
+#define MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW 163
+
+typedef struct MAVLINK_PACKED __mavlink_flash_fw_write_window_t
+{
+ uint32_t addr; /*< block offset*/
+ uint8_t index; /*< packet index in the block*/
+ uint8_t count; /*< packets in the block*/
+ uint8_t length; /*< */
+ uint8_t data[240]; /*< */
+} mavlink_flash_fw_write_window_t;
+
+#define MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN 247
+#define MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_MIN_LEN 247
+#define MAVLINK_MSG_ID_163_LEN 247
+#define MAVLINK_MSG_ID_163_MIN_LEN 247
+
+#define MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_CRC 120
+#define MAVLINK_MSG_ID_163_CRC 120
+
+#define MAVLINK_MSG_FLASH_FW_WRITE_WINDOW_FIELD_DATA_LEN 240
+
+#if MAVLINK_COMMAND_24BIT
+#define MAVLINK_MESSAGE_INFO_FLASH_FW_WRITE_WINDOW { \
+	163, \
+	"FLASH_FW_WRITE_WINDOW", \
+	5, \
+	{  { "addr", NULL, MAVLINK_TYPE_UINT32_T, 0, 0, offsetof(mavlink_flash_fw_write_window_t, addr) }, \
+         { "index", NULL, MAVLINK_TYPE_UINT8_T, 0, 4, offsetof(mavlink_flash_fw_write_window_t, index) }, \
+         { "count", NULL, MAVLINK_TYPE_UINT8_T, 0, 5, offsetof(mavlink_flash_fw_write_window_t, count) }, \
+         { "length", NULL, MAVLINK_TYPE_UINT8_T, 0, 6, offsetof(mavlink_flash_fw_write_window_t, length) }, \
+         { "data", NULL, MAVLINK_TYPE_UINT8_T, 240, 7, offsetof(mavlink_flash_fw_write_window_t, data) }, \
+         } \
+}
+#else
+#define MAVLINK_MESSAGE_INFO_FLASH_FW_WRITE_WINDOW { \
+	"FLASH_FW_WRITE_WINDOW", \
+	5, \
+	{  { "addr", NULL, MAVLINK_TYPE_UINT32_T, 0, 0, offsetof(mavlink_flash_fw_write_window_t, addr) }, \
+         { "index", NULL, MAVLINK_TYPE_UINT8_T, 0, 4, offsetof(mavlink_flash_fw_write_window_t, index) }, \
+         { "count", NULL, MAVLINK_TYPE_UINT8_T, 0, 5, offsetof(mavlink_flash_fw_write_window_t, count) }, \
+         { "length", NULL, MAVLINK_TYPE_UINT8_T, 0, 6, offsetof(mavlink_flash_fw_write_window_t, length) }, \
+         { "data", NULL, MAVLINK_TYPE_UINT8_T, 240, 7, offsetof(mavlink_flash_fw_write_window_t, data) }, \
+         } \
+}
+#endif
+
+/**
+ * @brief Pack a flash_fw_write_window message
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ *
+ * @param addr block offset
+ * @param index packet index in the block
+ * @param count packets in the block
+ * @param length 
+ * @param data 
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_flash_fw_write_window_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg,
+						       uint32_t addr, uint8_t index, uint8_t count, uint8_t length, const uint8_t *data)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN];
+	_mav_put_uint32_t(buf, 0, addr);
+	_mav_put_uint8_t(buf, 4, index);
+	_mav_put_uint8_t(buf, 5, count);
+	_mav_put_uint8_t(buf, 6, length);
+	_mav_put_uint8_t_array(buf, 7, data, 240);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN);
+#else
+	mavlink_flash_fw_write_window_t packet;
+	packet.addr = addr;
+	packet.index = index;
+	packet.count = count;
+	packet.length = length;
+	mav_array_memcpy(packet.data, data, sizeof(uint8_t)*240);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW;
+    return mavlink_finalize_message(msg, system_id, component_id, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_CRC);
+}
+
+/**
+ * @brief Pack a flash_fw_write_window message on a channel
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param chan The MAVLink channel this message will be sent over
+ * @param msg The MAVLink message to compress the data into
+ * @param addr block offset
+ * @param index packet index in the block
+ * @param count packets in the block
+ * @param length 
+ * @param data 
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_flash_fw_write_window_pack_chan(uint8_t system_id, uint8_t component_id, uint8_t chan,
+							   mavlink_message_t* msg,
+						           uint32_t addr,uint8_t index,uint8_t count,uint8_t length,const uint8_t *data)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN];
+	_mav_put_uint32_t(buf, 0, addr);
+	_mav_put_uint8_t(buf, 4, index);
+	_mav_put_uint8_t(buf, 5, count);
+	_mav_put_uint8_t(buf, 6, length);
+	_mav_put_uint8_t_array(buf, 7, data, 240);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN);
+#else
+	mavlink_flash_fw_write_window_t packet;
+	packet.addr = addr;
+	packet.index = index;
+	packet.count = count;
+	packet.length = length;
+	mav_array_memcpy(packet.data, data, sizeof(uint8_t)*240);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW;
+    return mavlink_finalize_message_chan(msg, system_id, component_id, chan, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_CRC);
+}
+
+/**
+ * @brief Encode a flash_fw_write_window struct
+ *
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ * @param flash_fw_write_window C-struct to read the message contents from
+ */
+static inline uint16_t mavlink_msg_flash_fw_write_window_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_flash_fw_write_window_t* flash_fw_write_window)
+{
+	return mavlink_msg_flash_fw_write_window_pack(system_id, component_id, msg, flash_fw_write_window->addr, flash_fw_write_window->index, flash_fw_write_window->count, flash_fw_write_window->length, flash_fw_write_window->data);
+}
+
+/**
+ * @brief Encode a flash_fw_write_window struct on a channel
+ *
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param chan The MAVLink channel this message will be sent over
+ * @param msg The MAVLink message to compress the data into
+ * @param flash_fw_write_window C-struct to read the message contents from
+ */
+static inline uint16_t mavlink_msg_flash_fw_write_window_encode_chan(uint8_t system_id, uint8_t component_id, uint8_t chan, mavlink_message_t* msg, const mavlink_flash_fw_write_window_t* flash_fw_write_window)
+{
+	return mavlink_msg_flash_fw_write_window_pack_chan(system_id, component_id, chan, msg, flash_fw_write_window->addr, flash_fw_write_window->index, flash_fw_write_window->count, flash_fw_write_window->length, flash_fw_write_window->data);
+}
+
+/**
+ * @brief Send a flash_fw_write_window message
+ * @param chan MAVLink channel to send the message
+ *
+ * @param addr block offset
+ * @param index packet index in the block
+ * @param count packets in the block
+ * @param length 
+ * @param data 
+ */
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_flash_fw_write_window_send(mavlink_channel_t chan, uint32_t addr, uint8_t index, uint8_t count, uint8_t length, const uint8_t *data)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN];
+	_mav_put_uint32_t(buf, 0, addr);
+	_mav_put_uint8_t(buf, 4, index);
+	_mav_put_uint8_t(buf, 5, count);
+	_mav_put_uint8_t(buf, 6, length);
+	_mav_put_uint8_t_array(buf, 7, data, 240);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW, buf, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_CRC);
+#else
+	mavlink_flash_fw_write_window_t packet;
+	packet.addr = addr;
+	packet.index = index;
+	packet.count = count;
+	packet.length = length;
+	mav_array_memcpy(packet.data, data, sizeof(uint8_t)*240);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW, (const char *)&packet, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_CRC);
+#endif
+}
+
+/**
+ * @brief Send a flash_fw_write_window message
+ * @param chan MAVLink channel to send the message
+ * @param struct The MAVLink struct to serialize
+ */
+static inline void mavlink_msg_flash_fw_write_window_send_struct(mavlink_channel_t chan, const mavlink_flash_fw_write_window_t* flash_fw_write_window)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+    mavlink_msg_flash_fw_write_window_send(chan, flash_fw_write_window->addr, flash_fw_write_window->index, flash_fw_write_window->count, flash_fw_write_window->length, flash_fw_write_window->data);
+#else
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW, (const char *)flash_fw_write_window, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_CRC);
+#endif
+}
+
+#if MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN <= MAVLINK_MAX_PAYLOAD_LEN
+/*
+  This varient of _send() can be used to save stack space by re-using
+  memory from the receive buffer.  The caller provides a
+  mavlink_message_t which is the size of a full mavlink message. This
+  is usually the receive buffer for the channel, and allows a reply to an
+  incoming message with minimum stack space usage.
+ */
+static inline void mavlink_msg_flash_fw_write_window_send_buf(mavlink_message_t *msgbuf, mavlink_channel_t chan,  uint32_t addr, uint8_t index, uint8_t count, uint8_t length, const uint8_t *data)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char *buf = (char *)msgbuf;
+	_mav_put_uint32_t(buf, 0, addr);
+	_mav_put_uint8_t(buf, 4, index);
+	_mav_put_uint8_t(buf, 5, count);
+	_mav_put_uint8_t(buf, 6, length);
+	_mav_put_uint8_t_array(buf, 7, data, 240);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW, buf, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_CRC);
+#else
+	mavlink_flash_fw_write_window_t *packet = (mavlink_flash_fw_write_window_t *)msgbuf;
+	packet->addr = addr;
+	packet->index = index;
+	packet->count = count;
+	packet->length = length;
+	mav_array_memcpy(packet->data, data, sizeof(uint8_t)*240);
+    _mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW, (const char *)packet, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_MIN_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_CRC);
+#endif
+}
+#endif
+
+#endif
+
+// MESSAGE FLASH_FW_WRITE_WINDOW UNPACKING
+
+
+/**
+ * @brief Get field addr from flash_fw_write_window message
+ *
+ * @return block offset
+ */
+static inline uint32_t mavlink_msg_flash_fw_write_window_get_addr(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  0);
+}
+
+/**
+ * @brief Get field index from flash_fw_write_window message
+ *
+ * @return packet index in the block
+ */
+static inline uint8_t mavlink_msg_flash_fw_write_window_get_index(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  4);
+}
+
+/**
+ * @brief Get field count from flash_fw_write_window message
+ *
+ * @return packets in the block
+ */
+static inline uint8_t mavlink_msg_flash_fw_write_window_get_count(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  5);
+}
+
+/**
+ * @brief Get field length from flash_fw_write_window message
+ *
+ * @return 
+ */
+static inline uint8_t mavlink_msg_flash_fw_write_window_get_length(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  6);
+}
+
+/**
+ * @brief Get field data from flash_fw_write_window message
+ *
+ * @return 
+ */
+static inline uint16_t mavlink_msg_flash_fw_write_window_get_data(const mavlink_message_t* msg, uint8_t *data)
+{
+	return _MAV_RETURN_uint8_t_array(msg, data, 240,  7);
+}
+
+/**
+ * @brief Decode a flash_fw_write_window message into a struct
+ *
+ * @param msg The message to decode
+ * @param flash_fw_write_window C-struct to decode the message contents into
+ */
+static inline void mavlink_msg_flash_fw_write_window_decode(const mavlink_message_t* msg, mavlink_flash_fw_write_window_t* flash_fw_write_window)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	flash_fw_write_window->addr = mavlink_msg_flash_fw_write_window_get_addr(msg);
+	flash_fw_write_window->index = mavlink_msg_flash_fw_write_window_get_index(msg);
+	flash_fw_write_window->count = mavlink_msg_flash_fw_write_window_get_count(msg);
+	flash_fw_write_window->length = mavlink_msg_flash_fw_write_window_get_length(msg);
+	mavlink_msg_flash_fw_write_window_get_data(msg, flash_fw_write_window->data);
+#else
+        uint8_t len = msg->len < MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN? msg->len : MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN;
+        memset(flash_fw_write_window, 0, MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW_LEN);
+	memcpy(flash_fw_write_window, _MAV_PAYLOAD(msg), len);
+#endif
+}
@@ -28,16 +28,32 @@ ser_handler stm32_ser_id = ( ser_handler )-1;
 #define FLASH_RX_BLOCK_LENGTH	(128)
 #define FLASH_PACKET_LENGTH   	128
 
+#define FLASH_WINDOW_PROTOCOL		2
+#define FLASH_WINDOW_PROTOCOL_CRC32	3
+#define FLASH_WINDOW_PACKET_LENGTH	240
+#define FLASH_WINDOW_PACKET_MAX		32
+#define FLASH_WINDOW_BUF_MAX		8
+#define FLASH_WINDOW_RETRY_MAX		10
+#define FLASH_WINDOW_TIMEOUT		1000
+
+#define FLASH_VERIFY_CRC32_KEY		"CRC32"
+#define FLASH_VERIFY_CRC32_KEY_LENGTH	5
+
 
 uint32_t tx_buf[768*1024/4];
 uint32_t rx_buf[768*1024/4];
 
 char err_msg_str[512];
 
+static uint32_t   flash_window_resend;
+static uint8_t    flash_window_protocol;
+static uint32_t   flash_window_crc;
+
 
 int opencr_ld_down( int argc, const char **argv );
 int opencr_ld_jump_to_boot( char *portname );
 int opencr_ld_flash_write( uint32_t addr, uint8_t *p_data, uint32_t length  );
+int opencr_ld_flash_write_window( uint32_t addr, uint8_t *p_data, uint32_t length  );
 int opencr_ld_flash_read( uint32_t addr, uint8_t *p_data, uint32_t length  );
 int opencr_ld_flash_erase( uint32_t length  );
 
@@ -51,6 +67,7 @@ int read_byte( void );
 int write_bytes( char *p_data, int len );
 void delay_ms( int WaitTime );
 uint32_t crc_calc( uint32_t crc_in, uint8_t data_in );
+uint32_t crc32_calc( uint32_t crc_in, uint8_t *p_data, uint32_t length );
 
 
 err_code_t cmd_read_version( uint32_t *p_version, uint32_t *p_revision );
@@ -60,9 +77,11 @@ err_code_t cmd_flash_fw_write_begin( void );
 err_code_t cmd_flash_fw_write_end( void );
 err_code_t cmd_flash_fw_write_packet( uint16_t addr, uint8_t *p_data, uint8_t length );
 err_code_t cmd_flash_fw_write_block( uint32_t addr, uint32_t length  );
+err_code_t cmd_flash_fw_write_begin_window( uint8_t *p_protocol, uint8_t *p_buf_count, uint8_t *p_packet_length, uint8_t *p_packet_max );
+err_code_t cmd_flash_fw_write_window( uint32_t addr, uint8_t *p_data, uint32_t length, uint8_t packet_length, uint32_t mask, uint32_t *p_crc );
 err_code_t cmd_flash_fw_send_block_multi( uint8_t block_count );
 err_code_t cmd_flash_fw_read_block( uint32_t addr, uint8_t *p_data, uint16_t length );
-err_code_t cmd_flash_fw_verify( uint32_t length, uint32_t crc, uint32_t *p_crc_ret );
+err_code_t cmd_flash_fw_verify( uint32_t length, uint32_t crc, uint8_t crc32, uint32_t *p_crc_ret );
 err_code_t cmd_jump_to_fw(void);
 
 
@@ -107,11 +126,12 @@ int opencr_ld_down( int argc, const char **argv )
   uint8_t  *p_buf_crc;
   char *portname;
   uint32_t baud;
-  uint8_t  block_buf[FLASH_TX_BLOCK_LENGTH];
+  uint8_t  *p_buf = (uint8_t *)tx_buf;
   uint32_t addr;
   uint32_t len;
   uint8_t jump_to_fw = 0;
   uint8_t retry;
+  uint8_t crc32;
 
 
   baud     = strtol( argv[ 2 ], NULL, 10 );
@@ -139,6 +159,13 @@ int opencr_ld_down( int argc, const char **argv )
 
   fw_size = opencr_fpsize;
 
+  if( fw_size > sizeof(tx_buf) )
+  {
+    printf("file size over : %d KB\r\n", (int)(sizeof(tx_buf)/1024));
+    fclose( opencr_fp );
+    return -1;
+  }
+
 
   // Jump To Boot
   if( opencr_ld_jump_to_boot(portname ) < 0 )
@@ -201,31 +228,36 @@ int opencr_ld_down( int argc, const char **argv )
   }
 
 #if 1
+  fw_size = opencr_ld_file_read_data( p_buf, fw_size );
+
   t = iclock();
-  crc  = 0;
-  addr = 0;
-  while(1)
+  ret = opencr_ld_flash_write_window( 0, p_buf, fw_size );
+  if( ret == 1 )
   {
-    len = opencr_ld_file_read_data( block_buf, FLASH_TX_BLOCK_LENGTH);
-    if( len == 0 ) break;
-
-    for( i=0; i<len; i++ )
+    // Older bootloader, 8KB blocks acked one by one
+    addr = 0;
+    while( addr < fw_size )
     {
-      crc = crc_calc( crc,  block_buf[i] );
-    }
+      len = fw_size - addr;
+      if( len > FLASH_TX_BLOCK_LENGTH )
+      {
+        len = FLASH_TX_BLOCK_LENGTH;
+      }
 
-    for( retry=0; retry<3; retry++ )
-    {
-      ret = opencr_ld_flash_write( addr, block_buf, len );
-      if( ret >= 0 ) break;
-    }
-    if( ret < 0 ) break;
+      for( retry=0; retry<3; retry++ )
+      {
+        ret = opencr_ld_flash_write( addr, &p_buf[addr], len );
+        if( ret >= 0 ) break;
+      }
+      if( ret < 0 ) break;
 
-    addr += len;
+      addr += len;
+    }
   }
   dt = iclock() - t;
 
-  printf("flash_write : %d : %f sec \r\n", ret,  GET_CALC_TIME(dt));
+  calc_time = GET_CALC_TIME(dt);
+  printf("flash_write : %d : %f sec, %1.1f KB/s, resend %d\r\n", ret, calc_time, calc_time > 0 ? fw_size/1024.0/calc_time : 0.0, flash_window_resend);
   if( ret < 0 )
   {
     ser_close( stm32_ser_id );
@@ -235,6 +267,22 @@ int opencr_ld_down( int argc, const char **argv )
     return -2;
   }
 
+  // Bootloaders without the CRC32 protocol verify with the additive sum
+  if( flash_window_protocol >= FLASH_WINDOW_PROTOCOL_CRC32 )
+  {
+    crc32 = 1;
+    crc   = flash_window_crc;
+  }
+  else
+  {
+    crc32 = 0;
+    crc   = 0;
+    for( i=0; i<fw_size; i++ )
+    {
+      crc = crc_calc( crc,  p_buf[i] );
+    }
+  }
+
 
 #else
   for( i=0; i<fw_size/4; i++ )
@@ -292,7 +340,7 @@ int opencr_ld_down( int argc, const char **argv )
     }
 
     t = iclock();
-    err_code = cmd_flash_fw_verify( fw_size, crc, &crc_ret );
+    err_code = cmd_flash_fw_verify( fw_size, crc, crc32, &crc_ret );
     dt = iclock() - t;
     
     if(err_code == OK)
@@ -303,7 +351,7 @@ int opencr_ld_down( int argc, const char **argv )
 
   if( err_code == OK )
   {
-    printf("CRC OK %X %X %f sec\r\n", crc, crc_ret, GET_CALC_TIME(dt));
+    printf("CRC%s OK %X %X %f sec\r\n", crc32 ? "32" : "", crc, crc_ret, GET_CALC_TIME(dt));
   }
   else
   {
@@ -483,6 +531,174 @@ int opencr_ld_flash_write( uint32_t addr, uint8_t *p_data, uint32_t length  )
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : opencr_ld_flash_write_window
+     WORK    : keeps as many blocks in flight as the bootloader has buffers,
+               it programs one block while the next is received and acks
+               each block once programmed. A NAK carries the bitmap of the
+               packets it got, only the missing ones are sent again.
+               with the CRC32 protocol every block carries its crc, a block
+               corrupted on the way is sent again as a whole and the image
+               crc is accumulated in flash_window_crc
+               returns 1 when the bootloader has no windowed download
+---------------------------------------------------------------------------*/
+int opencr_ld_flash_write_window( uint32_t addr, uint8_t *p_data, uint32_t length  )
+{
+  int ret = 0;
+  err_code_t err_code = OK;
+  mavlink_message_t rx_msg;
+  mavlink_ack_t     ack_msg;
+  uint8_t  buf_count;
+  uint8_t  packet_length;
+  uint8_t  packet_max;
+  uint8_t  acked[FLASH_WINDOW_BUF_MAX];
+  uint32_t block_crc[FLASH_WINDOW_BUF_MAX];
+  uint32_t *p_crc;
+  uint32_t block_length;
+  uint32_t block_total;
+  uint32_t block_sent;
+  uint32_t block_done;
+  uint32_t block_addr;
+  uint32_t block_index;
+  uint32_t received;
+  uint32_t crc_ret;
+  uint32_t mask;
+  uint32_t count;
+  uint32_t len;
+  int retry = 0;
+
+
+  flash_window_resend = 0;
+  flash_window_crc    = 0;
+
+  err_code = cmd_flash_fw_write_begin_window( &flash_window_protocol, &buf_count, &packet_length, &packet_max );
+  if( err_code != OK )
+  {
+    flash_window_protocol = 0;
+    return 1;
+  }
+
+  block_length = packet_length * packet_max;
+  block_total  = (length + block_length - 1) / block_length;
+  block_sent   = 0;
+  block_done   = 0;
+  memset(acked, 0, sizeof(acked));
+
+  while( block_done < block_total )
+  {
+    while( block_sent < block_total && block_sent - block_done < buf_count )
+    {
+      len = length - block_sent*block_length;
+      if( len > block_length ) len = block_length;
+
+      p_crc = NULL;
+      if( flash_window_protocol >= FLASH_WINDOW_PROTOCOL_CRC32 )
+      {
+        p_crc  = &block_crc[block_sent%buf_count];
+        *p_crc = crc32_calc( 0, &p_data[block_sent*block_length], len );
+        flash_window_crc = crc32_calc( flash_window_crc, &p_data[block_sent*block_length], len );
+      }
+
+      acked[block_sent%buf_count] = 0;
+      cmd_flash_fw_write_window( addr + block_sent*block_length, &p_data[block_sent*block_length], len, packet_length, 0xFFFFFFFF, p_crc );
+      block_sent++;
+    }
+
+    len = length - block_done*block_length;
+    if( len > block_length ) len = block_length;
+    count = (len + packet_length - 1) / packet_length;
+    p_crc = (flash_window_protocol >= FLASH_WINDOW_PROTOCOL_CRC32) ? &block_crc[block_done%buf_count] : NULL;
+
+    if( msg_get_resp(0, &rx_msg, FLASH_WINDOW_TIMEOUT) == FALSE )
+    {
+      if( ++retry > FLASH_WINDOW_RETRY_MAX )
+      {
+        opencr_ld_write_err_msg("flash_write_window timeout : 0x%X\r\n", addr + block_done*block_length);
+        ret = -1;
+        break;
+      }
+
+      // Poll the oldest block with its last packet, answered by an ack or a NAK
+      cmd_flash_fw_write_window( addr + block_done*block_length, &p_data[block_done*block_length], len, packet_length, (uint32_t)1<<(count-1), p_crc );
+      flash_window_resend++;
+      continue;
+    }
+
+    if( rx_msg.msgid != MAVLINK_MSG_ID_ACK ) continue;
+
+    mavlink_msg_ack_decode( &rx_msg, &ack_msg);
+    if( ack_msg.msg_id != MAVLINK_MSG_ID_FLASH_FW_WRITE_WINDOW ) continue;
+
+    if( ack_msg.err_code == ERR_INVALID_CMD && block_done == 0 )
+    {
+      // Drain the rejects of the packets already sent
+      while( msg_get_resp(0, &rx_msg, 100) == TRUE );
+      flash_window_protocol = 0;
+      return 1;
+    }
+    if( ack_msg.err_code != OK && ack_msg.err_code != ERR_FLASH_PACKET_LOST && ack_msg.err_code != ERR_FLASH_CRC )
+    {
+      opencr_ld_write_err_msg("flash_write_window ERR : 0x%04X\r\n", ack_msg.err_code);
+      ret = -2;
+      break;
+    }
+
+    block_addr = ack_msg.data[3]<<24|ack_msg.data[2]<<16|ack_msg.data[1]<<8|ack_msg.data[0];
+    received   = ack_msg.data[7]<<24|ack_msg.data[6]<<16|ack_msg.data[5]<<8|ack_msg.data[4];
+    crc_ret    = ack_msg.data[11]<<24|ack_msg.data[10]<<16|ack_msg.data[9]<<8|ack_msg.data[8];
+
+    if( block_addr < addr ) continue;
+    block_index = (block_addr - addr) / block_length;
+    if( block_index < block_done || block_index >= block_sent ) continue;
+
+    p_crc = (flash_window_protocol >= FLASH_WINDOW_PROTOCOL_CRC32) ? &block_crc[block_index%buf_count] : NULL;
+
+    if( ack_msg.err_code == OK )
+    {
+      if( p_crc != NULL && crc_ret != *p_crc )
+      {
+        opencr_ld_write_err_msg("flash_write_window crc ERR : 0x%X, %X %X\r\n", block_addr, *p_crc, crc_ret);
+        ret = -4;
+        break;
+      }
+
+      acked[block_index%buf_count] = 1;
+      while( block_done < block_sent && acked[block_done%buf_count] == 1 )
+      {
+        block_done++;
+      }
+      retry = 0;
+    }
+    else
+    {
+      if( ++retry > FLASH_WINDOW_RETRY_MAX )
+      {
+        opencr_ld_write_err_msg("flash_write_window resend over : 0x%X\r\n", block_addr);
+        ret = -3;
+        break;
+      }
+
+      // ERR_FLASH_CRC comes with an empty bitmap, the whole block goes again
+      len = length - block_index*block_length;
+      if( len > block_length ) len = block_length;
+      count = (len + packet_length - 1) / packet_length;
+      mask  = (count < 32) ? (((uint32_t)1<<count) - 1) : 0xFFFFFFFF;
+      mask &= ~received;
+
+      cmd_flash_fw_write_window( block_addr, &p_data[block_index*block_length], len, packet_length, mask, p_crc );
+      for( ; mask; mask &= mask-1 )
+      {
+        flash_window_resend++;
+      }
+    }
+  }
+
+  cmd_flash_fw_write_end();
+
+  return ret;
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : opencr_ld_flash_read
      WORK    :
@@ -917,6 +1133,110 @@ err_code_t cmd_flash_fw_write_block( uint32_t addr, uint32_t length  )
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : cmd_flash_fw_write_begin_window
+     WORK    : asks for the windowed download, older bootloaders answer
+               without the window parameters
+---------------------------------------------------------------------------*/
+err_code_t cmd_flash_fw_write_begin_window( uint8_t *p_protocol, uint8_t *p_buf_count, uint8_t *p_packet_length, uint8_t *p_packet_max )
+{
+  err_code_t err_code = OK;
+  mavlink_message_t tx_msg;
+  mavlink_message_t rx_msg;
+  mavlink_ack_t     ack_msg;
+  uint8_t param[8];
+  uint8_t resp = 1;
+
+
+  memset(param, 0, sizeof(param));
+  param[0] = FLASH_WINDOW_PROTOCOL_CRC32;
+
+  mavlink_msg_flash_fw_write_begin_pack(0, 0, &tx_msg, resp, param);
+  msg_send(0, &tx_msg);
+
+  if( msg_get_resp(0, &rx_msg, 500) == TRUE )
+  {
+    mavlink_msg_ack_decode( &rx_msg, &ack_msg);
+
+    if( tx_msg.msgid != ack_msg.msg_id )  err_code = ERR_MISMATCH_ID;
+    else if( ack_msg.err_code != OK )     err_code = ack_msg.err_code;
+    else if( ack_msg.length != 4
+          || (ack_msg.data[0] != FLASH_WINDOW_PROTOCOL && ack_msg.data[0] != FLASH_WINDOW_PROTOCOL_CRC32)
+          || ack_msg.data[1] == 0 || ack_msg.data[1] > FLASH_WINDOW_BUF_MAX
+          || ack_msg.data[2] == 0 || ack_msg.data[2] > FLASH_WINDOW_PACKET_LENGTH
+          || ack_msg.data[3] == 0 || ack_msg.data[3] > FLASH_WINDOW_PACKET_MAX )
+    {
+      err_code = ERR_NOT_SUPPORTED;
+    }
+    else
+    {
+      *p_protocol      = ack_msg.data[0];
+      *p_buf_count     = ack_msg.data[1];
+      *p_packet_length = ack_msg.data[2];
+      *p_packet_max    = ack_msg.data[3];
+    }
+  }
+  else
+  {
+    err_code = ERR_TIMEOUT;
+  }
+
+  return err_code;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : cmd_flash_fw_write_window
+     WORK    : sends the packets of a block selected by mask in one write,
+               no response per packet. p_crc, if given, follows as the
+               block crc
+---------------------------------------------------------------------------*/
+err_code_t cmd_flash_fw_write_window( uint32_t addr, uint8_t *p_data, uint32_t length, uint8_t packet_length, uint32_t mask, uint32_t *p_crc )
+{
+  err_code_t err_code = OK;
+  mavlink_message_t tx_msg;
+  uint8_t  buf[(FLASH_WINDOW_PACKET_MAX+1)*MAVLINK_MAX_PACKET_LEN];
+  uint8_t  data[FLASH_WINDOW_PACKET_LENGTH];
+  uint32_t count;
+  uint32_t offset;
+  uint32_t packet_len;
+  uint32_t len;
+  uint32_t i;
+
+
+  count = (length + packet_length - 1) / packet_length;
+
+  len = 0;
+  for( i=0; i<count; i++ )
+  {
+    if( (mask & ((uint32_t)1<<i)) == 0 ) continue;
+
+    offset     = i * packet_length;
+    packet_len = length - offset;
+    if( packet_len > packet_length ) packet_len = packet_length;
+
+    memset(data, 0xFF, sizeof(data));
+    memcpy(data, &p_data[offset], packet_len);
+
+    mavlink_msg_flash_fw_write_window_pack(0, 0, &tx_msg, addr, i, count, packet_len, data);
+    len += mavlink_msg_to_send_buffer(&buf[len], &tx_msg);
+  }
+
+  if( p_crc != NULL )
+  {
+    mavlink_msg_flash_fw_window_crc_pack(0, 0, &tx_msg, addr, *p_crc);
+    len += mavlink_msg_to_send_buffer(&buf[len], &tx_msg);
+  }
+
+  if( len > 0 && write_bytes((char *)buf, len) != len )
+  {
+    err_code = ERR_SIZE_OVER;
+  }
+
+  return err_code;
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : cmd_flash_fw_read_block
      WORK    :
@@ -1015,7 +1335,7 @@ err_code_t cmd_flash_fw_read_block( uint32_t addr, uint8_t *p_data, uint16_t len
      TITLE   : cmd_flash_fw_verify
      WORK    :
 ---------------------------------------------------------------------------*/
-err_code_t cmd_flash_fw_verify( uint32_t length, uint32_t crc, uint32_t *p_crc_ret )
+err_code_t cmd_flash_fw_verify( uint32_t length, uint32_t crc, uint8_t crc32, uint32_t *p_crc_ret )
 {
   err_code_t err_code = OK;
   mavlink_message_t tx_msg;
@@ -1025,6 +1345,13 @@ err_code_t cmd_flash_fw_verify( uint32_t length, uint32_t crc, uint32_t *p_crc_r
   uint8_t resp = 1;
 
 
+  // The key in param asks for a CRC32 on the CRC unit
+  memset(param, 0, sizeof(param));
+  if( crc32 == 1 )
+  {
+    memcpy(param, FLASH_VERIFY_CRC32_KEY, FLASH_VERIFY_CRC32_KEY_LENGTH);
+  }
+
   mavlink_msg_flash_fw_verify_pack(0, 0, &tx_msg, resp, length, crc, param);
   msg_send(0, &tx_msg);
 
@@ -1099,6 +1426,44 @@ uint32_t crc_calc( uint32_t crc_in, uint8_t data_in )
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : crc32_calc
+     WORK    : CRC-32 (IEEE 802.3, same as zlib), table driven.
+               crc_in is the result of the previous part or 0 to start
+---------------------------------------------------------------------------*/
+uint32_t crc32_calc( uint32_t crc_in, uint8_t *p_data, uint32_t length )
+{
+  static uint32_t crc_table[256];
+  static uint8_t  crc_table_init = 0;
+  uint32_t crc;
+  uint32_t i;
+  uint32_t j;
+
+
+  if( crc_table_init == 0 )
+  {
+    for( i=0; i<256; i++ )
+    {
+      crc = i;
+      for( j=0; j<8; j++ )
+      {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+      }
+      crc_table[i] = crc;
+    }
+    crc_table_init = 1;
+  }
+
+  crc = ~crc_in;
+  for( i=0; i<length; i++ )
+  {
+    crc = crc_table[(crc ^ p_data[i]) & 0xFF] ^ (crc >> 8);
+  }
+
+  return ~crc;
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : opencr_ld_write_err_msg
      WORK    :
@@ -59,7 +59,7 @@ int main( int argc, const char **argv )
 
   if( argc < 4 )
   {
-    fprintf( stderr, "Usage: opencl_ld <port> <baud> <binary image name> [<0|1 to send Go command to new flashed app>]\n" );
+    fprintf( stderr, "Usage: opencl_ld <port> <baud> <binary image name> [<0|1 to send Go command to new flashed app>] [delta]\n" );
     fprintf( stderr, "       opencr_ld_shell make fw.bin burger V171017R1\n" );
     fprintf( stderr, "       opencr_ld_sheel view fw_name\n" );
 
@@ -29,6 +29,12 @@ typedef uint16_t err_code_t;
 #define ERR_TIMEOUT                         0xF020
 #define ERR_MISMATCH_ID                     0xF021
 #define ERR_SIZE_OVER                       0xF022
+#define ERR_NOT_SUPPORTED                   0xF023
+
+// Reported by the bootloader
+#define ERR_INVALID_CMD                     0x0001
+#define ERR_FLASH_CRC                       0x0019
+#define ERR_FLASH_PACKET_LOST               0x001A
 
 
 
@@ -78,9 +78,6 @@ BOOL msg_get_resp( uint8_t chan, mavlink_message_t *p_msg, uint32_t timeout)
 {
   BOOL ret = FALSE;
   //int  ch_ret;
-  int  length;
-  int  i;
-  uint8_t ch_buff[128];
   uint8_t ch;
   static mavlink_message_t msg[MSG_CH_MAX];
   static mavlink_status_t status[MSG_CH_MAX];
@@ -88,13 +85,23 @@ BOOL msg_get_resp( uint8_t chan, mavlink_message_t *p_msg, uint32_t timeout)
 
 
 #ifndef WIN32_BUILD
+  // Bytes after a complete message are kept for the next call,
+  // acks of the windowed download can arrive back to back.
+  static uint8_t ch_buff[128];
+  static int     ch_length = 0;
+  static int     ch_index  = 0;
+
   retry = timeout/100;
   ser_set_timeout_ms( stm32_ser_id, 100 );
   while(1)
   {
-    length = read_bytes( ch_buff, 128 );
+    if( ch_index >= ch_length )
+    {
+      ch_index  = 0;
+      ch_length = read_bytes( ch_buff, 128 );
+    }
 
-    if( length <= 0 )
+    if( ch_length <= 0 )
     {
       if( retry-- <= 0 )
       {
@@ -107,9 +114,9 @@ BOOL msg_get_resp( uint8_t chan, mavlink_message_t *p_msg, uint32_t timeout)
       }
     }
 
-    for( i=0; i<length; i++ )
+    while( ch_index < ch_length )
     {
-      ch = ch_buff[i];
+      ch = ch_buff[ch_index++];
       ret = msg_recv( chan, ch, &msg[chan], &status[chan] );
 
       if( ret == TRUE )
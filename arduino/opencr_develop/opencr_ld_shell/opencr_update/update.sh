@@ -25,9 +25,12 @@ echo "OpenCR Update Start.."
 if (($#==2))
 then
   $shell_cmd $1 115200 $2 1
+elif (($#==3)) && [ "$3" == "delta" ]
+then
+  $shell_cmd $1 115200 $2 1 delta
 else
   echo "wrong parameter "
-  echo "update.sh <port> fw_name"
+  echo "update.sh <port> fw_name [delta]"
 fi
 
 exit
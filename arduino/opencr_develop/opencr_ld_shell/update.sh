@@ -5,9 +5,12 @@ echo "OpenCR Update Start.."
 if (($#==2))
 then
   ./opencr_ld_shell $1 115200 $2 1
+elif (($#==3)) && [ "$3" == "delta" ]
+then
+  ./opencr_ld_shell $1 115200 $2 1 delta
 else
   echo "wrong parameter "
-  echo "update.sh <port> fw_name"
+  echo "update.sh <port> fw_name [delta]"
 fi
 
 exit